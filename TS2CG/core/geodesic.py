@@ -0,0 +1,20 @@
+"""Shared settings of the path (geodesic) distances of DAI and INU"""
+
+import logging
+
+logger = logging.getLogger(__name__)
+
+# longest edge (nm) of the point graph; a few point spacings, but below the distance between two sheets of a fold
+GEODESIC_EDGE_CUTOFF = 5.0
+# edges per point in the C++ engine: the nearest ones within the edge cutoff
+GEODESIC_NEIGHBOURS = 12
+
+
+def native_engine():
+    """The C++ engines of PCG (TS2CG.cpp._pcg: geodesics for DAI and INU, domain assignment for DOP),
+    or None if the python modules were not built"""
+    try:
+        from ..cpp import _pcg
+        return _pcg
+    except ImportError:
+        return None
@@ -0,0 +1,203 @@
+#include <cmath>
+#include <algorithm>
+#include "CellList.h"
+
+CellList::CellList()
+{
+    m_N[0]=m_N[1]=m_N[2]=0;
+    m_Cutoff2=0;
+    m_Sparse=false;
+    m_CellStart.assign(1,0);
+}
+CellList::~CellList()
+{
+
+}
+double CellList::Wrap(double x, int d) const
+{
+    double L = m_Box(d);
+    if(x>=0 && x<L)
+        return x;
+    x = x - L*std::floor(x/L);
+    if(x>=L)        // floor rounding for tiny negative x
+        x = 0;
+    return x;
+}
+void CellList::GridOf(const Vec3D &X, int *g) const
+{
+    for (int d=0;d<3;d++)
+    {
+        g[d] = int(X(d)/m_CellSize(d));
+        if(g[d]>=m_N[d])
+            g[d] = m_N[d]-1;
+        else if(g[d]<0)
+            g[d] = 0;
+    }
+}
+int CellList::CellID(int i, int j, int k) const
+{
+    if(!m_Sparse)
+        return i+m_N[0]*(j+m_N[1]*k);
+    return FindCell(Key(i,j,k));
+}
+int CellList::FindCell(long long key) const
+{
+    size_t mask = m_HashKey.size()-1;
+    for (size_t h=Slot(key);;h=(h+1)&mask)
+    {
+        if(m_HashKey[h]==key)
+            return m_HashCell[h];
+        if(m_HashKey[h]<0)
+            return -1;
+    }
+}
+int CellList::InsertCell(long long key)
+{
+    size_t mask = m_HashKey.size()-1;
+    size_t h = Slot(key);
+    for (;m_HashKey[h]>=0;h=(h+1)&mask)
+        if(m_HashKey[h]==key)
+            return m_HashCell[h];
+    m_HashKey[h] = key;
+    m_HashCell[h] = m_CellKey.size();
+    m_CellKey.push_back(key);
+    return m_HashCell[h];
+}
+int CellList::CellOf(const Vec3D &X) const
+{
+    int g[3];
+    GridOf(X,g);
+    return CellID(g[0],g[1],g[2]);
+}
+void CellList::Build(const Vec3D *pos, int np, const Vec3D &box, double cutoff, double cellsize)
+{
+    m_Box = box;
+    m_Cutoff2 = cutoff*cutoff;
+    double size = std::max(cellsize,cutoff);
+    for (int d=0;d<3;d++)
+    {
+        m_N[d] = int(m_Box(d)/size);
+        if(m_N[d]<1)
+            m_N[d] = 1;
+        m_CellSize(d) = m_Box(d)/double(m_N[d]);
+    }
+    // a sparse set of points in a big box would mostly give empty cells; then only the occupied ones are kept
+    double maxcells = std::max(8.0*np, 4096.0);
+    m_Sparse = (double(m_N[0])*double(m_N[1])*double(m_N[2])>maxcells);
+    m_CellKey.clear();
+    if(m_Sparse)
+    {
+        // at most np occupied cells, keep the table at most half full
+        m_HashShift = 64;
+        size_t size = 1;
+        while(size<2*size_t(np)+2)
+        {
+            size *= 2;
+            m_HashShift--;
+        }
+        m_HashKey.assign(size,-1);
+        m_HashCell.assign(size,0);
+    }
+
+    //=== counting sort of the points into cells
+    std::vector<int> cell(np);
+    std::vector<Vec3D> wrapped(np);
+    int g[3];
+    for (int i=0;i<np;i++)
+    {
+        wrapped[i] = Vec3D(Wrap(pos[i](0),0),Wrap(pos[i](1),1),Wrap(pos[i](2),2));
+        GridOf(wrapped[i],g);
+        if(!m_Sparse)
+            cell[i] = g[0]+m_N[0]*(g[1]+m_N[1]*g[2]);
+        else
+            cell[i] = InsertCell(Key(g[0],g[1],g[2]));
+    }
+    int nc = m_Sparse ? int(m_CellKey.size()) : m_N[0]*m_N[1]*m_N[2];
+    m_CellStart.assign(nc+1,0);
+    for (int i=0;i<np;i++)
+        m_CellStart[cell[i]+1]++;
+    for (int c=0;c<nc;c++)
+        m_CellStart[c+1]+=m_CellStart[c];
+
+    std::vector<int> fill(m_CellStart.begin(),m_CellStart.end()-1);
+    m_Index.resize(np);
+    m_X.resize(np); m_Y.resize(np); m_Z.resize(np);
+    for (int i=0;i<np;i++)
+    {
+        int s = fill[cell[i]]++;
+        m_Index[s] = i;
+        m_X[s] = wrapped[i](0);
+        m_Y[s] = wrapped[i](1);
+        m_Z[s] = wrapped[i](2);
+    }
+}
+int CellList::Neighbours(const int *g, int *nb) const
+{
+    // with less than 3 cells in a direction the periodic images coincide; visit each cell once
+    int off[3][3], no[3];
+    for (int d=0;d<3;d++)
+    {
+        no[d] = 0;
+        for (int s=-1;s<2;s++)
+        {
+            int m = (g[d]+s+m_N[d])%m_N[d];
+            bool dup = false;
+            for (int q=0;q<no[d];q++)
+                if(off[d][q]==m)
+                    dup = true;
+            if(!dup)
+                off[d][no[d]++] = m;
+        }
+    }
+    int n = 0;
+    for (int a=0;a<no[2];a++)
+    for (int b=0;b<no[1];b++)
+    for (int e=0;e<no[0];e++)
+    {
+        int c = CellID(off[0][e],off[1][b],off[2][a]);
+        if(c>=0)
+            nb[n++] = c;
+    }
+    return n;
+}
+int CellList::NeighbourCells(int c, int *nb) const
+{
+    int g[3];
+    long long key = m_Sparse ? m_CellKey[c] : c;
+    g[0] = int(key%m_N[0]);
+    g[1] = int((key/m_N[0])%m_N[1]);
+    g[2] = int(key/(m_N[0]*(long long)(m_N[1])));
+    return Neighbours(g,nb);
+}
+double CellList::Dist2(const Vec3D &X1, const Vec3D &X2) const
+{
+    double dx[3];
+    for (int d=0;d<3;d++)
+    {
+        dx[d] = X2(d)-X1(d);
+        if(std::fabs(dx[d])>m_Box(d)/2.0)
+        {
+            if(dx[d]<0)
+                dx[d]=m_Box(d)+dx[d];
+            else if(dx[d]>0)
+                dx[d]=dx[d]-m_Box(d);
+        }
+    }
+    return dx[0]*dx[0]+dx[1]*dx[1]+dx[2]*dx[2];
+}
+bool CellList::AnyWithin(const Vec3D &X) const
+{
+    if(m_Index.empty())
+        return false;
+    Vec3D P(Wrap(X(0),0),Wrap(X(1),1),Wrap(X(2),2));
+    int nb[27], g[3];
+    GridOf(P,g);
+    int n = Neighbours(g,nb);
+    for (int c=0;c<n;c++)
+        for (int s=m_CellStart[nb[c]];s<m_CellStart[nb[c]+1];s++)
+        {
+            if(Dist2(Vec3D(m_X[s],m_Y[s],m_Z[s]),P)<m_Cutoff2)
+                return true;
+        }
+    return false;
+}
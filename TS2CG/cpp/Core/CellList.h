@@ -0,0 +1,93 @@
+#if !defined(AFX_CellList_H_5C3A21B8_C13C_5648_BF23_124095086891__INCLUDED_)
+#define AFX_CellList_H_5C3A21B8_C13C_5648_BF23_124095086891__INCLUDED_
+
+#include <vector>
+#include "Vec3D.h"
+/*
+ Weria Pezeshkian (weria.pezeshkian@gmail.com)
+ Copyright (c) Weria Pezeshkian
+ Periodic cell (linked) list shared by PCG and SOL (TS2CGCore).
+
+ Points are binned with a counting sort into a CSR layout: m_CellStart[c]..m_CellStart[c+1]
+ are the slots of cell c in m_Index (original point ids) and in m_X/m_Y/m_Z (the wrapped
+ coordinates in the same order). A neighbour query therefore walks contiguous memory
+ instead of chasing bead pointers through a map of cells.
+
+ The cell size is max(cellsize, cutoff) rounded so the box holds an integer number of
+ cells (at least one per direction). Positions are wrapped into the box before binning,
+ distances use the minimum image convention.
+
+ When the box would hold more than max(8*points, 4096) cells (a vesicle or a few protein beads in a
+ big box) only the occupied cells are stored: they get compact ids and an open addressing hash
+ table from the grid index to the id (sparse mode). Cells therefore always stay at the cutoff size.
+*/
+class CellList
+{
+public:
+    CellList();
+    ~CellList();
+
+    void Build(const Vec3D *pos, int np, const Vec3D &box, double cutoff, double cellsize);
+    inline void Build(const std::vector<Vec3D> &pos, const Vec3D &box, double cutoff, double cellsize) {Build(pos.data(), pos.size(), box, cutoff, cellsize);}
+
+    inline int GetNx()                          const {return m_N[0];}
+    inline int GetNy()                          const {return m_N[1];}
+    inline int GetNz()                          const {return m_N[2];}
+    inline int GetNumberOfCells()               const {return int(m_CellStart.size())-1;}   // stored (sparse mode: occupied) cells
+    inline bool IsSparse()                      const {return m_Sparse;}
+    inline Vec3D GetCellSize()                  const {return m_CellSize;}
+    inline int CellBegin(int c)                 const {return m_CellStart[c];}
+    inline int CellEnd(int c)                   const {return m_CellStart[c+1];}
+    inline int GetIndex(int slot)               const {return m_Index[slot];}        // original id of the point in a slot
+    inline Vec3D GetSortedPos(int slot)         const {return Vec3D(m_X[slot],m_Y[slot],m_Z[slot]);}
+
+public:
+    int CellID(int i, int j, int k)             const;      // -1 for an empty cell in sparse mode
+    int CellOf(const Vec3D &X)                  const;
+    int NeighbourCells(int c, int *nb)          const;      // the (up to) 27 periodic (non empty in sparse mode) neighbours of c, c included; returns how many
+    double Dist2(const Vec3D &X1, const Vec3D &X2) const;   // minimum image
+    bool AnyWithin(const Vec3D &X)              const;      // any point closer than cutoff?
+    // calls f(id, dist2) for every point closer than the cutoff
+    template <class F> void ForEachWithin(const Vec3D &X, F f) const
+    {
+        if(m_Index.empty())
+            return;
+        double x=Wrap(X(0),0), y=Wrap(X(1),1), z=Wrap(X(2),2);
+        int nb[27], g[3];
+        GridOf(Vec3D(x,y,z),g);
+        int n = Neighbours(g,nb);
+        for (int c=0;c<n;c++)
+            for (int s=m_CellStart[nb[c]];s<m_CellStart[nb[c]+1];s++)
+            {
+                double d2 = Dist2(Vec3D(m_X[s],m_Y[s],m_Z[s]),Vec3D(x,y,z));
+                if(d2<m_Cutoff2)
+                    f(m_Index[s],d2);
+            }
+    }
+
+private:
+    double Wrap(double x, int d) const;
+    void GridOf(const Vec3D &X, int *g) const;          // grid index (i,j,k) of a wrapped position
+    int Neighbours(const int *g, int *nb) const;
+    inline long long Key(int i, int j, int k) const {return i+(long long)(m_N[0])*(j+(long long)(m_N[1])*k);}
+    inline size_t Slot(long long key)         const {return size_t((unsigned long long)(key)*0x9E3779B97F4A7C15ULL>>m_HashShift);}
+    int FindCell(long long key)               const;      // -1 if the cell is empty
+    int InsertCell(long long key);
+
+    bool m_Sparse;
+    std::vector<long long> m_HashKey;                  // sparse mode: grid key (-1: empty) and compact cell id,
+    std::vector<int> m_HashCell;                       // linear probing in a power of two table
+    int m_HashShift;
+    std::vector<long long> m_CellKey;                  // compact cell id -> grid key (sparse mode)
+    int m_N[3];
+    Vec3D m_Box;
+    Vec3D m_CellSize;
+    double m_Cutoff2;
+    std::vector<int> m_CellStart;
+    std::vector<int> m_Index;
+    std::vector<double> m_X;
+    std::vector<double> m_Y;
+    std::vector<double> m_Z;
+};
+
+#endif
@@ -0,0 +1,160 @@
+#include <cmath>
+#include <algorithm>
+#include <queue>
+#include <functional>
+#include "Geodesic.h"
+#include "CellList.h"
+#include "Parallel.h"
+
+#define GEODESIC_BLOCK 4096
+
+Geodesic::Geodesic()
+{
+    m_Start.assign(1,0);
+}
+Geodesic::~Geodesic()
+{
+
+}
+void Geodesic::Build(const Vec3D *pos, int np, const Vec3D &box, double edgecutoff, int neighbours)
+{
+    CellList cells;
+    cells.Build(pos, np, box, edgecutoff, edgecutoff);
+
+    //=== neighbours of each point, per block so the blocks can run on different threads
+    int nblock = (np+GEODESIC_BLOCK-1)/GEODESIC_BLOCK;
+    std::vector<std::vector<int> > blockcount(nblock), blockid(nblock);
+    std::vector<std::vector<double> > blocklength(nblock);
+    Parallel::For(nblock, [&](int b) {
+        std::vector<std::pair<double,int> > nb;
+        int first = b*GEODESIC_BLOCK, last = std::min(np, first+GEODESIC_BLOCK);
+        for (int i=first;i<last;i++)
+        {
+            nb.clear();
+            cells.ForEachWithin(pos[i], [&nb,i](int j, double d2) {
+                if(j!=i)
+                    nb.push_back(std::make_pair(d2,j));
+            });
+            // ties are broken by the point id, the graph does not depend on the cell order
+            if(neighbours>0 && int(nb.size())>neighbours)
+            {
+                std::partial_sort(nb.begin(), nb.begin()+neighbours, nb.end());
+                nb.resize(neighbours);
+            }
+            blockcount[b].push_back(nb.size());
+            for (size_t k=0;k<nb.size();k++)
+            {
+                blockid[b].push_back(nb[k].second);
+                blocklength[b].push_back(sqrt(nb[k].first));
+            }
+        }
+    });
+
+    //=== symmetric CSR: every edge i-j is stored in the rows of i and j, duplicates are removed after
+    std::vector<int> degree(np+1,0);
+    for (int b=0;b<nblock;b++)
+    {
+        int e = 0;
+        for (size_t k=0;k<blockcount[b].size();k++)
+        {
+            int i = b*GEODESIC_BLOCK+k;
+            degree[i] += blockcount[b][k];
+            for (int m=0;m<blockcount[b][k];m++,e++)
+                degree[blockid[b][e]]++;
+        }
+    }
+    std::vector<int> start(np+1,0);
+    for (int i=0;i<np;i++)
+        start[i+1] = start[i]+degree[i];
+    std::vector<int> fill(start.begin(), start.end()-1);
+    std::vector<int> id(start[np]);
+    std::vector<double> length(start[np]);
+    for (int b=0;b<nblock;b++)
+    {
+        int e = 0;
+        for (size_t k=0;k<blockcount[b].size();k++)
+        {
+            int i = b*GEODESIC_BLOCK+k;
+            for (int m=0;m<blockcount[b][k];m++,e++)
+            {
+                int j = blockid[b][e];
+                id[fill[i]] = j;  length[fill[i]++] = blocklength[b][e];
+                id[fill[j]] = i;  length[fill[j]++] = blocklength[b][e];
+            }
+        }
+        std::vector<int>().swap(blockid[b]);
+        std::vector<double>().swap(blocklength[b]);
+    }
+    std::vector<int> unique(np,0);
+    Parallel::For(nblock, [&](int b) {
+        std::vector<std::pair<int,double> > row;
+        int first = b*GEODESIC_BLOCK, last = std::min(np, first+GEODESIC_BLOCK);
+        for (int i=first;i<last;i++)
+        {
+            row.clear();
+            for (int e=start[i];e<start[i+1];e++)
+                row.push_back(std::make_pair(id[e],length[e]));
+            std::sort(row.begin(), row.end());
+            int n = 0;
+            for (size_t k=0;k<row.size();k++)
+                if(n==0 || row[k].first!=id[start[i]+n-1])
+                {
+                    id[start[i]+n] = row[k].first;
+                    length[start[i]+n] = row[k].second;
+                    n++;
+                }
+            unique[i] = n;
+        }
+    });
+    m_Start.assign(np+1,0);
+    for (int i=0;i<np;i++)
+        m_Start[i+1] = m_Start[i]+unique[i];
+    m_Neighbour.resize(m_Start[np]);
+    m_Length.resize(m_Start[np]);
+    for (int i=0;i<np;i++)
+        for (int k=0;k<unique[i];k++)
+        {
+            m_Neighbour[m_Start[i]+k] = id[start[i]+k];
+            m_Length[m_Start[i]+k] = length[start[i]+k];
+        }
+}
+void Geodesic::Distances(const int *sources, int nsources, double cutoff, std::vector<double> &dist, std::vector<int> &nearest) const
+{
+    int np = GetNumberOfPoints();
+    dist.assign(np,-1);
+    nearest.assign(np,-1);
+    typedef std::pair<double,int> Item;
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item> > queue;
+    for (int s=0;s<nsources;s++)
+    {
+        int i = sources[s];
+        if(i<0 || i>=np || nearest[i]!=-1)
+            continue;
+        dist[i] = 0;
+        nearest[i] = s;
+        queue.push(Item(0,i));
+    }
+    std::vector<char> done(np,0);
+    while(!queue.empty())
+    {
+        Item top = queue.top();
+        queue.pop();
+        int i = top.second;
+        if(done[i])
+            continue;
+        done[i] = 1;
+        for (int e=m_Start[i];e<m_Start[i+1];e++)
+        {
+            int j = m_Neighbour[e];
+            double d = top.first+m_Length[e];
+            if(done[j] || (cutoff>0 && d>cutoff))
+                continue;
+            if(dist[j]<0 || d<dist[j])
+            {
+                dist[j] = d;
+                nearest[j] = nearest[i];
+                queue.push(Item(d,j));
+            }
+        }
+    }
+}
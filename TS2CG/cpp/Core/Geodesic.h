@@ -0,0 +1,47 @@
+#if !defined(AFX_Geodesic_H_3B9D21B8_C13C_5648_BF23_124095086900__INCLUDED_)
+#define AFX_Geodesic_H_3B9D21B8_C13C_5648_BF23_124095086900__INCLUDED_
+
+#include <vector>
+#include "Vec3D.h"
+/*
+ Weria Pezeshkian (weria.pezeshkian@gmail.com)
+ Copyright (c) Weria Pezeshkian
+ Geodesic (path) distances on a membrane point cloud (TS2CGCore).
+
+ Build() connects every point to its nearest neighbours closer than the edge cutoff (periodic box,
+ minimum image), the graph is symmetric and stored as CSR. The edge cutoff should be a few point
+ spacings but smaller than the distance between two sheets of a fold, so paths can not jump across.
+ The neighbour search runs in parallel blocks (Parallel::For).
+
+ Distances() is one multi-source Dijkstra for any number of sources: every point gets the path length
+ to its closest source and the index (in the source list) of that source. The search stops at the
+ cutoff radius, so painting small domains only visits the points inside them. It runs on one thread;
+ only Build() is parallel.
+*/
+class Geodesic
+{
+public:
+    Geodesic();
+    ~Geodesic();
+
+    // neighbours<=0: all points within the edge cutoff
+    void Build(const Vec3D *pos, int np, const Vec3D &box, double edgecutoff, int neighbours);
+    inline void Build(const std::vector<Vec3D> &pos, const Vec3D &box, double edgecutoff, int neighbours) {Build(pos.data(), pos.size(), box, edgecutoff, neighbours);}
+    // dist = -1 and nearest = -1 for points further than cutoff from all sources (cutoff<=0: no limit)
+    void Distances(const int *sources, int nsources, double cutoff, std::vector<double> &dist, std::vector<int> &nearest) const;
+    inline void Distances(const std::vector<int> &sources, double cutoff, std::vector<double> &dist, std::vector<int> &nearest) const {Distances(sources.data(), sources.size(), cutoff, dist, nearest);}
+
+    inline int GetNumberOfPoints()          const {return int(m_Start.size())-1;}
+    inline long GetNumberOfEdges()          const {return long(m_Neighbour.size());}   // each edge counted in both directions
+    inline int NeighbourBegin(int i)        const {return m_Start[i];}
+    inline int NeighbourEnd(int i)          const {return m_Start[i+1];}
+    inline int GetNeighbour(int e)          const {return m_Neighbour[e];}
+    inline double GetLength(int e)          const {return m_Length[e];}
+
+private:
+    std::vector<int> m_Start;
+    std::vector<int> m_Neighbour;
+    std::vector<double> m_Length;
+};
+
+#endif
@@ -0,0 +1,150 @@
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <cstring>
+#include "GroIO.h"
+
+namespace {
+// copy a fixed width field and drop the blanks
+std::string Field(const char *line, size_t len, size_t from, size_t width)
+{
+    std::string s;
+    for (size_t i=from;i<from+width && i<len;i++)
+        if(line[i]!=' ' && line[i]!='\t')
+            s.push_back(line[i]);
+    return s;
+}
+}
+bool GroIO::Read(const std::string &file, std::string &title, std::vector<GroAtom> &atoms, Vec3D &box)
+{
+    std::ifstream in(file.c_str(), std::ios::binary);
+    if (!in.is_open())
+        return false;
+    std::string data;
+    in.seekg(0, std::ios::end);
+    data.resize(size_t(in.tellg()));
+    in.seekg(0, std::ios::beg);
+    in.read(&data[0], data.size());
+    in.close();
+
+    size_t p = 0;
+    // returns the next line [b,e) without the end of line characters
+    auto nextline = [&](size_t &b, size_t &e) {
+        b = p;
+        e = data.find('\n', p);
+        if(e==std::string::npos)
+            e = data.size();
+        p = (e<data.size())? e+1 : e;
+        if(e>b && data[e-1]=='\r')
+            e--;
+    };
+    size_t b, e;
+    nextline(b, e);
+    title = data.substr(b, e-b);
+    nextline(b, e);
+    int natoms = std::atoi(data.substr(b, e-b).c_str());
+
+    atoms.clear();
+    atoms.reserve(natoms);
+    for (int i=0;i<natoms && p<data.size();i++)
+    {
+        nextline(b, e);
+        const char *line = data.c_str()+b;
+        size_t len = e-b;
+        GroAtom a;
+        a.resid = std::atoi(std::string(line, len<5?len:5).c_str());
+        a.resname = Field(line, len, 5, 5);
+        a.name = Field(line, len, 10, 5);
+        a.id = (len>15)?std::atoi(std::string(line+15, len<20?len-15:5).c_str()):0;
+        a.x = a.y = a.z = 0;
+        if(len>20)
+        {
+            char *end;
+            const char *c = line+20;
+            a.x = std::strtod(c, &end); c = end;
+            a.y = std::strtod(c, &end); c = end;
+            a.z = std::strtod(c, &end);
+        }
+        atoms.push_back(a);
+    }
+    nextline(b, e);
+    const char *c = data.c_str()+b;
+    char *end;
+    box(0) = std::strtod(c, &end); c = end;
+    box(1) = std::strtod(c, &end); c = end;
+    box(2) = std::strtod(c, &end);
+    return true;
+}
+GroWriter::GroWriter()
+{
+    m_File = NULL;
+    m_Used = 0;
+}
+GroWriter::~GroWriter()
+{
+    if(m_File!=NULL)
+    {
+        Flush();
+        fclose(m_File);
+    }
+}
+bool GroWriter::Open(const std::string &file, const std::string &title, int natoms)
+{
+    m_File = fopen(file.c_str(), "w");
+    if(m_File==NULL)
+        return false;
+    m_Buffer.resize(1<<20);
+    m_Used = 0;
+    fprintf(m_File, "%s\n", title.c_str());
+    fprintf(m_File, "%5d\n", natoms);
+    return true;
+}
+void GroWriter::Flush()
+{
+    if(m_Used>0)
+        fwrite(&m_Buffer[0], 1, m_Used, m_File);
+    m_Used = 0;
+}
+void GroWriter::Write(int resid, const std::string &resname, const std::string &name, int id, double x, double y, double z)
+{
+    // a gro line is 45 characters unless a field overflows its width
+    if(m_Buffer.size()-m_Used<256+resname.size()+name.size())
+        Flush();
+    int n = snprintf(&m_Buffer[m_Used], m_Buffer.size()-m_Used, "%5d%5s%5s%5d%8.3f%8.3f%8.3f\n", resid, resname.c_str(), name.c_str(), id, x, y, z);
+    if(n>0 && size_t(n)<m_Buffer.size()-m_Used)
+        m_Used += n;
+    else
+    {
+        // extremely long field; write it directly
+        Flush();
+        fprintf(m_File, "%5d%5s%5s%5d%8.3f%8.3f%8.3f\n", resid, resname.c_str(), name.c_str(), id, x, y, z);
+    }
+}
+void GroWriter::FormatAtom(std::string &out, int resid, const std::string &resname, const std::string &name, int id, double x, double y, double z)
+{
+    char line[256];
+    int n = snprintf(line, sizeof(line), "%5d%5s%5s%5d%8.3f%8.3f%8.3f\n", resid, resname.c_str(), name.c_str(), id, x, y, z);
+    if(n<0)
+    {
+        std::cout<<"---> error: could not format the gro line of atom "<<id<<"\n";
+        return;
+    }
+    if(size_t(n)<sizeof(line))
+    {
+        out.append(line, n);
+        return;
+    }
+    // extremely long field; format it again into a buffer of its size
+    std::vector<char> longline(size_t(n)+1);
+    snprintf(longline.data(), longline.size(), "%5d%5s%5s%5d%8.3f%8.3f%8.3f\n", resid, resname.c_str(), name.c_str(), id, x, y, z);
+    out.append(longline.data(), n);
+}
+void GroWriter::Close(const Vec3D &box)
+{
+    if(m_File==NULL)
+        return;
+    Flush();
+    fprintf(m_File, "%10.5f%10.5f%10.5f\n", box(0), box(1), box(2));
+    fclose(m_File);
+    m_File = NULL;
+}
@@ -0,0 +1,51 @@
+#if !defined(AFX_GroIO_H_6D2B21B8_C13C_5648_BF23_124095086892__INCLUDED_)
+#define AFX_GroIO_H_6D2B21B8_C13C_5648_BF23_124095086892__INCLUDED_
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "Vec3D.h"
+/*
+ Weria Pezeshkian (weria.pezeshkian@gmail.com)
+ Copyright (c) Weria Pezeshkian
+ Shared gro reader/writer (TS2CGCore).
+ GroIO::Read loads the whole file in one go and parses the fixed gro columns
+ (resid 0-4, resname 5-9, atom name 10-14, atom id 15-19, coordinates from 20 on).
+ GroWriter formats the atom lines into one buffer and flushes it in large blocks.
+*/
+struct GroAtom {
+    int resid;
+    std::string resname;
+    std::string name;
+    int id;
+    double x, y, z;
+};
+
+class GroIO
+{
+public:
+    // returns false if the file could not be opened
+    static bool Read(const std::string &file, std::string &title, std::vector<GroAtom> &atoms, Vec3D &box);
+};
+
+class GroWriter
+{
+public:
+    GroWriter();
+    ~GroWriter();
+
+    bool Open(const std::string &file, const std::string &title, int natoms);
+    void Write(int resid, const std::string &resname, const std::string &name, int id, double x, double y, double z);
+    void Close(const Vec3D &box);
+    // appends one atom line in the same format to a string (files written in pieces, PCG_MPI)
+    static void FormatAtom(std::string &out, int resid, const std::string &resname, const std::string &name, int id, double x, double y, double z);
+
+private:
+    void Flush();
+
+    FILE *m_File;
+    std::vector<char> m_Buffer;
+    size_t m_Used;
+};
+
+#endif
@@ -0,0 +1,41 @@
+#include "JSONString.h"
+
+std::string JSONString(const std::string &s)
+{
+    std::string out;
+    out.reserve(s.size()+2);
+    out += '"';
+    for (size_t i=0;i<s.size();i++)
+    {
+        unsigned char c = s[i];
+        if(c=='"' || c=='\\')
+        {
+            out += '\\';
+            out += char(c);
+        }
+        else if(c=='\n')
+            out += "\\n";
+        else if(c=='\t')
+            out += "\\t";
+        else if(c=='\r')
+            out += "\\r";
+        else if(c=='\b')
+            out += "\\b";
+        else if(c=='\f')
+            out += "\\f";
+        else if(c<0x20)
+        {
+            char code[8];
+            snprintf(code, sizeof(code), "\\u%04x", c);
+            out += code;
+        }
+        else
+            out += char(c);
+    }
+    out += '"';
+    return out;
+}
+void WriteJSONString(FILE *f, const std::string &s)
+{
+    fputs(JSONString(s).c_str(), f);
+}
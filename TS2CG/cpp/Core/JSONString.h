@@ -0,0 +1,17 @@
+#if !defined(AFX_JSONString_H_4A6C21B8_C13C_5648_BF23_124095086902__INCLUDED_)
+#define AFX_JSONString_H_4A6C21B8_C13C_5648_BF23_124095086902__INCLUDED_
+
+#include <stdio.h>
+#include <string>
+/*
+ Weria Pezeshkian (weria.pezeshkian@gmail.com)
+ Copyright (c) Weria Pezeshkian
+ Strings in the JSON files of PCG, PLM and SOL (TS2CGCore).
+ JSONString(s) is s in quotes with " and \ escaped and the control characters (below 0x20) written
+ as \n, \t, ... or \u00XX, so any file name or message gives valid JSON. Other bytes (e.g. UTF-8)
+ are copied as they are.
+*/
+std::string JSONString(const std::string &s);
+void WriteJSONString(FILE *f, const std::string &s);
+
+#endif
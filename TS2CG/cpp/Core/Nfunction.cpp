@@ -8,7 +8,6 @@
 #include <cctype>
 #include <iomanip>
 #include <string>
-#include "Def.h"
 #include "Nfunction.h"
 
 std::string Nfunction::Int_to_String(double ConInt) {
@@ -184,12 +183,12 @@ bool Nfunction::CopyBinaryFile(const std::string& inputFilename, const std::stri
 std::string Nfunction::trim(const std::string& str )
 {
     const std::string& whitespace = " \t";
-    char  strBegin = str.find_first_not_of(whitespace);
+    size_t strBegin = str.find_first_not_of(whitespace);
     if (strBegin == std::string::npos)
         return ""; // no content
     
-    char strEnd = str.find_last_not_of(whitespace);
-    char strRange = strEnd - strBegin + 1;
+    size_t strEnd = str.find_last_not_of(whitespace);
+    size_t strRange = strEnd - strBegin + 1;
     
     return str.substr(strBegin, strRange);
 }
@@ -0,0 +1,23 @@
+#include <stdlib.h>
+#include "Parallel.h"
+
+static int s_Threads = 0;
+
+int Parallel::GetThreads()
+{
+    if(s_Threads>0)
+        return s_Threads;
+    const char *env = getenv("TS2CG_NUM_THREADS");
+    if(env!=NULL && atoi(env)>0)
+        return atoi(env);
+    int n = std::thread::hardware_concurrency();
+    return (n>0) ? n : 1;
+}
+int Parallel::GetThreadSetting()
+{
+    return s_Threads;
+}
+void Parallel::SetThreads(int n)
+{
+    s_Threads = (n>0) ? n : 0;
+}
@@ -0,0 +1,90 @@
+#if !defined(AFX_Parallel_H_2F7A21B8_C13C_5648_BF23_124095086898__INCLUDED_)
+#define AFX_Parallel_H_2F7A21B8_C13C_5648_BF23_124095086898__INCLUDED_
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <exception>
+#include <algorithm>
+/*
+ Weria Pezeshkian (weria.pezeshkian@gmail.com)
+ Copyright (c) Weria Pezeshkian
+ Minimal thread helper shared by PCG, PLM and SOL (TS2CGCore).
+ Parallel::For(n, f) calls f(i) for i = 0..n-1 on GetThreads() threads; work items are handed out one
+ at a time, so the items should be blocks of work, not single points. Results must not depend on
+ which thread runs an item (e.g. give each block its own random number stream).
+ The number of threads is set with SetThreads (the -nt option), otherwise the TS2CG_NUM_THREADS
+ environment variable or the number of cores is used.
+ Parallel::Write(out, n, f) is For for text files: f(i, text) appends the lines of item i to text; the
+ items are formatted in blocks on all threads and the blocks are written to out in order, so the file is
+ the same as from a serial loop. Only a few blocks per thread are held at a time.
+ An exception thrown by f (e.g. a ToolExit) stops the loop and is thrown again on the calling thread.
+*/
+class Parallel
+{
+public:
+    static int  GetThreads();
+    static void SetThreads(int n);      // n<=0: automatic
+    static int  GetThreadSetting();     // what SetThreads was given, 0: automatic
+
+    template <class F> static void For(int n, F f)
+    {
+        int nt = std::min(GetThreads(), n);
+        if(nt<=1)
+        {
+            for (int i=0;i<n;i++)
+                f(i);
+            return;
+        }
+        std::atomic<int> next(0);
+        std::exception_ptr error;
+        std::mutex lock;
+        auto work = [&]() {
+            try {
+                for (int i=next++; i<n; i=next++)
+                    f(i);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> guard(lock);
+                if(!error)
+                    error = std::current_exception();
+                next = n;           // the other threads stop after their current item
+            }
+        };
+        std::vector<std::thread> threads;
+        for (int t=1;t<nt;t++)
+            threads.push_back(std::thread(work));
+        work();
+        for (size_t t=0;t<threads.size();t++)
+            threads[t].join();
+        if(error)
+            std::rethrow_exception(error);
+    }
+    template <class F> static bool Write(FILE *out, int n, F f)
+    {
+        const int block = 4096;                     // items per block
+        int nblock = (n+block-1)/block;
+        int round = 4*GetThreads();                 // blocks formatted before they are written
+        std::vector<std::string> text(std::min(round, nblock));
+        bool good = true;
+        for (int b0=0;b0<nblock;b0+=round)
+        {
+            int m = std::min(round, nblock-b0);
+            For(m, [&](int k) {
+                std::string &t = text[k];
+                t.clear();
+                int end = std::min(n, (b0+k+1)*block);
+                for (int i=(b0+k)*block;i<end;i++)
+                    f(i, t);
+            });
+            for (int k=0;k<m && good;k++)
+                good = (fwrite(text[k].data(), 1, text[k].size(), out)==text[k].size());
+        }
+        return good;
+    }
+};
+
+#endif
@@ -0,0 +1,156 @@
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <algorithm>
+#include <sys/resource.h>
+#include "PhaseReport.h"
+#include "JSONString.h"
+
+PhaseReport &PhaseReport::Get()
+{
+    static PhaseReport report;
+    return report;
+}
+PhaseReport::PhaseReport()
+{
+    m_T0 = std::chrono::steady_clock::now();
+}
+void PhaseReport::Start(const std::string &tool)
+{
+    m_Tool = tool;
+    m_Phases.clear();
+    m_Open.clear();
+    m_T0 = std::chrono::steady_clock::now();
+}
+void PhaseReport::Begin(const std::string &name)
+{
+    Phase p;
+    p.Name = name;
+    p.Depth = m_Open.size();
+    p.Seconds = 0;
+    p.RSS = 0;
+    p.PeakRSS = 0;
+    p.PeakGrowth = 0;
+    p.PeakAtBegin = PeakRSS();
+    p.T0 = std::chrono::steady_clock::now();
+    m_Open.push_back(m_Phases.size());
+    m_Phases.push_back(p);
+}
+void PhaseReport::End()
+{
+    if(m_Open.empty())
+        return;
+    Phase &p = m_Phases[m_Open.back()];
+    m_Open.pop_back();
+    p.Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()-p.T0).count();
+    p.RSS = CurrentRSS();
+    p.PeakRSS = std::max(PeakRSS(), p.RSS);
+    p.PeakGrowth = std::max(p.PeakRSS-p.PeakAtBegin, 0L);
+}
+void PhaseReport::Count(const std::string &key, long n)
+{
+    if(m_Open.empty())
+        return;
+    std::vector<std::pair<std::string, long> > &c = m_Phases[m_Open.back()].Counters;
+    for (size_t i=0;i<c.size();i++)
+    {
+        if(c[i].first==key)
+        {
+            c[i].second += n;
+            return;
+        }
+    }
+    c.push_back(std::make_pair(key, n));
+}
+// a "Vm...:  N kB" line of /proc/<pid>/status (pid 0: this process); -1 without procfs
+static long ProcStatus(const char *key, int pid = 0)
+{
+    char file[64];
+    if(pid>0)
+        snprintf(file, sizeof(file), "/proc/%d/status", pid);
+    else
+        snprintf(file, sizeof(file), "/proc/self/status");
+    FILE *f = fopen(file, "r");
+    if(f==NULL)
+        return -1;
+    char line[256];
+    long value = -1;
+    size_t n = strlen(key);
+    while(fgets(line, sizeof(line), f)!=NULL)
+    {
+        if(strncmp(line, key, n)==0 && line[n]==':')
+        {
+            if(sscanf(line+n+1, "%ld", &value)!=1)
+                value = -1;
+            break;
+        }
+    }
+    fclose(f);
+    return value;
+}
+long PhaseReport::PeakRSS()
+{
+    // VmHWM and VmRSS are counted the same way, so the peak is never below the current value
+    long hwm = ProcStatus("VmHWM");
+    if(hwm>=0)
+        return std::max(hwm, ProcStatus("VmRSS"));
+    struct rusage u;
+    if(getrusage(RUSAGE_SELF, &u)!=0)
+        return 0;
+#if defined(__APPLE__)
+    return u.ru_maxrss/1024;    // bytes on macOS
+#else
+    return u.ru_maxrss;
+#endif
+}
+long PhaseReport::PeakRSSOf(int pid)
+{
+    return ProcStatus("VmHWM", pid);
+}
+long PhaseReport::CurrentRSS()
+{
+    long rss = ProcStatus("VmRSS");
+    if(rss>=0)
+        return rss;
+    rss = 0;
+    FILE *f = fopen("/proc/self/statm", "r");
+    if(f==NULL)
+        return PeakRSS();       // no procfs (e.g. macOS)
+    long size = 0;
+    if(fscanf(f, "%ld %ld", &size, &rss)!=2)
+        rss = 0;
+    fclose(f);
+    return rss*(sysconf(_SC_PAGESIZE)/1024);
+}
+bool PhaseReport::Write(const std::string &file) const
+{
+    FILE *f = fopen(file.c_str(), "w");
+    if(f==NULL)
+    {
+        printf("---> warning: could not write the performance report %s \n", file.c_str());
+        return false;
+    }
+    double total = std::chrono::duration<double>(std::chrono::steady_clock::now()-m_T0).count();
+    fprintf(f, "{\n  \"tool\": ");
+    WriteJSONString(f, m_Tool);
+    fprintf(f, ",\n  \"total_seconds\": %.6f,\n  \"peak_rss_kb\": %ld,\n  \"phases\": [", total, PeakRSS());
+    for (size_t i=0;i<m_Phases.size();i++)
+    {
+        const Phase &p = m_Phases[i];
+        fprintf(f, "%s\n    {\"name\": ", (i==0) ? "" : ",");
+        WriteJSONString(f, p.Name);
+        fprintf(f, ", \"depth\": %d, \"seconds\": %.6f, \"rss_kb\": %ld, \"process_peak_rss_kb\": %ld, \"peak_growth_kb\": %ld, \"counters\": {",
+                p.Depth, p.Seconds, p.RSS, p.PeakRSS, p.PeakGrowth);
+        for (size_t j=0;j<p.Counters.size();j++)
+        {
+            if(j!=0)
+                fprintf(f, ", ");
+            WriteJSONString(f, p.Counters[j].first);
+            fprintf(f, ": %ld", p.Counters[j].second);
+        }
+        fprintf(f, "}}");
+    }
+    fprintf(f, "\n  ]\n}\n");
+    fclose(f);
+    return true;
+}
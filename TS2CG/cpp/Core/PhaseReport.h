@@ -0,0 +1,63 @@
+#if !defined(AFX_PhaseReport_H_6B2E21B8_C13C_5648_BF23_124095086896__INCLUDED_)
+#define AFX_PhaseReport_H_6B2E21B8_C13C_5648_BF23_124095086896__INCLUDED_
+
+#include <string>
+#include <vector>
+#include <chrono>
+/*
+ Weria Pezeshkian (weria.pezeshkian@gmail.com)
+ Copyright (c) Weria Pezeshkian
+ Per-phase timing, counters and memory of a run of PCG, PLM or SOL (TS2CGCore).
+
+ A tool calls Start() once, wraps each phase in a ScopedPhase and adds counters with Count()
+ (they go to the innermost open phase). Write() stores everything as JSON, e.g.
+   {"tool": "PCG", "total_seconds": 1.2, "peak_rss_kb": 51200,
+    "phases": [{"name": "lipid placement", "depth": 0, "seconds": 0.8, "rss_kb": 48000,
+                "process_peak_rss_kb": 51200, "peak_growth_kb": 3100, "counters": {"lipids": 9000, "rejections": 1200}}]}
+ rss_kb is the resident memory at the end of the phase and process_peak_rss_kb the high-water mark of
+ the process at that point (never below rss_kb). peak_growth_kb is how much the high-water mark rose
+ during the phase, so the phases with a large peak_growth_kb are where memory goes.
+ Counters are not thread safe; count outside parallel loops.
+*/
+class PhaseReport
+{
+public:
+    static PhaseReport &Get();          // one report per process
+
+    void Start(const std::string &tool);
+    void Begin(const std::string &name);
+    void End();
+    void Count(const std::string &key, long n = 1);
+    bool Write(const std::string &file) const;
+
+    static long PeakRSS();              // kB
+    static long CurrentRSS();           // kB
+    static long PeakRSSOf(int pid);     // kB, of another process so far; -1 if it can not be read
+
+private:
+    PhaseReport();
+    struct Phase {
+        std::string Name;
+        int Depth;
+        double Seconds;
+        long RSS;
+        long PeakRSS;                   // of the process, at the end of the phase
+        long PeakAtBegin;
+        long PeakGrowth;                // PeakRSS-PeakAtBegin
+        std::vector<std::pair<std::string, long> > Counters;
+        std::chrono::steady_clock::time_point T0;
+    };
+    std::string m_Tool;
+    std::vector<Phase> m_Phases;
+    std::vector<int> m_Open;            // indices of the open phases, innermost last
+    std::chrono::steady_clock::time_point m_T0;
+};
+// times the enclosing scope as one phase
+class ScopedPhase
+{
+public:
+    explicit ScopedPhase(const std::string &name) {PhaseReport::Get().Begin(name);}
+    ~ScopedPhase()                                {PhaseReport::Get().End();}
+};
+
+#endif
@@ -0,0 +1,118 @@
+#include <stdio.h>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include "PointStore.h"
+
+void PointLayer::clear()
+{
+    ID.clear(); Domain.clear(); Area.clear();
+    X.clear(); Normal.clear(); P1.clear(); P2.clear();
+    C1.clear(); C2.clear(); VType.clear();
+    HasBox = false;
+}
+void PointLayer::reserve(int n)
+{
+    ID.reserve(n); Domain.reserve(n); Area.reserve(n);
+    X.reserve(3*n); Normal.reserve(3*n); P1.reserve(3*n); P2.reserve(3*n);
+    C1.reserve(n); C2.reserve(n); VType.reserve(n);
+}
+void PointLayer::push_back(int id, int domain, double area, const Vec3D &x, const Vec3D &n, const Vec3D &p1, const Vec3D &p2, double c1, double c2, int vtype)
+{
+    ID.push_back(id);
+    Domain.push_back(domain);
+    Area.push_back(area);
+    for (int d=0;d<3;d++)
+    {
+        X.push_back(x(d));
+        Normal.push_back(n(d));
+        P1.push_back(p1(d));
+        P2.push_back(p2(d));
+    }
+    C1.push_back(c1);
+    C2.push_back(c2);
+    VType.push_back(vtype);
+}
+PointLayerView PointLayer::View() const
+{
+    PointLayerView v;
+    v.N = size();
+    v.ID = ID.data(); v.Domain = Domain.data(); v.Area = Area.data();
+    v.X = X.data(); v.Normal = Normal.data(); v.P1 = P1.data(); v.P2 = P2.data();
+    v.C1 = C1.data(); v.C2 = C2.data(); v.VType = VType.data();
+    v.Box = Box;
+    return v;
+}
+bool PointLayer::Write(const std::string &file, const std::string &layer) const
+{
+    FILE *BMFile = OpenWrite(file, layer, size(), HasBox ? &Box : NULL);
+    if(BMFile==NULL)
+        return false;
+    Append(BMFile);
+    fclose(BMFile);
+    return true;
+}
+FILE *PointLayer::OpenWrite(const std::string &file, const std::string &layer, int n, const Vec3D *box)
+{
+    FILE *BMFile = fopen(file.c_str(), "w");
+    if(BMFile==NULL)
+        return NULL;
+    if(box!=NULL)
+        fprintf(BMFile,  "%s%12.3f%12.3f%12.3f\n","Box",(*box)(0),(*box)(1),(*box)(2));
+    fprintf(BMFile,  "%s%10d%s\n","< Point NoPoints",n,">");
+    fprintf(BMFile,  "%s\n","< id domain_id area X Y Z Nx Ny Nz P1x P1y P1z P2x P2y P2z C1 C2 vtype >");
+    fprintf(BMFile,  "< %s >\n",layer.c_str());
+    return BMFile;
+}
+void PointLayer::Append(FILE *BMFile) const
+{
+    for (int i=0;i<size();i++)
+    {
+        const double *x=&X[3*i], *n=&Normal[3*i], *p1=&P1[3*i], *p2=&P2[3*i];
+        fprintf(BMFile,"%10d%5d%10.3f%10.3f%10.3f%10.3f%8.3f%8.3f%8.3f%8.3f%8.3f%8.3f%8.3f%8.3f%8.3f%8.3f%8.3f%10d\n",ID[i],Domain[i],Area[i],x[0],x[1],x[2],n[0],n[1],n[2],p1[0],p1[1],p1[2],p2[0],p2[1],p2[2],C1[i],C2[i],VType[i]);
+    }
+}
+bool PointLayer::Read(const std::string &file)
+{
+    std::ifstream in(file.c_str());
+    if(!in.is_open())
+        return false;
+    clear();
+    std::string line;
+    while(std::getline(in,line))
+    {
+        const char *c = line.c_str();
+        while(*c==' ' || *c=='\t')
+            c++;
+        if(*c=='\0')
+            continue;
+        if(strncmp(c,"Box",3)==0)
+        {
+            char *end;
+            c += 3;
+            Box(0) = strtod(c,&end); c = end;
+            Box(1) = strtod(c,&end); c = end;
+            Box(2) = strtod(c,&end);
+            HasBox = true;
+            continue;
+        }
+        if(*c=='<')
+            continue;
+        // the fixed width columns can touch each other (e.g. 1.000-2.000); strtod stops at the sign
+        double v[18];
+        int nv = 0;
+        char *end;
+        while(nv<18)
+        {
+            v[nv] = strtod(c,&end);
+            if(end==c)
+                break;
+            c = end;
+            nv++;
+        }
+        if(nv<17)
+            continue;
+        push_back(int(v[0]),int(v[1]),v[2],Vec3D(v[3],v[4],v[5]),Vec3D(v[6],v[7],v[8]),Vec3D(v[9],v[10],v[11]),Vec3D(v[12],v[13],v[14]),v[15],v[16],(nv>17)?int(v[17]):0);
+    }
+    return true;
+}
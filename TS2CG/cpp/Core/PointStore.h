@@ -0,0 +1,64 @@
+#if !defined(AFX_PointStore_H_8A3D21B8_C13C_5648_BF23_124095086894__INCLUDED_)
+#define AFX_PointStore_H_8A3D21B8_C13C_5648_BF23_124095086894__INCLUDED_
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "Vec3D.h"
+/*
+ Weria Pezeshkian (weria.pezeshkian@gmail.com)
+ Copyright (c) Weria Pezeshkian
+ In-memory copy of one membrane layer of a point folder (OuterBM.dat or InnerBM.dat), shared by
+ PLM (writer), PCG and the python module (TS2CGCore). Everything is stored as flat arrays, vectors
+ as x0 y0 z0 x1 y1 z1 ..., so it can be handed to numpy without reshuffling.
+ PointLayerView is the same layout with arrays held by someone else (e.g. numpy arrays given to the
+ python module _pcg), so nothing is copied before the points are made.
+*/
+struct PointLayerView {
+    int N;
+    const int    *ID;
+    const int    *Domain;
+    const double *Area;
+    const double *X;                // 3*N
+    const double *Normal;           // 3*N
+    const double *P1;               // 3*N
+    const double *P2;               // 3*N
+    const double *C1;
+    const double *C2;
+    const int    *VType;            // NULL: all surface points
+    Vec3D Box;
+
+    PointLayerView() : N(0), ID(NULL), Domain(NULL), Area(NULL), X(NULL), Normal(NULL), P1(NULL), P2(NULL), C1(NULL), C2(NULL), VType(NULL) {}
+};
+struct PointLayer {
+    std::vector<int>    ID;
+    std::vector<int>    Domain;
+    std::vector<double> Area;
+    std::vector<double> X;          // 3*N
+    std::vector<double> Normal;     // 3*N
+    std::vector<double> P1;         // 3*N
+    std::vector<double> P2;         // 3*N
+    std::vector<double> C1;
+    std::vector<double> C2;
+    std::vector<int>    VType;      // 0 surface, 1 edge
+    Vec3D Box;
+    bool HasBox;
+
+    PointLayer() : HasBox(false) {}
+    inline int size()                   const {return ID.size();}
+    void clear();
+    void reserve(int n);
+    void push_back(int id, int domain, double area, const Vec3D &x, const Vec3D &n, const Vec3D &p1, const Vec3D &p2, double c1, double c2, int vtype);
+    PointLayerView View() const;
+
+    // writes the PLM .dat format; layer is "Outer" or "Inner". The box line is only written if HasBox is true
+    bool Write(const std::string &file, const std::string &layer) const;
+    // the same file in parts: OpenWrite writes the header of n points (box line if box is not NULL), then
+    // Append adds the points of each part in order; NULL if the file can not be opened
+    static FILE *OpenWrite(const std::string &file, const std::string &layer, int n, const Vec3D *box);
+    void Append(FILE *f) const;
+    // reads a PLM .dat file; returns false if it can not be opened
+    bool Read(const std::string &file);
+};
+
+#endif
@@ -0,0 +1,44 @@
+#if !defined(AFX_RefinedSurface_H_4C2E21B8_C13C_5648_BF23_124095086897__INCLUDED_)
+#define AFX_RefinedSurface_H_4C2E21B8_C13C_5648_BF23_124095086897__INCLUDED_
+
+#include <string>
+#include <vector>
+#include "PointStore.h"
+/*
+ Weria Pezeshkian (weria.pezeshkian@gmail.com)
+ Copyright (c) Weria Pezeshkian
+ Everything PLM writes into a point folder, kept in memory: the two layers (OuterBM.dat, InnerBM.dat) and
+ the inclusions and exclusions (IncData.dat, ExcData.dat) on the points of the outer layer. This is how
+ PCG -TSfile gets its points without a point folder.
+
+ PLMRefineSurface is defined in the PLMRefine library (Pointillism/PLMRefine.cpp). It is a shared library
+ that exports only this function, so the classes PLM has with the same names as PCG (inclusion, exclusion,
+ Job, help) do not meet in one binary.
+*/
+struct SurfaceInclusions {
+    std::vector<int>    IncType;
+    std::vector<int>    IncPoint;       // point of the outer layer
+    std::vector<double> IncDirection;   // 3*N, global frame
+    std::vector<int>    ExcPoint;
+    std::vector<double> ExcRadius;
+};
+struct RefinedSurface : public SurfaceInclusions {
+    PointLayer Outer;
+    PointLayer Inner;                   // empty for a monolayer
+};
+// the same with the layers held by the caller (python module _pcg); see Argument::SetSurface
+struct RefinedSurfaceView : public SurfaceInclusions {
+    PointLayerView Outer;
+    PointLayerView Inner;               // N=0 for a monolayer
+};
+
+#if defined(__GNUC__)
+#define PLM_REFINE_EXPORT __attribute__((visibility("default")))
+#else
+#define PLM_REFINE_EXPORT
+#endif
+// runs PLM on the TS file of args (a PLM command line, args[0] is the program name) and keeps the results
+// in surface; on bad input it stops the program the way PLM does
+extern "C" PLM_REFINE_EXPORT void PLMRefineSurface(const std::vector<std::string> &args, RefinedSurface &surface);
+
+#endif
@@ -0,0 +1,135 @@
+#include "RigidTransform.h"
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+inline double Wrap(double x, double L)
+{
+    return (x>=L)? x-L : ((x<0)? x+L : x);
+}
+// scalar part; also handles the tail of the SIMD loops
+template <bool SECOND>
+void Scalar(int from, const double *x, const double *y, const double *z, int n, const double *r,
+            const Vec3D &T1, const Vec3D &T2, const Vec3D &box, double *ox, double *oy, double *oz)
+{
+    const double t0=T1(0), t1=T1(1), t2=T1(2);
+    const double s0=T2(0), s1=T2(1), s2=T2(2);
+    const double L0=box(0), L1=box(1), L2=box(2);
+    for (int i=from;i<n;i++)
+    {
+        double a = r[0]*x[i]+r[1]*y[i]+r[2]*z[i];
+        double b = r[3]*x[i]+r[4]*y[i]+r[5]*z[i];
+        double c = r[6]*x[i]+r[7]*y[i]+r[8]*z[i];
+        a = a+t0; b = b+t1; c = c+t2;
+        if(SECOND)
+        {
+            a = a+s0; b = b+s1; c = c+s2;
+        }
+        ox[i] = Wrap(a,L0);
+        oy[i] = Wrap(b,L1);
+        oz[i] = Wrap(c,L2);
+    }
+}
+#if defined(__AVX512F__)
+inline __m512d Wrap8(__m512d v, __m512d L)
+{
+    __mmask8 lt = _mm512_cmp_pd_mask(v, _mm512_setzero_pd(), _CMP_LT_OQ);
+    __mmask8 ge = _mm512_cmp_pd_mask(v, L, _CMP_GE_OQ);
+    v = _mm512_mask_add_pd(v, lt, v, L);
+    return _mm512_mask_sub_pd(v, ge, v, L);
+}
+template <bool SECOND>
+void Kernel(const double *x, const double *y, const double *z, int n, const double *r,
+            const Vec3D &T1, const Vec3D &T2, const Vec3D &box, double *ox, double *oy, double *oz)
+{
+    __m512d R[9];
+    for (int k=0;k<9;k++)
+        R[k] = _mm512_set1_pd(r[k]);
+    const __m512d t0=_mm512_set1_pd(T1(0)), t1=_mm512_set1_pd(T1(1)), t2=_mm512_set1_pd(T1(2));
+    const __m512d s0=_mm512_set1_pd(T2(0)), s1=_mm512_set1_pd(T2(1)), s2=_mm512_set1_pd(T2(2));
+    const __m512d L0=_mm512_set1_pd(box(0)), L1=_mm512_set1_pd(box(1)), L2=_mm512_set1_pd(box(2));
+    int i=0;
+    for (;i+8<=n;i+=8)
+    {
+        __m512d X=_mm512_loadu_pd(x+i), Y=_mm512_loadu_pd(y+i), Z=_mm512_loadu_pd(z+i);
+        // no fma: keep (r0*x + r1*y) + r2*z rounding
+        __m512d a=_mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(R[0],X),_mm512_mul_pd(R[1],Y)),_mm512_mul_pd(R[2],Z));
+        __m512d b=_mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(R[3],X),_mm512_mul_pd(R[4],Y)),_mm512_mul_pd(R[5],Z));
+        __m512d c=_mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(R[6],X),_mm512_mul_pd(R[7],Y)),_mm512_mul_pd(R[8],Z));
+        a=_mm512_add_pd(a,t0); b=_mm512_add_pd(b,t1); c=_mm512_add_pd(c,t2);
+        if(SECOND)
+        {
+            a=_mm512_add_pd(a,s0); b=_mm512_add_pd(b,s1); c=_mm512_add_pd(c,s2);
+        }
+        _mm512_storeu_pd(ox+i,Wrap8(a,L0));
+        _mm512_storeu_pd(oy+i,Wrap8(b,L1));
+        _mm512_storeu_pd(oz+i,Wrap8(c,L2));
+    }
+    Scalar<SECOND>(i,x,y,z,n,r,T1,T2,box,ox,oy,oz);
+}
+const char *KernelName = "AVX-512";
+#elif defined(__AVX2__)
+inline __m256d Wrap4(__m256d v, __m256d L)
+{
+    __m256d lt = _mm256_cmp_pd(v, _mm256_setzero_pd(), _CMP_LT_OQ);
+    __m256d ge = _mm256_cmp_pd(v, L, _CMP_GE_OQ);
+    v = _mm256_blendv_pd(v, _mm256_add_pd(v, L), lt);
+    return _mm256_blendv_pd(v, _mm256_sub_pd(v, L), ge);
+}
+template <bool SECOND>
+void Kernel(const double *x, const double *y, const double *z, int n, const double *r,
+            const Vec3D &T1, const Vec3D &T2, const Vec3D &box, double *ox, double *oy, double *oz)
+{
+    __m256d R[9];
+    for (int k=0;k<9;k++)
+        R[k] = _mm256_set1_pd(r[k]);
+    const __m256d t0=_mm256_set1_pd(T1(0)), t1=_mm256_set1_pd(T1(1)), t2=_mm256_set1_pd(T1(2));
+    const __m256d s0=_mm256_set1_pd(T2(0)), s1=_mm256_set1_pd(T2(1)), s2=_mm256_set1_pd(T2(2));
+    const __m256d L0=_mm256_set1_pd(box(0)), L1=_mm256_set1_pd(box(1)), L2=_mm256_set1_pd(box(2));
+    int i=0;
+    for (;i+4<=n;i+=4)
+    {
+        __m256d X=_mm256_loadu_pd(x+i), Y=_mm256_loadu_pd(y+i), Z=_mm256_loadu_pd(z+i);
+        // no fma: keep (r0*x + r1*y) + r2*z rounding
+        __m256d a=_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(R[0],X),_mm256_mul_pd(R[1],Y)),_mm256_mul_pd(R[2],Z));
+        __m256d b=_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(R[3],X),_mm256_mul_pd(R[4],Y)),_mm256_mul_pd(R[5],Z));
+        __m256d c=_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(R[6],X),_mm256_mul_pd(R[7],Y)),_mm256_mul_pd(R[8],Z));
+        a=_mm256_add_pd(a,t0); b=_mm256_add_pd(b,t1); c=_mm256_add_pd(c,t2);
+        if(SECOND)
+        {
+            a=_mm256_add_pd(a,s0); b=_mm256_add_pd(b,s1); c=_mm256_add_pd(c,s2);
+        }
+        _mm256_storeu_pd(ox+i,Wrap4(a,L0));
+        _mm256_storeu_pd(oy+i,Wrap4(b,L1));
+        _mm256_storeu_pd(oz+i,Wrap4(c,L2));
+    }
+    Scalar<SECOND>(i,x,y,z,n,r,T1,T2,box,ox,oy,oz);
+}
+const char *KernelName = "AVX2";
+#else
+template <bool SECOND>
+void Kernel(const double *x, const double *y, const double *z, int n, const double *r,
+            const Vec3D &T1, const Vec3D &T2, const Vec3D &box, double *ox, double *oy, double *oz)
+{
+    Scalar<SECOND>(0,x,y,z,n,r,T1,T2,box,ox,oy,oz);
+}
+const char *KernelName = "scalar";
+#endif
+}
+void RigidTransform::Apply(const double *x, const double *y, const double *z, int n,
+                           const Tensor2 &R, const Vec3D &T1, const Vec3D &box,
+                           double *ox, double *oy, double *oz)
+{
+    Kernel<false>(x,y,z,n,R.data(),T1,Vec3D(),box,ox,oy,oz);
+}
+void RigidTransform::Apply(const double *x, const double *y, const double *z, int n,
+                           const Tensor2 &R, const Vec3D &T1, const Vec3D &T2, const Vec3D &box,
+                           double *ox, double *oy, double *oz)
+{
+    Kernel<true>(x,y,z,n,R.data(),T1,T2,box,ox,oy,oz);
+}
+const char *RigidTransform::ISA()
+{
+    return KernelName;
+}
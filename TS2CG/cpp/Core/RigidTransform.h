@@ -0,0 +1,31 @@
+#if !defined(AFX_RigidTransform_H_7E1C21B8_C13C_5648_BF23_124095086893__INCLUDED_)
+#define AFX_RigidTransform_H_7E1C21B8_C13C_5648_BF23_124095086893__INCLUDED_
+
+#include "Vec3D.h"
+#include "Tensor2.h"
+/*
+ Weria Pezeshkian (weria.pezeshkian@gmail.com)
+ Copyright (c) Weria Pezeshkian
+ Batched rigid body transform of a molecule template stored as SoA (x[], y[], z[]):
+
+        out = R*in + T1 (+ T2)
+
+ followed in the same pass by the single periodic shift that bead::BringBeadInBox does
+ (x>=L -> x-L, x<0 -> x+L). Uses AVX-512 or AVX2 when the compiler targets them
+ (e.g. -DTS2CG_NATIVE=ON) and a plain loop the compiler can vectorise otherwise.
+ The operations are done in the same order as Tensor2*Vec3D + Vec3D, so all paths
+ give the same numbers as the bead by bead code.
+*/
+class RigidTransform
+{
+public:
+    static void Apply(const double *x, const double *y, const double *z, int n,
+                      const Tensor2 &R, const Vec3D &T1, const Vec3D &box,
+                      double *ox, double *oy, double *oz);
+    static void Apply(const double *x, const double *y, const double *z, int n,
+                      const Tensor2 &R, const Vec3D &T1, const Vec3D &T2, const Vec3D &box,
+                      double *ox, double *oy, double *oz);
+    static const char *ISA();   // which kernel was compiled in
+};
+
+#endif
@@ -0,0 +1,218 @@
+#include <cmath>
+#include <algorithm>
+#include "SoftRelax.h"
+#include "Parallel.h"
+
+#define RELAX_BLOCK 4096
+#define RELAX_FTOL 0.01         // stop when the largest force is below this (energy/nm)
+#define RELAX_CLASH 0.9         // a clash is a pair closer than RELAX_CLASH*sigma
+
+SoftRelax::SoftRelax(double sigma, double restraintcutoff, double krestraint, double maxstep)
+{
+    m_Sigma = sigma;
+    m_RCut = restraintcutoff;
+    m_K = krestraint;
+    m_MaxStep = maxstep;
+    m_Skin = 0.2*sigma;
+}
+SoftRelax::~SoftRelax()
+{
+
+}
+Vec3D SoftRelax::MinImage(const Vec3D &a, const Vec3D &b) const
+{
+    Vec3D d = a-b;
+    for (int k=0;k<3;k++)
+    {
+        if(d(k)>0.5*m_Box(k))
+            d(k) -= m_Box(k);
+        else if(d(k)<-0.5*m_Box(k))
+            d(k) += m_Box(k);
+    }
+    return d;
+}
+void SoftRelax::BuildRestraints(const std::vector<Vec3D> &pos, const std::vector<int> &molecule, const Vec3D &box)
+{
+    int n = pos.size();
+    CellList cells;
+    cells.Build(pos, box, m_RCut, m_RCut);
+    std::vector<std::vector<int> > partner(n);
+    Parallel::For((n+RELAX_BLOCK-1)/RELAX_BLOCK, [&](int b) {
+        for (int s=b*RELAX_BLOCK;s<std::min(n,(b+1)*RELAX_BLOCK);s++)
+        {
+            int i = cells.GetIndex(s);
+            cells.ForEachWithin(pos[i], [&](int j, double) {
+                if(j!=i && molecule[j]==molecule[i])
+                    partner[i].push_back(j);
+            });
+            std::sort(partner[i].begin(), partner[i].end());
+        }
+    });
+    m_RStart.assign(n+1,0);
+    for (int i=0;i<n;i++)
+        m_RStart[i+1] = m_RStart[i]+partner[i].size();
+    m_RPartner.resize(m_RStart[n]);
+    m_RLength.resize(m_RStart[n]);
+    for (int i=0;i<n;i++)
+        for (size_t k=0;k<partner[i].size();k++)
+        {
+            m_RPartner[m_RStart[i]+k] = partner[i][k];
+            m_RLength[m_RStart[i]+k] = MinImage(pos[i],pos[partner[i][k]]).norm();
+        }
+}
+void SoftRelax::BuildNeighbourList(const std::vector<Vec3D> &pos, const std::vector<int> &molecule)
+{
+    int n = pos.size();
+    CellList cells;
+    cells.Build(pos, m_Box, m_Sigma+m_Skin, m_Sigma+m_Skin);
+    int nblock = (n+RELAX_BLOCK-1)/RELAX_BLOCK;
+    std::vector<std::vector<int> > count(nblock), list(nblock);
+    m_Order.resize(n);
+    Parallel::For(nblock, [&](int b) {
+        for (int s=b*RELAX_BLOCK;s<std::min(n,(b+1)*RELAX_BLOCK);s++)
+        {
+            int i = cells.GetIndex(s);         // slots are ordered by cell
+            m_Order[s] = i;
+            int c = 0;
+            cells.ForEachWithin(pos[i], [&](int j, double) {
+                if(molecule[j]!=molecule[i])
+                {
+                    list[b].push_back(j);
+                    c++;
+                }
+            });
+            count[b].push_back(c);
+        }
+    });
+    m_NStart.assign(n+1,0);
+    m_NList.clear();
+    for (int b=0;b<nblock;b++)
+    {
+        for (size_t k=0;k<count[b].size();k++)
+            m_NStart[b*RELAX_BLOCK+k+1] = m_NStart[b*RELAX_BLOCK+k]+count[b][k];
+        m_NList.insert(m_NList.end(), list[b].begin(), list[b].end());
+    }
+    m_ListPos = pos;
+}
+double SoftRelax::Forces(const std::vector<Vec3D> &pos, const std::vector<int> &molecule, std::vector<Vec3D> &force)
+{
+    int n = pos.size();
+    bool rebuild = (int(m_ListPos.size())!=n);
+    for (int i=0;i<n && !rebuild;i++)
+        if(MinImage(pos[i],m_ListPos[i]).norm2()>0.25*m_Skin*m_Skin)
+            rebuild = true;
+    if(rebuild)
+        BuildNeighbourList(pos, molecule);
+    force.assign(n, Vec3D(0,0,0));
+    int nblock = (n+RELAX_BLOCK-1)/RELAX_BLOCK;
+    std::vector<double> energy(nblock,0);
+    double s2 = m_Sigma*m_Sigma;
+    Parallel::For(nblock, [&](int b) {
+        double e = 0;
+        for (int s=b*RELAX_BLOCK;s<std::min(n,(b+1)*RELAX_BLOCK);s++)
+        {
+            int i = m_Order[s];
+            Vec3D F(0,0,0);
+            for (int k=m_NStart[s];k<m_NStart[s+1];k++)
+            {
+                Vec3D d = MinImage(pos[i],pos[m_NList[k]]);
+                double r2 = d.norm2();
+                if(r2>=s2 || r2<1e-12)
+                    continue;
+                double r = sqrt(r2);
+                double x = 1-r/m_Sigma;
+                e += 0.5*x*x;
+                F += d*(2*x/(m_Sigma*r));
+            }
+            for (int k=m_RStart[i];k<m_RStart[i+1];k++)
+            {
+                Vec3D d = MinImage(pos[i],pos[m_RPartner[k]]);
+                double r = d.norm();
+                if(r<1e-12)
+                    continue;
+                double dr = r-m_RLength[k];
+                e += 0.25*m_K*dr*dr;
+                F -= d*(m_K*dr/r);
+            }
+            force[i] = F;
+        }
+        energy[b] = e;
+    });
+    double E = 0;
+    for (int b=0;b<nblock;b++)
+        E += energy[b];
+    return E;
+}
+long SoftRelax::CountClashes(const std::vector<Vec3D> &pos, const std::vector<int> &molecule, const Vec3D &box) const
+{
+    int n = pos.size();
+    CellList cells;
+    cells.Build(pos, box, RELAX_CLASH*m_Sigma, RELAX_CLASH*m_Sigma);
+    int nblock = (n+RELAX_BLOCK-1)/RELAX_BLOCK;
+    std::vector<long> count(nblock,0);
+    Parallel::For(nblock, [&](int b) {
+        for (int s=b*RELAX_BLOCK;s<std::min(n,(b+1)*RELAX_BLOCK);s++)
+        {
+            int i = cells.GetIndex(s);
+            cells.ForEachWithin(pos[i], [&](int j, double) {
+                if(j>i && molecule[j]!=molecule[i])
+                    count[b]++;
+            });
+        }
+    });
+    long c = 0;
+    for (int b=0;b<nblock;b++)
+        c += count[b];
+    return c;
+}
+SoftRelaxStats SoftRelax::Run(std::vector<Vec3D> &pos, const std::vector<int> &molecule, const std::vector<char> &frozen, const Vec3D &box, int steps)
+{
+    SoftRelaxStats stats;
+    int n = pos.size();
+    m_Box = box;
+    m_ListPos.clear();
+    stats.ClashesBefore = CountClashes(pos, molecule, box);
+    BuildRestraints(pos, molecule, box);
+    stats.Restraints = m_RStart[n]/2;
+
+    std::vector<Vec3D> force, trial(n), trialforce;
+    double E = Forces(pos, molecule, force);
+    stats.EnergyBefore = E;
+    stats.Steps = 0;
+    stats.Accepted = 0;
+    double h = 0.2*m_MaxStep;
+    for (int step=0;step<steps;step++)
+    {
+        double fmax2 = 0;
+        for (int i=0;i<n;i++)
+            if(frozen.empty() || !frozen[i])
+                fmax2 = std::max(fmax2, force[i].norm2());
+        if(fmax2<RELAX_FTOL*RELAX_FTOL)
+            break;
+        stats.Steps++;
+        double scale = h/sqrt(fmax2);
+        for (int i=0;i<n;i++)
+        {
+            trial[i] = pos[i];
+            if(!frozen.empty() && frozen[i])
+                continue;
+            trial[i] += force[i]*scale;
+            for (int k=0;k<3;k++)
+                trial[i](k) -= m_Box(k)*floor(trial[i](k)/m_Box(k));
+        }
+        double Et = Forces(trial, molecule, trialforce);
+        if(Et<E)
+        {
+            pos.swap(trial);
+            force.swap(trialforce);
+            E = Et;
+            h = std::min(1.2*h, m_MaxStep);
+            stats.Accepted++;
+        }
+        else
+            h *= 0.2;
+    }
+    stats.EnergyAfter = E;
+    stats.ClashesAfter = CountClashes(pos, molecule, box);
+    return stats;
+}
@@ -0,0 +1,65 @@
+#if !defined(AFX_SoftRelax_H_4C1E21B8_C13C_5648_BF23_124095086901__INCLUDED_)
+#define AFX_SoftRelax_H_4C1E21B8_C13C_5648_BF23_124095086901__INCLUDED_
+
+#include <vector>
+#include "Vec3D.h"
+#include "CellList.h"
+/*
+ Weria Pezeshkian (weria.pezeshkian@gmail.com)
+ Copyright (c) Weria Pezeshkian
+ Soft-core pre-relaxation of generated coordinates (TS2CGCore), used by PCG -relax.
+
+ Energy:
+   - beads of different molecules closer than sigma repel with (1-r/sigma)^2, which is finite at r=0,
+     so fully overlapping beads can still be separated;
+   - beads of the same molecule closer than the restraint cutoff at the start are kept at their start
+     distance with k/2 (d-d0)^2 (an elastic network on the template geometry).
+ Steepest descent with the step control of GROMACS: the bead with the largest force moves by the step
+ size, the step grows by 1.2 after an accepted step and shrinks by 0.2 after a rejected one.
+ Repulsion uses a Verlet list (sigma + skin) built from the cell list, rebuilt when a bead has moved
+ more than half of the skin. Beads are visited in cell order, in blocks with Parallel::For; every bead
+ only sums its own force, so the result does not depend on the number of threads.
+*/
+struct SoftRelaxStats
+{
+    long ClashesBefore;     // pairs of beads of different molecules closer than 0.9 sigma
+    long ClashesAfter;
+    long Restraints;
+    int Steps;
+    int Accepted;
+    double EnergyBefore;
+    double EnergyAfter;
+};
+class SoftRelax
+{
+public:
+    SoftRelax(double sigma, double restraintcutoff, double krestraint, double maxstep);
+    ~SoftRelax();
+
+    // molecule: beads of one molecule have the same id; frozen (may be empty): beads that do not move
+    SoftRelaxStats Run(std::vector<Vec3D> &pos, const std::vector<int> &molecule, const std::vector<char> &frozen, const Vec3D &box, int steps);
+    long CountClashes(const std::vector<Vec3D> &pos, const std::vector<int> &molecule, const Vec3D &box) const;
+
+private:
+    void BuildRestraints(const std::vector<Vec3D> &pos, const std::vector<int> &molecule, const Vec3D &box);
+    void BuildNeighbourList(const std::vector<Vec3D> &pos, const std::vector<int> &molecule);
+    double Forces(const std::vector<Vec3D> &pos, const std::vector<int> &molecule, std::vector<Vec3D> &force);
+    Vec3D MinImage(const Vec3D &a, const Vec3D &b) const;       // a-b, minimum image
+
+    double m_Sigma;
+    double m_RCut;
+    double m_K;
+    double m_MaxStep;
+    double m_Skin;
+    Vec3D m_Box;
+
+    std::vector<Vec3D> m_ListPos;          // positions when the Verlet list was built
+    std::vector<int> m_Order;              // beads in cell order
+    std::vector<int> m_NStart;             // Verlet list of the bead m_Order[s]: m_NStart[s]..m_NStart[s+1]
+    std::vector<int> m_NList;
+    std::vector<int> m_RStart;             // restraints of bead i: m_RStart[i]..m_RStart[i+1]
+    std::vector<int> m_RPartner;
+    std::vector<double> m_RLength;
+};
+
+#endif
@@ -0,0 +1,119 @@
+#if !defined(AFX_Tensor2_H_3O4421B8_D12D_11D3_CF24_124095086555__INCLUDED_)
+#define AFX_Tensor2_H_3O4421B8_D12D_11D3_CF24_124095086555__INCLUDED_
+
+#include <iostream>
+#include "Vec3D.h"
+
+/*
+ 3x3 tensor shared by PCG, PLM and SOL (TS2CGCore).
+ Header only; the nine components are stored row-major in one array
+
+        | V1 |      | T[0] T[1] T[2] |
+     T= | V2 |   =  | T[3] T[4] T[5] |
+        | V3 |      | T[6] T[7] T[8] |
+
+ The arithmetic keeps the same summation order as the old out-of-line version so the
+ results are bit-for-bit identical.
+*/
+class Tensor2
+{
+public:
+    constexpr Tensor2(const Vec3D& v1, const Vec3D& v2, const Vec3D& v3)
+        : m_T{v1(0), v1(1), v1(2), v2(0), v2(1), v2(2), v3(0), v3(1), v3(2)} {}
+    constexpr Tensor2() : m_T{0, 0, 0, 0, 0, 0, 0, 0, 0} {}
+    Tensor2(char t) : m_T{0, 0, 0, 0, 0, 0, 0, 0, 0}
+    {
+        if(t=='I')
+        {
+            m_T[0]=1.0;
+            m_T[4]=1.0;
+            m_T[8]=1.0;
+        }
+        else if(t!='O')
+        {
+            std::cout<<" Error: Matrix with name "<<t<<" has not been defined \n";
+        }
+    }
+
+public:
+    constexpr Vec3D         GetV1()        const {return Vec3D(m_T[0],m_T[1],m_T[2]);}
+    constexpr Vec3D         GetV2()        const {return Vec3D(m_T[3],m_T[4],m_T[5]);}
+    constexpr Vec3D         GetV3()        const {return Vec3D(m_T[6],m_T[7],m_T[8]);}
+    inline double*          data()               {return m_T;}
+    constexpr const double* data()         const {return m_T;}
+
+private:
+    double m_T[9];
+
+public:
+    constexpr double at(int n, int m)                   const {return m_T[3*n+m];}
+    inline void put(int n, int m, double s)                   {m_T[3*n+m]=s;}
+    inline double& operator()(const int n, const int m)       {return m_T[3*n+m];}
+    constexpr double operator()(const int n, const int m) const {return m_T[3*n+m];}
+
+    Vec3D MULT(const Tensor2& T, const Vec3D& A) const {return T*A;}
+
+    Tensor2 operator + (const Tensor2& M) const
+    {
+        Tensor2 M1;
+        for (int i=0;i<9;i++)
+            M1.m_T[i]=m_T[i]+M.m_T[i];
+        return M1;
+    }
+    Tensor2 operator - (const Tensor2& M) const
+    {
+        Tensor2 M1;
+        for (int i=0;i<9;i++)
+            M1.m_T[i]=m_T[i]-M.m_T[i];
+        return M1;
+    }
+    Tensor2 operator * (const Tensor2& M) const
+    {
+        Tensor2 M1;
+        for (int i=0;i<3;i++)
+            for (int j=0;j<3;j++)
+            {
+                double s=0;
+                for (int k=0;k<3;k++)
+                    s=s+m_T[3*i+k]*M.m_T[3*k+j];
+                M1.m_T[3*i+j]=s;
+            }
+        return M1;
+    }
+    Tensor2 operator * (double x) const
+    {
+        Tensor2 M1;
+        for (int i=0;i<9;i++)
+            M1.m_T[i]=m_T[i]*x;
+        return M1;
+    }
+    // each row dotted with A
+    constexpr Vec3D operator * (const Vec3D& A) const
+    {
+        return Vec3D(m_T[0]*A(0)+m_T[1]*A(1)+m_T[2]*A(2),
+                     m_T[3]*A(0)+m_T[4]*A(1)+m_T[5]*A(2),
+                     m_T[6]*A(0)+m_T[7]*A(1)+m_T[8]*A(2));
+    }
+    // outer product X X^T
+    Tensor2 makeTen(const Vec3D& X) const
+    {
+        Tensor2 A;
+        for (int i=0;i<3;i++)
+        {
+            A.m_T[i]  =X(0)*X(i);
+            A.m_T[3+i]=X(1)*X(i);
+            A.m_T[6+i]=X(2)*X(i);
+        }
+        return A;
+    }
+    Tensor2 Transpose(const Tensor2& X) const
+    {
+        Tensor2 A;
+        for (int i=0;i<3;i++)
+            for (int j=0;j<3;j++)
+                A.m_T[3*i+j]=X.m_T[3*j+i];
+        return A;
+    }
+};
+
+#endif
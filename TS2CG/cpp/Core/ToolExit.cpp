@@ -0,0 +1,26 @@
+#include <stdlib.h>
+#include <atomic>
+#include <string>
+#include <iostream>
+#include "ToolExit.h"
+
+static std::atomic<int> s_ThrowScopes(0);
+
+ToolExit::ToolExit(int code) : std::runtime_error("the tool stopped with exit code "+std::to_string(code)+", see its output"), m_Code(code)
+{
+}
+void ToolExit::Exit(int code)
+{
+    std::cout.flush();
+    if(s_ThrowScopes>0)
+        throw ToolExit(code);
+    exit(code);
+}
+ToolExit::ThrowScope::ThrowScope()
+{
+    s_ThrowScopes++;
+}
+ToolExit::ThrowScope::~ThrowScope()
+{
+    s_ThrowScopes--;
+}
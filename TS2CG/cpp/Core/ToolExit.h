@@ -0,0 +1,34 @@
+#if !defined(AFX_ToolExit_H_7C1F21B8_C13C_5648_BF23_124095086901__INCLUDED_)
+#define AFX_ToolExit_H_7C1F21B8_C13C_5648_BF23_124095086901__INCLUDED_
+
+#include <stdexcept>
+/*
+ Weria Pezeshkian (weria.pezeshkian@gmail.com)
+ Copyright (c) Weria Pezeshkian
+ How PCG, PLM and SOL stop on bad input (TS2CGCore).
+
+ ToolExit::Exit(code) is exit(code) for the command line tools. The python modules run the tools inside
+ the interpreter; they open a ThrowScope, and while one is open Exit throws a ToolExit instead, so the
+ caller gets an exception and the interpreter keeps running. Parallel::For hands an exception of a
+ worker thread to the calling thread.
+*/
+class ToolExit : public std::runtime_error
+{
+public:
+    explicit ToolExit(int code);
+    inline int GetCode()                    const {return m_Code;}
+
+    [[noreturn]] static void Exit(int code);
+
+    class ThrowScope
+    {
+    public:
+        ThrowScope();
+        ~ThrowScope();
+    };
+
+private:
+    int m_Code;
+};
+
+#endif
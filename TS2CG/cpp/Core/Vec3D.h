@@ -0,0 +1,86 @@
+#if !defined(AFX_Vec3D_H_8F4421B8_D12D_11D3_CF24_124095086555__INCLUDED_)
+#define AFX_Vec3D_H_8F4421B8_D12D_11D3_CF24_124095086555__INCLUDED_
+
+#include <iostream>
+#include <cmath>
+/*******************
+ Weria Pezeshkian (weria.pezeshkian@gmail.com)
+ Copyright (c) Weria Pezeshkian
+ An inhouse made  3d vector object.
+ This is the single copy shared by PCG, PLM and SOL (TS2CGCore). Everything is inline so the
+ compiler can keep the components in registers; the components are stored in a fixed array
+ so that loops over (0,1,2) vectorise and a Vec3D can be viewed as three contiguous doubles.
+ *******************/
+
+class Vec3D {
+public:
+    constexpr Vec3D(double x = 0.0, double y = 0.0, double z = 0.0) : m_V{x, y, z} {}
+
+    inline double& operator()(const int n)                  {return m_V[n];}
+    constexpr double operator()(const int n)        const   {return m_V[n];}
+    constexpr double at(int n)                      const   {return m_V[n];}
+    inline void put(int n, double s)                        {m_V[n] = s;}
+    inline double* data()                                   {return m_V;}
+    constexpr const double* data()                  const   {return m_V;}
+
+    constexpr Vec3D operator+(const Vec3D& other) const {
+        return Vec3D(m_V[0] + other.m_V[0], m_V[1] + other.m_V[1], m_V[2] + other.m_V[2]);
+    }
+    constexpr Vec3D operator-(const Vec3D& other) const {
+        return Vec3D(m_V[0] - other.m_V[0], m_V[1] - other.m_V[1], m_V[2] - other.m_V[2]);
+    }
+    // cross product
+    constexpr Vec3D operator*(const Vec3D& other) const {
+        return Vec3D(m_V[1] * other.m_V[2] - m_V[2] * other.m_V[1],
+                     m_V[2] * other.m_V[0] - m_V[0] * other.m_V[2],
+                     m_V[0] * other.m_V[1] - m_V[1] * other.m_V[0]);
+    }
+    constexpr Vec3D operator*(double scalar) const {
+        return Vec3D(m_V[0] * scalar, m_V[1] * scalar, m_V[2] * scalar);
+    }
+    inline Vec3D& operator+=(const Vec3D& other) {
+        m_V[0] += other.m_V[0]; m_V[1] += other.m_V[1]; m_V[2] += other.m_V[2];
+        return *this;
+    }
+    inline Vec3D& operator-=(const Vec3D& other) {
+        m_V[0] -= other.m_V[0]; m_V[1] -= other.m_V[1]; m_V[2] -= other.m_V[2];
+        return *this;
+    }
+    inline Vec3D& operator*=(double scalar) {
+        m_V[0] *= scalar; m_V[1] *= scalar; m_V[2] *= scalar;
+        return *this;
+    }
+
+    constexpr double norm2() const {return m_V[0] * m_V[0] + m_V[1] * m_V[1] + m_V[2] * m_V[2];}
+    inline double norm() const {return std::sqrt(norm2());}
+    static constexpr double dot(const Vec3D& v1, const Vec3D& v2) {
+        return v1.m_V[0] * v2.m_V[0] + v1.m_V[1] * v2.m_V[1] + v1.m_V[2] * v2.m_V[2];
+    }
+    // Function to check if any element is non-finite
+    inline bool isbad() const {
+        return !std::isfinite(m_V[0]) || !std::isfinite(m_V[1]) || !std::isfinite(m_V[2]);
+    }
+    inline bool isgood() const {
+        return std::isfinite(m_V[0]) && std::isfinite(m_V[1]) && std::isfinite(m_V[2]);
+    }
+    inline void print() const {
+        std::cout << m_V[0] << "  " << m_V[1] << "  " << m_V[2] << "\n";
+    }
+    inline void normalize() {
+        double n = norm();
+        if (n == 0)
+            return;
+        m_V[0] = m_V[0] / n;
+        m_V[1] = m_V[1] / n;
+        m_V[2] = m_V[2] / n;
+    }
+    friend std::ostream& operator<<(std::ostream& os, const Vec3D& vec) {
+        os << vec.m_V[0] << " " << vec.m_V[1] << " " << vec.m_V[2];
+        return os;
+    }
+
+private:
+    double m_V[3];
+};
+
+#endif
@@ -2,6 +2,8 @@
 #include "Argument.h"
 #include "help.h"
 #include "Nfunction.h"
+#include "Parallel.h"
+#include "ToolExit.h"
 
 Argument::Argument(std::vector <std::string> argument)
          :  m_Argument(argument),
@@ -20,7 +22,16 @@ Argument::Argument(std::vector <std::string> argument)
             m_Renorm(true),
             m_SkipLipids(false),
             m_KEEP_POINTS_CLOSE_TO_PROTEINS(false),
-            m_PRINT_LESS_OUTPUT(false)
+            m_PRINT_LESS_OUTPUT(false),
+            m_DomainK(1.0),
+            m_DomainArea(false),
+            m_DomainLeaflet("both"),
+            m_RelaxSteps(0),
+            m_RelaxSigma(0.4),
+            m_BatchJobs(1),
+            m_BatchMemory(0),
+            m_Stream(false),
+            m_pSurface(NULL)
 {
 
 
@@ -28,6 +39,8 @@ Argument::Argument(std::vector <std::string> argument)
     m_ArgCon = 1;
     std::string Arg1;
     Nfunction f;
+    std::vector<std::string> plmoptions;   // passed on to PLM with -TSfile
+    bool plmonly = false;                   // an option that only PLM takes
 
         for (long i=1;i<m_Argument.size();i=i+2)
         {
@@ -39,7 +52,7 @@ Argument::Argument(std::vector <std::string> argument)
                 }
                 else{
                     std::cout<<"---> error: 332 \n";
-                    exit(0);
+                    ToolExit::Exit(0);
                 }
             }
             else if (Arg1==FunctionType) // (Arg1=="-function")
@@ -69,7 +82,7 @@ Argument::Argument(std::vector <std::string> argument)
                 }
                 else{
                     std::cout<<"---> error: 332 \n";
-                    exit(0);
+                    ToolExit::Exit(0);
                 }
             }
             else if(Arg1 == G_SKIP_LIPID_PLACEMENT)
@@ -92,10 +105,105 @@ Argument::Argument(std::vector <std::string> argument)
                 i=i-1;
 
             }
+            else if(Arg1 == G_THREADS)
+            {
+                Parallel::SetThreads(f.String_to_Int(m_Argument.at(i+1)));
+                plmoptions.push_back(Arg1);
+                plmoptions.push_back(m_Argument.at(i+1));
+            }
+            else if(Arg1 == G_TS_FILE)
+            {
+                m_TSFile = m_Argument.at(i+1);
+                if (f.FileExist (m_TSFile)!=true)
+                {
+                    std::cout<<"---> error: TS file, with name "<<m_TSFile<<" does not exist \n";
+                    m_Health = false;
+                }
+            }
+            else if(PLMOptionValues(Arg1)>=0)
+            {
+                int n = PLMOptionValues(Arg1);
+                if(m_Argument.size()<=size_t(i+n))
+                {
+                    std::cout<<"---> error: "<<Arg1<<" needs "<<n<<" values \n";
+                    ToolExit::Exit(0);
+                }
+                for (int k=0;k<=n;k++)
+                    plmoptions.push_back(m_Argument[i+k]);
+                plmonly = true;
+                i=i+n-1;
+            }
+            else if(Arg1 == G_DOMAIN_SPEC)
+            {
+                m_DomainSpecFile = m_Argument.at(i+1);
+                if (f.FileExist (m_DomainSpecFile)!=true)
+                {
+                    std::cout<<"---> error: domain spec file, with name "<<m_DomainSpecFile<<" does not exist \n";
+                    m_Health = false;
+                }
+            }
+            else if(Arg1 == G_DOMAIN_K)
+            {
+                m_DomainK = f.String_to_Double(m_Argument.at(i+1));
+            }
+            else if(Arg1 == G_DOMAIN_AREA)
+            {
+                m_DomainArea = true;
+                i=i-1;
+            }
+            else if(Arg1 == G_DOMAIN_LEAFLET)
+            {
+                m_DomainLeaflet = m_Argument.at(i+1);
+                if(m_DomainLeaflet!="both" && m_DomainLeaflet!="outer" && m_DomainLeaflet!="inner")
+                {
+                    std::cout<<"---> error: "<<G_DOMAIN_LEAFLET<<" should be both, outer or inner \n";
+                    m_Health = false;
+                }
+            }
+            else if(Arg1 == G_RELAX)
+            {
+                m_RelaxSteps = f.String_to_Int(m_Argument.at(i+1));
+            }
+            else if(Arg1 == G_RELAX_SIGMA)
+            {
+                m_RelaxSigma = f.String_to_Double(m_Argument.at(i+1));
+                if(m_RelaxSigma<=0)
+                {
+                    std::cout<<"---> error: "<<G_RELAX_SIGMA<<" should be positive \n";
+                    m_Health = false;
+                }
+            }
+            else if(Arg1 == G_BATCH)
+            {
+                m_BatchFile = m_Argument.at(i+1);
+                if (f.FileExist (m_BatchFile)!=true)
+                {
+                    std::cout<<"---> error: batch manifest, with name "<<m_BatchFile<<" does not exist \n";
+                    m_Health = false;
+                }
+            }
+            else if(Arg1 == G_BATCH_JOBS)
+            {
+                m_BatchJobs = f.String_to_Int(m_Argument.at(i+1));
+                if(m_BatchJobs<1)
+                {
+                    std::cout<<"---> error: "<<G_BATCH_JOBS<<" should be at least 1 \n";
+                    m_Health = false;
+                }
+            }
+            else if(Arg1 == G_BATCH_MEMORY)
+            {
+                m_BatchMemory = f.String_to_Double(m_Argument.at(i+1));
+            }
+            else if(Arg1 == G_STREAM)
+            {
+                m_Stream = true;
+                i=i-1;
+            }
             else if(Arg1 == G_HELPEx)
             {
                 help helpmessage(m_Argument.at(0));
-                exit(0);
+                ToolExit::Exit(0);
             }
             else if(Arg1 == G_renormalized_lipid_ratio)
             {
@@ -200,10 +308,28 @@ Argument::Argument(std::vector <std::string> argument)
             }
         }
         
+        //=== the PLM command line of -TSfile
+        if(m_TSFile!="")
+        {
+            m_PLMArgument.push_back("PLM");
+            m_PLMArgument.push_back("-TSfile");
+            m_PLMArgument.push_back(m_TSFile);
+            m_PLMArgument.insert(m_PLMArgument.end(), plmoptions.begin(), plmoptions.end());
+            if(m_Monolayer)     // only the upper layer is refined, as with PLM -monolayer 1
+            {
+                m_PLMArgument.push_back("-monolayer");
+                m_PLMArgument.push_back("1");
+            }
+        }
+        else if(plmonly)
+        {
+            std::cout<<"---> error: PLM options (e.g. -Mashno, -ap) can only be used with "<<G_TS_FILE<<" \n";
+            m_Health = false;
+        }
         /// checking if the defined files exists.
         if(m_Health == true)
         {
-            if (f.FileExist (m_StrFileName)!=true)
+            if (m_BatchFile=="" && f.FileExist (m_StrFileName)!=true)     // in batch mode every job has its own str file
             {
                 std::cout<<"---> error, str file, with name . "<<m_StrFileName<<" . does not exist \n";
                 m_Health = false;
@@ -231,17 +357,27 @@ Argument::Argument(std::vector <std::string> argument)
     if(!m_Health){
         std::cout << "---> error: there was some errors in the commandline \n";
         std::cout<<"\n"<<"*** For more information and tips execute ./PCG -h ***"<<"\n";
-        exit(0);
+        ToolExit::Exit(0);
     }
     if(!ValidateVariables()){
         std::cout << "---> error: bad input data. \n";
         std::cout<<"\n"<<"*** For more information and tips execute ./PCG -h ***"<<"\n";
-        exit(0);
+        ToolExit::Exit(0);
     }
  
 }
 Argument::~Argument() {
    
+}
+int Argument::PLMOptionValues(const std::string &option)
+{
+    if(option == G_PLM_THICKNESS || option == G_PLM_ALGTYPE || option == G_PLM_AP || option == G_PLM_MASHNO || option == G_PLM_BOXDIST)
+        return 1;
+    if(option == G_PLM_RESCALE)
+        return 3;
+    if(option == G_PLM_SMOOTH || option == G_PLM_RESIZEBOX)
+        return 0;
+    return -1;
 }
 bool Argument::ValidateVariables(){
     
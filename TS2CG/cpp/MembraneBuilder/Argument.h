@@ -2,6 +2,7 @@
 #define AFX_ARGUMENT_H_7F4A21B8_C13C_11D3_BF23_124095086234__INCLUDED_
 #include "Def.h"
 #include "Wall.h"
+struct RefinedSurfaceView;
 /**
  * @struct Shape_1DSin
  * @brief Structure representing the parameters for a 1D sine wave shape.
@@ -66,6 +67,21 @@ public:
     inline Shape_1DSin Get1DSinState() const { return m_1DSinState; }
     inline bool GetMonolayer() const { return m_Monolayer; }
     inline bool Skip_LipidPlacement() const { return m_SkipLipids; }
+    inline const std::string GetDomainSpecFile() const { return m_DomainSpecFile; }
+    inline double GetDomainK() const { return m_DomainK; }
+    inline bool GetDomainAreaWeighted() const { return m_DomainArea; }
+    inline const std::string GetDomainLeaflet() const { return m_DomainLeaflet; }
+    inline int GetRelaxSteps() const { return m_RelaxSteps; }
+    inline double GetRelaxSigma() const { return m_RelaxSigma; }
+    inline const std::string GetBatchFile() const { return m_BatchFile; }
+    inline int GetBatchJobs() const { return m_BatchJobs; }
+    inline double GetBatchMemory() const { return m_BatchMemory; }
+    inline bool GetStream() const { return m_Stream; }
+    inline const std::string GetTSFile() const { return m_TSFile; }
+    inline const std::vector<std::string> &GetPLMArguments() const { return m_PLMArgument; }
+    inline const RefinedSurfaceView *GetSurface() const { return m_pSurface; }
+    /// points held by the caller (python module _pcg) instead of the point folder; they must outlive the run
+    inline void SetSurface(const RefinedSurfaceView *surface) { m_pSurface = surface; }
 
     bool m_WPointDir; ///< Flag for wall point direction, public to allow direct modification
     bool m_KEEP_POINTS_CLOSE_TO_PROTEINS;
@@ -90,12 +106,26 @@ private:
     double m_Iter;                       ///< Number of iterations for the algorithm
     double m_RCutOff;                    ///< Cutoff distance for interactions
     bool m_SkipLipids;                    ///if true, do not place any lipid,
+    std::string m_DomainSpecFile;        ///< Lipid spec file for the curvature driven domain assignment (empty: off)
+    double m_DomainK;                    ///< Curvature preference strength of the domain assignment
+    bool m_DomainArea;                   ///< Weight the domain assignment with the point area
+    std::string m_DomainLeaflet;         ///< Leaflets to assign: both, outer or inner
+    int m_RelaxSteps;                    ///< Steepest descent steps of the soft-core pre-relaxation (0: off)
+    double m_RelaxSigma;                 ///< Distance below which beads of different molecules repel (nm)
+    std::string m_BatchFile;             ///< Manifest of batch jobs (empty: a single run)
+    int m_BatchJobs;                     ///< Number of batch jobs that run at the same time
+    double m_BatchMemory;                ///< Memory budget of the running batch jobs (MB, 0: no limit)
+    bool m_Stream;                       ///< Place the lipids of an analytical shape without keeping its points
+    std::string m_TSFile;                ///< TS file refined by PLM in this process (empty: read the point folder)
+    std::vector<std::string> m_PLMArgument; ///< PLM command line of the -TSfile run
+    const RefinedSurfaceView *m_pSurface; ///< points held by the caller (NULL: -TSfile or the point folder)
 
     Wall m_Wall;                         ///< Wall object storing wall-related data and settings
     Shape_1DSin m_1DSinState;            ///< Shape configuration for the 1D sine wave
     ///
     ///
     bool ValidateVariables();
+    static int PLMOptionValues(const std::string &option);  ///< values of a PLM option taken with -TSfile, -1 if it is not one
 };
 
 #endif // !defined(AFX_ARGUMENT_H_7F4A21B8_C13C_11D3_BF23_124095086234__INCLUDED_)
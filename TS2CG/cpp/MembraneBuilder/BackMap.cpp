@@ -3,12 +3,21 @@
 
 #include <stdio.h>
 #include <math.h>
+#include <memory>
 #include "BackMap.h"
 #include "GroFile.h"
+#include "GroIO.h"
+#include "RigidTransform.h"
 #include "GenerateUnitCells.h"
 #include "Def.h"
 #include "PDBFile.h"
 #include "PointBasedBlueprint.h"
+#include "PhaseReport.h"
+#include "DomainAssigner.h"
+#include "SoftRelax.h"
+#include "PointSource.h"
+#include "LipidStream.h"
+#include "ToolExit.h"
 /*
  1) read the point
  2) exclude the point base of exclsuion data
@@ -24,8 +33,10 @@
  
  
  */
-BackMap::BackMap(Argument *pArgu)
+BackMap::BackMap(Argument *pArgu, PointBasedBlueprint *pSharedPoints, Decomposition *pDecomposition)
 {
+    m_pDecomposition = pDecomposition;
+    m_FirstLipidResID = 1;
     m_monolayer = false;  // this is false
     m_Warning=0;
     srand (pArgu->GetSeed());
@@ -35,10 +46,24 @@ BackMap::BackMap(Argument *pArgu)
     std::cout<<"                         Version:  "<<SoftWareVersion<<"  \n";
     std::cout<<"███████████████████████████████████████████████████████████████  \n";
     Nfunction f;      // In this class there are some useful function and we can use it.
+    PhaseReport &report = PhaseReport::Get();    // timing, counters and memory per phase, written to <defout>_report.json
+    report.Start("PCG");
+    if(pArgu->GetStream())
+    {
+        StreamAnalyticalShape(pArgu);
+        return;
+    }
 
     //====== getting data points to create cg membrane
     std::cout<<"---> attempting to obtain point data \n";
-    PointBasedBlueprint SurfDataPoint(pArgu);
+    report.Begin("point read");
+    std::unique_ptr<PointBasedBlueprint> ownpoints;
+    if(pSharedPoints==NULL)
+    {
+        ownpoints.reset(new PointBasedBlueprint(pArgu));
+        pSharedPoints = ownpoints.get();
+    }
+    PointBasedBlueprint &SurfDataPoint = *pSharedPoints;
     std::vector<point*>  pPointUp = SurfDataPoint.m_pPointUp;
     std::vector<point*>  pPointDown = SurfDataPoint.m_pPointDown;
     std::vector<inclusion*>  pInc = SurfDataPoint.m_pInc;
@@ -54,32 +79,59 @@ BackMap::BackMap(Argument *pArgu)
         m_monolayer=true;
         std::cout<<"---> note: while we have points to build both monolayers, since monolayer is defined in PCG commond, we create only one layer \n";
     }
+    report.Count("upper points", pPointUp.size());
+    report.Count("lower points", pPointDown.size());
+    report.Count("inclusions", pInc.size());
+    report.Count("exclusions", pExc.size());
+    report.End();
     std::cout<<"---> point data has been obtained \n";
 
+    //====== curvature driven domain assignment (the same as DOP, done here natively)
+    std::vector<DomainLipidSpec> specs;         // also the lipids of the domains, see GenDomains
+    if(pArgu->GetDomainSpecFile()!="")
+    {
+        report.Begin("domain assignment");
+        if(!DomainAssigner::ReadSpecFile(pArgu->GetDomainSpecFile(), specs))
+            ToolExit::Exit(0);
+        DomainAssigner assigner(specs, pArgu->GetDomainK(), pArgu->GetDomainAreaWeighted(), pArgu->GetSeed());
+        std::string leaflet = pArgu->GetDomainLeaflet();
+        if(leaflet!="inner" || m_monolayer)
+        {
+            std::cout<<"---> assigning domains of the upper monolayer from the curvature \n";
+            assigner.Assign(pPointUp, false, 1);
+        }
+        if(leaflet!="outer" && !m_monolayer)
+        {
+            std::cout<<"---> assigning domains of the lower monolayer from the curvature \n";
+            assigner.Assign(pPointDown, true, 2);
+        }
+        report.Count("points", pPointUp.size()+pPointDown.size());
+        report.End();
+    }
+
     //======== OutPut file name declaration and finding input file names ========================================
     std::string gname = pArgu->GetGeneralOutputFilename();   // get the generic name for the outputs
     m_FinalOutputGroFileName =gname+".gro";                     // create the output gro file name based on the generic name
     m_FinalTopologyFileName=gname+".top";
     
     //======
-    std::cout<<"---> attempting to generate molecule type \n";
-    GenerateMolType  MOLTYPE(pArgu);   // using the str file, the included gro file in the str and the lib file, different mol types will be generated. proteins and lipids are treated as mols.
-    m_map_MolName2MoleculesType = MOLTYPE.GetMolType();   // a map containing all the mol types: (name, MolType)
-    std::cout<<"---> molecule types have been generated \n";
+    MakeMoleculeTypes(pArgu);
   
     //== we should exclude points and get rid of exclusion. This is done by making the area of the point zero.
     //== this could be made more efficient but is not needed as exclusion should not inlcude to many points
+    report.Begin("exclusion");
     ExcludePointsUsingExclusion(pExc, pPointUp, pPointDown);
+    report.End();
     
     //==== now we need to place the proteins
     // first we read str file to find protein info
     std::string strfilename = pArgu->GetStructureFileName();    // str file name
     if(FindProteinList(strfilename)==false) // this data will be stored in m_map_IncID2ProteinLists map(tsi_protein_id,ProteinList)
-        std::exit(0);
+        ToolExit::Exit(0);
     //== before going further, it would be better to check if the info about
     //proteins in str file also exist in the PLM output and also in the mol type
     if(CheckProteinInfo (m_map_IncID2ProteinLists, m_map_MolName2MoleculesType, pInc)==false) //
-        std::exit(0);
+        ToolExit::Exit(0);
     
 
     std::vector<inclusion> RandomInc;
@@ -115,8 +167,13 @@ BackMap::BackMap(Argument *pArgu)
         std::cout<<" Note: in the normal condition PLM always write global so only applicable if you want to change the point folder manually\n";
     }
     //== Placing the inclusions;
+    report.Begin("protein placement");
     if(PlaceProteins(pPointUp,pInc)==false) // this creates all the protein beads and put them in m_FinalBeads
-        std::exit(0);
+        ToolExit::Exit(0);
+    report.Count("beads", m_FinalBeads.size());
+    report.End();
+    int nproteinbeads = m_FinalBeads.size();
+    m_FirstLipidResID = m_ResID;
     std::cout<<"---> proteins are placed, now we remove points that are close to the proteins \n";
     
     //=== removing points closeby the proteins
@@ -128,18 +185,36 @@ BackMap::BackMap(Argument *pArgu)
         for ( std::vector<bead>::iterator it = m_FinalBeads.begin(); it != m_FinalBeads.end(); it++ )
             tempropbeads.push_back(&(*it));
         
+        report.Begin("point removal");
         bool RMpoint = RemovePointsCloseToBeadList(pPointUp, pPointDown, tempropbeads, RCutOff, pBox);
+        report.End();
         
         if(RMpoint==false){
-            std::exit(0);
+            ToolExit::Exit(0);
         }
     }
     
+    //=== with a decomposition, each rank places the lipids on its own points (the same steps up to here on all ranks)
+    if(m_pDecomposition!=NULL)
+    {
+        m_pDecomposition->SelectPoints(pPointUp, pPointDown, *pBox);
+        // the points of the other ranks are not needed any more, unless the wall still uses them
+        if(ownpoints && (pArgu->GetFunction()=="analytical_shape" || pWall->GetWallPoint().empty()))
+            ownpoints->KeepPoints(pPointUp, pPointDown);
+        if(!m_pDecomposition->IsMaster())        // the rank 0 goes on with the stream of a single run
+            srand(m_pDecomposition->GetSeed(pArgu->GetSeed()));
+        std::cout<<"---> rank "<<m_pDecomposition->GetRank()<<" of "<<m_pDecomposition->GetSize()<<" places lipids on "<<pPointUp.size()+pPointDown.size()<<" points \n";
+    }
     std::vector<Domain*> pAllDomain;
     bool Renormalizedlipidratio = pArgu->GetRenorm();
     m_Iter = pArgu->GetIter();  // how many iteration should be made to make sure enough lipid is placed.
-    GenDomains GENDOMAIN(strfilename,pPointUp,pPointDown,Renormalizedlipidratio);  // this somehow reads the lipids
+    report.Begin("domain generation");
+    GenDomains GENDOMAIN(strfilename,pPointUp,pPointDown,Renormalizedlipidratio,specs);  // this somehow reads the lipids
     pAllDomain = GENDOMAIN.GetDomains();
+    if(m_pDecomposition!=NULL)
+        m_pDecomposition->ReconcileQuotas(pAllDomain);
+    report.Count("domains", pAllDomain.size());
+    report.End();
 
 if(pArgu->Skip_LipidPlacement() == false){
     std::cout<<"---> generating domains using the input files \n";
@@ -159,12 +234,16 @@ if(pArgu->Skip_LipidPlacement() == false){
     
     std::cout<<"\n";
     std::cout<<"remaining time: ";
+    report.Begin("lipid placement");
+    int nbeads = m_FinalBeads.size();
     for ( std::vector<Domain*>::iterator it = pAllDomain.begin(); it != pAllDomain.end(); it++ ) // all the domains
     {
         if((*it)->GetDomainPoint().size()!=0)// this is only valid if
             GenLipidsForADomain(*it);
         std::cout<<"█";
     }
+    report.Count("beads", m_FinalBeads.size()-nbeads);
+    report.End();
     std::cout<<"\n";
 
     std::string sms = InfoDomain(pAllDomain);
@@ -173,10 +252,25 @@ if(pArgu->Skip_LipidPlacement() == false){
 else{
     std::cout<<"--> Note: We have skipped lipid placement as requested. \n";
 }
+    //=============== soft-core pre-relaxation of the placed molecules; proteins stay where they are
+    if(pArgu->GetRelaxSteps()>0 && int(m_FinalBeads.size())>nproteinbeads)
+    {
+        report.Begin("relaxation");
+        RelaxBeads(pArgu->GetRelaxSteps(), pArgu->GetRelaxSigma(), nproteinbeads);
+        report.End();
+    }
+    //=== every rank has the proteins; the rank 0 writes them
+    if(m_pDecomposition!=NULL && !m_pDecomposition->IsMaster())
+        m_FinalBeads.erase(m_FinalBeads.begin(), m_FinalBeads.begin()+nproteinbeads);
     //=============== write the wall info
     std::cout<<"---> attempting to make the wall beads \n";
+    report.Begin("wall");
     std::vector<bead> WB = pWall->GetWallBead();
-    if((pWall->GetWallPoint()).size()>0 && pWall->GetState()==true)
+    // the wall goes at the end of the gro file, so with a decomposition the last rank writes it
+    bool writewall = (m_pDecomposition==NULL || m_pDecomposition->GetRank()==m_pDecomposition->GetSize()-1);
+    if(!writewall)
+        WB.clear();
+    if((pWall->GetWallPoint()).size()>0 && pWall->GetState()==true && writewall)
     {
         PDBFile pdb;
         std::string pdbfile = "Wall.pdb";
@@ -190,20 +284,20 @@ else{
     {
         m_FinalBeads.push_back((*it));
     }
+    report.Count("beads", WB.size());
+    report.End();
     std::cout<<"---> attempting to write the final gro file \n";
-    WriteFinalGroFile(pBox);
-    std::cout<<"---> attempting to write the final topology file \n";
-    bool gentop = GenTopologyFile(pAllDomain,(WB.size()));
-    if(m_Warning==0)
-    {
-        std::cout<<" ██████████████████████████████████████████████████████████████  \n";
-        std::cout<<" █████████  Seems everything went well. Well done! ████████████  \n";
-        std::cout<<" ██████████████████████████████████████████████████████████████  \n";
-    }
+    report.Begin("write");
+    if(m_pDecomposition==NULL)
+        WriteFinalGroFile(pBox);
     else
-    {
-        std::cout<<" █████████  outputs have been generated, but there were "<< m_Warning<<" warnings in the process █████████████  \n";
-    }
+        WriteDistributedGroFile(pBox, WB.size());
+    std::cout<<"---> attempting to write the final topology file \n";
+    GenTopologyFile(pAllDomain,(pWall->GetWallBead()).size());
+    report.Count("beads", m_FinalBeads.size());
+    report.End();
+    if(m_pDecomposition==NULL || m_pDecomposition->IsMaster())
+        report.Write(gname+"_report.json");
     Welldone();
     
     
@@ -214,25 +308,16 @@ BackMap::~BackMap()
 {
     
 }
-void BackMap::GenLipid(MolType moltype, int listid, Vec3D Pos, Vec3D Normal, Vec3D Dir,Vec3D t1,Vec3D t2)
+void BackMap::GenLipid(const MolType &moltype, Vec3D Pos, Vec3D Normal, Vec3D t1, Vec3D t2)
 {
-     Tensor2 LG = TransferMatLG(Normal, t1, t2);
-      std::vector<bead> vbeads = moltype.Beads;
-            for ( std::vector<bead>::iterator it = vbeads.begin(); it != vbeads.end(); it++ )
-            {
-                Vec3D BPos((*it).GetXPos(),(*it).GetYPos(),(*it).GetZPos());
-                Vec3D vX = LG*BPos+ Pos;
-                int beadid = (m_FinalBeads.size()+1);
-                bead TemB(beadid, (*it).GetBeadName(), (*it).GetBeadType(), (*it).GetResName(), m_ResID, vX(0), vX(1),vX(2));
-                TemB.BringBeadInBox(m_pBox);
-                m_FinalBeads.push_back(TemB);
-            }
-    
-    m_ResID++;
-    
+    Tensor2 LG = TransferMatLG(Normal, t1, t2);
+    int n = moltype.X.size();
+    m_TemX.resize(n); m_TemY.resize(n); m_TemZ.resize(n);
+    RigidTransform::Apply(moltype.X.data(), moltype.Y.data(), moltype.Z.data(), n, LG, Pos, *m_pBox, m_TemX.data(), m_TemY.data(), m_TemZ.data());
+    AddMoleculeBeads(moltype);
     return;
 }
-void BackMap::GenProtein(MolType moltype, int listid, Vec3D Pos, Vec3D Normal, Vec3D Dir,Vec3D t1,Vec3D t2)
+void BackMap::GenProtein(const MolType &moltype, int listid, Vec3D Pos, Vec3D Normal, Vec3D Dir,Vec3D t1,Vec3D t2)
 {
         Tensor2 LG = TransferMatLG(Normal, t1, t2);
         Tensor2 GL = LG.Transpose(LG);
@@ -247,55 +332,104 @@ void BackMap::GenProtein(MolType moltype, int listid, Vec3D Pos, Vec3D Normal, V
         double S= LocalDir(1);
         Tensor2 Rot=Rz(C,S);
         Vec3D DH= Normal*((m_map_IncID2ProteinLists.at(listid)).Z0);
-        double phi = (m_map_IncID2ProteinLists.at(listid)).Phi;
-        double theta = (m_map_IncID2ProteinLists.at(listid)).Theta;
 
-        //
-        std::vector<bead> vbeads = moltype.Beads;
-        for ( std::vector<bead>::iterator it = vbeads.begin(); it != vbeads.end(); it++ )
+        //=== rotate the protein around its own axis first, then the same placement as lipids
+        int n = moltype.X.size();
+        std::vector<double> rx(n), ry(n), rz(n);
+        for (int i=0;i<n;i++)
         {
-            Vec3D BPos((*it).GetXPos(),(*it).GetYPos(),(*it).GetZPos());
-            Vec3D vX = LG*(Rot*BPos)+ Pos+DH;
-            int beadid = (m_FinalBeads.size()+1);
-            bead TemB(beadid, (*it).GetBeadName(), (*it).GetBeadType(), (*it).GetResName(), m_ResID, vX(0), vX(1),vX(2));
-            TemB.BringBeadInBox(m_pBox);
-            m_FinalBeads.push_back(TemB);
+            Vec3D RB = Rot*Vec3D(moltype.X[i],moltype.Y[i],moltype.Z[i]);
+            rx[i] = RB(0); ry[i] = RB(1); rz[i] = RB(2);
         }
-        m_ResID++;
+        m_TemX.resize(n); m_TemY.resize(n); m_TemZ.resize(n);
+        RigidTransform::Apply(rx.data(), ry.data(), rz.data(), n, LG, Pos, DH, *m_pBox, m_TemX.data(), m_TemY.data(), m_TemZ.data());
+        AddMoleculeBeads(moltype);
     return;
 }
+void BackMap::RelaxBeads(int steps, double sigma, int nfrozen)
+{
+    // beads of one molecule share the resid (AddMoleculeBeads)
+    int n = m_FinalBeads.size();
+    std::vector<Vec3D> pos(n);
+    std::vector<int> molecule(n);
+    std::vector<char> frozen(n,0);
+    for (int i=0;i<n;i++)
+    {
+        bead &b = m_FinalBeads[i];
+        pos[i] = Vec3D(b.GetXPos(),b.GetYPos(),b.GetZPos());
+        molecule[i] = b.GetResid();
+        frozen[i] = (i<nfrozen);
+    }
+    std::cout<<"---> relaxing the placed molecules with a soft-core repulsion, up to "<<steps<<" steps \n";
+    SoftRelax relax(sigma, 2.5*sigma, 100.0, 0.05);
+    SoftRelaxStats stats = relax.Run(pos, molecule, frozen, *m_pBox, steps);
+    for (int i=nfrozen;i<n;i++)
+        m_FinalBeads[i].UpdatePos(pos[i](0),pos[i](1),pos[i](2));
+    std::cout<<"---> bead pairs closer than "<<0.9*sigma<<" nm: "<<stats.ClashesBefore<<" before and "<<stats.ClashesAfter<<" after "<<stats.Steps<<" steps \n";
+    PhaseReport &report = PhaseReport::Get();
+    report.Count("beads", n);
+    report.Count("restraints", stats.Restraints);
+    report.Count("steps", stats.Steps);
+    report.Count("accepted steps", stats.Accepted);
+    report.Count("clashes before", stats.ClashesBefore);
+    report.Count("clashes after", stats.ClashesAfter);
+}
+void BackMap::AddMoleculeBeads(const MolType &moltype)
+{
+    // the transformed coordinates are in m_TemX/Y/Z
+    int i=0;
+    for ( std::vector<bead>::const_iterator it = moltype.Beads.begin(); it != moltype.Beads.end(); it++, i++ )
+    {
+        int beadid = (m_FinalBeads.size()+1);
+        m_FinalBeads.push_back(bead(beadid, (*it).GetBeadName(), (*it).GetBeadType(), (*it).GetResName(), m_ResID, m_TemX[i], m_TemY[i], m_TemZ[i]));
+    }
+    m_ResID++;
+}
 void BackMap::WriteFinalGroFile(Vec3D *pBox)
 {
-    FILE *fgro;
-    fgro = fopen(m_FinalOutputGroFileName.c_str(), "w");
+    GroWriter gro;
+    if(!gro.Open(m_FinalOutputGroFileName," System ",m_FinalBeads.size()))
+    {
+        std::cout<<"---> error: could not open "<<m_FinalOutputGroFileName<<" for writing \n";
+        return;
+    }
     /// resid  res name   noatom   x   y   z
-    const char* Title=" System ";
-    int Size=m_FinalBeads.size();
-    
-    fprintf(fgro,  "%s\n",Title);
-    fprintf(fgro, "%5d\n",Size);
     int i=0;
     for (std::vector<bead>::iterator it = m_FinalBeads.begin() ; it != m_FinalBeads.end(); ++it)
     {
         i++;
-        double x=(*it).GetXPos();
-        double y=(*it).GetYPos();
-        double z=(*it).GetZPos();
-        std::string rname  = (*it).GetResName();
-        std::string bname = (*it).GetBeadName();
-        
-        const char* A1=rname.c_str();
-        const char* A2=bname.c_str();
-        int resid=(*it).GetResid();
-        fprintf(fgro, "%5d%5s%5s%5d%8.3f%8.3f%8.3f\n",resid%100000,A1,A2,i%100000,x,y,z );
-        
+        gro.Write((*it).GetResid()%100000,(*it).GetResName(),(*it).GetBeadName(),i%100000,(*it).GetXPos(),(*it).GetYPos(),(*it).GetZPos());
     }
-
-    fprintf(fgro,  "%10.5f%10.5f%10.5f\n",(*pBox)(0),(*pBox)(1),(*pBox)(2) );
-    fclose(fgro);
+    gro.Close(*pBox);
     
     return;
 }
+void BackMap::WriteDistributedGroFile(Vec3D *pBox, int nwall)
+{
+    //=== atom ids and the resids of the lipids continue from the ranks before this one
+    long natoms = m_pDecomposition->Sum(m_FinalBeads.size());
+    long atomoffset = m_pDecomposition->Offset(m_FinalBeads.size());
+    long residoffset = m_pDecomposition->Offset(m_ResID-m_FirstLipidResID);
+    int nlipidend = m_FinalBeads.size()-nwall;
+    std::string head, body, tail;
+    std::ostringstream h;
+    h<<" System \n"<<std::setw(5)<<natoms<<"\n";
+    head = h.str();
+    body.reserve(46*m_FinalBeads.size());
+    for (int i=0;i<int(m_FinalBeads.size());i++)
+    {
+        bead &b = m_FinalBeads[i];
+        long resid = b.GetResid();
+        if(i<nlipidend && resid>=m_FirstLipidResID)
+            resid += residoffset;
+        GroWriter::FormatAtom(body, resid%100000, b.GetResName(), b.GetBeadName(), (atomoffset+i+1)%100000, b.GetXPos(), b.GetYPos(), b.GetZPos());
+    }
+    char line[64];
+    snprintf(line, sizeof(line), "%10.5f%10.5f%10.5f\n", (*pBox)(0), (*pBox)(1), (*pBox)(2));
+    tail = line;
+    if(!m_pDecomposition->WriteOrdered(m_FinalOutputGroFileName, head, body, tail))
+        std::cout<<"---> error: could not write "<<m_FinalOutputGroFileName<<"\n";
+}
 Tensor2 BackMap::Rz(double cos, double sin)
 {
     Tensor2  R('O');
@@ -338,7 +472,7 @@ std::vector<inclusion> BackMap::CreateRandomInclusion(std::vector<point*> &pPoin
                 std::cout<<"                      -) "<<(*it).first<<"\n";
             }
             std::cout<<"    ---------------------------------------------------------- \n";
-            exit(0);
+            ToolExit::Exit(0);
         }
 //=========================================================
         double membrane_total_area = 0 ;
@@ -449,7 +583,7 @@ bool BackMap::FindProteinList(std::string filename)
     if(strfile.good()==false)
     {
         std::cout<<"---> error (3R22-D): while opening the str file with  name: "<<filename<<"  ; check if the file exist "<<"\n";
-        exit(0);
+        ToolExit::Exit(0);
     }
     //== Read the file until reaching the protein section
     bool proteinflag=false;
@@ -498,7 +632,7 @@ bool BackMap::FindProteinList(std::string filename)
             {
             std::cout<<"---> error (3R22-E): protein information in the str file is incomplete "<<"\n";
             std::cout<<"---> other possible causs of this error. 1) the protein section in str file does not end with word End "<<"\n";
-            exit(0);
+            ToolExit::Exit(0);
             }
         }
       }//while (true)
@@ -547,7 +681,7 @@ void BackMap::ExcludePointsUsingExclusion(std::vector<exclusion*> &pExc, std::ve
             int pointid=(*it)->GetPointID();
             if(pointid<0 || pointid>m_pPointUp.size()){
                 std::cout<<"---> error: id = PCG23456: please report to the developer with the error id name \n";
-                exit(-1);
+                ToolExit::Exit(-1);
             }
             
             point *Up_p1=m_pPointUp.at(pointid);
@@ -671,6 +805,7 @@ bool BackMap::RemovePointsCloseToBeadList(std::vector<point*> &pPointUp, std::ve
     GenerateUnitCells GCNT(vpbeads, pBox,RCutOff,1.0);
     GCNT.Generate();
     // Here, we try to remove the points that are covered by the proteins. We do it by setting the A=0
+    long removed = 0;
   
     for ( std::vector<point*>::iterator it = pPointUp.begin(); it != pPointUp.end(); it++ )
     {
@@ -682,7 +817,10 @@ bool BackMap::RemovePointsCloseToBeadList(std::vector<point*> &pPointUp, std::ve
         if(rem==false)
             rem = GCNT.anythingaround(Pos2);
         if(rem==true)
+        {
             (*it)->UpdateArea(0);
+            removed++;
+        }
 
     }
     if(m_monolayer == false)
@@ -696,8 +834,12 @@ bool BackMap::RemovePointsCloseToBeadList(std::vector<point*> &pPointUp, std::ve
         if(rem==false)
             rem = GCNT.anythingaround(Pos2);
         if(rem==true)
+        {
             (*it)->UpdateArea(0);
+            removed++;
+        }
     }
+    PhaseReport::Get().Count("points removed", removed);
     
     return true;
 }
@@ -737,7 +879,6 @@ for (std::vector<DomainLipid*>::iterator it = pdomainlipids.begin(); it != pdoma
             NoMadeLipid++;
             (*it)->no_created=(*it)->no_created+1;
             {//================================ Create a single lipid at the point position ======================================
-                Vec3D  Dir(0,0,0);
                 Vec3D N =    Ran_point->GetNormal();
                 Vec3D T1 =   Ran_point->GetP1();
                 Vec3D T2 =   Ran_point->GetP2();
@@ -746,9 +887,9 @@ for (std::vector<DomainLipid*>::iterator it = pdomainlipids.begin(); it != pdoma
                 if (m_map_MolName2MoleculesType.count(ltype) == 0)
                 {
                     std::cout << " \n---> error: molecule name " <<ltype<<" does not exist in the lib files \n";
-                    exit(0);
+                    ToolExit::Exit(0);
                 }
-                GenLipid(m_map_MolName2MoleculesType.at(ltype), 0, Pos, N, Dir, T1, T2);
+                GenLipid(m_map_MolName2MoleculesType.at(ltype), Pos, N, T1, T2);
                 Ran_point->UpdateArea(0);
             }//============================================================================================================
         }
@@ -759,6 +900,10 @@ for (std::vector<DomainLipid*>::iterator it = pdomainlipids.begin(); it != pdoma
         }
     } //while(true)
 }
+    PhaseReport::Get().Count("points", dpoint.size());
+    PhaseReport::Get().Count("lipids", NoMadeTotalLipid);
+    PhaseReport::Get().Count("iterations", iteration);
+    PhaseReport::Get().Count("rejections", iteration-NoMadeTotalLipid);
     
 return true;
 }
@@ -767,6 +912,22 @@ bool BackMap::GenTopologyFile(std::vector<Domain*> pdomains, int WBead_no)
 {
     //==========================================================================================================
     //==========================================================================================================
+    //=== with a decomposition the lipids of each rank are one block of the gro file; the rank 0 lists them all
+    std::vector<long> created;
+    for ( std::vector<Domain*>::iterator it = pdomains.begin(); it != pdomains.end(); it++ )
+    {
+        std::vector<DomainLipid> DL = (*it)->GetDomainLipids();
+        for ( std::vector<DomainLipid>::iterator it2 = DL.begin(); it2 != DL.end(); it2++ )
+            created.push_back((*it2).no_created);
+    }
+    int nblock = 1;
+    if(m_pDecomposition!=NULL)
+    {
+        created = m_pDecomposition->Gather(created);
+        if(!m_pDecomposition->IsMaster())
+            return true;
+        nblock = m_pDecomposition->GetSize();
+    }
     std::ofstream Topgro;
     Topgro.open(m_FinalTopologyFileName.c_str());
     Topgro<<" ;This file was generated by TS2CG membrane builder script i.e., PCG \n";
@@ -777,30 +938,36 @@ bool BackMap::GenTopologyFile(std::vector<Domain*> pdomains, int WBead_no)
     for ( std::map<int,ProteinList>::iterator it = m_map_IncID2ProteinLists.begin(); it != m_map_IncID2ProteinLists.end(); it++ )
         Topgro<<(it->second).ProteinName<<"   "<<(it->second).created<<"\n";
 
-    int layer = 0;
-    
-    
-    for ( std::vector<Domain*>::iterator it = pdomains.begin(); it != pdomains.end(); it++ )
+    int k = 0;
+    for (int block=0;block<nblock;block++)
     {
-        layer++;
-        std::vector<DomainLipid> DL = (*it)->GetDomainLipids();
-        
-        if(layer%2!=0 || m_monolayer == false)
+        if(nblock>1)
+            Topgro <<"; rank "<<block<<" \n";
+        int layer = 0;
+        for ( std::vector<Domain*>::iterator it = pdomains.begin(); it != pdomains.end(); it++ )
         {
-            Topgro <<"; domain "<<(*it)->GetDomainID() <<" \n";
-            if(layer%2!=0 && m_monolayer == false)
-            Topgro  <<" ;  in the upper monolayer \n";
-            else if(layer%2==0 && m_monolayer == false)
-            Topgro <<" ;  in the lower monolayer \n";
-            for ( std::vector<DomainLipid>::iterator it2 = DL.begin(); it2 != DL.end(); it2++ )
+            layer++;
+            std::vector<DomainLipid> DL = (*it)->GetDomainLipids();
+        
+            if(layer%2!=0 || m_monolayer == false)
             {
-                if((*it2).no_created == 0)
-                    Topgro <<"   ;  ";
-                Topgro <<"     "<<(*it2).Name<<"  "<<(*it2).no_created<<"     "<<std::endl ;
-                
+                Topgro <<"; domain "<<(*it)->GetDomainID() <<" \n";
+                if(layer%2!=0 && m_monolayer == false)
+                Topgro  <<" ;  in the upper monolayer \n";
+                else if(layer%2==0 && m_monolayer == false)
+                Topgro <<" ;  in the lower monolayer \n";
+                for ( std::vector<DomainLipid>::iterator it2 = DL.begin(); it2 != DL.end(); it2++ )
+                {
+                    if(created[k] == 0)
+                        Topgro <<"   ;  ";
+                    Topgro <<"     "<<(*it2).Name<<"  "<<created[k]<<"     "<<std::endl ;
+                    k++;
+                }
             }
-        }
+            else
+                k += DL.size();
 
+        }
     }
     if(WBead_no!=0)
     Topgro<<"Wall    "<<WBead_no<<"\n";
@@ -810,8 +977,109 @@ bool BackMap::GenTopologyFile(std::vector<Domain*> pdomains, int WBead_no)
 }
 void BackMap::Welldone()
 {
+    if(m_Warning==0)
+    {
+        std::cout<<" ██████████████████████████████████████████████████████████████  \n";
+        std::cout<<" █████████  Seems everything went well. Well done! ████████████  \n";
+        std::cout<<" ██████████████████████████████████████████████████████████████  \n";
+    }
+    else
+    {
+        std::cout<<" █████████  outputs have been generated, but there were "<< m_Warning<<" warnings in the process █████████████  \n";
+    }
 //std::cout << "\n ████████████████ Well Done ██████████████████\n";
 }
+void BackMap::MakeMoleculeTypes(Argument *pArgu)
+{
+    PhaseReport &report = PhaseReport::Get();
+    std::cout<<"---> attempting to generate molecule type \n";
+    report.Begin("molecule types");
+    GenerateMolType  MOLTYPE(pArgu);   // using the str file, the included gro file in the str and the lib file, different mol types will be generated. proteins and lipids are treated as mols.
+    m_map_MolName2MoleculesType = MOLTYPE.GetMolType();   // a map containing all the mol types: (name, MolType)
+    for ( std::map<std::string , MolType>::iterator it = m_map_MolName2MoleculesType.begin(); it != m_map_MolName2MoleculesType.end(); it++ )
+    {
+        MolType &mol = it->second;
+        mol.X.clear(); mol.Y.clear(); mol.Z.clear();
+        for ( std::vector<bead>::iterator itb = mol.Beads.begin(); itb != mol.Beads.end(); itb++ )
+        {
+            mol.X.push_back((*itb).GetXPos());
+            mol.Y.push_back((*itb).GetYPos());
+            mol.Z.push_back((*itb).GetZPos());
+        }
+    }
+    report.Count("molecule types", m_map_MolName2MoleculesType.size());
+    report.End();
+    std::cout<<"---> molecule types have been generated \n";
+}
+void BackMap::StreamAnalyticalShape(Argument *pArgu)
+{
+    PhaseReport &report = PhaseReport::Get();
+    std::string gname = pArgu->GetGeneralOutputFilename();
+    m_FinalOutputGroFileName =gname+".gro";
+    m_FinalTopologyFileName=gname+".top";
+    std::string strfilename = pArgu->GetStructureFileName();
+    if(pArgu->GetFunction()!="analytical_shape" || pArgu->GetWall().GetState() || pArgu->m_WPointDir || pArgu->GetDomainSpecFile()!="" || pArgu->GetRelaxSteps()>0 || m_pDecomposition!=NULL)
+    {
+        std::cout<<"---> error: "<<G_STREAM<<" only works with -function analytical_shape, without a wall, "<<G_DOMAIN_SPEC<<", "<<G_RELAX<<" or MPI \n";
+        ToolExit::Exit(0);
+    }
+
+    //====== the shape; its points are made later, tile by tile
+    std::cout<<"---> attempting to obtain point data \n";
+    report.Begin("point read");
+    std::unique_ptr<PointSource> source(PointSource::New(pArgu));
+    if(source==NULL)
+        ToolExit::Exit(0);
+    Vec3D Box = source->GetBox();
+    m_pBox = &Box;
+    m_monolayer = pArgu->GetMonolayer();
+    long npoint[2] = {source->GetSize(0), m_monolayer ? 0 : source->GetSize(1)};
+    double area[2] = {source->GetArea(0), m_monolayer ? 0 : source->GetArea(1)};
+    report.Count("upper points", npoint[0]);
+    report.Count("lower points", npoint[1]);
+    report.End();
+    std::cout<<"---> the shape has "<<npoint[0]<<" upper and "<<npoint[1]<<" lower points; they will be made while the lipids are placed \n";
+
+    MakeMoleculeTypes(pArgu);
+    if(FindProteinList(strfilename)==false)
+        ToolExit::Exit(0);
+    if(!m_map_IncID2ProteinLists.empty())
+    {
+        std::cout<<"---> error: proteins can not be placed with "<<G_STREAM<<" \n";
+        ToolExit::Exit(0);
+    }
+
+    report.Begin("domain generation");
+    GenDomains GENDOMAIN(strfilename, area, npoint, pArgu->GetRenorm());
+    std::vector<Domain*> pAllDomain = GENDOMAIN.GetDomains();
+    report.Count("domains", pAllDomain.size());
+    report.End();
+
+    LipidStream stream(source.get(), &m_map_MolName2MoleculesType, pArgu->GetSeed(), m_FinalOutputGroFileName);
+    if(pArgu->Skip_LipidPlacement() == false)
+    {
+        std::cout<<"---> now,  the lipids are placed tile by tile \n";
+        report.Begin("lipid placement");
+        for (size_t i=0;i<pAllDomain.size();i++)      // the upper and the lower domain of each Domain line
+            stream.PlaceLayer(i%2, pAllDomain[i]);
+        report.Count("beads", stream.GetBeads());
+        report.End();
+        m_Warning += stream.GetWarning();
+        std::cout<<InfoDomain(pAllDomain);
+    }
+    else
+        std::cout<<"--> Note: We have skipped lipid placement as requested. \n";
+
+    std::cout<<"---> attempting to write the final gro file \n";
+    report.Begin("write");
+    stream.WriteGro(m_FinalOutputGroFileName, Box);
+    std::cout<<"---> attempting to write the final topology file \n";
+    GenTopologyFile(pAllDomain, 0);
+    report.Count("beads", stream.GetBeads());
+    report.End();
+    report.Write(gname+"_report.json");
+    Welldone();
+}
 
 std::string BackMap::InfoDomain(std::vector<Domain*> pAllDomain)
 {
@@ -23,6 +23,8 @@
 #include "ReadDTSFolder.h"
 #include "Data_Structure.h"
 #include "GenDomains.h"
+#include "PointBasedBlueprint.h"
+#include "Decomposition.h"
 
 
 
@@ -30,8 +32,11 @@ class BackMap
 {
 public:
     
-	BackMap(Argument *pArgu);
+	// pSharedPoints: points already read (batch jobs); pDecomposition: the build is split between ranks (PCG_MPI)
+	BackMap(Argument *pArgu, PointBasedBlueprint *pSharedPoints = NULL, Decomposition *pDecomposition = NULL);
 	virtual ~BackMap();
+
+    inline const std::vector<bead> &GetBeads()     const {return m_FinalBeads;}    // the beads of the gro file, in its order
  
 private:
     // final data
@@ -50,6 +55,8 @@ private:
     double m_Iter;
     std::string m_InclusionDirectionType;
     Vec3D *m_pBox;
+    Decomposition *m_pDecomposition;        // NULL: a single process builds everything
+    int m_FirstLipidResID;                  // resid of the first molecule after the proteins
 
 
 private:  // function members 
@@ -60,10 +67,14 @@ private:  // function members
     bool RemovePointsCloseToBeadList(std::vector<point*> &PointUp, std::vector<point*> &PointDown, std::vector<bead*> vpbeads, double RCutOff, Vec3D* m_pBox);
     bool GenLipidsForADomain(Domain *pdomain); // generates all the lipid for a specific domain
     bool GenTopologyFile(std::vector<Domain*>, int wbeadno); // generates topology file
+    void RelaxBeads(int steps, double sigma, int nfrozen); // soft-core pre-relaxation of m_FinalBeads, the first nfrozen beads do not move
+    void MakeMoleculeTypes(Argument *pArgu);   // fills m_map_MolName2MoleculesType
+    void StreamAnalyticalShape(Argument *pArgu);   // -stream: the lipids are placed while the points of the shape are made, tile by tile
 
     
     //======== old functions
     void WriteFinalGroFile(Vec3D *pBox);
+    void WriteDistributedGroFile(Vec3D *pBox, int nwall);   // all ranks of m_pDecomposition write one file; the last nwall beads are the wall
     bool AnyBeadWithinCutoff(UnitCell *,Vec3D Pos);
     Tensor2 Rz(double cos, double sin);
     Tensor2 TransferMatLG(Vec3D N, Vec3D t1, Vec3D t2);
@@ -72,8 +83,10 @@ private:  // function members
 
    // void CreateWallBead(std::vector<point*>  p1, std::vector<point*>  p2);
     bool FindProteinList(std::string str);
-    void GenProtein(MolType moltype, int , Vec3D Pos, Vec3D Normal, Vec3D Dir,Vec3D t1,Vec3D t2);
-    void GenLipid(MolType moltype, int , Vec3D Pos, Vec3D Normal, Vec3D Dir,Vec3D t1,Vec3D t2);
+    void GenProtein(const MolType &moltype, int , Vec3D Pos, Vec3D Normal, Vec3D Dir,Vec3D t1,Vec3D t2);
+    void GenLipid(const MolType &moltype, Vec3D Pos, Vec3D Normal, Vec3D t1, Vec3D t2);
+    void AddMoleculeBeads(const MolType &moltype);   // appends one molecule with the coordinates in m_TemX/Y/Z
+    std::vector<double> m_TemX, m_TemY, m_TemZ;        // scratch for the placement kernel
     void Welldone();
     std::string InfoDomain(std::vector<Domain*> pAllDomain);
 
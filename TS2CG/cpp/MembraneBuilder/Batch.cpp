@@ -0,0 +1,208 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+#include "Batch.h"
+#include "BackMap.h"
+#include "ReadLipidLibrary.h"
+#include "Nfunction.h"
+#include "PhaseReport.h"
+#include "ToolExit.h"
+#include "JSONString.h"
+
+// PCG stops on an error with exit(0) (or a ToolExit inside the python module); inside a job that is a failure
+static void JobAborted()
+{
+    std::cout.flush();
+    fflush(stdout);
+    _exit(1);
+}
+Batch::Batch(Argument *pArgu)
+{
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point t0 = Clock::now();
+    std::vector<std::string> argument = pArgu->GetArgumentString();
+    for (size_t i=0;i<argument.size();i++)
+    {
+        if(argument[i]==G_BATCH || argument[i]==G_BATCH_JOBS || argument[i]==G_BATCH_MEMORY)
+            i++;
+        else
+            m_BaseArgument.push_back(argument[i]);
+    }
+    if(!ReadManifest(pArgu->GetBatchFile()))
+        ToolExit::Exit(0);
+    std::cout<<"---> batch of "<<m_Jobs.size()<<" jobs from "<<pArgu->GetBatchFile()<<", "<<pArgu->GetBatchJobs()<<" at the same time \n";
+
+    //=== shared inputs: the points (with the exclusions applied) and the lipid library
+    std::unique_ptr<PointBasedBlueprint> shared;
+    if(pArgu->GetFunction()=="backmap" && !pArgu->GetWall().GetState() && !pArgu->m_WPointDir)
+    {
+        if(pArgu->GetTSFile()!="")
+        std::cout<<"---> refining "<<pArgu->GetTSFile()<<" once for all jobs \n";
+        else
+        std::cout<<"---> reading the point folder "<<pArgu->GetDTSFolder()<<" once for all jobs \n";
+        shared.reset(new PointBasedBlueprint(pArgu));
+    }
+    if(pArgu->GetLipidLibrary()!="no")
+    {
+        ReadLipidLibrary library(pArgu);          // stays in the library cache of this process
+        if(!library.GetHealth())
+        {
+            std::cout<<"---> error: faild in reading the library "<<pArgu->GetLipidLibrary()<<"\n";
+            ToolExit::Exit(0);
+        }
+    }
+    std::cout<<"---> shared inputs are loaded in "<<std::chrono::duration<double>(Clock::now()-t0).count()<<" s \n";
+
+    //=== run the jobs in forked processes
+    long budget = long(pArgu->GetBatchMemory()*1024);      // kB
+    long peak = 0;                                          // largest peak memory of a finished job, kB
+    long seed = PhaseReport::CurrentRSS();                  // every job starts as a copy of this process
+    std::map<pid_t, std::pair<int, Clock::time_point> > running;
+    size_t next = 0;
+    int failed = 0;
+    while(next<m_Jobs.size() || !running.empty())
+    {
+        bool start = (next<m_Jobs.size() && int(running.size())<pArgu->GetBatchJobs());
+        if(start && budget>0 && !running.empty())
+        {
+            // the largest job so far: finished, or running (its peak up to now), and at least the start
+            long estimate = std::max(peak, seed);
+            for (std::map<pid_t, std::pair<int, Clock::time_point> >::iterator it = running.begin(); it != running.end(); ++it)
+                estimate = std::max(estimate, PhaseReport::PeakRSSOf(it->first));
+            start = (long(running.size()+1)*estimate<=budget);
+        }
+        if(start)
+        {
+            std::cout.flush();
+            fflush(stdout);
+            pid_t pid = fork();
+            if(pid==0)
+                RunJob(m_Jobs[next], shared.get(), pArgu);
+            if(pid<0)
+            {
+                std::cout<<"---> error: could not start the job "<<m_Jobs[next].Defout<<"\n";
+                m_Jobs[next].Status = 1;
+                failed++;
+            }
+            else
+                running[pid] = std::make_pair(int(next), Clock::now());
+            next++;
+            continue;
+        }
+        int status = 0;
+        struct rusage usage;
+        pid_t pid = wait4(-1, &status, 0, &usage);
+        if(pid<0)
+            break;
+        std::map<pid_t, std::pair<int, Clock::time_point> >::iterator it = running.find(pid);
+        if(it==running.end())
+            continue;
+        BatchJob &job = m_Jobs[(it->second).first];
+        job.Seconds = std::chrono::duration<double>(Clock::now()-(it->second).second).count();
+        job.PeakRSS = usage.ru_maxrss;
+        job.Status = (WIFEXITED(status) && WEXITSTATUS(status)==0) ? 0 : 1;
+        peak = std::max(peak, job.PeakRSS);
+        running.erase(it);
+        if(job.Status!=0)
+            failed++;
+        std::cout<<"---> job "<<job.Defout<<((job.Status==0) ? " done" : " failed, see "+job.Defout+"_pcg.txt")
+                 <<" ("<<job.Seconds<<" s, "<<job.PeakRSS/1024<<" MB) \n";
+    }
+    double seconds = std::chrono::duration<double>(Clock::now()-t0).count();
+    WriteSummary(pArgu->GetGeneralOutputFilename()+"_batch.json", seconds);
+    std::cout<<"---> batch finished in "<<seconds<<" s: "<<m_Jobs.size()-failed<<" jobs done, "<<failed<<" failed \n";
+}
+Batch::~Batch()
+{
+
+}
+bool Batch::ReadManifest(const std::string &filename)
+{
+    Nfunction f;
+    std::ifstream file(filename.c_str());
+    std::string str;
+    while (std::getline(file,str))
+    {
+        str = f.trim(str);
+        if(str.size()==0 || str.at(0)==';')
+            continue;
+        std::vector<std::string> Line = f.split(str);
+        if(Line.size()<3)
+        {
+            std::cout<<"---> error: a batch job needs a str file, a seed and an output name: "<<str<<"\n";
+            return false;
+        }
+        BatchJob job;
+        job.Str = Line[0];
+        job.Seed = f.String_to_Int(Line[1]);
+        job.Defout = Line[2];
+        for (size_t i=3;i<Line.size() && Line[i].at(0)!=';';i++)
+            job.Options.push_back(Line[i]);
+        job.Status = -1;
+        job.Seconds = 0;
+        job.PeakRSS = 0;
+        m_Jobs.push_back(job);
+    }
+    if(m_Jobs.empty())
+    {
+        std::cout<<"---> error: the batch manifest "<<filename<<" has no jobs \n";
+        return false;
+    }
+    return true;
+}
+std::vector<std::string> Batch::JobArguments(const BatchJob &job) const
+{
+    std::vector<std::string> argument = m_BaseArgument;
+    argument.push_back(G_STR_FILE_TAG);   argument.push_back(job.Str);
+    argument.push_back(GET_SEED);         argument.push_back(std::to_string(job.Seed));
+    argument.push_back(G_DEFAULT_TAG);    argument.push_back(job.Defout);
+    argument.insert(argument.end(), job.Options.begin(), job.Options.end());
+    return argument;
+}
+void Batch::RunJob(const BatchJob &job, PointBasedBlueprint *pSharedPoints, const Argument *pArgu)
+{
+    if(freopen((job.Defout+"_pcg.txt").c_str(), "w", stdout)==NULL)
+        _exit(1);
+    atexit(JobAborted);
+    try {
+        Argument arg(JobArguments(job));
+        // the shared points only fit jobs that would read the same points
+        if(arg.GetDTSFolder()!=pArgu->GetDTSFolder() || arg.GetPLMArguments()!=pArgu->GetPLMArguments() || arg.GetFunction()!=pArgu->GetFunction() || arg.GetWall().GetState() || arg.m_WPointDir)
+            pSharedPoints = NULL;
+        BackMap B(&arg, pSharedPoints);
+    }
+    catch (const ToolExit &e) {
+        JobAborted();
+    }
+    std::cout.flush();
+    fflush(stdout);
+    _exit(0);
+}
+void Batch::WriteSummary(const std::string &filename, double seconds) const
+{
+    FILE *f = fopen(filename.c_str(), "w");
+    if(f==NULL)
+    {
+        std::cout<<"---> warning: could not write the batch summary "<<filename<<"\n";
+        return;
+    }
+    fprintf(f, "{\n  \"tool\": \"PCG batch\",\n  \"total_seconds\": %.6f,\n  \"jobs\": [", seconds);
+    for (size_t i=0;i<m_Jobs.size();i++)
+    {
+        const BatchJob &job = m_Jobs[i];
+        fprintf(f, "%s\n    {\"defout\": ", (i==0) ? "" : ",");
+        WriteJSONString(f, job.Defout);
+        fprintf(f, ", \"str\": ");
+        WriteJSONString(f, job.Str);
+        fprintf(f, ", \"seed\": %d, \"status\": \"%s\", \"seconds\": %.6f, \"peak_rss_kb\": %ld}",
+                job.Seed, (job.Status==0) ? "done" : ((job.Status>0) ? "failed" : "not run"), job.Seconds, job.PeakRSS);
+    }
+    fprintf(f, "\n  ]\n}\n");
+    fclose(f);
+}
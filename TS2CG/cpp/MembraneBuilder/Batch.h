@@ -0,0 +1,53 @@
+#if !defined(AFX_Batch_H_8A2C21B8_C13C_5648_BF23_124095086236__INCLUDED_)
+#define AFX_Batch_H_8A2C21B8_C13C_5648_BF23_124095086236__INCLUDED_
+
+#include "Def.h"
+#include "Argument.h"
+#include "PointBasedBlueprint.h"
+/*
+ Weria Pezeshkian (weria.pezeshkian@gmail.com)
+ Copyright (c) Weria Pezeshkian
+ Batch mode of PCG (-batch manifest): many builds from one point folder and lipid library.
+
+ Every line of the manifest is a job: "str_file seed defout [more PCG options]", ';' starts a comment.
+ A job runs with the command line of the batch, minus the -batch options, plus its own options.
+
+ The point folder (with the exclusions applied) and the lipid library are read once, then every job
+ runs in a forked process: it gets a copy-on-write view of the loaded points, its own random number
+ stream (srand(seed) as in a single run) and an error in one job (exit) does not stop the others.
+ A job gives the same output as the single PCG run with the same options. Jobs that use another point
+ folder, a wall (drawn with the job seed) or an analytical shape read their points themselves.
+
+ -batchjobs jobs run at the same time. With -batchmem, a job only starts if the peak memory of the
+ largest job so far, times the number of running jobs plus one, fits in the budget. Before a job has
+ finished, the largest job is the largest peak the running jobs have reached up to now (from procfs),
+ but never less than the memory of the batch process after loading the shared inputs. The output of job <defout> goes to <defout>_pcg.txt and a
+ summary of all jobs to <batch defout>_batch.json.
+*/
+struct BatchJob
+{
+    std::string Str;
+    int Seed;
+    std::string Defout;
+    std::vector<std::string> Options;
+    int Status;                 // 0: done, 1: failed, -1: not run
+    double Seconds;
+    long PeakRSS;               // kB
+};
+class Batch
+{
+public:
+    Batch(Argument *pArgu);
+    ~Batch();
+
+private:
+    bool ReadManifest(const std::string &filename);
+    std::vector<std::string> JobArguments(const BatchJob &job) const;
+    void RunJob(const BatchJob &job, PointBasedBlueprint *pSharedPoints, const Argument *pArgu);
+    void WriteSummary(const std::string &filename, double seconds) const;
+
+    std::vector<std::string> m_BaseArgument;       // the command line without the batch options
+    std::vector<BatchJob> m_Jobs;
+};
+
+#endif
@@ -33,21 +33,21 @@ Cylinder::Cylinder(Argument *pArgu)
 
     //*********
 
-    m_Point1 = CalculateArea_MakePoints(1, 1/m_Density,m_Thickness/2,m_DL,false);
-    m_Point2 = CalculateArea_MakePoints(-1, 1/m_Density,m_Thickness/2,m_DL,false);
+    m_Layer[0] = PlanLayer(1, 1/m_Density,m_Thickness/2,m_DL);
+    m_Layer[1] = PlanLayer(-1, 1/m_Density,m_Thickness/2,m_DL);
 
     
-    m_WallPoint1 = CalculateArea_MakePoints(1, 1/m_WallDensityup,m_Thickness/2,Hwall,true);
-    m_WallPoint2 = CalculateArea_MakePoints(-1, 1/m_WallDensityin,m_Thickness/2, Hwall,true);
+    m_Layer[2] = PlanLayer(1, 1/m_WallDensityup,m_Thickness/2,Hwall);
+    m_Layer[3] = PlanLayer(-1, 1/m_WallDensityin,m_Thickness/2, Hwall);
 
 }
 Cylinder::~Cylinder()
 {
     
 }
-std::vector<point> Cylinder::CalculateArea_MakePoints(int layer, double APL,double H, double DL, bool wall)
+Cylinder::Layer Cylinder::PlanLayer(int layer, double APL,double H, double DL)
 {
-    std::vector<point> Cpoints;
+    Layer L;
     double pi = acos(-1);
     double TotalArea = 0;
     std::vector <double> Curv;
@@ -70,9 +70,7 @@ std::vector<point> Cylinder::CalculateArea_MakePoints(int layer, double APL,doub
 
     int Npoints = TotalArea/APL;
     APL =  TotalArea/double(Npoints);
-    int beadid = 0;
     double DT = sqrt(APL);
-    double T=0;
     double R=m_R+double(layer)*H;
     double DTz = DT;
     int M=m_Box(2)/DT;
@@ -80,44 +78,49 @@ std::vector<point> Cylinder::CalculateArea_MakePoints(int layer, double APL,doub
     DT = double(2*PI*R)/double(N);
     DTz = double(m_Box(2))/double(M);
 
-    for (int j=0;j<M;j++)
-    {
-    for (int i=0;i<N;i++)
+    L.Side = layer;
+    L.R = R;
+    L.DT = DT;
+    L.DTz = DTz;
+    L.DL = DL;
+    L.M = std::max(M,0);
+    L.N = std::max(N,0);
+    L.Curv = Curv;
+    L.Area = (L.M*L.N>0) ? TotalArea/double(L.M*L.N) : 0;
+    return L;
+
+}
+int Cylinder::GetTiles(int layer) const
+{
+    return m_Layer[layer].M;
+}
+long Cylinder::GetTileStart(int layer, int tile) const
+{
+    return long(tile)*m_Layer[layer].N;
+}
+void Cylinder::MakeTile(int layer, int j, point *points) const
+{
+    const Layer &L = m_Layer[layer];
+    Vec3D BoxC(m_Box(0)/2, m_Box(1)/2, 0 );
+    Vec3D P2(0,0,1);
+    for (int i=0;i<L.N;i++)
     {
-            double T = DT*double(i)/R;
+        double T = L.DT*double(i)/L.R;
 
-            double x=R*cos(T);
-            double y=R*sin(T);
-            double z=(double(j)+0.5*(i%2))*DTz;
-            
-            Vec3D Pos(x,y,z);
-            Vec3D N = Pos;
-            N(2) = 0;
-            N.normalize();
-            N = N*double(layer);
-            Vec3D BoxC(m_Box(0)/2, m_Box(1)/2, 0 );
-            Pos = BoxC + Pos + N*(DL);
-            
-            Vec3D P2(0,0,1);
-            Vec3D P1 = N*P2;
-         //   std::cout<<P1(0)<<"  "<<P1(1)<<"  "<<P1(2)<<"   "<<P1.norm()<<"  \n";
-          //  std::cout<<N(0)<<"  "<<N(1)<<"  "<<N(2)<<"   "<<N.dot(P2,N)<<"  \n";
-
-            point p(beadid, APL, Pos, N, P1, P2 , Curv);
-            Cpoints.push_back(p);
-            beadid++;
-            
+        double x=L.R*cos(T);
+        double y=L.R*sin(T);
+        double z=(double(j)+0.5*(i%2))*L.DTz;
 
-        }
-        
-    }
-   // std::cout<<Npoints<<"  "<<Cpoints.size()<<"\n";
-    for (std::vector<point >::iterator it = Cpoints.begin() ; it != Cpoints.end(); ++it)
-    {
-            it->UpdateArea(TotalArea/double(Cpoints.size()));
-    }
-    return Cpoints;
+        Vec3D Pos(x,y,z);
+        Vec3D N = Pos;
+        N(2) = 0;
+        N.normalize();
+        N = N*double(L.Side);
+        Pos = BoxC + Pos + N*(L.DL);
+        Vec3D P1 = N*P2;
 
+        points[i] = point(j*L.N+i, L.Area, Pos, N, P1, P2 , L.Curv);
+    }
 }
 void Cylinder::Initialize(std::string filename)
 {
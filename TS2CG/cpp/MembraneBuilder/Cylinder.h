@@ -20,26 +20,40 @@
 #include "inclusion.h"
 #include "GenerateMolType.h"
 #include "Tensor2.h"
+#include "PointSource.h"
 
 
-class Cylinder
+class Cylinder : public PointSource
 {
 public:
     
 	Cylinder(Argument *pArgu);
 	virtual ~Cylinder();
     
-    inline  std::vector<point> GetWallPoint1()                const  {return m_WallPoint1;} // returns all the created wall beads
-    inline  std::vector<point> GetWallPoint2()                const  {return m_WallPoint2;} // returns all the created wall beads
+    inline  std::vector<point> GetWallPoint1()                const  {return MakeLayer(2);} // returns all the created wall beads
+    inline  std::vector<point> GetWallPoint2()                const  {return MakeLayer(3);} // returns all the created wall beads
 
-    inline  std::vector<point> GetUpPoint()                const  {return m_Point1;}    // upper monolayer beads
-    inline  std::vector<point> GetInPoint()                const  {return m_Point2;}    // inner monolayer beads
+    inline  std::vector<point> GetUpPoint()                const  {return MakeLayer(0);}    // upper monolayer beads
+    inline  std::vector<point> GetInPoint()                const  {return MakeLayer(1);}    // inner monolayer beads
 
     inline  Vec3D GetBox()                const  {return m_Box;}    // returns the box sides
 
+    int  GetTiles(int layer)                    const;
+    long GetTileStart(int layer, int tile)      const;
+    inline double GetArea(int layer)            const  {return m_Layer[layer].Area*double(GetSize(layer));}
+    void MakeTile(int layer, int tile, point *points) const;
+
 
 public:
 
+    struct Layer                    // M rings of N points along z
+    {
+        int Side;                   // 1 outer, -1 inner
+        double R, DT, DTz, DL, Area;
+        int M, N;
+        std::vector<double> Curv;
+    };
+
 private:
     Vec3D *m_pBox;
     Vec3D  m_Box;   // system box size
@@ -55,14 +69,11 @@ private:
 private:
     void Initialize(std::string filename); /// Read the data from the str file.
 
-    std::vector<point> CalculateArea_MakePoints(int i, double APL,double H,double DL, bool); // a function to create the area and the beads
+    Layer PlanLayer(int i, double APL,double H,double DL);  // the area of the layer and where its points go; the points are made by MakeTile
 
 
     bool m_monolayer;
-    std::vector<point>  m_Point1;
-    std::vector<point>  m_Point2;
-    std::vector<point>  m_WallPoint1;
-    std::vector<point>  m_WallPoint2;
+    Layer m_Layer[4];                        // upper, lower, upper wall and lower wall
     Vec3D F(double t,int layer, double H);
     Vec3D Normal(double t);
 
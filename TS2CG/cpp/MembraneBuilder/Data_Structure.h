@@ -18,6 +18,7 @@ struct MolType {
     std::string MolName;
     int beadnumber;
     double molarea;
+    std::vector<double> X, Y, Z;    // bead coordinates of Beads as SoA, for the batched placement kernel
 } ;
 struct DomainLipid {
     std::string Name;           // name of the lipid
@@ -25,6 +26,7 @@ struct DomainLipid {
     double Ratio;               // how many/ratio in the domain
     int no_created;          // how many has been created
     int MaxNo;                  // how many of this type we should create
+    double Quota;               // MaxNo before rounding down
     
 } ;
 struct ProteinList {
@@ -0,0 +1,44 @@
+#if !defined(AFX_Decomposition_H_6B3D21B8_C13C_5648_BF23_124095086237__INCLUDED_)
+#define AFX_Decomposition_H_6B3D21B8_C13C_5648_BF23_124095086237__INCLUDED_
+
+#include <string>
+#include <vector>
+#include "Vec3D.h"
+#include "point.h"
+#include "Domain.h"
+/*
+ Weria Pezeshkian (weria.pezeshkian@gmail.com)
+ Copyright (c) Weria Pezeshkian
+ Split of one PCG build between processes (ranks), used by BackMap when it is given one (PCG_MPI).
+
+ Every rank runs the same steps up to the domain generation, so they all have the same points,
+ proteins and wall. Then each rank keeps only its own points and places the lipids on them. Lipids
+ only use the point they sit on, so ranks do not need the points of the others (no halo). The quotas
+ of the domains are agreed between the ranks, so the total numbers match a single run. The rank 0
+ writes the proteins and the topology, and the last rank the wall, as it ends the gro file; the gro
+ file is written by all ranks in rank order.
+*/
+class Decomposition
+{
+public:
+    virtual ~Decomposition() {}
+
+    virtual int GetRank()                               const = 0;
+    virtual int GetSize()                               const = 0;
+    inline bool IsMaster()                              const {return GetRank()==0;}
+    // keeps the points of this rank
+    virtual void SelectPoints(std::vector<point*> &up, std::vector<point*> &down, const Vec3D &box) = 0;
+    // sets MaxNo of every domain lipid to the share of this rank of the total number
+    virtual void ReconcileQuotas(std::vector<Domain*> &domains) = 0;
+    // random seed of this rank
+    virtual int GetSeed(int seed)                       const = 0;
+    // sum of n over the ranks before this one, and over all ranks
+    virtual long Offset(long n)                         const = 0;
+    virtual long Sum(long n)                            const = 0;
+    // values of all ranks, rank after rank (only on the rank 0)
+    virtual std::vector<long> Gather(const std::vector<long> &values) const = 0;
+    // head (rank 0), body of every rank in rank order and tail (last rank) into one file
+    virtual bool WriteOrdered(const std::string &file, const std::string &head, const std::string &body, const std::string &tail) const = 0;
+};
+
+#endif
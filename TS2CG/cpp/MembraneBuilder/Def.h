@@ -40,6 +40,27 @@
 #define G_renormalized_lipid_ratio          "-renorm"
 #define G_KEEP_POINTS_CLOSE_TO_PROTEINS          "-keep"
 #define G_PRINT_LESS_OUTPUTS                    "-less"
+#define G_THREADS                       "-nt"
+#define G_DOMAIN_SPEC                   "-domainspec"       // curvature driven domain assignment (same spec file as DOP)
+#define G_DOMAIN_K                      "-domaink"
+#define G_DOMAIN_AREA                   "-domainarea"
+#define G_DOMAIN_LEAFLET                "-domainleaflet"
+#define G_RELAX                         "-relax"            // soft-core pre-relaxation steps after placement (0: off)
+#define G_RELAX_SIGMA                   "-relaxsigma"
+#define G_BATCH                         "-batch"            // manifest of jobs run from one set of loaded inputs
+#define G_BATCH_JOBS                    "-batchjobs"
+#define G_BATCH_MEMORY                  "-batchmem"
+#define G_STREAM                        "-stream"           // analytical shapes: place the lipids while the points are made, tile by tile
+#define G_TS_FILE                       "-TSfile"           // run PLM on this TS file in this process instead of reading -dts
+// PLM options taken with -TSfile and passed on to PLM
+#define G_PLM_THICKNESS                 "-bilayerThickness"
+#define G_PLM_ALGTYPE                   "-AlgType"
+#define G_PLM_RESCALE                   "-rescalefactor"
+#define G_PLM_AP                        "-ap"
+#define G_PLM_MASHNO                    "-Mashno"
+#define G_PLM_SMOOTH                    "-smooth"
+#define G_PLM_RESIZEBOX                 "-resizebox"
+#define G_PLM_BOXDIST                   "-b_dist"
 
 
 
@@ -6,6 +6,7 @@
 #include "Domain.h"
 #include "GenerateUnitCells.h"
 #include "Def.h"
+#include "ToolExit.h"
 
 /*
  
@@ -34,6 +35,16 @@ void Domain::AddADomainLipid(std::string name, double Ap, double Ratio)
     m_AllDomainLipids.push_back(DL);
 }
 void Domain::Configure(bool renorm)
+{
+    //== obtaining the total area of the domain points
+    double Tarea = 0; // total area of the domain point;
+    for ( std::vector<point*>::iterator it = m_point.begin(); it != m_point.end(); it++ )
+    {
+        Tarea+= (*it)->GetArea();
+    }
+    Configure(renorm, Tarea, m_point.size());
+}
+void Domain::Configure(bool renorm, double Tarea, long npoint)
 {
   //== this function 1) obtain the total ratio and possibly make it 1. 2) obtains max lipids of each one in this domain
 
@@ -63,13 +74,6 @@ void Domain::Configure(bool renorm)
                   << " (not 1). Make sure this is intentional, "
                   << "or use the -renorm option.\n";
     }
-    //== obtaining the total area of the domain points
-    
-    double Tarea = 0; // total area of the domain point;
-    for ( std::vector<point*>::iterator it = m_point.begin(); it != m_point.end(); it++ )
-    {
-        Tarea+= (*it)->GetArea();
-    }
     Tarea = Tarea*totalratio;
     double avAP = 0;
     // update the max no lipid of each lipid type in the domain
@@ -83,9 +87,10 @@ void Domain::Configure(bool renorm)
     for ( std::vector<DomainLipid>::iterator it = m_AllDomainLipids.begin(); it != m_AllDomainLipids.end(); it++ )
     {
         if(avAP!=0)
-        (*it).MaxNo= int(((*it).Ratio)*Tarea/avAP);
+        (*it).Quota = ((*it).Ratio)*Tarea/avAP;
         else
-        (*it).MaxNo=0;
+        (*it).Quota = 0;
+        (*it).MaxNo= int((*it).Quota);
         (*it).no_created = 0;
     }
     
@@ -95,10 +100,10 @@ void Domain::Configure(bool renorm)
        // std::cout<<"max domain lipid "<<m_DomainTotalLipid<<"  "<<(*it).MaxNo<<"\n";
     }
     
-    if(m_DomainTotalLipid>m_point.size())
+    if(m_DomainTotalLipid>npoint)
     {
-        std::cout<<" Error: Not enough point for the domain to place lipid: "<<m_DomainTotalLipid<<"  lipid should be created  "<<m_point.size()<<" points is available \n";
-        std::exit(0);
+        std::cout<<" Error: Not enough point for the domain to place lipid: "<<m_DomainTotalLipid<<"  lipid should be created  "<<npoint<<" points is available \n";
+        ToolExit::Exit(0);
     }
     for ( std::vector<DomainLipid>::iterator it = m_AllDomainLipids.begin(); it != m_AllDomainLipids.end(); it++ )
     {
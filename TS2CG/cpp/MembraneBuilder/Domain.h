@@ -64,6 +64,7 @@ public:
 public:
     void AddADomainLipid(std::string name, double Ap, double Ratio);
     void Configure(bool);
+    void Configure(bool renorm, double area, long npoint);   // the same for points that are not in memory (PCG -stream)
     
 private:
     int m_DomainTypeID;
@@ -0,0 +1,225 @@
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include "DomainAssigner.h"
+#include "Nfunction.h"
+#include "Parallel.h"
+
+#define DOMAIN_BLOCK 16384          // points per block of the parallel assignment
+
+DomainAssigner::DomainAssigner(const std::vector<DomainLipidSpec> &specs, double k, bool areaweighted, int seed)
+            : m_Specs(specs),
+              m_K(k),
+              m_AreaWeighted(areaweighted),
+              m_Seed(seed)
+{
+}
+DomainAssigner::~DomainAssigner()
+{
+}
+bool DomainAssigner::ReadSpecFile(const std::string &file, std::vector<DomainLipidSpec> &specs)
+{
+    std::ifstream in(file.c_str());
+    if(!in.is_open())
+    {
+        std::cout<<"---> error: domain spec file "<<file<<" does not exist \n";
+        return false;
+    }
+    specs.clear();
+    double total = 0;
+    std::string str;
+    while (std::getline(in, str))
+    {
+        std::vector<std::string> L = Nfunction::split(str);
+        if(L.size()==0 || L[0].at(0)==';')
+            continue;
+        if(L.size()<5)
+        {
+            std::cout<<"---> error: line <"<<str<<"> of "<<file<<" should be: domain_id name percentage curvature density \n";
+            return false;
+        }
+        DomainLipidSpec s;
+        s.DomainID = Nfunction::String_to_Int(L[0]);
+        s.Name = L[1];
+        s.Percentage = Nfunction::String_to_Double(L[2]);
+        s.Curvature = Nfunction::String_to_Double(L[3]);
+        s.Density = Nfunction::String_to_Double(L[4]);
+        if(s.Percentage<0 || s.Density<=0)
+        {
+            std::cout<<"---> error: line <"<<str<<"> of "<<file<<" should have a percentage of at least 0 and a density larger than 0 \n";
+            return false;
+        }
+        total += s.Percentage;
+        specs.push_back(s);
+    }
+    if(specs.size()==0 || fabs(total-1.0)>0.01)
+    {
+        std::cout<<"---> error: the percentages in "<<file<<" must sum to 1.0 (got "<<total<<") \n";
+        return false;
+    }
+    return true;
+}
+// one draw among the domains with quota left; -1 if there is none
+int DomainAssigner::Choose(double H, double area, const std::vector<long> &left, double u) const
+{
+    int n = m_Specs.size();
+    double w[64];
+    std::vector<double> wv;
+    double *pw = w;
+    if(n>64)
+    {
+        wv.resize(n);
+        pw = &wv[0];
+    }
+    double maxlog = -1e300;
+    int nvalid = 0;
+    for (int i=0;i<n;i++)
+    {
+        if(left[i]<=0)
+            continue;
+        double d = 2*H-m_Specs[i].Curvature;
+        pw[i] = -m_K*d*d*area;
+        maxlog = std::max(maxlog, pw[i]);
+        nvalid++;
+    }
+    if(nvalid==0)
+        return -1;
+    double sum = 0;
+    for (int i=0;i<n;i++)
+    {
+        if(left[i]<=0)
+            continue;
+        pw[i] = exp(pw[i]-maxlog);
+        sum += pw[i];
+    }
+    double x = u*sum;
+    int last = -1;
+    for (int i=0;i<n;i++)
+    {
+        if(left[i]<=0)
+            continue;
+        last = i;
+        x -= pw[i];
+        if(x<0)
+            return i;
+    }
+    return last;
+}
+static inline double Uniform(std::mt19937 &rng)
+{
+    return (double(rng())+0.5)/4294967296.0;
+}
+void DomainAssigner::Assign(const double *H, const double *area, long N, std::vector<int> &domain, unsigned stream) const
+{
+    const int nl = m_Specs.size();
+    domain.assign(N, -1);
+    if(N==0 || nl==0)
+        return;
+
+    //--- target of each domain, as in DOP
+    std::vector<long> target(nl);
+    long sum = 0;
+    for (int i=0;i<nl;i++)
+    {
+        target[i] = long(m_Specs[i].Percentage*N);
+        sum += target[i];
+    }
+    target[nl-1] += N-sum;
+
+    //--- random visiting order
+    std::seed_seq sq{(unsigned)m_Seed, stream, 0u};
+    std::mt19937 rng(sq);
+    std::vector<long> order(N);
+    for (long i=0;i<N;i++)
+        order[i] = i;
+    for (long i=N-1;i>0;i--)
+    {
+        long j = long((unsigned long long)(rng())*(unsigned long long)(i+1) >> 32);
+        std::swap(order[i], order[j]);
+    }
+
+    //--- quotas per block: cumulative floors, so the quotas of each domain add up to its target
+    const int nb = (N+DOMAIN_BLOCK-1)/DOMAIN_BLOCK;
+    std::vector<long> quota(long(nb)*nl);
+    for (int i=0;i<nl;i++)
+    {
+        long prev = 0;
+        for (int b=0;b<nb;b++)
+        {
+            long end = std::min(N, long(b+1)*DOMAIN_BLOCK);
+            long c = long(double(target[i])*double(end)/double(N));
+            if(b==nb-1)
+                c = target[i];
+            quota[long(b)*nl+i] = c-prev;
+            prev = c;
+        }
+    }
+
+    //--- blocks in parallel; a point that finds no quota left in its block stays -1 for now
+    Parallel::For(nb, [&](int b) {
+        std::seed_seq bsq{(unsigned)m_Seed, stream, (unsigned)(b+1)};
+        std::mt19937 brng(bsq);
+        std::vector<long> left(quota.begin()+long(b)*nl, quota.begin()+long(b+1)*nl);
+        long end = std::min(N, long(b+1)*DOMAIN_BLOCK);
+        for (long s=long(b)*DOMAIN_BLOCK;s<end;s++)
+        {
+            long p = order[s];
+            int c = Choose(H[p], m_AreaWeighted ? area[p] : 1.0, left, Uniform(brng));
+            if(c<0)
+                continue;
+            domain[p] = m_Specs[c].DomainID;
+            left[c]--;
+        }
+        std::copy(left.begin(), left.end(), quota.begin()+long(b)*nl);
+    });
+
+    //--- reconcile: what the blocks left over goes to the points that found no quota
+    std::vector<long> left(nl, 0);
+    for (int b=0;b<nb;b++)
+        for (int i=0;i<nl;i++)
+            left[i] += quota[long(b)*nl+i];
+    for (long s=0;s<N;s++)
+    {
+        long p = order[s];
+        if(domain[p]!=-1)
+            continue;
+        int c = Choose(H[p], m_AreaWeighted ? area[p] : 1.0, left, Uniform(rng));
+        if(c<0)
+            c = nl-1;
+        domain[p] = m_Specs[c].DomainID;
+        left[c]--;
+    }
+}
+void DomainAssigner::Assign(std::vector<point*> &points, bool inner, unsigned stream) const
+{
+    std::vector<double> H(points.size()), A(points.size());
+    for (size_t i=0;i<points.size();i++)
+    {
+        std::vector<double> C = points[i]->GetCurvature();
+        H[i] = (C.at(0)+C.at(1))/2;
+        if(inner)
+            H[i] = -H[i];
+        A[i] = points[i]->GetArea();
+    }
+    std::vector<int> domain;
+    Assign(H, A, domain, stream);
+    for (size_t i=0;i<points.size();i++)
+        points[i]->UpdateDomainID(domain[i]);
+    std::cout<<Info(domain);
+}
+std::string DomainAssigner::Info(const std::vector<int> &domain) const
+{
+    std::ostringstream sms;
+    for (size_t i=0;i<m_Specs.size();i++)
+    {
+        long n = std::count(domain.begin(), domain.end(), m_Specs[i].DomainID);
+        sms<<"        "<<m_Specs[i].Name<<" (domain "<<m_Specs[i].DomainID<<"): "<<std::fixed<<std::setprecision(1)
+           <<100.0*n/std::max<size_t>(domain.size(), 1)<<"% (target: "<<100.0*m_Specs[i].Percentage<<"%) \n";
+    }
+    return sms.str();
+}
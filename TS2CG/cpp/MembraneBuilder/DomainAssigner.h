@@ -0,0 +1,57 @@
+#if !defined(AFX_DomainAssigner_H_5A8C21B8_C13C_5648_BF23_124095086899__INCLUDED_)
+#define AFX_DomainAssigner_H_5A8C21B8_C13C_5648_BF23_124095086899__INCLUDED_
+
+#include <string>
+#include <vector>
+#include "point.h"
+/*
+ Weria Pezeshkian (weria.pezeshkian@gmail.com)
+ Copyright (c) Weria Pezeshkian
+ Curvature driven domain assignment; the native version of tools/domain_placer.py (DOP).
+ Reads the same lipid spec file (domain_id name percentage curvature density per line) and gives
+ each point one of the domains with Boltzmann weight
+
+        w_i ~ exp(-k (2H - c_i)^2 A)       (A = 1 unless area weighting is on)
+
+ among the domains that still have quota left, so that every domain ends with int(percentage*N)
+ points (the last one takes the rest), exactly as DOP does. The density is the area per lipid; as DOP
+ writes it into the str file, each domain gets the lipids of its spec lines (see GenDomains).
+ Points are visited in a random order that is cut into blocks; blocks run in parallel, each with its
+ own random stream and its own share of the quotas. Points of a block that run out of quota are
+ assigned afterwards from what the other blocks left over, so the totals are still exact. For a
+ given seed the result does not depend on the number of threads.
+*/
+struct DomainLipidSpec {
+    int DomainID;
+    std::string Name;
+    double Percentage;
+    double Curvature;
+    double Density;
+};
+
+class DomainAssigner
+{
+public:
+    DomainAssigner(const std::vector<DomainLipidSpec> &specs, double k, bool areaweighted, int seed);
+    ~DomainAssigner();
+
+    static bool ReadSpecFile(const std::string &file, std::vector<DomainLipidSpec> &specs);
+
+    // H: mean curvature per point (already sign flipped for an inner leaflet), area: per point.
+    // stream separates the random numbers of different leaflets
+    void Assign(const double *H, const double *area, long N, std::vector<int> &domain, unsigned stream) const;
+    inline void Assign(const std::vector<double> &H, const std::vector<double> &area, std::vector<int> &domain, unsigned stream) const {Assign(H.data(), area.data(), H.size(), domain, stream);}
+    // updates point::m_DomainID from the curvature stored in the points
+    void Assign(std::vector<point*> &points, bool inner, unsigned stream) const;
+    std::string Info(const std::vector<int> &domain) const;
+
+private:
+    std::vector<DomainLipidSpec> m_Specs;
+    double m_K;
+    bool m_AreaWeighted;
+    int m_Seed;
+
+    int Choose(double H, double area, const std::vector<long> &left, double u) const;
+};
+
+#endif
@@ -32,26 +32,21 @@ FlatPointMaker::FlatPointMaker(Argument *pArgu)
 
     //*********
 
-    m_Point1 = CalculateArea_MakePoints(1, 1/m_Density,m_Thickness/2,false);
-    m_Point2 = CalculateArea_MakePoints(-1, 1/m_Density,m_Thickness/2,false);
+    m_Layer[0] = PlanLayer(1, 1/m_Density,m_Thickness/2,false);
+    m_Layer[1] = PlanLayer(-1, 1/m_Density,m_Thickness/2,false);
 
     
-    m_WallPoint1 = CalculateArea_MakePoints(1, 1/m_WallDensity,m_Thickness/2+Hwall,true);
-    m_WallPoint2 = CalculateArea_MakePoints(-1, 1/m_WallDensity,m_Thickness/2+Hwall,true);
+    m_Layer[2] = PlanLayer(1, 1/m_WallDensity,m_Thickness/2+Hwall,true);
+    m_Layer[3] = PlanLayer(-1, 1/m_WallDensity,m_Thickness/2+Hwall,true);
 
 }
 FlatPointMaker::~FlatPointMaker()
 {
     
 }
-std::vector<point> FlatPointMaker::CalculateArea_MakePoints(int layer, double APL,double H, bool wall)
+FlatPointMaker::Layer FlatPointMaker::PlanLayer(int layer, double APL,double H, bool wall)
 {
-    std::vector<point> Cpoints;
-    std::vector <double> c;  // we set curvature to zero as it is not important for this function
-    c.push_back(0);
-    c.push_back(0);
-    std::vector<Vec3D> Pos,NormalV,T1vec,T2vec;
-    std::vector<Vec3D> V1, V2,V3,V4;
+    Layer L;
     double xmin = 0;
     double ymin = 0;
     double xmax = (*m_pBox)(0);
@@ -67,59 +62,55 @@ std::vector<point> FlatPointMaker::CalculateArea_MakePoints(int layer, double AP
         
     }
     double area = (*m_pBox)(0)*(*m_pBox)(1);
-    double Lenght = (*m_pBox)(0);
     double DL = sqrt(APL);
-    double Nx = int((*m_pBox)(0)/DL)+1;
-    double Ny = int((*m_pBox)(1)/DL)+1;
-    double dx = (*m_pBox)(0)/double(Nx);
-    double dy = (*m_pBox)(1)/double(Ny);
-
+    int Nx = int((*m_pBox)(0)/DL)+1;
+    int Ny = int((*m_pBox)(1)/DL)+1;
+    L.Side = layer;
+    L.Z = ((*m_pBox)(2)/2)+layer*H;
+    L.Dx = (*m_pBox)(0)/double(Nx);
+    L.Dy = (*m_pBox)(1)/double(Ny);
+
+    //=== the grid lines inside the range are one run of rows and one of columns, so only their ends are kept
+    L.I0 = L.I1 = L.J0 = L.J1 = 0;
     for (int i=0;i<Nx;i++)
-    {
-        double x = dx*double(i);
-        for (int j=0;j<Ny;j++)
+        if(L.Dx*double(i)>=xmin && L.Dx*double(i)<=xmax)
         {
-            double y = dy*double(j);
-
-            Vec3D X (x,y,((*m_pBox)(2)/2)+layer*H);
-            V1.push_back(X);
-            Vec3D T1(double(1+layer)/2,double(1-layer)/2,0);
-            Vec3D T2(double(1-layer)/2,double(1+layer)/2,0);
-            Vec3D N(0,0,layer);
-            V3.push_back(T1);
-            V4.push_back(T2);
-            V2.push_back(N);
-
+            if(L.I1==0)
+                L.I0 = i;
+            L.I1 = i+1;
         }
-        
-        
-    }
-    for(int i=0;i<V1.size();i++)
-    {
-            Pos.push_back(V1.at(i));
-            NormalV.push_back(V2.at(i));
-            T1vec.push_back(V3.at(i));
-            T2vec.push_back(V4.at(i));
-    }
-    int beadid = 0;
-    for (int i=0;i<Pos.size();i++)
-    {
-            if((Pos.at(i))(0)>=xmin && (Pos.at(i))(0)<=xmax && (Pos.at(i))(1)>=ymin && (Pos.at(i))(1)<=ymax)
-            {
-                point p(beadid, APL, Pos.at(i), NormalV.at(i), T1vec.at(i), T2vec.at(i) , c );
-                Cpoints.push_back(p);
-                beadid++;
-            }
-    }
-    for (std::vector<point >::iterator it = Cpoints.begin() ; it != Cpoints.end(); ++it)
-    {
-        it->UpdateArea(area/double(Cpoints.size()));
-    }
-    
-    
-    return Cpoints;
+    for (int j=0;j<Ny;j++)
+        if(L.Dy*double(j)>=ymin && L.Dy*double(j)<=ymax)
+        {
+            if(L.J1==0)
+                L.J0 = j;
+            L.J1 = j+1;
+        }
+    long n = long(L.I1-L.I0)*(L.J1-L.J0);
+    L.Area = (n>0) ? area/double(n) : 0;
+    return L;
     
 }
+int FlatPointMaker::GetTiles(int layer) const
+{
+    return m_Layer[layer].I1-m_Layer[layer].I0;
+}
+long FlatPointMaker::GetTileStart(int layer, int tile) const
+{
+    return long(tile)*(m_Layer[layer].J1-m_Layer[layer].J0);
+}
+void FlatPointMaker::MakeTile(int layer, int tile, point *points) const
+{
+    const Layer &L = m_Layer[layer];
+    std::vector <double> c(2,0);  // we set curvature to zero as it is not important for this function
+    Vec3D T1(double(1+L.Side)/2,double(1-L.Side)/2,0);
+    Vec3D T2(double(1-L.Side)/2,double(1+L.Side)/2,0);
+    Vec3D N(0,0,L.Side);
+    double x = L.Dx*double(L.I0+tile);
+    int ny = L.J1-L.J0;
+    for (int j=0;j<ny;j++)
+        points[j] = point(tile*ny+j, L.Area, Vec3D(x,L.Dy*double(L.J0+j),L.Z), N, T1, T2, c);
+}
 void FlatPointMaker::Initialize(std::string filename)
 {
     
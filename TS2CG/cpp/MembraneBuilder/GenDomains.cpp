@@ -6,6 +6,7 @@
 #include <limits>
 #include "GenDomains.h"
 #include "Def.h"
+#include "ToolExit.h"
 
 /*
  
@@ -15,11 +16,38 @@
  
  */
 
-GenDomains::GenDomains(std::string strfilename, std::vector<point*> pPointUp, std::vector<point*> pPointDown, bool renorm)
+GenDomains::GenDomains(std::string strfilename, const std::vector<point*> &pPointUp, const std::vector<point*> &pPointDown, bool renorm, const std::vector<DomainLipidSpec> &specs)
+{
+    m_Health = true;
+    //==== bucket the points by domain id once; the lower layer first so the ids keep the order of the old point scan
+    BucketPoints(1,pPointDown);
+    BucketPoints(0,pPointUp);
+    ReadLipidList(strfilename, specs);
+    //=== renormalizaing and obtaining max lipid and more...
+    for ( std::vector<Domain*>::iterator it = m_pAllDomains.begin(); it != m_pAllDomains.end(); it++ )
+        (*it)->Configure(renorm);
+
+
+}
+GenDomains::GenDomains(std::string strfilename, const double area[2], const long npoint[2], bool renorm)
 {
-    Nfunction f;
-    double SmallestDouble = std::numeric_limits<double>::epsilon();
     m_Health = true;
+    //==== all points have the domain id 0; the domains get their area and number of points, not the points
+    if(npoint[0]+npoint[1]>0)
+        SlotOf(0);
+    ReadLipidList(strfilename);
+    for (size_t i=0;i<m_pAllDomains.size();i++)
+    {
+        int layer = i%2;            // the upper and lower domain of each Domain line
+        if(m_pAllDomains[i]->GetDomainID()==0)
+            m_pAllDomains[i]->Configure(renorm, area[layer], npoint[layer]);
+        else
+            m_pAllDomains[i]->Configure(renorm, 0, 0);
+    }
+}
+void GenDomains::ReadLipidList(std::string strfilename, const std::vector<DomainLipidSpec> &specs)
+{
+    Nfunction f;
     //************************ Read str file *************/
     
     std::ifstream strfile;
@@ -73,22 +101,8 @@ GenDomains::GenDomains(std::string strfilename, std::vector<point*> pPointUp, st
             {
 
                 int domainid = f.String_to_Int(Line.at(1));
-                //std::getline (strfile,str);
-                std::vector<point*> P1,P2;
-                for ( std::vector<point*>::iterator it = pPointUp.begin(); it != pPointUp.end(); it++ )
-                {
-                    int id = (*it)->GetDomainID();
-                    if(id==domainid && (*it)->GetArea()>SmallestDouble)
-                    P1.push_back((*it));
-                }
-                for ( std::vector<point*>::iterator it = pPointDown.begin(); it != pPointDown.end(); it++ )
-                {
-                    int id = (*it)->GetDomainID();
-                    if(id==domainid && (*it)->GetArea()>SmallestDouble)
-                    P2.push_back((*it));
-                }
-                Domain Do1 (domainid,P1);
-                Domain Do2 (domainid,P2);
+                Domain Do1 (domainid,DomainPoints(0,domainid));
+                Domain Do2 (domainid,DomainPoints(1,domainid));
 
                     while (true)
                     {
@@ -127,33 +141,39 @@ GenDomains::GenDomains(std::string strfilename, std::vector<point*> pPointUp, st
     }
 
     strfile.close();
-    //==== get all the domain ids from the points. it will be much shorter then the point list
-    std::vector<int> PointDomianIDRange;
-    for ( std::vector<point*>::iterator it = pPointDown.begin(); it != pPointDown.end(); it++ )
+    //== with -domainspec, the domains are those DOP writes into the str file: each spec line is a lipid with
+    //== ratio 1 in both monolayers and its density as the area per lipid; spec lines with the same id share a domain
+    if(!specs.empty())
     {
-        int id = (*it)->GetDomainID();
-        std::vector<int>::iterator mem = std::find(PointDomianIDRange.begin(), PointDomianIDRange.end(), id);
-        if (mem == PointDomianIDRange.end())
-        PointDomianIDRange.push_back(id);
-    }
-    for ( std::vector<point*>::iterator it = pPointUp.begin(); it != pPointUp.end(); it++ )
-    {
-        int id = (*it)->GetDomainID();
-        std::vector<int>::iterator mem = std::find(PointDomianIDRange.begin(), PointDomianIDRange.end(), id);
-        if (mem == PointDomianIDRange.end())
-        PointDomianIDRange.push_back(id);
+        if(!m_AllDomains.empty())
+            std::cout<<"---> note: the domains of the [Lipids List] are replaced by those of the -domainspec file \n";
+        m_AllDomains.clear();
+        for (size_t i=0;i<specs.size();i++)
+        {
+            size_t d = 0;
+            while(d<m_AllDomains.size() && m_AllDomains[d].GetDomainID()!=specs[i].DomainID)
+                d += 2;
+            if(d==m_AllDomains.size())
+            {
+                m_AllDomains.push_back(Domain(specs[i].DomainID,DomainPoints(0,specs[i].DomainID)));
+                m_AllDomains.push_back(Domain(specs[i].DomainID,DomainPoints(1,specs[i].DomainID)));
+            }
+            m_AllDomains[d].AddADomainLipid(specs[i].Name, specs[i].Density, 1);
+            m_AllDomains[d+1].AddADomainLipid(specs[i].Name, specs[i].Density, 1);
+        }
     }
     //==
     //== CHECK if all the points domain are defined in the file
     
     //m_AllDomains
-    std::vector<int> DomianTypes;
+    std::vector<char> DefinedSlot(m_SlotDomainID.size(),0);
     for ( std::vector<Domain>::iterator it = m_AllDomains.begin(); it != m_AllDomains.end(); it++ )
     {
         int domainidtype = (*it).GetDomainID();
-        DomianTypes.push_back(domainidtype);
-        std::vector<int>::iterator pdomainid = std::find(PointDomianIDRange.begin(), PointDomianIDRange.end(), domainidtype);
-        if (pdomainid == PointDomianIDRange.end())
+        std::unordered_map<int,int>::const_iterator slot = m_Slot.find(domainidtype);
+        if (slot != m_Slot.end())
+            DefinedSlot[slot->second] = 1;
+        else
         {
             std::cout<<"---> warning: there is a domain defined with domain id of "<<domainidtype<<" while no point with this domain exist \n";
             std::cout<<"---> note: this could has happened because some points are covered my protein or exclusions! \n";
@@ -161,14 +181,12 @@ GenDomains::GenDomains(std::string strfilename, std::vector<point*> pPointUp, st
 
     }
     std::cout<<"---> checking if the domain ids in str file covers all in the point files \n";
-    for ( std::vector<int>::iterator it = PointDomianIDRange.begin(); it != PointDomianIDRange.end(); it++ )
+    for (size_t slot=0;slot<m_SlotDomainID.size();slot++)
     {
-        std::vector<int>::iterator domainid = std::find(DomianTypes.begin(), DomianTypes.end(), *it);
-
-        if (domainid == DomianTypes.end())
+        if (DefinedSlot[slot]==0)
         {
-            std::cout<<" Error: there are points with domain id of "<<*it<<" while this id is not defined in the str file \n";
-            std::exit(0);
+            std::cout<<" Error: there are points with domain id of "<<m_SlotDomainID[slot]<<" while this id is not defined in the str file \n";
+            ToolExit::Exit(0);
 
         }
         
@@ -178,16 +196,59 @@ GenDomains::GenDomains(std::string strfilename, std::vector<point*> pPointUp, st
     {
         m_pAllDomains.push_back(&(*it));
     }
-    //=== renormalizaing and obtaining max lipid and more...
-    for ( std::vector<Domain*>::iterator it = m_pAllDomains.begin(); it != m_pAllDomains.end(); it++ )
-        (*it)->Configure(renorm);
-
-
 }
 GenDomains::~GenDomains()
 {
     
 }
+int GenDomains::SlotOf(int domainid)
+{
+    std::unordered_map<int,int>::iterator it = m_Slot.find(domainid);
+    if(it!=m_Slot.end())
+        return it->second;
+    int slot = m_SlotDomainID.size();
+    m_Slot[domainid] = slot;
+    m_SlotDomainID.push_back(domainid);
+    return slot;
+}
+void GenDomains::BucketPoints(int layer, const std::vector<point*> &points)
+{
+    // all ids are registered (for the checks), only points with an area are placed in a domain
+    double SmallestDouble = std::numeric_limits<double>::epsilon();
+    std::vector<int> slot(points.size());
+    int lastid = 0, lastslot = -1;      // domain ids come in long runs
+    for (size_t i=0;i<points.size();i++)
+    {
+        int id = points[i]->GetDomainID();
+        if(lastslot<0 || id!=lastid)
+        {
+            lastid = id;
+            lastslot = SlotOf(id);
+        }
+        slot[i] = (points[i]->GetArea()>SmallestDouble) ? lastslot : -1;
+    }
+    // the other layer may add slots later, so size for the ids known at the end (DomainPoints checks the range)
+    std::vector<int> &start = m_Start[layer];
+    start.assign(m_SlotDomainID.size()+1,0);
+    for (size_t i=0;i<points.size();i++)
+        if(slot[i]>=0)
+            start[slot[i]+1]++;
+    for (size_t s=0;s<m_SlotDomainID.size();s++)
+        start[s+1] += start[s];
+    std::vector<int> fill(start.begin(), start.end()-1);
+    m_Sorted[layer].resize(start.back());
+    for (size_t i=0;i<points.size();i++)
+        if(slot[i]>=0)
+            m_Sorted[layer][fill[slot[i]]++] = points[i];
+}
+std::vector<point*> GenDomains::DomainPoints(int layer, int domainid) const
+{
+    std::unordered_map<int,int>::const_iterator it = m_Slot.find(domainid);
+    const std::vector<int> &start = m_Start[layer];
+    if(it==m_Slot.end() || it->second+1>=int(start.size()))
+        return std::vector<point*>();
+    return std::vector<point*>(m_Sorted[layer].begin()+start[it->second], m_Sorted[layer].begin()+start[it->second+1]);
+}
 
 
 
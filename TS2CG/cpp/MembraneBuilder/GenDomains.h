@@ -11,11 +11,13 @@
 #include <map>
 #include <iomanip>
 #include <valarray>
+#include <unordered_map>
 #include "Domain.h"
 #include "LMatrix.h"
 #include "Nfunction.h"
 #include "Vec3D.h"
 #include "point.h"
+#include "DomainAssigner.h"
 
 
 
@@ -23,7 +25,11 @@ class GenDomains
 {
 public:
     
-	GenDomains(std::string file, std::vector<point*> point1, std::vector<point*> point2, bool renorm);
+	// specs (PCG -domainspec): the lipids of the domains, instead of the [Lipids List] of the str file
+	GenDomains(std::string file, const std::vector<point*> &point1, const std::vector<point*> &point2, bool renorm,
+	           const std::vector<DomainLipidSpec> &specs = std::vector<DomainLipidSpec>());
+	// points that are made later (PCG -stream): all have the domain id 0, area and npoint are per layer (upper, lower)
+	GenDomains(std::string file, const double area[2], const long npoint[2], bool renorm);
 	~GenDomains();
     
     inline  std::vector<Domain*> GetDomains()                const  {return m_pAllDomains;}
@@ -31,11 +37,18 @@ public:
 public:
     void Configure();
 private:
-    
-    
-    
+    // one counting sort pass: the points of each domain id become a contiguous range of m_Sorted[layer]
+    void ReadLipidList(std::string file, const std::vector<DomainLipidSpec> &specs = std::vector<DomainLipidSpec>());       // the domains of the [Lipids List] of the str file (or of the specs) and the domain id checks
+    int  SlotOf(int domainid);
+    void BucketPoints(int layer, const std::vector<point*> &points);
+    std::vector<point*> DomainPoints(int layer, int domainid) const;
 
 private:
+    std::unordered_map<int,int> m_Slot;          // domain id -> slot, ids in the order they are first seen in the point files
+    std::vector<int> m_SlotDomainID;
+    std::vector<int> m_Start[2];                 // m_Sorted[layer][m_Start[layer][s]..m_Start[layer][s+1]] are the points of slot s
+    std::vector<point*> m_Sorted[2];
+
     std::vector<point*> m_pPointUp;
     std::vector<point*> m_pPointDown;
     std::vector<Domain*> m_pAllDomains;
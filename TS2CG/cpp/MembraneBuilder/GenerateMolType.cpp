@@ -5,6 +5,7 @@
 #include <math.h>
 #include "GenerateMolType.h"
 #include "GroFile.h"
+#include "ToolExit.h"
 /*
  This class reads the str file to generate molecules
  1) Reads the header of the str file to find all the gro file names that are started by word include
@@ -14,6 +15,43 @@
  struct MolType is in the ReadLipidLibrary class.
  */
 
+//=================================================================================================================
+//=========================== internal lipid library (Martini 2), coordinates in units of -Bondlength
+//=================================================================================================================
+namespace {
+struct LiBBead {int ID; const char *Name; const char *Type; double X, Y, Z;};
+struct LiBMolecule {const char *Name; double Area; int FirstBead; int BeadNumber;};
+
+const LiBBead LiBBeads[] = {
+    // DLPC, as Mol_Def_DPhospholipid("DLPC", "- - - NC3 - PO4 GL1 GL2 C1A C2A C3A - - - C1B C2B C3B - - -", 0.65)
+    {1,"NC3","Q",0,0,2},    {1,"PO4","Q",0,0,0},    {1,"GL1","Q",0,0,-1},   {1,"GL2","Q",0,1,-1},
+    {1,"C1A","Q",0,0,-3},   {1,"C2A","Q",0,0,-4},   {1,"C3A","Q",0,0,-5},
+    {1,"C1B","Q",0,1,-1},   {1,"C2B","Q",0,1,-2},   {1,"C3B","Q",0,1,-3},
+    // DOPC
+    {1,"NC3","Q0",0,0,1},   {2,"PO4","Qa",0,0,0},   {3,"GL1","Na",0,0,-1},  {4,"GL2","Na",0,0,-2},
+    {5,"G1A","C1",0,0,-3},  {6,"G2A","C1",0,0,-4},  {7,"D3A","C3",0,0,-5},  {8,"D4A","C1",0,0,-6},
+    {9,"C1B","C1",0,1,-2},  {10,"C2B","C1",0,1,-3}, {11,"C3B","C3",0,1,-4}, {12,"C4B","C1",0,1,-5},
+    // POPC
+    {1,"NC3","Q0",0,0,1},   {2,"PO4","Qa",0,0,0},   {3,"GL1","Na",0,0,-1},  {4,"GL2","Na",0,0,-2},
+    {5,"G1A","C1",0,0,-3},  {6,"G2A","C1",0,0,-4},  {7,"D3A","C1",0,0,-5},  {8,"D4A","C1",0,0,-6},
+    {9,"C1B","C1",0,1,-2},  {10,"C2B","C1",0,1,-3}, {11,"C3B","C3",0,1,-4}, {12,"C4B","C1",0,1,-5},
+    // DPPC
+    {1,"NC3","Q0",0,0,1},   {2,"PO4","Qa",0,0,0},   {3,"GL1","Na",0,0,-1},  {4,"GL2","Na",0,0,-2},
+    {5,"G1A","C1",0,0,-3},  {6,"G2A","C1",0,0,-4},  {7,"D3A","C1",0,0,-5},  {8,"D4A","C1",0,0,-6},
+    {9,"C1B","C1",0,1,-2},  {10,"C2B","C1",0,1,-3}, {11,"C3B","C1",0,1,-4}, {12,"C4B","C1",0,1,-5},
+    // CHOL
+    {1,"ROH","SP1",0,0,0},  {2,"R1","SC1",0,0,-1},  {3,"R2","SC3",0,0,-2},  {4,"R3","SC1",0,0,-3},
+    {5,"R4","SC1",0,0,-4},  {6,"R5","SC1",0,0,-5},  {7,"C1","SC1",0,0,-6},  {8,"C2","C1",0,0,-7},
+};
+const LiBMolecule LiBMolecules[] = {
+    {"DLPC", 0.65, 0, 10},
+    {"DOPC", 0.7, 10, 12},
+    {"POPC", 0.69, 22, 12},
+    {"DPPC", 0.68, 34, 12},
+    {"CHOL", 0.4, 46, 8},
+};
+}
+
 
 GenerateMolType::GenerateMolType(Argument *pArgu)
 {
@@ -30,7 +68,7 @@ GenerateMolType::GenerateMolType(Argument *pArgu)
     if(strfile.good()==false)
     {
         std::cout<<"---> error: while opening the str file with  name: "<<strfilename<<"  ; check if the file exist "<<"\n";
-        exit(0);
+        ToolExit::Exit(0);
     }
     std::cout<<"---> generating molecule types from  "<<strfilename<<"  file"<<"\n";
 //=======================================================
@@ -55,7 +93,7 @@ GenerateMolType::GenerateMolType(Argument *pArgu)
             {
                 std::cout<<"--> Error: File name "<<namestr<<" included in the "<<strfilename<<" does not exist \n";
                 std::cout<<"-> aborted! You are allowed to try one more time. Kidding, please do not :) \n";
-                exit(0);
+                ToolExit::Exit(0);
             }
         }
         std::getline (strfile,namestr);
@@ -81,7 +119,7 @@ GenerateMolType::GenerateMolType(Argument *pArgu)
         else
         {
             std::cout<<"--> Faild in reading the library "<<ExternalLIB.GetLiBTitle()<<"\n";
-            exit(0);
+            ToolExit::Exit(0);
         }
     }
     if(pArgu->GetLipidLibrary()=="no")
@@ -146,242 +184,28 @@ double GenerateMolType::MolAreaCal(MolType mol)
 //============================================================================================================
 void GenerateMolType::LiBMol()
 {
-  
-
-    Mol_Def_DPhospholipid("DLPC", "- - - NC3 - PO4 GL1 GL2 C1A C2A C3A - - - C1B C2B C3B - - -", 0.65);
-    
+    // the internal library is the constant table LiBBeads/LiBMolecules (top of this file); only the
+    // scaling by -Bondlength is done at run time
     double l = m_BondLenght;
-    
-    //====== DOPC ===========//
-    {
-    std::vector<bead> molbead;
-        {Vec3D X(0,0,1);
-        X=X*l;
-        bead b1(1, "NC3", "Q0", "DOPC", 1, X(0),X(1),X(2));
-        molbead.push_back(b1);}
-        {Vec3D X(0,0,0);
-        X=X*l;
-        bead b1(2, "PO4", "Qa", "DOPC", 1, X(0),X(1),X(2));
-        molbead.push_back(b1);}
-        {Vec3D X(0,0,-1);
-        X=X*l;
-        bead b1(3, "GL1", "Na", "DOPC", 1, X(0),X(1),X(2));
-        molbead.push_back(b1);}
-        {Vec3D X(0,0,-2);
-        X=X*l;
-        bead b1(4, "GL2", "Na", "DOPC", 1, X(0),X(1),X(2));
-        molbead.push_back(b1);}
-        {Vec3D X(0,0,-3);
-        X=X*l;
-        bead b1(5, "G1A", "C1", "DOPC", 1, X(0),X(1),X(2));
-        molbead.push_back(b1);}
-        {Vec3D X(0,0,-4);
-        X=X*l;
-        bead b1(6, "G2A", "C1", "DOPC", 1, X(0),X(1),X(2));
-        molbead.push_back(b1);}
-        {Vec3D X(0,0,-5);
-        X=X*l;
-        bead b1(7, "D3A", "C3", "DOPC", 1, X(0),X(1),X(2));
-        molbead.push_back(b1);}
-        {Vec3D X(0,0,-6);
-        X=X*l;
-        bead b1(8, "D4A", "C1", "DOPC", 1, X(0),X(1),X(2));
-        molbead.push_back(b1);}
-        {Vec3D X(0,1,-2);
-        X=X*l;
-        bead b1(9, "C1B", "C1", "DOPC", 1, X(0),X(1),X(2));
-        molbead.push_back(b1);}
-        {Vec3D X(0,1,-3);
-        X=X*l;
-        bead b1(10, "C2B", "C1", "DOPC", 1, X(0),X(1),X(2));
-        molbead.push_back(b1);}
-        {Vec3D X(0,1,-4);
-        X=X*l;
-        bead b1(11, "C3B", "C3", "DOPC", 1, X(0),X(1),X(2));
-        molbead.push_back(b1);}
-        {Vec3D X(0,1,-5);
-        X=X*l;
-        bead b1(12, "C4B", "C1", "DOPC", 1, X(0),X(1),X(2));
-        molbead.push_back(b1);}
-   
-    MolType Mol;
-    Mol.Beads = molbead;
-    Mol.beadnumber=12;
-        Mol.molarea = 0.7;
-    Mol.MolName = "DOPC";
-    m_MoleculesType.insert(std::pair<std::string, MolType>("DOPC", Mol));
-    }
-    
-
-    
-    //====== POPC ===========//
-    {
-        std::vector<bead> molbead;
-        {Vec3D X(0,0,1);
-            X=X*l;
-            bead b1(1, "NC3", "Q0", "POPC", 1, X(0),X(1),X(2));
-            molbead.push_back(b1);}
-        {Vec3D X(0,0,0);
-            X=X*l;
-            bead b1(2, "PO4", "Qa", "POPC", 1, X(0),X(1),X(2));
-            molbead.push_back(b1);}
-        {Vec3D X(0,0,-1);
-            X=X*l;
-            bead b1(3, "GL1", "Na", "POPC", 1, X(0),X(1),X(2));
-            molbead.push_back(b1);}
-        {Vec3D X(0,0,-2);
-            X=X*l;
-            bead b1(4, "GL2", "Na", "POPC", 1, X(0),X(1),X(2));
-            molbead.push_back(b1);}
-        {Vec3D X(0,0,-3);
-            X=X*l;
-            bead b1(5, "G1A", "C1", "POPC", 1, X(0),X(1),X(2));
-            molbead.push_back(b1);}
-        {Vec3D X(0,0,-4);
-            X=X*l;
-            bead b1(6, "G2A", "C1", "POPC", 1, X(0),X(1),X(2));
-            molbead.push_back(b1);}
-        {Vec3D X(0,0,-5);
-            X=X*l;
-            bead b1(7, "D3A", "C1", "POPC", 1, X(0),X(1),X(2));
-            molbead.push_back(b1);}
-        {Vec3D X(0,0,-6);
-            X=X*l;
-            bead b1(8, "D4A", "C1", "POPC", 1, X(0),X(1),X(2));
-            molbead.push_back(b1);}
-        {Vec3D X(0,1,-2);
-            X=X*l;
-            bead b1(9, "C1B", "C1", "POPC", 1, X(0),X(1),X(2));
-            molbead.push_back(b1);}
-        {Vec3D X(0,1,-3);
-            X=X*l;
-            bead b1(10, "C2B", "C1", "POPC", 1, X(0),X(1),X(2));
-            molbead.push_back(b1);}
-        {Vec3D X(0,1,-4);
-            X=X*l;
-            bead b1(11, "C3B", "C3", "POPC", 1, X(0),X(1),X(2));
-            molbead.push_back(b1);}
-        {Vec3D X(0,1,-5);
-            X=X*l;
-            bead b1(12, "C4B", "C1", "POPC", 1, X(0),X(1),X(2));
-            molbead.push_back(b1);}
-        
-        MolType Mol;
-        Mol.Beads = molbead;
-        Mol.beadnumber=12;
-        Mol.molarea = 0.69;
-        Mol.MolName = "POPC";
-        m_MoleculesType.insert(std::pair<std::string, MolType>("POPC", Mol));
-    }
-    //===
-    //====== DPPC ===========//
-    {
-        std::vector<bead> molbead;
-        {Vec3D X(0,0,1);
-            X=X*l;
-            bead b1(1, "NC3", "Q0", "DPPC", 1, X(0),X(1),X(2));
-            molbead.push_back(b1);}
-        {Vec3D X(0,0,0);
-            X=X*l;
-            bead b1(2, "PO4", "Qa", "DPPC", 1, X(0),X(1),X(2));
-            molbead.push_back(b1);}
-        {Vec3D X(0,0,-1);
-            X=X*l;
-            bead b1(3, "GL1", "Na", "DPPC", 1, X(0),X(1),X(2));
-            molbead.push_back(b1);}
-        {Vec3D X(0,0,-2);
-            X=X*l;
-            bead b1(4, "GL2", "Na", "DPPC", 1, X(0),X(1),X(2));
-            molbead.push_back(b1);}
-        {Vec3D X(0,0,-3);
-            X=X*l;
-            bead b1(5, "G1A", "C1", "DPPC", 1, X(0),X(1),X(2));
-            molbead.push_back(b1);}
-        {Vec3D X(0,0,-4);
-            X=X*l;
-            bead b1(6, "G2A", "C1", "DPPC", 1, X(0),X(1),X(2));
-            molbead.push_back(b1);}
-        {Vec3D X(0,0,-5);
-            X=X*l;
-            bead b1(7, "D3A", "C1", "DPPC", 1, X(0),X(1),X(2));
-            molbead.push_back(b1);}
-        {Vec3D X(0,0,-6);
-            X=X*l;
-            bead b1(8, "D4A", "C1", "DPPC", 1, X(0),X(1),X(2));
-            molbead.push_back(b1);}
-        {Vec3D X(0,1,-2);
-            X=X*l;
-            bead b1(9, "C1B", "C1", "DPPC", 1, X(0),X(1),X(2));
-            molbead.push_back(b1);}
-        {Vec3D X(0,1,-3);
-            X=X*l;
-            bead b1(10, "C2B", "C1", "DPPC", 1, X(0),X(1),X(2));
-            molbead.push_back(b1);}
-        {Vec3D X(0,1,-4);
-            X=X*l;
-            bead b1(11, "C3B", "C1", "DPPC", 1, X(0),X(1),X(2));
-            molbead.push_back(b1);}
-        {Vec3D X(0,1,-5);
-            X=X*l;
-            bead b1(12, "C4B", "C1", "DPPC", 1, X(0),X(1),X(2));
-            molbead.push_back(b1);}
-        
-        MolType Mol;
-        Mol.Beads = molbead;
-        Mol.beadnumber=12;
-        Mol.molarea = 0.68;
-        Mol.MolName = "DPPC";
-        m_MoleculesType.insert(std::pair<std::string, MolType>("DPPC", Mol));
-    }
-     
-
-    
-    //====== CHOL ===========//
+    for (int m=0;m<int(sizeof(LiBMolecules)/sizeof(LiBMolecules[0]));m++)
     {
+        const LiBMolecule &M = LiBMolecules[m];
         std::vector<bead> molbead;
-        {Vec3D X(0,0,0);
-            X=X*l;
-            bead b1(1, "ROH", "SP1", "CHOL", 1, X(0),X(1),X(2));
-            molbead.push_back(b1);}
-        {Vec3D X(0,0,-1);
-            X=X*l;
-            bead b1(2, "R1", "SC1", "CHOL", 1, X(0),X(1),X(2));
-            molbead.push_back(b1);}
-        {Vec3D X(0,0,-2);
-            X=X*l;
-            bead b1(3, "R2", "SC3", "CHOL", 1, X(0),X(1),X(2));
-            molbead.push_back(b1);}
-        {Vec3D X(0,0,-3);
-            X=X*l;
-            bead b1(4, "R3", "SC1", "CHOL", 1, X(0),X(1),X(2));
-            molbead.push_back(b1);}
-        {Vec3D X(0,0,-4);
-            X=X*l;
-            bead b1(5, "R4", "SC1", "CHOL", 1, X(0),X(1),X(2));
-            molbead.push_back(b1);}
-        {Vec3D X(0,0,-5);
-            X=X*l;
-            bead b1(6, "R5", "SC1", "CHOL", 1, X(0),X(1),X(2));
-            molbead.push_back(b1);}
-        {Vec3D X(0,0,-6);
-            X=X*l;
-            bead b1(7, "C1", "SC1", "CHOL", 1, X(0),X(1),X(2));
-            molbead.push_back(b1);}
-        {Vec3D X(0,0,-7);
+        molbead.reserve(M.BeadNumber);
+        for (int i=M.FirstBead;i<M.FirstBead+M.BeadNumber;i++)
+        {
+            const LiBBead &B = LiBBeads[i];
+            Vec3D X(B.X,B.Y,B.Z);
             X=X*l;
-            bead b1(8, "C2", "C1", "CHOL", 1, X(0),X(1),X(2));
-            molbead.push_back(b1);}
-        
+            molbead.push_back(bead(B.ID, B.Name, B.Type, M.Name, 1, X(0),X(1),X(2)));
+        }
         MolType Mol;
         Mol.Beads = molbead;
-        Mol.beadnumber=8;
-        Mol.molarea = 0.4;
-        Mol.MolName = "CHOL";
-        m_MoleculesType.insert(std::pair<std::string, MolType>("CHOL", Mol));
+        Mol.beadnumber=M.BeadNumber;
+        Mol.molarea = M.Area;
+        Mol.MolName = M.Name;
+        m_MoleculesType.insert(std::pair<std::string, MolType>(M.Name, Mol));
     }
-    
-
-    
 }
 void  GenerateMolType::Mol_Def_DPhospholipid(std::string resname, std::string BeadDEf, double APL)
 {
@@ -7,6 +7,10 @@
 #include "Argument.h"
 #include "bead.h"
 #include "Vec3D.h"
+#include "CellList.h"
+/*
+ Overlap search for PCG; the cell binning itself is done by the shared CellList (TS2CGCore).
+ */
 class GenerateUnitCells
 {
 public:
@@ -18,9 +22,9 @@ public:
 
 
 
-        inline std::map <std::string, UnitCell > GetAllCNTCells()           {return m_AllCNTCells;}
     inline std::vector <double> GetCNTCellSize()        {return m_CNTCellSize;}
     inline std::vector <int> GetCNTCellNo()        {return m_CNTCellNo;}
+    inline const CellList &GetCellList()        const {return m_CellList;}
 
 
 
@@ -29,14 +33,11 @@ public:
     bool anythingaround (Vec3D PX);
 
 int IDFromIndex(int,int,int);
-//  void AddtoVertexList(vertex * z);
 
     void Generate();
 
 private:
-    std::map <std::string, UnitCell > m_AllCNTCells;
-
-int IndexFromID(int,int *,int *,int *);
+    CellList m_CellList;
 double m_CNTSize;
 private:
     std::vector< bead* > m_pAllBead;
@@ -48,8 +49,6 @@ int m_Nz;
     std::vector <double> m_CNTCellSize;
     std::vector <int> m_CNTCellNo;
 
-    double dist2between2Points(Vec3D X1,Vec3D X2);
-
     double m_Cutoff;
     
 
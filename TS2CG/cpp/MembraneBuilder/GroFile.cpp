@@ -4,6 +4,8 @@
 #include <algorithm>
 #include "GroFile.h"
 #include "Nfunction.h"
+#include "GroIO.h"
+#include "ToolExit.h"
 
 GroFile::GroFile(std::string gmxfilename) {
     m_GroFileName = gmxfilename;
@@ -30,42 +32,21 @@ void GroFile::ReadGroFile(std::string file) {
         file = file + ".gro";
     }
     
-    std::ifstream FGRO(file.c_str());
-    if (!FGRO.is_open()) {
+    std::vector<GroAtom> atoms;
+    Vec3D box;
+    if (!GroIO::Read(file, m_Title, atoms, box)) {
         std::cout << "---> Error: Could not open the file: " << file << std::endl;
-        exit(0);  // Return on error instead of throwing an exception
+        ToolExit::Exit(0);  // Return on error instead of throwing an exception
     }
-    getline (FGRO,m_Title);
     m_Title.erase(std::remove(m_Title.begin(), m_Title.end(), ' '), m_Title.end());
     
-    std::string str,line;
-    int NoBeads;
-    FGRO>>NoBeads;
-    getline (FGRO,str);
-
-    double x,y,z,v1,v2,v3;
-    int resid, secondInt;
-    std::string firstStr, secondStr;
-        
-    for (int i=0; i<NoBeads; i++) {
-        
-        getline (FGRO,line);
-        resid = std::stoi(line.substr(0, 5));  // First integer (column 0-4)
-        firstStr = line.substr(5, 5);             // First string (column 5-9)
-        secondStr = line.substr(10, 5);           // Second string (column 10-14)
-        secondInt = std::stoi(line.substr(15, 5)); // Second integer (column 15-19)
-        firstStr.erase(std::remove(firstStr.begin(), firstStr.end(), ' '), firstStr.end());
-        secondStr.erase(std::remove(secondStr.begin(), secondStr.end(), ' '), secondStr.end());
-        std::istringstream iss(line.substr(20));
-        iss >> x >> y >> z >> v1 >> v2 >> v3;
-        
-        bead make_Bead(i, secondStr, secondStr, firstStr, resid, x, y, z);
+    m_AllBeads.reserve(atoms.size());
+    for (size_t i=0; i<atoms.size(); i++) {
+        const GroAtom &a = atoms[i];
+        bead make_Bead(i, a.name, a.name, a.resname, a.resid, a.x, a.y, a.z);
         m_AllBeads.push_back(make_Bead);
-        
     }
-    float Lx,Ly,Lz;
-    FGRO>>Lx>>Ly>>Lz;
-    FGRO.close();
+    float Lx = box(0), Ly = box(1), Lz = box(2);
     
     m_Box(0)=Lx; m_Box(1)=Ly; m_Box(2)=Lz;
     m_pBox = &m_Box;
@@ -5,6 +5,8 @@
 #include "Job.h"
 #include "Nfunction.h"
 #include "BackMap.h"
+#include "Batch.h"
+#include "ToolExit.h"
 // this class does not do much, it is just an extra check in case in future we want to diversify.
 // this class just get the arguments and call BackMap class. 
 Job::Job(std::vector<std::string> argument) {
@@ -13,16 +15,18 @@ Job::Job(std::vector<std::string> argument) {
     std::string function = arg.GetFunction();
 //-- checking if the ExecutableName is PCG and also if the type of fuctions known,
     if (executable==ExecutableName) { // ExecutableName = PCG
-        if (function == "backmap" || function == "analytical_shape") {
+        if (arg.GetBatchFile() != "") {
+            Batch B(&arg); // many PCG runs from one set of loaded inputs
+        } else if (function == "backmap" || function == "analytical_shape") {
             BackMap B(&arg); // call Backmap class
         } else {
             std::cout << function << "---> function is not recognized \n";
-            std::exit(0);
+            ToolExit::Exit(0);
         }
     }
     else {
         std::cout << "---> error executable name <"<<executable<<">  is wrong \n";
-        std::exit(0);
+        ToolExit::Exit(0);
     }
 }
 Job::~Job()
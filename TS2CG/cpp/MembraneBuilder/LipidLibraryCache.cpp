@@ -0,0 +1,225 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+#include <mutex>
+#include <fstream>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "LipidLibraryCache.h"
+
+#define LIBCACHE_MAGIC "TS2CGLB1"     // change the last character when the record layout changes
+
+namespace {
+std::mutex CacheLock;
+std::map<unsigned long long, LipidLibraryEntry> Memory;
+
+// binary records: int32, double and length prefixed strings, in host byte order
+void PutInt(std::string &out, int v)                {out.append((const char*)&v, sizeof(v));}
+void PutDouble(std::string &out, double v)          {out.append((const char*)&v, sizeof(v));}
+void PutString(std::string &out, const std::string &s)  {PutInt(out, s.size()); out.append(s);}
+
+class Reader
+{
+public:
+    Reader(const char *data, size_t size) : m_P(data), m_End(data+size), m_Good(true) {}
+    bool Good()     const {return m_Good;}
+    bool AtEnd()    const {return m_P==m_End;}
+    int Int()
+    {
+        int v = 0;
+        Raw(&v, sizeof(v));
+        return v;
+    }
+    double Double()
+    {
+        double v = 0;
+        Raw(&v, sizeof(v));
+        return v;
+    }
+    unsigned long long ULong()
+    {
+        unsigned long long v = 0;
+        Raw(&v, sizeof(v));
+        return v;
+    }
+    std::string String()
+    {
+        int n = Int();
+        if(!m_Good || n<0 || size_t(m_End-m_P)<size_t(n))
+        {
+            m_Good = false;
+            return "";
+        }
+        std::string s(m_P, n);
+        m_P += n;
+        return s;
+    }
+private:
+    void Raw(void *v, size_t n)
+    {
+        if(!m_Good || size_t(m_End-m_P)<n)
+        {
+            m_Good = false;
+            return;
+        }
+        memcpy(v, m_P, n);
+        m_P += n;
+    }
+    const char *m_P;
+    const char *m_End;
+    bool m_Good;
+};
+}
+
+unsigned long long LipidLibraryCache::Key(const std::string &text, double bondlength)
+{
+    unsigned long long h = 1469598103934665603ULL;
+    for (size_t i=0;i<text.size();i++)
+    {
+        h ^= (unsigned char)(text[i]);
+        h *= 1099511628211ULL;
+    }
+    const unsigned char *b = (const unsigned char*)&bondlength;
+    for (size_t i=0;i<sizeof(bondlength);i++)
+    {
+        h ^= b[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+std::string LipidLibraryCache::FileName(unsigned long long key)
+{
+    const char *dir = getenv("TS2CG_CACHE_DIR");
+    if(dir==NULL || dir[0]=='\0')
+        return "";
+    char name[64];
+    snprintf(name, sizeof(name), "lib_%016llx.bin", key);
+    return std::string(dir)+"/"+name;
+}
+bool LipidLibraryCache::Load(unsigned long long key, LipidLibraryEntry &entry)
+{
+    std::lock_guard<std::mutex> lock(CacheLock);
+    std::map<unsigned long long, LipidLibraryEntry>::iterator it = Memory.find(key);
+    if(it!=Memory.end())
+    {
+        entry = it->second;
+        return true;
+    }
+    std::string filename = FileName(key);
+    if(filename.empty() || !ReadFile(filename, key, entry))
+        return false;
+    Memory[key] = entry;
+    return true;
+}
+void LipidLibraryCache::Store(unsigned long long key, const LipidLibraryEntry &entry)
+{
+    std::lock_guard<std::mutex> lock(CacheLock);
+    Memory[key] = entry;
+    std::string filename = FileName(key);
+    if(!filename.empty())
+        WriteFile(filename, key, entry);
+}
+bool LipidLibraryCache::ReadFile(const std::string &filename, unsigned long long key, LipidLibraryEntry &entry)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    if(fd<0)
+        return false;
+    struct stat st;
+    if(fstat(fd,&st)!=0 || st.st_size<=0)
+    {
+        close(fd);
+        return false;
+    }
+    size_t size = st.st_size;
+    void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(map==MAP_FAILED)
+        return false;
+
+    Reader in((const char*)map, size);
+    bool good = (size>=8 && memcmp(map, LIBCACHE_MAGIC, 8)==0);
+    if(good)
+    {
+        in.ULong();                 // the magic word
+        good = (in.ULong()==key);
+    }
+    LipidLibraryEntry e;
+    if(good)
+    {
+        e.Title = in.String();
+        e.Version = in.String();
+        int nmol = in.Int();
+        for (int m=0;m<nmol && in.Good();m++)
+        {
+            MolType Mol;
+            Mol.MolName = in.String();
+            Mol.molarea = in.Double();
+            int nbead = in.Int();
+            for (int b=0;b<nbead && in.Good();b++)
+            {
+                int id = in.Int();
+                std::string name = in.String();
+                std::string type = in.String();
+                std::string resname = in.String();
+                int resid = in.Int();
+                double x = in.Double();
+                double y = in.Double();
+                double z = in.Double();
+                Mol.Beads.push_back(bead(id, name, type, resname, resid, x, y, z));
+            }
+            Mol.beadnumber = Mol.Beads.size();
+            e.MoleculesType.insert(std::pair<std::string, MolType>(Mol.MolName, Mol));
+        }
+        good = in.Good() && in.AtEnd();
+    }
+    munmap(map, size);
+    if(good)
+        entry = e;
+    return good;
+}
+void LipidLibraryCache::WriteFile(const std::string &filename, unsigned long long key, const LipidLibraryEntry &entry)
+{
+    std::string out(LIBCACHE_MAGIC);
+    out.append((const char*)&key, sizeof(key));
+    PutString(out, entry.Title);
+    PutString(out, entry.Version);
+    PutInt(out, entry.MoleculesType.size());
+    for (std::map<std::string, MolType>::const_iterator it = entry.MoleculesType.begin(); it != entry.MoleculesType.end(); it++)
+    {
+        std::vector<bead> beads = (it->second).Beads;
+        PutString(out, (it->second).MolName);
+        PutDouble(out, (it->second).molarea);
+        PutInt(out, beads.size());
+        for (std::vector<bead>::iterator b = beads.begin(); b != beads.end(); ++b)
+        {
+            PutInt(out, b->GetID());
+            PutString(out, b->GetBeadName());
+            PutString(out, b->GetBeadType());
+            PutString(out, b->GetResName());
+            PutInt(out, b->GetResid());
+            PutDouble(out, b->GetXPos());
+            PutDouble(out, b->GetYPos());
+            PutDouble(out, b->GetZPos());
+        }
+    }
+    // write next to the final name and rename, so a run in parallel never maps half a file
+    std::ostringstream tmp;
+    tmp<<filename<<".tmp"<<getpid();
+    std::ofstream file(tmp.str().c_str(), std::ios::binary);
+    if(!file.good())
+    {
+        std::cout<<"---> warning: can not write the lipid library cache "<<filename<<"\n";
+        return;
+    }
+    file.write(out.data(), out.size());
+    file.close();
+    if(!file.good() || rename(tmp.str().c_str(), filename.c_str())!=0)
+    {
+        std::cout<<"---> warning: can not write the lipid library cache "<<filename<<"\n";
+        remove(tmp.str().c_str());
+    }
+}
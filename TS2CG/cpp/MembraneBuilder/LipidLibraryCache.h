@@ -0,0 +1,38 @@
+#if !defined(AFX_LipidLibraryCache_H_7E2B21B8_C13C_5648_BF23_124095086235__INCLUDED_)
+#define AFX_LipidLibraryCache_H_7E2B21B8_C13C_5648_BF23_124095086235__INCLUDED_
+
+#include <string>
+#include <map>
+#include "Data_Structure.h"
+/*
+ Weria Pezeshkian (weria.pezeshkian@gmail.com)
+ Copyright (c) Weria Pezeshkian
+ Cache of parsed lipid libraries (-LLIB), used by ReadLipidLibrary.
+
+ The key is a 64 bit FNV-1a hash of the library text and of -Bondlength (the bead coordinates are
+ stored already scaled). A parsed library is kept in memory for the rest of the process, so repeated
+ PCG runs from python or from a batch parse it once. When the environment variable TS2CG_CACHE_DIR
+ is set, it is also written there as lib_<key>.bin and later runs map that file (mmap) instead of
+ parsing the text. The file starts with a magic word and the key; a file that does not match, is
+ truncated or can not be read is ignored and the library is parsed again.
+*/
+struct LipidLibraryEntry
+{
+    std::string Title;
+    std::string Version;
+    std::map<std::string , MolType> MoleculesType;
+};
+class LipidLibraryCache
+{
+public:
+    static unsigned long long Key(const std::string &text, double bondlength);
+    static bool Load(unsigned long long key, LipidLibraryEntry &entry);
+    static void Store(unsigned long long key, const LipidLibraryEntry &entry);
+
+private:
+    static std::string FileName(unsigned long long key);      // empty if TS2CG_CACHE_DIR is not set
+    static bool ReadFile(const std::string &filename, unsigned long long key, LipidLibraryEntry &entry);
+    static void WriteFile(const std::string &filename, unsigned long long key, const LipidLibraryEntry &entry);
+};
+
+#endif
@@ -0,0 +1,194 @@
+#include <stdlib.h>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include "LipidStream.h"
+#include "GroIO.h"
+#include "Parallel.h"
+#include "RigidTransform.h"
+#include "Tensor2.h"
+#include "ToolExit.h"
+
+#define STREAM_BATCH 65536          // points made at the same time (a batch has at least one tile)
+
+LipidStream::LipidStream(const PointSource *pSource, const std::map<std::string, MolType> *pMolTypes, int seed, const std::string &scratch)
+            : m_pSource(pSource),
+              m_pMolTypes(pMolTypes),
+              m_Seed(seed),
+              m_Scratch(scratch),
+              m_Beads(0),
+              m_Warning(0)
+{
+}
+LipidStream::~LipidStream()
+{
+    for (size_t i=0;i<m_Blocks.size();i++)
+    {
+        if(m_Blocks[i].pFile!=NULL)
+            fclose(m_Blocks[i].pFile);
+        remove(m_Blocks[i].File.c_str());
+    }
+}
+void LipidStream::PlaceLayer(int layer, Domain *pDomain)
+{
+    std::vector<DomainLipid*> lipids = pDomain->GetpDomainLipids();
+    int nl = lipids.size();
+    int ntile = m_pSource->GetTiles(layer);
+    long N = m_pSource->GetSize(layer);
+    if(nl==0 || N==0)
+        return;
+    Vec3D box = m_pSource->GetBox();
+    size_t first = m_Blocks.size();
+    for (int k=0;k<nl;k++)
+    {
+        std::map<std::string, MolType>::const_iterator it = m_pMolTypes->find(lipids[k]->Name);
+        if(it==m_pMolTypes->end())
+        {
+            std::cout << " \n---> error: molecule name " <<lipids[k]->Name<<" does not exist in the lib files \n";
+            ToolExit::Exit(0);
+        }
+        Block block;
+        block.pMolType = &(it->second);
+        block.File = m_Scratch+"."+std::to_string(m_Blocks.size())+".tmp";
+        block.pFile = fopen(block.File.c_str(), "w+b");
+        block.Molecules = 0;
+        if(block.pFile==NULL)
+        {
+            std::cout<<"---> error: could not open the scratch file "<<block.File<<"\n";
+            ToolExit::Exit(0);
+        }
+        m_Blocks.push_back(block);
+    }
+
+    std::vector<long> prev(nl,0), carry(nl,0);
+    for (int t0=0;t0<ntile;)
+    {
+        //=== the next tiles, up to STREAM_BATCH points, and the number of each lipid on them (in order, because of the carry)
+        int t1 = t0+1;
+        while(t1<ntile && m_pSource->GetTileStart(layer,t1+1)-m_pSource->GetTileStart(layer,t0)<=STREAM_BATCH)
+            t1++;
+        int nt = t1-t0;
+        std::vector<long> count(size_t(nt)*nl);
+        for (int t=t0;t<t1;t++)
+        {
+            long end = m_pSource->GetTileStart(layer,t+1);
+            long room = end-m_pSource->GetTileStart(layer,t);
+            for (int k=0;k<nl;k++)
+            {
+                long total = lipids[k]->MaxNo;
+                long cum = (t==ntile-1) ? total : long(double(total)*double(end)/double(N));
+                long want = cum-prev[k]+carry[k];
+                long c = std::min(want, room);
+                prev[k] = cum;
+                room -= c;
+                carry[k] = want-c;
+                count[size_t(t-t0)*nl+k] = c;
+            }
+        }
+
+        //=== the tiles in parallel, each with its own points and random number stream
+        std::vector<std::vector<double> > out(size_t(nt)*nl);
+        Parallel::For(nt, [&](int b) {
+            int t = t0+b;
+            long n = m_pSource->GetTileStart(layer,t+1)-m_pSource->GetTileStart(layer,t);
+            if(n==0)
+                return;
+            std::vector<double> c(2,0);
+            std::vector<point> points(n, point(0, 0, Vec3D(), Vec3D(), Vec3D(), Vec3D(), c));
+            m_pSource->MakeTile(layer, t, points.data());
+            std::seed_seq sq{(unsigned)m_Seed, (unsigned)(layer+1), (unsigned)t};
+            std::mt19937 rng(sq);
+            std::vector<long> order(n);
+            std::iota(order.begin(), order.end(), 0);
+            long next = 0;
+            for (int k=0;k<nl;k++)
+            {
+                const MolType &mol = *(m_Blocks[first+k].pMolType);
+                int nb = mol.X.size();
+                std::vector<double> x(nb), y(nb), z(nb);
+                std::vector<double> &xyz = out[size_t(b)*nl+k];
+                xyz.reserve(3*nb*count[size_t(b)*nl+k]);
+                for (long i=0;i<count[size_t(b)*nl+k];i++, next++)
+                {
+                    std::swap(order[next], order[std::uniform_int_distribution<long>(next, n-1)(rng)]);
+                    point &p = points[order[next]];
+                    Tensor2 GL(p.GetP1(), p.GetP2(), p.GetNormal());
+                    RigidTransform::Apply(mol.X.data(), mol.Y.data(), mol.Z.data(), nb, GL.Transpose(GL), p.GetPos(), box, x.data(), y.data(), z.data());
+                    for (int j=0;j<nb;j++)
+                    {
+                        xyz.push_back(x[j]);
+                        xyz.push_back(y[j]);
+                        xyz.push_back(z[j]);
+                    }
+                }
+            }
+        });
+
+        //=== to the scratch files in tile order
+        for (int b=0;b<nt;b++)
+            for (int k=0;k<nl;k++)
+            {
+                Block &block = m_Blocks[first+k];
+                const std::vector<double> &xyz = out[size_t(b)*nl+k];
+                if(xyz.size()>0 && fwrite(xyz.data(), sizeof(double), xyz.size(), block.pFile)!=xyz.size())
+                {
+                    std::cout<<"---> error: could not write the scratch file "<<block.File<<"\n";
+                    ToolExit::Exit(0);
+                }
+                block.Molecules += count[size_t(b)*nl+k];
+                m_Beads += xyz.size()/3;
+            }
+        t0 = t1;
+    }
+    for (int k=0;k<nl;k++)
+    {
+        lipids[k]->no_created = m_Blocks[first+k].Molecules;
+        if(carry[k]>0)
+        {
+            std::cout<<"---> Warning: "<<carry[k]<<" "<<lipids[k]->Name<<" did not fit on the points of the layer \n";
+            m_Warning++;
+        }
+    }
+}
+bool LipidStream::WriteGro(const std::string &file, const Vec3D &box)
+{
+    GroWriter gro;
+    if(!gro.Open(file," System ",m_Beads))
+    {
+        std::cout<<"---> error: could not open "<<file<<" for writing \n";
+        return false;
+    }
+    int resid = 1;
+    long atom = 0;
+    std::vector<double> xyz;
+    for (size_t i=0;i<m_Blocks.size();i++)
+    {
+        Block &block = m_Blocks[i];
+        const MolType &mol = *block.pMolType;
+        long nb = mol.Beads.size();
+        long chunk = std::max(1L, STREAM_BATCH/std::max(nb,1L));       // molecules read at a time
+        rewind(block.pFile);
+        for (long m=0;m<block.Molecules;m+=chunk)
+        {
+            long nm = std::min(chunk, block.Molecules-m);
+            xyz.resize(3*nb*nm);
+            if(fread(xyz.data(), sizeof(double), xyz.size(), block.pFile)!=xyz.size())
+            {
+                std::cout<<"---> error: could not read the scratch file "<<block.File<<"\n";
+                return false;
+            }
+            const double *x = xyz.data();
+            for (long k=0;k<nm;k++, resid++)
+                for (long j=0;j<nb;j++, x+=3)
+                {
+                    atom++;
+                    gro.Write(resid%100000, mol.Beads[j].GetResName(), mol.Beads[j].GetBeadName(), atom%100000, x[0], x[1], x[2]);
+                }
+        }
+        fclose(block.pFile);
+        block.pFile = NULL;
+        remove(block.File.c_str());
+    }
+    gro.Close(box);
+    return true;
+}
@@ -0,0 +1,56 @@
+#if !defined(AFX_LipidStream_H_5C3E21B8_C13C_5648_BF23_124095086240__INCLUDED_)
+#define AFX_LipidStream_H_5C3E21B8_C13C_5648_BF23_124095086240__INCLUDED_
+
+#include <stdio.h>
+#include <map>
+#include <string>
+#include <vector>
+#include "Vec3D.h"
+#include "Domain.h"
+#include "Data_Structure.h"
+#include "PointSource.h"
+/*
+ Weria Pezeshkian (weria.pezeshkian@gmail.com)
+ Copyright (c) Weria Pezeshkian
+ Lipid placement on an analytical shape without keeping its points (PCG -stream).
+
+ The points of a layer are made by the PointSource a batch of tiles at a time and dropped as soon
+ as the lipids on them are placed. The quota of each lipid of the domain is shared between the
+ tiles in proportion to their number of points (all points of a layer have the same area); what
+ does not fit in a tile goes to the next one. In a tile the lipids go to random points, drawn from
+ a random number stream of the seed, the layer and the tile, so the result does not depend on -nt.
+ The molecules of every lipid type are kept in a scratch file next to the gro file and copied
+ into it at the end, in the order of the topology file.
+*/
+class LipidStream
+{
+public:
+    LipidStream(const PointSource *pSource, const std::map<std::string, MolType> *pMolTypes, int seed, const std::string &scratch);
+    ~LipidStream();
+
+    // places the lipids of the domain on layer 0 (upper) or 1 (lower) and sets their no_created
+    void PlaceLayer(int layer, Domain *pDomain);
+    // writes the placed molecules as the gro file and removes the scratch files
+    bool WriteGro(const std::string &file, const Vec3D &box);
+
+    inline int  GetWarning()                    const {return m_Warning;}
+    inline long GetBeads()                      const {return m_Beads;}
+
+private:
+    struct Block                // the molecules of one lipid type of one layer
+    {
+        const MolType *pMolType;
+        std::string File;
+        FILE *pFile;            // bead coordinates, x y z as doubles
+        long Molecules;
+    };
+    const PointSource *m_pSource;
+    const std::map<std::string, MolType> *m_pMolTypes;
+    int m_Seed;
+    std::string m_Scratch;
+    std::vector<Block> m_Blocks;
+    long m_Beads;
+    int m_Warning;
+};
+
+#endif
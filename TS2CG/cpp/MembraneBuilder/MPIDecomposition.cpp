@@ -0,0 +1,128 @@
+#include <cmath>
+#include <algorithm>
+#include "MPIDecomposition.h"
+
+#define MPI_WRITE_CHUNK (1<<30)      // MPI-IO counts are int
+
+MPIDecomposition::MPIDecomposition(MPI_Comm comm)
+{
+    m_Comm = comm;
+    MPI_Comm_rank(m_Comm, &m_Rank);
+    MPI_Comm_size(m_Comm, &m_Size);
+}
+MPIDecomposition::~MPIDecomposition()
+{
+
+}
+void MPIDecomposition::SelectPoints(std::vector<point*> &up, std::vector<point*> &down, const Vec3D &box)
+{
+    int axis = 0;
+    for (int k=1;k<3;k++)
+        if(box(k)>box(axis))
+            axis = k;
+    //=== all ranks have all points, so they find the same borders without communication
+    std::vector<double> x;
+    x.reserve(up.size()+down.size());
+    for (size_t i=0;i<up.size();i++)
+        x.push_back(up[i]->GetPos()(axis));
+    for (size_t i=0;i<down.size();i++)
+        x.push_back(down[i]->GetPos()(axis));
+    if(x.empty())
+        return;
+    std::vector<double> sorted(x);
+    std::sort(sorted.begin(), sorted.end());
+    double lo = (m_Rank==0) ? -HUGE_VAL : sorted[(size_t(m_Rank)*sorted.size())/m_Size];
+    double hi = (m_Rank==m_Size-1) ? HUGE_VAL : sorted[(size_t(m_Rank+1)*sorted.size())/m_Size];
+
+    size_t nup = up.size();
+    std::vector<point*> own;
+    for (size_t i=0;i<nup;i++)
+        if(x[i]>=lo && x[i]<hi)
+            own.push_back(up[i]);
+    up.swap(own);
+    own.clear();
+    for (size_t i=0;i<down.size();i++)
+        if(x[nup+i]>=lo && x[nup+i]<hi)
+            own.push_back(down[i]);
+    down.swap(own);
+}
+void MPIDecomposition::ReconcileQuotas(std::vector<Domain*> &domains)
+{
+    std::vector<DomainLipid*> lipids;
+    for (size_t d=0;d<domains.size();d++)
+    {
+        std::vector<DomainLipid*> dl = domains[d]->GetpDomainLipids();
+        lipids.insert(lipids.end(), dl.begin(), dl.end());
+    }
+    int n = lipids.size();
+    std::vector<double> quota(n), all(size_t(n)*m_Size);
+    for (int j=0;j<n;j++)
+        quota[j] = lipids[j]->Quota;
+    MPI_Allgather(quota.data(), n, MPI_DOUBLE, all.data(), n, MPI_DOUBLE, m_Comm);
+
+    std::vector<std::pair<double,int> > remainder(m_Size);
+    for (int j=0;j<n;j++)
+    {
+        double total = 0;
+        long floors = 0;
+        for (int r=0;r<m_Size;r++)
+        {
+            double q = all[size_t(r)*n+j];
+            total += q;
+            floors += long(q);
+            remainder[r] = std::make_pair(-(q-long(q)), r);     // largest remainder first, then the lowest rank
+        }
+        long extra = long(total)-floors;
+        std::sort(remainder.begin(), remainder.end());
+        int mine = long(quota[j]);
+        for (long k=0;k<extra && k<m_Size;k++)
+            if(remainder[k].second==m_Rank)
+                mine++;
+        lipids[j]->MaxNo = mine;
+    }
+}
+long MPIDecomposition::Offset(long n) const
+{
+    long offset = 0;
+    MPI_Exscan(&n, &offset, 1, MPI_LONG, MPI_SUM, m_Comm);
+    return (m_Rank==0) ? 0 : offset;
+}
+long MPIDecomposition::Sum(long n) const
+{
+    long sum = 0;
+    MPI_Allreduce(&n, &sum, 1, MPI_LONG, MPI_SUM, m_Comm);
+    return sum;
+}
+std::vector<long> MPIDecomposition::Gather(const std::vector<long> &values) const
+{
+    std::vector<long> all((m_Rank==0) ? values.size()*m_Size : 0);
+    MPI_Gather(const_cast<long*>(values.data()), values.size(), MPI_LONG, all.data(), values.size(), MPI_LONG, 0, m_Comm);
+    return all;
+}
+bool MPIDecomposition::WriteOrdered(const std::string &file, const std::string &head, const std::string &body, const std::string &tail) const
+{
+    MPI_File fh;
+    if(MPI_File_open(m_Comm, const_cast<char*>(file.c_str()), MPI_MODE_CREATE|MPI_MODE_WRONLY, MPI_INFO_NULL, &fh)!=MPI_SUCCESS)
+        return false;
+    MPI_File_set_size(fh, 0);
+    long headsize = head.size();
+    MPI_Bcast(&headsize, 1, MPI_LONG, 0, m_Comm);
+    long offset = headsize+Offset(body.size());
+    long end = headsize+Sum(body.size());
+
+    bool ok = true;
+    MPI_Status status;
+    if(m_Rank==0)
+        ok = ok && MPI_File_write_at(fh, 0, const_cast<char*>(head.data()), head.size(), MPI_CHAR, &status)==MPI_SUCCESS;
+    for (size_t done=0;done<body.size();done+=MPI_WRITE_CHUNK)
+    {
+        int n = std::min(body.size()-done, size_t(MPI_WRITE_CHUNK));
+        ok = ok && MPI_File_write_at(fh, offset+done, const_cast<char*>(body.data()+done), n, MPI_CHAR, &status)==MPI_SUCCESS;
+    }
+    if(m_Rank==m_Size-1)
+        ok = ok && MPI_File_write_at(fh, end, const_cast<char*>(tail.data()), tail.size(), MPI_CHAR, &status)==MPI_SUCCESS;
+    MPI_File_close(&fh);
+    int good = ok ? 1 : 0, allgood = 0;
+    MPI_Allreduce(&good, &allgood, 1, MPI_INT, MPI_MIN, m_Comm);
+    return allgood==1;
+}
@@ -0,0 +1,40 @@
+#if !defined(AFX_MPIDecomposition_H_6B3D21B8_C13C_5648_BF23_124095086238__INCLUDED_)
+#define AFX_MPIDecomposition_H_6B3D21B8_C13C_5648_BF23_124095086238__INCLUDED_
+
+#include <mpi.h>
+#include "Decomposition.h"
+/*
+ Weria Pezeshkian (weria.pezeshkian@gmail.com)
+ Copyright (c) Weria Pezeshkian
+ Decomposition over MPI ranks (PCG_MPI, built with -DTS2CG_MPI=ON).
+
+ The box is cut into slabs along its longest side. The slab borders are the quantiles of the point
+ coordinates, so every rank gets about the same number of points (also for a vesicle in a large box).
+ The quota of every domain lipid is int(sum of the unrounded quotas of all ranks), as in a single run,
+ and is shared by giving each rank its rounded down quota plus one for the largest remainders.
+ Ranks r>0 use the seed + 7919 r. The gro file is written with MPI-IO, each rank at the offset given
+ by the sizes of the ranks before it.
+*/
+class MPIDecomposition : public Decomposition
+{
+public:
+    MPIDecomposition(MPI_Comm comm);
+    ~MPIDecomposition();
+
+    int GetRank()                               const {return m_Rank;}
+    int GetSize()                               const {return m_Size;}
+    void SelectPoints(std::vector<point*> &up, std::vector<point*> &down, const Vec3D &box);
+    void ReconcileQuotas(std::vector<Domain*> &domains);
+    int GetSeed(int seed)                       const {return seed+7919*m_Rank;}
+    long Offset(long n)                         const;
+    long Sum(long n)                            const;
+    std::vector<long> Gather(const std::vector<long> &values) const;
+    bool WriteOrdered(const std::string &file, const std::string &head, const std::string &body, const std::string &tail) const;
+
+private:
+    MPI_Comm m_Comm;
+    int m_Rank;
+    int m_Size;
+};
+
+#endif
@@ -0,0 +1,38 @@
+/* PCG with the lipid placement and the gro output split between MPI ranks (see MPIDecomposition.h).
+ usage: mpirun -np N PCG_MPI <the PCG options>
+ Copyright (c) Weria Pezeshkian
+ email: weria.pezeshkian@gmail.com
+ */
+#include <mpi.h>
+#include "Def.h"
+#include "Argument.h"
+#include "BackMap.h"
+#include "MPIDecomposition.h"
+
+int main(int argc, char* argv[])
+{
+    MPI_Init(&argc, &argv);
+    MPIDecomposition decomposition(MPI_COMM_WORLD);
+    // the rank 0 talks to the terminal, the others to pcg_rank<r>.txt
+    if(!decomposition.IsMaster())
+    {
+        std::string name = "pcg_rank"+std::to_string(decomposition.GetRank())+".txt";
+        if(freopen(name.c_str(), "w", stdout)==NULL)
+            MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    std::vector <std::string> argument;
+    for (long i=0;i<argc;i++)
+        argument.push_back(std::string(argv[i]));
+    argument[0] = ExecutableName;
+    {
+        Argument arg(argument);
+        if(arg.GetFunction()!="backmap" && arg.GetFunction()!="analytical_shape")
+        {
+            std::cout << arg.GetFunction() << "---> function is not recognized \n";
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        }
+        BackMap B(&arg, NULL, &decomposition);
+    }
+    MPI_Finalize();
+    return 0;
+}
@@ -5,10 +5,9 @@
 #include <math.h>
 #include "PointBasedBlueprint.h"
 #include "Def.h"
-#include "FlatPointMaker.h"
-#include "Sphere.h"
-#include "Cylinder.h"
-#include "SHGeneric1DPBCPointMaker.h"
+#include <memory>
+#include "PointSource.h"
+#include "ToolExit.h"
 
 /*
  
@@ -33,57 +32,32 @@ PointBasedBlueprint::PointBasedBlueprint(Argument *pArgu)
 
     if(function=="analytical_shape")
     {
-        std::string ftype= functiontype(ifilename);
-    
-        if(ftype == "Flat")
-        {
-            std::cout<<"---> note: Flat bilayer will be made \n";
-            FlatPointMaker  Fu(pArgu);
-            m_PointUp = Fu.GetUpPoint();
-            m_PointDown = Fu.GetInPoint();
-            m_WPointUp  = Fu.GetWallPoint1();
-            m_WPointDown  = Fu.GetWallPoint2();
-            m_Box=Fu.GetBox();
-        }
-         else if(ftype == "1D_PBC_Fourier")
-        {
-            std::cout<<"---> note: shape from 1D_PBC_Fourier will be made \n";
-            SHGeneric1DPBCPointMaker  Fu(pArgu);
-            m_PointUp = Fu.GetUpPoint();
-            m_PointDown = Fu.GetInPoint();
-            m_WPointUp  = Fu.GetWallPoint1();
-            m_WPointDown  = Fu.GetWallPoint2();
-            m_Box=Fu.GetBox();
-        }
-        else if(ftype == "Sphere")
-        {
-            std::cout<<"---> note: vesicle will be made \n";
-            Sphere  Fu(pArgu);
-            m_PointUp = Fu.GetUpPoint();
-            m_PointDown = Fu.GetInPoint();
-            m_WPointUp  = Fu.GetWallPoint1();
-            m_WPointDown  = Fu.GetWallPoint2();
-            m_Box=Fu.GetBox();
-        }
-        else if(ftype == "Cylinder")
-        {
-            std::cout<<"---> note: vesicle will be made \n";
-            Cylinder  Fu(pArgu);
-            m_PointUp = Fu.GetUpPoint();
-            m_PointDown = Fu.GetInPoint();
-            m_WPointUp  = Fu.GetWallPoint1();
-            m_WPointDown  = Fu.GetWallPoint2();
-            m_Box=Fu.GetBox();
-        }
-        else
-        {
-            std::cout<<"----> error: the shape defined in the str file is unknown :) \n";
-            std::exit(0);
-        }
+        std::unique_ptr<PointSource> shape(PointSource::New(pArgu));
+        if(shape==NULL)
+            ToolExit::Exit(0);
+        m_PointUp = shape->MakeLayer(0);
+        m_PointDown = shape->MakeLayer(1);
+        m_WPointUp  = shape->MakeLayer(2);
+        m_WPointDown  = shape->MakeLayer(3);
+        m_Box=shape->GetBox();
     }
     else
     {
         
+        if(pArgu->GetSurface()!=NULL)
+            DTSFolder.Read(*pArgu->GetSurface());
+        else if(pArgu->GetTSFile()!="")
+        {
+            // PLM in this process, its point folder stays in memory
+            std::cout<<"---> refining "<<pArgu->GetTSFile()<<" with PLM \n";
+            // the rand() streams of PLM and of PCG as they are when the two run one after the other
+            RefinedSurface surface;
+            srand(1);
+            PLMRefineSurface(pArgu->GetPLMArguments(), surface);
+            srand(pArgu->GetSeed());
+            DTSFolder.Read(surface);
+        }
+        else
         DTSFolder.Read(dtsfoldername);
         m_PointUp = DTSFolder.GetUpperPoints();
         m_PointDown = DTSFolder.GetInnerPoints();
@@ -103,7 +77,7 @@ PointBasedBlueprint::PointBasedBlueprint(Argument *pArgu)
         if (-1 == dir_err)
         {
             std::cout<<"error--> creating directory  "<<Folder<<"\n";
-            exit(1);
+            ToolExit::Exit(1);
         }
         
         ///Fabian write the point folder
@@ -117,7 +91,7 @@ PointBasedBlueprint::PointBasedBlueprint(Argument *pArgu)
 
         
         std::cout<<"---> the point folder has been written \n";
-        exit(0);
+        ToolExit::Exit(0);
     }
     
     
@@ -147,7 +121,7 @@ PointBasedBlueprint::PointBasedBlueprint(Argument *pArgu)
         {
             std::cout<<"--->error: the point id for the inclusion is out of range: \n ";
             std::cout<<" point id "<<pid<<" while # points is "<<m_pPointUp.size()<<"\n";
-            std::exit(0);
+            ToolExit::Exit(0);
         }
         
     }
@@ -162,6 +136,7 @@ PointBasedBlueprint::PointBasedBlueprint(Argument *pArgu)
     //=============== make wall; Wall info and data
         m_Wall = pArgu->GetWall();
         m_Wall.UpdateBox(m_pBox);
+        m_Wall.UpdateSeed(pArgu->GetSeed());
          if(function=="analytical_shape")
              m_Wall.CreateWall(m_pWPointUp,m_pWPointDown);
          else
@@ -181,7 +156,7 @@ PointBasedBlueprint::PointBasedBlueprint(Argument *pArgu)
             if(pointid<0 || pointid>m_pPointUp.size())
             {
                 std::cout<<"---> error point id for the exclusion is wrong \n";
-                std::exit(0);
+                ToolExit::Exit(0);
             }
 
             double R = (*it)->GetRadius();
@@ -226,62 +201,29 @@ PointBasedBlueprint::~PointBasedBlueprint()
 {
     
 }
-std::string PointBasedBlueprint::functiontype(std::string filename)
+void PointBasedBlueprint::KeepPoints(std::vector<point*> &up, std::vector<point*> &down)
 {
-    std::string ftype;
-    bool OK=true;
-    Nfunction f;
-    std::ifstream file;
-    file.open(filename.c_str());
-    bool flag = false;
-    std::string str;
-    
-    while (true)
-    {
-        std::getline (file,str);
-        if(file.eof())
-            break;
-        
-        std::vector<std::string> Line = f.split(str);
-        if(Line.size()!=0 && (Line.at(0)).at(0)!=';')
-        {
-            if((Line.at(0)).at(0)=='[' && flag==false)
-            {
-                str = f.trim(str);
-                str.erase(std::remove(str.begin(), str.end(), '['), str.end());
-                str.erase(std::remove(str.begin(), str.end(), ']'), str.end());
-                str.erase(std::remove(str.begin(), str.end(), ' '), str.end());
-                
-                if(str=="ShapeData")
-                    flag = true;
-            }
-            else if((Line.at(0))=="End" && flag==true)
-            {
-                flag=false;
-            }
-            else if(flag==true && Line.at(0)=="ShapeType")
-            {
-
-                    if(Line.size()<2)
-                        std::cout<<" Error: ShapeType information in the str file is not correct \n";
-                    else
-                    ftype = Line.at(1);
-                
-                break;
-
-            }
-            
-            
-        }
-        
-        
-    }
-    
-    
-    file.close();
-    
-
-    return ftype;
+    // the kept points are copied into new containers, so the memory of the others is given back
+    std::vector<point> keptup, keptdown;
+    keptup.reserve(up.size());
+    keptdown.reserve(down.size());
+    for (std::vector<point*>::iterator it = up.begin() ; it != up.end(); ++it)
+        keptup.push_back(**it);
+    for (std::vector<point*>::iterator it = down.begin() ; it != down.end(); ++it)
+        keptdown.push_back(**it);
+    m_PointUp.swap(keptup);
+    m_PointDown.swap(keptdown);
+
+    m_pPointUp.clear();
+    m_pPointDown.clear();
+    for (std::vector<point>::iterator it = m_PointUp.begin() ; it != m_PointUp.end(); ++it)
+        m_pPointUp.push_back(&(*it));
+    for (std::vector<point>::iterator it = m_PointDown.begin() ; it != m_PointDown.end(); ++it)
+        m_pPointDown.push_back(&(*it));
+    std::vector<point*>(m_pPointUp).swap(m_pPointUp);
+    std::vector<point*>(m_pPointDown).swap(m_pPointDown);
+    up = m_pPointUp;
+    down = m_pPointDown;
 }
 void PointBasedBlueprint::WritePointFile(int layer, std::string filename, std::vector<point> &allpoint, Vec3D box){
 
@@ -27,6 +27,8 @@ public:
     
 	PointBasedBlueprint(Argument *pArgu);
 	virtual ~PointBasedBlueprint();
+    // keeps only the points of up and down (e.g. of one MPI rank) and frees the others; up and down then point to the kept copies
+    void KeepPoints(std::vector<point*> &up, std::vector<point*> &down);
     
 
 
@@ -55,8 +57,6 @@ private:
     Wall m_Wall;
 
 private:
-    std::string functiontype(std::string filename);
-    
     void WritePointFile(int layer, std::string filename, std::vector<point>& allpoint, Vec3D box);
 };
 
@@ -0,0 +1,98 @@
+#include <algorithm>
+#include "PointSource.h"
+#include "Nfunction.h"
+#include "Parallel.h"
+#include "FlatPointMaker.h"
+#include "Sphere.h"
+#include "Cylinder.h"
+#include "SHGeneric1DPBCPointMaker.h"
+
+std::vector<point> PointSource::MakeLayer(int layer) const
+{
+    std::vector<point> points;
+    int ntile = GetTiles(layer);
+    long n = GetTileStart(layer, ntile);
+    if(n==0)
+        return points;
+    std::vector<double> c(2,0);
+    points.assign(n, point(0, 0, Vec3D(), Vec3D(), Vec3D(), Vec3D(), c));
+    Parallel::For(ntile, [&](int t) {
+        MakeTile(layer, t, points.data()+GetTileStart(layer, t));
+    });
+    return points;
+}
+PointSource *PointSource::New(Argument *pArgu)
+{
+    std::string ftype = ShapeType(pArgu->GetStructureFileName());
+    if(ftype == "Flat")
+    {
+        std::cout<<"---> note: Flat bilayer will be made \n";
+        return new FlatPointMaker(pArgu);
+    }
+    else if(ftype == "1D_PBC_Fourier")
+    {
+        std::cout<<"---> note: shape from 1D_PBC_Fourier will be made \n";
+        return new SHGeneric1DPBCPointMaker(pArgu);
+    }
+    else if(ftype == "Sphere")
+    {
+        std::cout<<"---> note: vesicle will be made \n";
+        return new Sphere(pArgu);
+    }
+    else if(ftype == "Cylinder")
+    {
+        std::cout<<"---> note: vesicle will be made \n";
+        return new Cylinder(pArgu);
+    }
+    std::cout<<"----> error: the shape defined in the str file is unknown :) \n";
+    return NULL;
+}
+std::string PointSource::ShapeType(std::string filename)
+{
+    std::string ftype;
+    Nfunction f;
+    std::ifstream file;
+    file.open(filename.c_str());
+    bool flag = false;
+    std::string str;
+
+    while (true)
+    {
+        std::getline (file,str);
+        if(file.eof())
+            break;
+
+        std::vector<std::string> Line = f.split(str);
+        if(Line.size()!=0 && (Line.at(0)).at(0)!=';')
+        {
+            if((Line.at(0)).at(0)=='[' && flag==false)
+            {
+                str = f.trim(str);
+                str.erase(std::remove(str.begin(), str.end(), '['), str.end());
+                str.erase(std::remove(str.begin(), str.end(), ']'), str.end());
+                str.erase(std::remove(str.begin(), str.end(), ' '), str.end());
+
+                if(str=="ShapeData")
+                    flag = true;
+            }
+            else if((Line.at(0))=="End" && flag==true)
+            {
+                flag=false;
+            }
+            else if(flag==true && Line.at(0)=="ShapeType")
+            {
+
+                    if(Line.size()<2)
+                        std::cout<<" Error: ShapeType information in the str file is not correct \n";
+                    else
+                    ftype = Line.at(1);
+
+                break;
+
+            }
+        }
+    }
+    file.close();
+
+    return ftype;
+}
@@ -0,0 +1,41 @@
+#if !defined(AFX_PointSource_H_5C3E21B8_C13C_5648_BF23_124095086239__INCLUDED_)
+#define AFX_PointSource_H_5C3E21B8_C13C_5648_BF23_124095086239__INCLUDED_
+
+#include <vector>
+#include <string>
+#include "Vec3D.h"
+#include "point.h"
+#include "Argument.h"
+/*
+ Weria Pezeshkian (weria.pezeshkian@gmail.com)
+ Copyright (c) Weria Pezeshkian
+ Points of an analytical shape (-function analytical_shape), made on request one tile at a time.
+
+ The layers are 0: upper monolayer, 1: lower monolayer, 2 and 3: upper and lower wall layers.
+ A tile is a ring (Sphere, Cylinder), a row (Flat) or a column along y (1D_PBC_Fourier). The tiles
+ of a layer follow the point ids: GetTileStart(layer, t) is the id of the first point of tile t and
+ GetTileStart(layer, GetTiles(layer)) the number of points, so a tile can be made without the ones
+ before it. All points of a layer have the same area.
+*/
+class PointSource
+{
+public:
+    virtual ~PointSource() {}
+
+    virtual Vec3D GetBox()                              const = 0;
+    virtual int  GetTiles(int layer)                    const = 0;
+    virtual long GetTileStart(int layer, int tile)      const = 0;
+    virtual double GetArea(int layer)                   const = 0;      // area of the whole layer
+    // writes the points of the tile to points[0], points[1], ...
+    virtual void MakeTile(int layer, int tile, point *points) const = 0;
+
+    inline long GetSize(int layer)                      const {return GetTileStart(layer, GetTiles(layer));}
+    // all points of the layer, the tiles are made in parallel
+    std::vector<point> MakeLayer(int layer) const;
+
+    // the shape named by ShapeType in the [Shape Data] of the str file; NULL if it is unknown
+    static PointSource *New(Argument *pArgu);
+    static std::string ShapeType(std::string filename);
+};
+
+#endif
@@ -50,6 +50,69 @@ void ReadDTSFolder::Read(std::string foldername)
 
 
 
+}
+void ReadDTSFolder::Read(const RefinedSurface &surface)
+{
+    Read(surface.Outer.View(), surface.Inner.View(), surface);
+}
+void ReadDTSFolder::Read(const RefinedSurfaceView &surface)
+{
+    Read(surface.Outer, surface.Inner, surface);
+}
+void ReadDTSFolder::Read(const PointLayerView &outer, const PointLayerView &inner, const SurfaceInclusions &surface)
+{
+    // the same objects Read(foldername) makes, at full precision
+    m_Box = outer.Box;
+    m_OuterPoint = PointObjects(outer,1);
+    m_InnerPoint = PointObjects(inner,-1);
+    m_Inclusion.clear();
+    m_Exclusion.clear();
+    if(surface.IncPoint.size()==0)
+    {
+        std::cout<<"--> the TS file has no inclusion, we will generate a random distribution of proteins if information is provided in STR file \n";
+    }
+    else
+    {
+        std::cout<<"--> the TS file has inclusions, we will generate proteins according to them \n";
+    }
+    for (size_t i=0;i<surface.IncPoint.size();i++)
+    {
+        Vec3D D(surface.IncDirection[3*i],surface.IncDirection[3*i+1],surface.IncDirection[3*i+2]);
+        D.normalize();
+        inclusion p(i, surface.IncType[i], surface.IncPoint[i], D);
+        m_Inclusion.push_back(p);
+    }
+    if(surface.ExcPoint.size()!=0)
+    {
+        std::cout<<"--> the TS file has exclusions, meaning the system contains pores \n";
+    }
+    for (size_t i=0;i<surface.ExcPoint.size();i++)
+    {
+        exclusion p(i, surface.ExcPoint[i], surface.ExcRadius[i]);
+        m_Exclusion.push_back(p);
+    }
+}
+std::vector<point> ReadDTSFolder::PointObjects(const PointLayerView &layer, int lay)
+{
+    std::vector<point>  AllPoint;
+    AllPoint.reserve(layer.N);
+    for (int i=0;i<layer.N;i++)
+    {
+        if(layer.Area[i]==0) {
+            std::cout<<"point id "<<layer.ID[i]<<"  has zero area \n";
+        }
+        const double *x = &layer.X[3*i], *n = &layer.Normal[3*i], *p1 = &layer.P1[3*i], *p2 = &layer.P2[3*i];
+        std::vector <double> C;
+        C.push_back(layer.C1[i]);
+        C.push_back(layer.C2[i]);
+        point p(layer.ID[i], layer.Area[i], Vec3D(x[0],x[1],x[2]), Vec3D(n[0],n[1],n[2]), Vec3D(p1[0],p1[1],p1[2]), Vec3D(p2[0],p2[1],p2[2]), C);
+        p.UpdatePointType(layer.VType!=NULL ? layer.VType[i] : 0);
+        if(lay==-1)
+        p.UpdateUpperLayer(false);
+        p.UpdateDomainID(layer.Domain[i]);
+        AllPoint.push_back(p);
+    }
+    return AllPoint;
 }
 ReadDTSFolder::~ReadDTSFolder() {
 
@@ -7,6 +7,7 @@
 #include "point.h"
 #include "inclusion.h"
 #include "exclusion.h"
+#include "RefinedSurface.h"
 
 
 class ReadDTSFolder
@@ -29,6 +30,8 @@ public:
 public:
     
     void Read(std::string foldername);
+    void Read(const RefinedSurface &surface);     // the point folder of an in-process PLM run (-TSfile)
+    void Read(const RefinedSurfaceView &surface); // points held by the caller (python module _pcg)
 
 
 
@@ -45,6 +48,8 @@ private:
 private:
     bool FileExist (const std::string &name);
     std::vector<point> ReadPointObjects(std::string file,int);
+    void Read(const PointLayerView &outer, const PointLayerView &inner, const SurfaceInclusions &incexc);
+    std::vector<point> PointObjects(const PointLayerView &layer, int lay);
     std::vector<inclusion> ReadInclusionObjects(std::string file);
     std::vector<exclusion> ReadExclusionObjects(std::string file);
 
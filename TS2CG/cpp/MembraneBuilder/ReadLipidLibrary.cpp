@@ -4,6 +4,7 @@
 #include <stdio.h>
 #include <math.h>
 #include "ReadLipidLibrary.h"
+#include "LipidLibraryCache.h"
 
 
 
@@ -23,8 +24,24 @@ ReadLipidLibrary::ReadLipidLibrary(Argument *pArgu)
 //==== File has been checked
 //=======================================================
 
-    std::ifstream LiBFile;
-    LiBFile.open(LiBfilename.c_str());
+    std::string text;
+    {
+        std::ifstream file(LiBfilename.c_str(), std::ios::binary);
+        std::ostringstream content;
+        content<<file.rdbuf();
+        text = content.str();
+    }
+    //==== a library that was already parsed with this -Bondlength comes from the cache
+    unsigned long long key = LipidLibraryCache::Key(text, m_BondLenght);
+    LipidLibraryEntry cached;
+    if(LipidLibraryCache::Load(key, cached))
+    {
+        m_LiBTitle = cached.Title;
+        m_LiBVersion = cached.Version;
+        m_MoleculesType = cached.MoleculesType;
+        return;
+    }
+    std::istringstream LiBFile(text);
     std::string str;
 //=======================================================
 //==== reading Lib File
@@ -139,12 +156,13 @@ ReadLipidLibrary::ReadLipidLibrary(Argument *pArgu)
         
         }
     }
-
-    
-
-
-
-    
+    if(m_Health==true)
+    {
+        cached.Title = m_LiBTitle;
+        cached.Version = m_LiBVersion;
+        cached.MoleculesType = m_MoleculesType;
+        LipidLibraryCache::Store(key, cached);
+    }
 }
 ReadLipidLibrary::~ReadLipidLibrary()
 {
@@ -3,6 +3,7 @@
 
 #include <stdio.h>
 #include <math.h>
+#include <algorithm>
 #include "SHGeneric1DPBCPointMaker.h"
 #include "GroFile.h"
 #include "ReadDTSFolder.h"
@@ -10,6 +11,11 @@
 #include "Def.h"
 #include "PDBFile.h"
 #include "GenDomains.h"
+#include "Parallel.h"
+
+#define CURVE_BLOCK 256             // columns per block when the columns are counted
+#define CURVE_TOLERANCE 1e-8        // relative difference of a chord and its two halves at which a piece is kept
+#define CURVE_DT 1e-4               // parameter step of the tangent and the curvature
 SHGeneric1DPBCPointMaker::SHGeneric1DPBCPointMaker(Argument *pArgu)
 {
     m_WallBox.push_back(0);
@@ -33,192 +39,204 @@ SHGeneric1DPBCPointMaker::SHGeneric1DPBCPointMaker(Argument *pArgu)
 
     //*********
 
-    m_Point1 = CalculateArea_MakePoints(1, 1/m_Density,m_Thickness/2,false);
-    m_Point2 = CalculateArea_MakePoints(-1, 1/m_Density,m_Thickness/2,false);
+    m_Layer[0] = PlanLayer(1, 1/m_Density,m_Thickness/2,false);
+    m_Layer[1] = PlanLayer(-1, 1/m_Density,m_Thickness/2,false);
 
     
-    m_WallPoint1 = CalculateArea_MakePoints(1, 1/m_WallDensityup,m_Thickness/2+Hwall,true);
-    m_WallPoint2 = CalculateArea_MakePoints(-1, 1/m_WallDensitydown,m_Thickness/2+Hwall,true);
+    m_Layer[2] = PlanLayer(1, 1/m_WallDensityup,m_Thickness/2+Hwall,true);
+    m_Layer[3] = PlanLayer(-1, 1/m_WallDensitydown,m_Thickness/2+Hwall,true);
 
 }
 SHGeneric1DPBCPointMaker::~SHGeneric1DPBCPointMaker() {
     
 }
-std::vector<point> SHGeneric1DPBCPointMaker::CalculateArea_MakePoints(int layer, double APL,double H, bool wall)
+SHGeneric1DPBCPointMaker::Layer SHGeneric1DPBCPointMaker::PlanLayer(int layer, double APL,double H, bool wall)
 {
-    std::vector<point> Cpoints;
-    double dt = 0.0002/m_Box(0);
-    int Nup = int((*m_pBox)(0)+5*H)/dt;
-    int Ndown = int(5*H/(dt));
-    
-
-    std::vector <double> C0;  // curvature of eachh point
-    std::vector<Vec3D> Pos,NormalV,T1vec,T2vec;
-    std::vector <std::vector <double> > VecCurvature;  // curvature of eachh point
-
-    std::vector<Vec3D> V1, V2,V3,V4;
-    Vec3D OLDV1;
-    Vec3D t2(0,1,0);
-
-    double xmin = 0;
-    double ymin = 0;
-    double xmax = (*m_pBox)(0);
-    double ymax = (*m_pBox)(1);
+    Layer L;
+    L.Side = layer;
+    L.H = H;
+    L.Xmin = 0;
+    L.Ymin = 0;
+    L.Xmax = (*m_pBox)(0);
+    L.Ymax = (*m_pBox)(1);
     
     if(wall==true)
     {
-        xmin = (m_WallBox.at(0))*((*m_pBox)(0));
-        xmax = (m_WallBox.at(1))*((*m_pBox)(0));
-        ymin = (m_WallBox.at(2))*((*m_pBox)(1));
-        ymax = (m_WallBox.at(3))*((*m_pBox)(1));
+        L.Xmin = (m_WallBox.at(0))*((*m_pBox)(0));
+        L.Xmax = (m_WallBox.at(1))*((*m_pBox)(0));
+        L.Ymin = (m_WallBox.at(2))*((*m_pBox)(1));
+        L.Ymax = (m_WallBox.at(3))*((*m_pBox)(1));
 
 
     }
-    
-    for (int i=-Ndown;i<Nup;i++)
-    {
-        double t = i*dt;
-        Vec3D X = F(t,layer,H);
-            V1.push_back(X);
-            Vec3D T = X-OLDV1;
-            T = T*(1/T.norm());
-            V3.push_back(T);
-            V4.push_back(t2);
-            OLDV1 = X;
-            Vec3D n = T*t2;
-            n=n*(1/n.norm());
-            if(layer==1)
-                n=n*(-1);
-            V2.push_back(n);
-            
-        
-    }
-    //double area = 0;
-    C0.push_back(0);
-    double AreaInsideBox = 0;
-    for (int i=1;i<V1.size();i++)
-    {
-        double DX = (V1.at(i))(0)-(V1.at(i-1))(0);
-        double DZ = (V1.at(i))(2)-(V1.at(i-1))(2);
-        double C = 0;
-        double curvature = 0;
-
-        if((V1.at(i))(0)>=0 && (V1.at(i))(0)<(*m_pBox)(0))
+    //=== the part of the curve inside the box, x(t0)=0 and x(t1)=Lx, and its arc length s(t)
+    double t0 = FindT(0, layer, H);
+    double t1 = FindT((*m_pBox)(0), layer, H);
+    ArcLength(layer, H, t0, t1, L.Tnode, L.Snode);
+    double Length = L.Snode.back();
+
+    L.DL = sqrt(APL);
+    int TNx = Length/L.DL;
+    if(TNx%2!=0)
+        TNx++;
+    L.DL = (TNx>0) ? Length/double(TNx) : 0;
+
+    //=== rows along y, shifted by half a row on every second column; the points in the range are counted first
+    L.Dy = sqrt(APL);
+    L.NY = m_Box(1)/L.Dy;
+    L.Dy= m_Box(1)/double(L.NY);
+    std::vector<double> X(TNx);
+    int nblock = (TNx+CURVE_BLOCK-1)/CURVE_BLOCK;
+    Parallel::For(nblock, [&](int b) {
+        int end = std::min(TNx, (b+1)*CURVE_BLOCK);
+        Vec3D N, T;
+        double C;
+        for (int i=b*CURVE_BLOCK;i<end;i++)
         {
-           AreaInsideBox+= (V1.at(i)-V1.at(i-1)).norm();
+            Vec3D P;
+            Column(L, i, P, N, T, C);
+            X[i] = P(0);
         }
-
-        if(i!=(V1.size()-1))
-        {
-
-            double angle = 0;
-            Vec3D Dr1 = V1.at(i)-V1.at(i-1);
-            Vec3D Dr2 = V1.at(i+1)-V1.at(i);
-            Vec3D TY(0,1,0);
-            
-            double cangle = Dr2.dot(Dr1,Dr2)/(Dr1.norm()*Dr2.norm());
-            
-            if(cangle>1 )
-            {
-                cangle=1;
-            }
-            else if(cangle<-1)
-            {
-             cangle=-1;
-            }
-            angle = acos(cangle);
-            if(TY.dot((Dr1*Dr2),TY)>0)
-                angle = -angle;
-            
-            double length = (Dr1).norm()+(Dr2).norm();
-            if(length==0)
+    });
+    L.First.assign(TNx+1, 0);
+    for (int i=0;i<TNx;i++)
+    {
+        int n = 0;
+        if(X[i]>=L.Xmin && X[i]<=L.Xmax)
+            for (int j=0;j<L.NY;j++)
             {
-                std::cout<<"Error: 232567 I do not know what the hell is going on \n";
+                double y=(double(j))*L.Dy+0.5*double(i%2)*L.Dy;
+                if(y>=L.Ymin && y<=L.Ymax)
+                    n++;
             }
-            
-            
-            curvature = 2*angle/length;
-            C0.push_back(curvature);
-            
-        }
+        L.First[i+1] = L.First[i]+n;
     }
-    C0.push_back(0);
-    double DL = sqrt(APL);
-    int TNx = AreaInsideBox/DL;
-    if(TNx%2!=0)
-        TNx++;
-    DL = AreaInsideBox/double(TNx);
-    
-    
-    AreaInsideBox = AreaInsideBox*(*m_pBox)(1);
-
+    L.Area = (L.First[TNx]>0) ? Length*(*m_pBox)(1)/double(L.First[TNx]) : 0;
+    return L;
 
-    Vec3D DXOLD = V1.at(0);
-    for(int i=1;i<V1.size();i++)
+}
+int SHGeneric1DPBCPointMaker::GetTiles(int layer) const
+{
+    return int(m_Layer[layer].First.size())-1;
+}
+long SHGeneric1DPBCPointMaker::GetTileStart(int layer, int tile) const
+{
+    return m_Layer[layer].First[tile];
+}
+void SHGeneric1DPBCPointMaker::MakeTile(int layer, int i, point *points) const
+{
+    const Layer &L = m_Layer[layer];
+    long n = L.First[i+1]-L.First[i];
+    if(n==0)
+        return;
+    Vec3D X, N, T;
+    double C;
+    Column(L, i, X, N, T, C);
+    std::vector <double> tc(2,0);
+    if(C>0)
+        tc[0] = C;
+    else
+        tc[1] = C;
+    Vec3D t2(0,1,0);
+    long k = 0;
+    for (int j=0;j<L.NY && k<n;j++)
     {
-        Vec3D DX = DXOLD-V1.at(i);
-        if(DX.norm()>=DL &&  (V1.at(i))(0)>=0 && (V1.at(i))(0)<(*m_pBox)(0))
-        {
-            DXOLD = V1.at(i);
-            
-            Pos.push_back(V1.at(i));
-            NormalV.push_back(V2.at(i));
-            T1vec.push_back(V3.at(i));
-            T2vec.push_back(V4.at(i));
-            
-            if(C0.at(i)>0)
-            {
-                std::vector <double> tc;
-                tc.push_back(C0.at(i));
-                tc.push_back(0);
-                VecCurvature.push_back(tc);
-            }
-            else
-            {
-                std::vector <double> tc;
-                tc.push_back(0);
-                tc.push_back(C0.at(i));
-                VecCurvature.push_back(tc);
-
-            }
-        }
+        double y=(double(j))*L.Dy+0.5*double(i%2)*L.Dy;
+        if(y<L.Ymin || y>L.Ymax)
+            continue;
+        X(1) = y;
+        points[k] = point(int(L.First[i]+k), L.Area, X, N, T, t2, tc);
+        k++;
     }
+}
+void SHGeneric1DPBCPointMaker::Column(const Layer &L, int i, Vec3D &X, Vec3D &n, Vec3D &T, double &C) const
+{
+    // position of column i on the curve, the normal, the tangent and the curvature there
+    double s = L.DL*double(i);
+    int k = std::upper_bound(L.Snode.begin(), L.Snode.end(), s)-L.Snode.begin();
+    k = std::max(1, std::min(k, int(L.Snode.size())-1));
+    double t = L.Tnode[k-1]+(L.Tnode[k]-L.Tnode[k-1])*(s-L.Snode[k-1])/(L.Snode[k]-L.Snode[k-1]);
 
-    int beadid = 0;
-    double dy = sqrt(APL);
-    int NY = m_Box(1)/dy;
-    dy= m_Box(1)/double(NY);
-    APL = AreaInsideBox/double(Pos.size()*NY);
-    for (int i=0;i<Pos.size();i++)
+    Vec3D t2(0,1,0);
+    X = F(t,L.Side,L.H);
+    Vec3D Dr1 = X-F(t-CURVE_DT,L.Side,L.H);
+    Vec3D Dr2 = F(t+CURVE_DT,L.Side,L.H)-X;
+    T = Dr1+Dr2;
+    T = T*(1/T.norm());
+    n = T*t2;
+    n=n*(1/n.norm());
+    if(L.Side==1)
+        n=n*(-1);
+    // turning angle over the two steps; positive when the curve bends away from y
+    double angle = -atan2(Vec3D::dot(Dr1*Dr2,t2), Vec3D::dot(Dr1,Dr2));
+    C = 2*angle/(Dr1.norm()+Dr2.norm());
+}
+double SHGeneric1DPBCPointMaker::FindT(double x, int layer, double H) const
+{
+    // x(t)-t is the x part of the offset, which is never more than H
+    double a = x-H-1;
+    double b = x+H+1;
+    for (int k=0;k<200 && b-a>1e-12;k++)
     {
-        for (int j=0;j<NY;j++)
+        double m = 0.5*(a+b);
+        if(F(m,layer,H)(0)<x)
+            a = m;
+        else
+            b = m;
+    }
+    return b;
+}
+void SHGeneric1DPBCPointMaker::ArcLength(int layer, double H, double t0, double t1, std::vector<double> &Tnode, std::vector<double> &Snode) const
+{
+    //=== a start grid that resolves the highest mode, then every piece is halved until its chord is as long as its two halves
+    double fmax = 1;
+    for (std::vector<Vec3D>::const_iterator modeIt = m_Modes.begin(); modeIt != m_Modes.end(); ++modeIt)
+        fmax = std::max(fmax, fabs((*modeIt)(1)));
+    int npiece = 16*int(ceil(fmax));
+    std::vector<std::vector<double> > T(npiece), S(npiece);
+    Parallel::For(npiece, [&](int p) {
+        double a = t0+(t1-t0)*double(p)/double(npiece);
+        double b = (p==npiece-1) ? t1 : t0+(t1-t0)*double(p+1)/double(npiece);
+        std::vector<double> stack(1, b);
+        Vec3D Xa = F(a,layer,H);
+        double s = 0;
+        while(!stack.empty())
         {
-                double y=(double(j))*dy+0.5*double(i%2)*dy;
-                (Pos.at(i))(1) = y;
-               if((Pos.at(i))(0)>=xmin && (Pos.at(i))(0)<=xmax && y>=ymin && y<=ymax)
-               {
-                point p(beadid, APL, Pos.at(i), NormalV.at(i), T1vec.at(i), T2vec.at(i) , VecCurvature.at(i));
-                Cpoints.push_back(p);
-                beadid++;
-               }
+            double c = stack.back();
+            Vec3D Xc = F(c,layer,H);
+            double m = 0.5*(a+c);
+            Vec3D Xm = F(m,layer,H);
+            double half = (Xm-Xa).norm()+(Xc-Xm).norm();
+            if(half-(Xc-Xa).norm()>CURVE_TOLERANCE*half && stack.size()<60)
+            {
+                stack.push_back(m);
+                continue;
+            }
+            s += half+(half-(Xc-Xa).norm())/3;      // the chord error falls as the square of the length
+            T[p].push_back(c);
+            S[p].push_back(s);
+            a = c;
+            Xa = Xc;
+            stack.pop_back();
         }
-
-    }
-
-    for (std::vector<point >::iterator it = Cpoints.begin() ; it != Cpoints.end(); ++it)
+    });
+    Tnode.assign(1, t0);
+    Snode.assign(1, 0);
+    for (int p=0;p<npiece;p++)
     {
-            it->UpdateArea(AreaInsideBox/double(Cpoints.size()));
+        double s0 = Snode.back();
+        Tnode.insert(Tnode.end(), T[p].begin(), T[p].end());
+        for (size_t i=0;i<S[p].size();i++)
+            Snode.push_back(s0+S[p][i]);
     }
-    return Cpoints;
-
 }
-Vec3D SHGeneric1DPBCPointMaker::F(double t, int layer,double H)
+Vec3D SHGeneric1DPBCPointMaker::F(double t, int layer,double H) const
 {
     double pi = acos(-1);
     Vec3D F;
     F(0) =t;
     F(2) = (*m_pBox)(2)/2;
-    for (std::vector<Vec3D>::iterator modeIt = m_Modes.begin(); modeIt != m_Modes.end(); ++modeIt) {
+    for (std::vector<Vec3D>::const_iterator modeIt = m_Modes.begin(); modeIt != m_Modes.end(); ++modeIt) {
         Vec3D mode = *modeIt;  // Store dereferenced object in a temporary variable for clarity
         double frequency = mode(1) * 2 * pi / m_Box(0);  // Calculate the frequency
         double phase = mode(2) * pi / 180;  // Convert phase angle to radians
@@ -229,13 +247,13 @@ Vec3D SHGeneric1DPBCPointMaker::F(double t, int layer,double H)
     F = F + Normal(t)*(H*double(layer)/(Normal(t)).norm());
     return F;
 }
-Vec3D SHGeneric1DPBCPointMaker::Normal(double t)  // Normal function to the mid-surface at point denoted by t
+Vec3D SHGeneric1DPBCPointMaker::Normal(double t) const  // Normal function to the mid-surface at point denoted by t
 {
     double pi = acos(-1);  // More descriptive constant for pi
     Vec3D normalVector;
     normalVector(2) = -1;  // Set initial value of the Z component
 
-    for (std::vector<Vec3D>::iterator modeIt = m_Modes.begin(); modeIt != m_Modes.end(); ++modeIt) {
+    for (std::vector<Vec3D>::const_iterator modeIt = m_Modes.begin(); modeIt != m_Modes.end(); ++modeIt) {
         Vec3D mode = *modeIt;  // Temporary variable to hold the dereferenced mode
 
         double frequency = mode(1) * 2 * pi / m_Box(0);  // Calculate the frequency
@@ -20,6 +20,7 @@
 #include "inclusion.h"
 #include "GenerateMolType.h"
 #include "Tensor2.h"
+#include "PointSource.h"
 /*
  [Shape Data]
  ShapeType 1D_PBC_Fourier
@@ -33,24 +34,39 @@
  End
  */
 
-class SHGeneric1DPBCPointMaker
+class SHGeneric1DPBCPointMaker : public PointSource
 {
 public:
     
 	SHGeneric1DPBCPointMaker(Argument *pArgu);
 	virtual ~SHGeneric1DPBCPointMaker();
     
-    inline  std::vector<point> GetWallPoint1()                const  {return m_WallPoint1;} // returns all the created wall beads
-    inline  std::vector<point> GetWallPoint2()                const  {return m_WallPoint2;} // returns all the created wall beads
+    inline  std::vector<point> GetWallPoint1()                const  {return MakeLayer(2);} // returns all the created wall beads
+    inline  std::vector<point> GetWallPoint2()                const  {return MakeLayer(3);} // returns all the created wall beads
 
-    inline  std::vector<point> GetUpPoint()                const  {return m_Point1;}    // upper monolayer beads
-    inline  std::vector<point> GetInPoint()                const  {return m_Point2;}    // inner monolayer beads
+    inline  std::vector<point> GetUpPoint()                const  {return MakeLayer(0);}    // upper monolayer beads
+    inline  std::vector<point> GetInPoint()                const  {return MakeLayer(1);}    // inner monolayer beads
 
     inline  Vec3D GetBox()                const  {return m_Box;}    // returns the box sides
 
+    int  GetTiles(int layer)                    const;
+    long GetTileStart(int layer, int tile)      const;
+    inline double GetArea(int layer)            const  {return m_Layer[layer].Area*double(GetSize(layer));}
+    void MakeTile(int layer, int tile, point *points) const;
+
 
 public:
 
+    struct Layer                    // columns along y at equal arc length of the curve
+    {
+        int Side;                   // 1 upper, -1 lower
+        double H, DL, Dy, Area;     // offset from the mid surface, column spacing, row spacing, area per point
+        double Xmin, Xmax, Ymin, Ymax;
+        int NY;
+        std::vector<double> Tnode, Snode;   // arc length table of the curve
+        std::vector<long> First;    // id of the first point of each column, the number of points at the end
+    };
+
 private:
     Vec3D *m_pBox;
     Vec3D  m_Box;   // system box size
@@ -64,17 +80,18 @@ private:
 private:
     void Initialize(std::string filename); /// Read the data from the str file.
 
-    std::vector<point> CalculateArea_MakePoints(int i, double APL,double H,bool); // a function to create the area and the beads
+    Layer PlanLayer(int i, double APL,double H,bool);  // the area of the layer and where its points go; the points are made by MakeTile
+    double FindT(double x, int layer, double H) const;    // curve parameter at which the layer reaches x
+    // nodes of the layer curve between t0 and t1, denser where it bends, and the arc length at each node
+    void ArcLength(int layer, double H, double t0, double t1, std::vector<double> &Tnode, std::vector<double> &Snode) const;
+    void Column(const Layer &L, int i, Vec3D &X, Vec3D &n, Vec3D &T, double &C) const;
 
 
     bool m_monolayer;
-    std::vector<point>  m_Point1;
-    std::vector<point>  m_Point2;
-    std::vector<point>  m_WallPoint1;
-    std::vector<point>  m_WallPoint2;
+    Layer m_Layer[4];                        // upper, lower, upper wall and lower wall
     std::vector<Vec3D>  m_Modes;
-    Vec3D F(double t,int layer, double H);
-    Vec3D Normal(double t);
+    Vec3D F(double t,int layer, double H) const;
+    Vec3D Normal(double t) const;
 
 
 
@@ -32,21 +32,21 @@ Sphere::Sphere(Argument *pArgu)
 
     //*********
 
-    m_Point1 = CalculateArea_MakePoints(1, 1/m_Density,m_Thickness/2,m_DL,false);
-    m_Point2 = CalculateArea_MakePoints(-1, 1/m_Density,m_Thickness/2,m_DL,false);
+    m_Layer[0] = PlanLayer(1, 1/m_Density,m_Thickness/2,m_DL);
+    m_Layer[1] = PlanLayer(-1, 1/m_Density,m_Thickness/2,m_DL);
 
     
-    m_WallPoint1 = CalculateArea_MakePoints(1, 1/m_WallDensityup,m_Thickness/2,Hwall,true);
-    m_WallPoint2 = CalculateArea_MakePoints(-1, 1/m_WallDensityin,m_Thickness/2, Hwall,true);
+    m_Layer[2] = PlanLayer(1, 1/m_WallDensityup,m_Thickness/2,Hwall);
+    m_Layer[3] = PlanLayer(-1, 1/m_WallDensityin,m_Thickness/2, Hwall);
 
 }
 Sphere::~Sphere()
 {
     
 }
-std::vector<point> Sphere::CalculateArea_MakePoints(int layer, double APL,double H, double DL, bool wall)
+Sphere::Layer Sphere::PlanLayer(int layer, double APL,double H, double DL)
 {
-    std::vector<point> Cpoints;
+    Layer L;
     double pi = acos(-1);
     double TotalArea = 0;
     std::vector <double> Curv;
@@ -71,55 +71,63 @@ std::vector<point> Sphere::CalculateArea_MakePoints(int layer, double APL,double
 
     int Npoints = TotalArea/APL;
     APL =  TotalArea/double(Npoints);
-    int beadid = 0;
-    double DT = FindDeltaTheta(Npoints);
+    L.Side = layer;
+    L.DT = FindDeltaTheta(Npoints);
+    L.R = m_R+double(layer)*H;
+    L.DL = DL;
+    L.Curv = Curv;
+
+    //=== the rings are known before any point is made
+    L.First.push_back(0);
     double T=0;
-    double R=m_R+double(layer)*H;
-    for (int i=0;i<=PI/DT;i++)
+    for (int i=0;i<=PI/L.DT;i++)
     {
-        T+=DT;
-        int M=2*PI*sin(T)/DT;
-        
-        
-        for (int j=0;j<M;j++)
-        {
-            double Phi=DT/sin(T)*j;
-            double x=R*cos(Phi)*sin(T);
-            double y=R*sin(Phi)*sin(T);
-            double z=R*cos(T);
-            
-            Vec3D Pos(x,y,z);
-            Vec3D N=Pos*(double(layer)/Pos.norm());
-            Vec3D BoxC(m_Box(0)/2, m_Box(1)/2, m_Box(2)/2 );
-            Pos=BoxC+Pos+N*(DL);
-            
-            Vec3D P1(-N(1),N(0),0);
-            Vec3D P2 = N*P1;
-            
-            
-            point p(beadid, APL, Pos, N, P1, P2 , Curv);
-            Cpoints.push_back(p);
-            beadid++;
-            
-
-        }
-        
+        T+=L.DT;
+        int M=2*PI*sin(T)/L.DT;
+        L.Theta.push_back(T);
+        L.First.push_back(L.First.back()+std::max(M,0));
     }
-   // std::cout<<Npoints<<"  "<<Cpoints.size()<<"\n";
-    for (std::vector<point >::iterator it = Cpoints.begin() ; it != Cpoints.end(); ++it)
+    L.Area = (L.First.back()>0) ? TotalArea/double(L.First.back()) : 0;
+    return L;
+
+}
+int Sphere::GetTiles(int layer) const
+{
+    return m_Layer[layer].Theta.size();
+}
+long Sphere::GetTileStart(int layer, int tile) const
+{
+    return m_Layer[layer].First[tile];
+}
+void Sphere::MakeTile(int layer, int tile, point *points) const
+{
+    const Layer &L = m_Layer[layer];
+    double T = L.Theta[tile];
+    Vec3D BoxC(m_Box(0)/2, m_Box(1)/2, m_Box(2)/2 );
+    for (long j=0;j<L.First[tile+1]-L.First[tile];j++)
     {
-            it->UpdateArea(TotalArea/double(Cpoints.size()));
-    }
-    return Cpoints;
+        double Phi=L.DT/sin(T)*j;
+        double x=L.R*cos(Phi)*sin(T);
+        double y=L.R*sin(Phi)*sin(T);
+        double z=L.R*cos(T);
 
+        Vec3D Pos(x,y,z);
+        Vec3D N=Pos*(double(L.Side)/Pos.norm());
+        Pos=BoxC+Pos+N*(L.DL);
+
+        Vec3D P1(-N(1),N(0),0);
+        Vec3D P2 = N*P1;
+
+        points[j] = point(int(L.First[tile]+j), L.Area, Pos, N, P1, P2 , L.Curv);
+    }
 }
 double Sphere::FindDeltaTheta(int N)
 {
-    
-    double deltaTheta=PI/2;
+    // with deltaTheta = PI/s a grid has at most 4s^2/PI points, so no s below sqrt(PI N)/2 can give more than N
+    int s = std::max(2, int(sqrt(PI*double(N))/2));
+    double deltaTheta=PI/s;
     int TotPoint=0;
-    int s=2;
-    
+
     while(true)
     {
         int M=PI/deltaTheta;
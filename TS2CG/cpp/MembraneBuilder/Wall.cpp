@@ -1,8 +1,26 @@
 
 
 #include <stdio.h>
+#include <cmath>
+#include <algorithm>
+#include <stdint.h>
 #include "Wall.h"
-#include "GenerateUnitCells.h"
+#include "Parallel.h"
+
+#define WALL_BLOCK 256          // cells handed to a thread at a time
+
+//=== the random number stream of one cell (splitmix64); most cells have a few points, so seeding an mt19937 per cell would cost more than the draw
+static inline uint64_t SplitMix(uint64_t &s)
+{
+    uint64_t z = (s += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+static inline double Uniform(uint64_t &s)       // in (0,1)
+{
+    return (double(SplitMix(s) >> 11)+0.5)/9007199254740992.0;
+}
 
 Wall::Wall()
 {
@@ -13,6 +31,7 @@ Wall::Wall()
     m_BeadName = "WL";
     m_CellSize = 3;
     m_Uniform = false;
+    m_Seed = 0;
 
 }
 Wall::~Wall()
@@ -35,6 +54,10 @@ void Wall::UpdateCellSize(double x)
 {
     m_CellSize = x;
 }
+void Wall::UpdateSeed(int x)
+{
+    m_Seed = x;
+}
 void Wall::UpdateH(double x)
 {
     m_H = x;
@@ -86,8 +109,8 @@ void Wall::CreateWall(std::vector<point*>  p1, std::vector<point*>  p2)
         std::cout<<"Note ----> Maximum wall density beads that can be created is "<<maxden<<" [particle]/nm^2, if you need more, use PLM and increase Mashno \n";
         //===== making wall beads of all availabe points
 
-        std::vector<bead> b1 = MakeUniformBeads(p1);
-        std::vector<bead> b2 = MakeUniformBeads(p2);
+        std::vector<bead> b1 = MakeUniformBeads(p1, 0);
+        std::vector<bead> b2 = MakeUniformBeads(p2, 1);
         
 
         
@@ -167,124 +190,96 @@ void Wall::Wall_itp()
     fclose (fitp);
 }
 /// This function creats a uniform bead distribution based on the given density
-std::vector<bead> Wall::MakeUniformBeads(std::vector<point*> &mypoints)
+std::vector<bead> Wall::MakeUniformBeads(std::vector<point*> &mypoints, int layer)
 {
-
-
     std::vector<bead> ReturnB;
-    int i=0;
-    int resid = 0;
-    std::vector<bead> TB;
-    for (std::vector<point*>::iterator it = mypoints.begin() ; it != mypoints.end(); ++it)
+    int npoint = mypoints.size();
+    if(m_Uniform==false)
     {
-        
-        double p_area = (*it)->GetArea();
-      
-        
-        Vec3D X=(*it)->GetPos();
-        /*if(m_Uniform==false)
+        std::cout<<" here in the wall is ok \n";
+        ReturnB.reserve(npoint);
+        for (int i=0;i<npoint;i++)
         {
-        Vec3D N=(*it)->GetNormal();
-        X=X+N*(m_H);
-        }*/
-        bead  tb(i, m_BeadName, m_BeadName, "Wall", resid,X(0), X(1),X(2));
-        TB.push_back(tb);
-        i++;
-        resid++;
-        
-
-
+            Vec3D X=mypoints[i]->GetPos();
+            ReturnB.push_back(bead(i, m_BeadName, m_BeadName, "Wall", i, X(0), X(1), X(2)));
+        }
+        return ReturnB;
     }
 
-    std::vector<bead*> pTB;
-    for (std::vector<bead>::iterator it = TB.begin() ; it != TB.end(); ++it)
-        pTB.push_back(&(*it));
-    
-    
-    
-  if(m_Uniform==true)
-  {
-    GenerateUnitCells GN(pTB,m_pBox, 1, m_CellSize);
-    GN.Generate();
-
-    std::map <std::string, UnitCell > AUC = GN.GetAllCNTCells();
-    
-
-    for (std::map <std::string, UnitCell >::iterator it = AUC.begin(); it != AUC.end(); it++)
+    //=== the points are sorted by their cell; the cells are those of GenerateUnitCells (never smaller than 1 nm)
+    double size = std::max(m_CellSize, 1.0);
+    double cellsize[3];
+    for (int k=0;k<3;k++)
+        cellsize[k] = (*m_pBox)(k)/double(std::max(1,int((*m_pBox)(k)/size)));
+    std::vector<WallSite> site(npoint);
+    for (int i=0;i<npoint;i++)
+    {
+        Vec3D X=mypoints[i]->GetPos();
+        for (int k=0;k<3;k++)
+            site[i].Cell[k] = int(X(k)/cellsize[k]);
+        site[i].ID = i;
+    }
+    std::sort(site.begin(), site.end());
+    std::vector<int> first;
+    for (int i=0;i<npoint;i++)
+        if(i==0 || !site[i-1].SameCell(site[i]))       // the first point of a cell
+            first.push_back(i);
+    int ncell = first.size();
+    first.push_back(npoint);
+
+    //=== the number of beads of each cell, and where they go in the output
+    std::vector<long> offset(ncell+1,0);
+    int capped = 0;
+    for (int c=0;c<ncell;c++)
     {
-        UnitCell tu= it->second;
-        std::vector <bead *> B = tu.GetBeadList();
         double area = 0;
-        for (std::vector<bead*>::iterator it = B.begin() ; it != B.end(); ++it)
+        for (int i=first[c];i<first[c+1];i++)
+            area+=mypoints[site[i].ID]->GetArea();
+        int n = first[c+1]-first[c];
+        int newN = (m_Density!=0) ? int(m_Density*area)+1 : 0;
+        if(newN>n)
         {
-            area+=(mypoints.at((*it)->GetID()))->GetArea();
+            newN = n;
+            capped++;
         }
-        int newN =0;
-        if(m_Density!=0 && B.size()!=0)
-        newN=int(m_Density*area)+1;
-      //  std::cout<<newN<<" area1 "<<m_Density<<"  "<<area<<" \n";
-
-        if(newN>B.size())
-        {
-            newN =B.size();
-            std::cout<<" warning, should not happen. Please report to developer with ID number wall3245643 \n";
-        }
-        double ratio = double(newN)/double(B.size());
-        // === For developer, if the number of the beads are too little this will not give the exact number
-        for (std::vector<bead*>::iterator it = B.begin() ; it != B.end(); ++it)
-            (*it)->UpdateHasMol(false);
-        
-        
-
-        int accepted = 0;
-        while(newN>accepted)
-        for (std::vector<bead*>::iterator it = B.begin() ; it != B.end(); ++it)
+        offset[c+1] = offset[c]+newN;
+    }
+    if(capped>0)
+        std::cout<<" warning, should not happen. Please report to developer with ID number wall3245643 ("<<capped<<" cells) \n";
+
+    //=== each cell takes exactly newN of its points, a weighted draw without replacement with weight = point area
+    //=== (the newN smallest -log(u)/area); every cell has its own random number stream, so the cells run in parallel
+    ReturnB.assign(offset[ncell], bead(0, m_BeadName, m_BeadName, "Wall", 0));
+    int nblock = (ncell+WALL_BLOCK-1)/WALL_BLOCK;
+    Parallel::For(nblock, [&](int b) {
+        std::vector<std::pair<double,int> > key;
+        for (int c=b*WALL_BLOCK;c<std::min(ncell,(b+1)*WALL_BLOCK);c++)
         {
-
-            int trand = rand()%100000000;
-            double prob=double(trand)/100000000.0;
-            double p_area = (mypoints.at((*it)->GetID()))->GetArea();
-          //  int id=i;
-            Vec3D X=(mypoints.at((*it)->GetID()))->GetPos();
-            Vec3D N=(mypoints.at((*it)->GetID()))->GetNormal();
-            X=X+N*(m_H);
-            (*it)->UpdatePos(X(0),X(1),X(2));
-            if(prob<p_area/area && newN>accepted && (*it)->Hasmol()==false)
+            int n = first[c+1]-first[c];
+            int newN = offset[c+1]-offset[c];
+            if(newN==0)
+                continue;
+            const int *cell = site[first[c]].Cell;
+            uint64_t rng = uint64_t(unsigned(m_Seed));
+            rng = SplitMix(rng)^uint64_t(layer+1);
+            for (int k=0;k<3;k++)
+                rng = SplitMix(rng)^uint64_t(unsigned(cell[k]));
+            key.resize(n);
+            for (int i=0;i<n;i++)
             {
-                ReturnB.push_back(*(*it));
-                accepted++;
-                (*it)->UpdateHasMol(false);
-
+                int id = site[first[c]+i].ID;
+                key[i] = std::make_pair(-std::log(Uniform(rng))/mypoints[id]->GetArea(), id);
+            }
+            std::nth_element(key.begin(), key.begin()+(newN-1), key.end());
+            std::sort(key.begin(), key.begin()+newN, [](const std::pair<double,int> &a, const std::pair<double,int> &b) {return a.second<b.second;});
+            for (int j=0;j<newN;j++)
+            {
+                int id = key[j].second;
+                Vec3D X=mypoints[id]->GetPos()+mypoints[id]->GetNormal()*(m_H);
+                ReturnB[offset[c]+j] = bead(id, m_BeadName, m_BeadName, "Wall", id, X(0), X(1), X(2));
             }
         }
-        if (accepted<newN)
-            std::cout<<newN-accepted<<"   "<<accepted<<" should have been "<<newN<<"\n";
-
-        
-     }
-    }
-    else
-    {
-        std::cout<<" here in the wall is ok \n";
-        for (std::vector<bead>::iterator it = TB.begin() ; it != TB.end(); ++it)
-        {
-
-            ReturnB.push_back(*it);
-            
-        }
-    }
+    });
 
     return ReturnB;
- 
 }
-
-
-
-
-
-
-
-
-
-
-
@@ -2,6 +2,7 @@
 #define AFX_Wall_H_894B21B8_C13C_5648_BF23_124775086234__INCLUDED_
 
 
+#include <algorithm>
 #include "Def.h"
 #include "Vec3D.h"
 #include "UnitCell.h"
@@ -29,6 +30,7 @@ public:
   void UpdateState(bool x);
   void UpdateUniform(bool x);
   void UpdateH(double x);
+  void UpdateSeed(int x);
   void UpdateDen(double x);
   void UpdateBeadName(std::string x);
   void PrintWallState();
@@ -50,7 +52,17 @@ private:
   std::string m_BeadName;
   Vec3D *m_pBox;
     double m_CellSize;
-    std::vector<bead> MakeUniformBeads(std::vector<point*> &p);
+    int m_Seed;
+    // layer 0 (upper) or 1 (inner) selects the random number streams of the cells
+    std::vector<bead> MakeUniformBeads(std::vector<point*> &p, int layer);
+
+    struct WallSite             // a point and the cell it is in, ordered by cell and then by point id
+    {
+        int Cell[3];
+        int ID;
+        bool SameCell(const WallSite &o) const  {return std::equal(Cell, Cell+3, o.Cell);}
+        bool operator<(const WallSite &o) const {return SameCell(o) ? ID<o.ID : std::lexicographical_compare(Cell, Cell+3, o.Cell, o.Cell+3);}
+    };
 
     
 
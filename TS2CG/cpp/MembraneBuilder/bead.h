@@ -16,9 +16,9 @@ public:
 
 
         inline const int GetID()                const  {return m_ID;}
-        inline double GetXPos()                        {return m_X;}
-        inline double GetYPos()                        {return m_Y;}
-        inline double GetZPos()                        {return m_Z;}
+        inline double GetXPos()                 const  {return m_X;}
+        inline double GetYPos()                 const  {return m_Y;}
+        inline double GetZPos()                 const  {return m_Z;}
         inline std::string GetBeadType()        const        {return m_BeadType;}
         inline std::string GetResName()         const        {return m_ResName;}
         inline int GetResid()         const        {return m_Resid;}
@@ -110,6 +110,68 @@ help::help(std::string exe)
                   << std::setw(15) << "bool"
                   << std::setw(20) << "false"
                   << "print less outputs\n";
+
+        std::cout << std::left << std::setw(20) << G_THREADS
+                  << std::setw(15) << "int"
+                  << std::setw(20) << "all cores"
+                  << "number of threads\n";
+
+        std::cout << std::left << std::setw(20) << G_DOMAIN_SPEC
+                  << std::setw(15) << "string"
+                  << std::setw(20) << "off"
+                  << "assign domains from curvature (DOP lipid spec file)\n";
+
+        std::cout << std::left << std::setw(20) << G_DOMAIN_K
+                  << std::setw(15) << "double"
+                  << std::setw(20) << "1.0"
+                  << "curvature preference strength\n";
+
+        std::cout << std::left << std::setw(20) << G_DOMAIN_AREA
+                  << std::setw(15) << "bool"
+                  << std::setw(20) << "false"
+                  << "weight the domain assignment with the point area\n";
+
+        std::cout << std::left << std::setw(20) << G_DOMAIN_LEAFLET
+                  << std::setw(15) << "string"
+                  << std::setw(20) << "both"
+                  << "leaflets to assign: both, outer or inner\n";
+
+        std::cout << std::left << std::setw(20) << G_RELAX
+                  << std::setw(15) << "int"
+                  << std::setw(20) << "0"
+                  << "soft-core relaxation steps after placement\n";
+
+        std::cout << std::left << std::setw(20) << G_RELAX_SIGMA
+                  << std::setw(15) << "double"
+                  << std::setw(20) << "0.4"
+                  << "closest distance between beads of different molecules\n";
+
+        std::cout << std::left << std::setw(20) << G_BATCH
+                  << std::setw(15) << "string"
+                  << std::setw(20) << "off"
+                  << "manifest of jobs: str seed defout [options]\n";
+
+        std::cout << std::left << std::setw(20) << G_BATCH_JOBS
+                  << std::setw(15) << "int"
+                  << std::setw(20) << "1"
+                  << "number of batch jobs that run at the same time\n";
+
+        std::cout << std::left << std::setw(20) << G_BATCH_MEMORY
+                  << std::setw(15) << "double"
+                  << std::setw(20) << "0"
+                  << "memory budget of the running batch jobs in MB (0: no limit)\n";
+
+        std::cout << std::left << std::setw(20) << G_STREAM
+                  << std::setw(15) << "bool"
+                  << std::setw(20) << "false"
+                  << "analytical shapes: place lipids while the points are made\n";
+
+        std::cout << std::left << std::setw(20) << G_TS_FILE
+                  << std::setw(15) << "string"
+                  << std::setw(20) << "off"
+                  << "run PLM on this TS file in this process instead of reading -dts\n";
+        std::cout << "   with -TSfile, the PLM options -bilayerThickness -AlgType -rescalefactor -ap -Mashno \n";
+        std::cout << "   -smooth -resizebox -b_dist are taken as well; with -monolayer only the upper layer is refined \n";
         std::cout << "=========================================================================== \n";
         std::cout << "basic example:  "<<ExecutableName<<" "<<G_POINT_FOLDER<<"  point "<<G_STR_FILE_TAG<<" input.str \n";
     }
@@ -5,8 +5,10 @@
  Copyright (c) Weria Pezeshkian
  */
 #include <fstream>
+#include <iterator>
 #include "CreateMashBluePrint.h"
 #include "Nfunction.h"
+#include "ToolExit.h"
 CreateMashBluePrint::CreateMashBluePrint()
 {
 }
@@ -43,6 +45,10 @@ void CreateMashBluePrint::ReadTopology(std::string file)
             Read_TSIFile(file);
 
         }
+        else if(ext=="btsi")
+        {
+            Read_BinaryTSIFile(file);
+        }
         else if(ext=="top")
         {
             Read_Mult_QFile(file);
@@ -50,6 +56,85 @@ void CreateMashBluePrint::ReadTopology(std::string file)
         }
 
 
+}
+namespace {
+// reads the next value of a binary tsi file; stops the program if the file ends before it
+template <class T> T Get(const std::vector<char> &data, size_t &pos)
+{
+    if(pos+sizeof(T)>data.size())
+    {
+        std::cout<<"---> error: the binary tsi file is shorter than its header says \n";
+        ToolExit::Exit(1);
+    }
+    T value;
+    memcpy(&value, &data[pos], sizeof(T));
+    pos += sizeof(T);
+    return value;
+}
+}
+void CreateMashBluePrint::Read_BinaryTSIFile(std::string tsifile)
+{
+    std::ifstream in(tsifile.c_str(), std::ios::binary);
+    std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    size_t pos = 8;
+    if(data.size()<pos || std::string(data.data(), 8)!=BinaryTSI_Magic)
+    {
+        std::cout<<"---> error: "<<tsifile<<" is not a binary tsi file \n";
+        ToolExit::Exit(1);
+    }
+    if(Get<int>(data, pos)!=BinaryTSI_Order)
+    {
+        std::cout<<"---> error: "<<tsifile<<" was written on a machine with another byte order \n";
+        ToolExit::Exit(1);
+    }
+    for (int k=0;k<3;k++)
+        m_Box(k) = Get<double>(data, pos);
+
+    long long n = Get<long long>(data, pos);
+    for (long long i=0;i<n;i++)
+    {
+        Vertex_Map v;
+        Get<int>(data, pos);
+        v.id=i;
+        v.include = true;
+        v.x=Get<double>(data, pos);
+        v.y=Get<double>(data, pos);
+        v.z=Get<double>(data, pos);
+        v.domain=Get<int>(data, pos);
+        m_VertexMap.push_back(v);
+    }
+    n = Get<long long>(data, pos);
+    for (long long i=0;i<n;i++)
+    {
+        Triangle_Map t;
+        t.id=Get<int>(data, pos);
+        t.v1=Get<int>(data, pos);
+        t.v2=Get<int>(data, pos);
+        t.v3=Get<int>(data, pos);
+        m_TriangleMap.push_back(t);
+    }
+    n = Get<long long>(data, pos);
+    for (long long i=0;i<n;i++)
+    {
+        Inclusion_Map inc;
+        inc.id=Get<int>(data, pos);
+        inc.tid=Get<int>(data, pos);
+        inc.vid=Get<int>(data, pos);
+        double x=Get<double>(data, pos);
+        double y=Get<double>(data, pos);
+        double norm = sqrt(x*x+y*y);
+        inc.x = x/norm; inc.y = y/norm;
+        m_InclusionMap.push_back(inc);
+    }
+    n = Get<long long>(data, pos);
+    for (long long i=0;i<n;i++)
+    {
+        Exclusion_Map tem;
+        tem.id = Get<int>(data, pos);
+        tem.vid = Get<int>(data, pos);
+        tem.R = Get<double>(data, pos);
+        m_ExclusionMap.push_back(tem);
+    }
 }
 void CreateMashBluePrint::Read_TSIFile(std::string tsifile)
 {
@@ -74,7 +159,7 @@ void CreateMashBluePrint::Read_TSIFile(std::string tsifile)
             if(S.size()<3)
             {
                 std::cout<<"---> Error, information of the box is not sufficent in the tsi file \n";
-                exit(0);
+                ToolExit::Exit(1);
             }
             else
             {
@@ -100,7 +185,7 @@ void CreateMashBluePrint::Read_TSIFile(std::string tsifile)
                 if(S.size()<4)
                 {
                     std::cout<<"error ---> information of the vertex "<<i<<" is not sufficent in the tsi file \n";
-                    exit(0);
+                    ToolExit::Exit(1);
                 }
                 else
                 {
@@ -130,7 +215,7 @@ void CreateMashBluePrint::Read_TSIFile(std::string tsifile)
                 if(S.size()<4)
                 {
                     std::cout<<"error ---> information of the triangles  "<<i<<" is not sufficent in the tsi file \n";
-                    exit(0);
+                    ToolExit::Exit(1);
                 }
                 else
                 {
@@ -155,7 +240,7 @@ void CreateMashBluePrint::Read_TSIFile(std::string tsifile)
                 if(S.size()<5)
                 {
                     std::cout<<"error ---> information of the inclusion "<<i<<" is not sufficent in the tsi file \n";
-                    exit(0);
+                    ToolExit::Exit(1);
                 }
                 else
                 {
@@ -184,7 +269,7 @@ void CreateMashBluePrint::Read_TSIFile(std::string tsifile)
                 if(S.size()<3)
                 {
                     std::cout<<"error ---> information of the exclusion at line "<<i<<" is not sufficent in the tsi file \n";
-                    exit(0);
+                    ToolExit::Exit(1);
                 }
                 Exclusion_Map tem;
                 tem.id = f.String_to_Int(S[0]);
@@ -197,7 +282,7 @@ void CreateMashBluePrint::Read_TSIFile(std::string tsifile)
         else
         {
             std::cout<<"error ---> "<<str<<" is unidentified key word for tsi file \n";
-            exit(0);
+            ToolExit::Exit(1);
         }
     }
 }
@@ -239,7 +324,7 @@ void CreateMashBluePrint::Read_Mult_QFile(std::string topfile)
         if(b.size()>3)
         {
             std::cout<<"---> Error: box information in the file "<<qfiles.at(fi)<<" is not correct "<<std::endl;
-            exit(0);
+            ToolExit::Exit(1);
         }
         // The final box size will be the largest box in all the q files
         if(m_Box(0)<f.String_to_Double(b[0]))
@@ -259,7 +344,7 @@ void CreateMashBluePrint::Read_Mult_QFile(std::string topfile)
         if(b.size()>1)
         {
             std::cout<<"----> Error: number of vertices in the file "<<qfiles.at(fi)<<" is not correct "<<std::endl;
-            exit(0);
+            ToolExit::Exit(1);
         }
         int NV = f.String_to_Int(b[0]);
         for (int i=0;i<NV;i++)
@@ -270,7 +355,7 @@ void CreateMashBluePrint::Read_Mult_QFile(std::string topfile)
             if(b.size()>5 || b.size()<4)
             {
                 std::cout<<"----> Error: Line "<<i+2<<", info of a vertex in the file "<<qfiles.at(fi)<<" is not correct.  "<<std::endl;
-                exit(0);
+                ToolExit::Exit(1);
             }
             Vertex_Map v;
             v.id=vid;
@@ -294,7 +379,7 @@ void CreateMashBluePrint::Read_Mult_QFile(std::string topfile)
         if(b.size()>1)
         {
             std::cout<<"----> Error: number of triangle in the file "<<qfiles.at(fi)<<" is not correct "<<str<<std::endl;
-            exit(0);
+            ToolExit::Exit(1);
         }
         int nt=f.String_to_Int(b[0]);
         for (int i=0;i<nt;i++)
@@ -305,7 +390,7 @@ void CreateMashBluePrint::Read_Mult_QFile(std::string topfile)
             if(b.size()>5 || b.size()<4)
             {
                 std::cout<<"----> Error: Line "<<i+2<<", info of a triangle in the file "<<qfiles.at(fi)<<" is not correct.  "<<std::endl;
-                exit(0);
+                ToolExit::Exit(1);
             }
             Triangle_Map t;
             t.id=tid;
@@ -48,6 +48,7 @@ private:
     void ReadTopology(std::string file);  // a function to generate a mesh topology using the provided files. If the restart is on, then the topology will be generated from the restart file.
     void Read_Mult_QFile(std::string);
     void Read_TSIFile(std::string topfile);
+    void Read_BinaryTSIFile(std::string topfile);   // .btsi, as written by PLM with -visformat binary/zlib
     void GenerateIncFromInputfile(); // this function generate some distribution of inclsuions based on the input file. It do this only if the topology is from q files, since the tsi file format should have inclusion inside ...
 
 private:
@@ -1,8 +1,13 @@
 
 
-
+#include <math.h>
 #include "Curvature.h"
 #include "Tensor2.h"
+#include "Parallel.h"
+#include "ToolExit.h"
+
+#define CURV_BLOCK 256          // vertices handed to a thread at a time
+
 Curvature::Curvature()
 {
 
@@ -14,187 +19,190 @@ Curvature::~Curvature()
 void Curvature::SurfVertexCurvature(vertex * pvertex)
 {
     m_pVertex=pvertex;
-    std::vector<triangle *> Ntr=m_pVertex->GetVTraingleList();
-    double Area=0.0;
-    Vec3D Normal;
-    for (std::vector<triangle *>::iterator it = Ntr.begin() ; it != Ntr.end(); ++it)
-    {
-        Vec3D v=(*it)->GetNormalVector();
-        double a=(*it)->GetArea();
-        v=v*a;
-        Normal=Normal+v;
-        Area+=a;
-    }
-    Area=Area/3.0;
-    if(Area==0)
-    {
-        std::cout<<Ntr.size()<<"\n";
-        std::string sms=" error----> vertex has a zero area \n";
-        std::cout<<sms<<"\n";
-        exit(0);
-    }
-    else if(Area<0)
-    {
-        std::string sms=" error----> vertex has a negetive area \n";
-        std::cout<<sms<<"\n";
-        exit(0);
-    }
-    double no=Normal.norm();
-    no=1.0/no;
-    Normal=Normal*no;
-    m_pVertex->UpdateNormal_Area(Normal,Area);
-        ///=======
-    //=== Shape Operator
-    //========
-    Tensor2  SV;
-    Tensor2 IT('I');
-
-    Tensor2 P=IT-IT.makeTen(Normal);
-
-    Tensor2 Pt=P.Transpose(P);
-    std::vector<links *> NLinks=m_pVertex->GetVLinkList();
-
-    // what if the edge vertex has one triangle?
-    for (std::vector<links *>::iterator it = NLinks.begin() ; it != NLinks.end(); ++it)
-    {
-       if((*it)->GetMirrorFlag()==true)
-       {
-           Vec3D ve=(*it)->GetNormal();
-           double we=ve.dot(Normal,ve);
-           Vec3D Be=(*it)->GetBe();
-           double he=(*it)->GetHe();
-           Vec3D Se = P*Be;
-
-           // ff should be 1 but just for sake of numerical errors
-           double ff=Se.norm();
-           if(ff==0)
-           {
-               std::cout<<"-----> Error: projection is zero error"<<"\n";
-               exit(0);
-           }
-           else
-           {
-               Se=Se*(1.0/ff);
-           }
-
-           Tensor2 Q=P.makeTen(Se);
-
-           SV=SV+(Q)*(we*he);
-       }//if((*it)->GetMirrorFlag()==true)
-    }
-
-
-    /*
-   // method in the paper
-    Tensor2 SV2;
-    for (std::vector<links *>::iterator it = NLinks.begin() ; it != NLinks.end(); ++it)
-    {
-       if((*it)->GetMirrorFlag()==true)
-       {
-           Vec3D ve=(*it)->GetNormal();
-           double we=ve.dot(Normal,ve);
-           Vec3D Be=(*it)->GetBe();
-           double he=(*it)->GetHe();
-           Tensor2 Se;
-           Se=(Se.makeTen(Be))*he;
-           SV2=SV2+(Pt*(Se*P))*we;
-       }//if((*it)->GetMirrorFlag()==true)
-    }
-    */
-
-    // end paper
-
-
-    ///=============
-    //==== Find Curvature and local frame
-    //=============
-
-    Tensor2 Hous = Householder(Normal);
-    Tensor2 LSV;// Local SV
-    LSV=(Hous.Transpose(Hous))*(SV*Hous);    // LSV is the curvature matrix in the local frame, the it is a 2*2 minor matrix since all the 3 component are zero.
-
-    double b=LSV(0,0)+LSV(1,1);
-    double c=LSV(0,0)*LSV(1,1)-LSV(1,0)*LSV(0,1);
-
-
-    double delta=b*b-4*c;
-    double c1,c2;
-    if(delta>0.0)
-    {
-    delta=sqrt(delta);
-    c1=b+delta;
-    c1=0.5*c1;      // c1 always will be larger then c2
-    c2=b-delta;
-    c2=0.5*c2;
-
+    std::vector<vertex *> one(1,pvertex);
+    SurfVertexCurvature(one);
+}
+void Curvature::SurfVertexCurvature(const std::vector<vertex *> &pv)
+{
+    // what comes out of a vertex: 0 ok, 1 zero area, 2 negative area, 3 zero projection, 4 no curvature (delta<0)
+    long nv = pv.size();
+    std::vector<char> status(nv,0);
+    std::vector<double> failed(nv,0);           // delta (status 4) or the number of triangles (status 1)
+
+    Parallel::For(int((nv+CURV_BLOCK-1)/CURV_BLOCK), [&](int b) {
+        long v0 = long(b)*CURV_BLOCK;
+        int n = int(std::min(long(CURV_BLOCK), nv-v0));
+
+        //=== the block outputs, one array per component
+        double N[3][CURV_BLOCK], A[CURV_BLOCK], SV[6][CURV_BLOCK];      // SV: 00 01 02 11 12 22
+        double C1[CURV_BLOCK], C2[CURV_BLOCK], LG[9][CURV_BLOCK], Delta[CURV_BLOCK];
+        char St[CURV_BLOCK];
+
+        //=== one ring of the block in CSR form: the mirrored links of vertex j are first[j]..first[j+1]
+        std::vector<int> first(n+1,0);
+        std::vector<double> ring;               // per link: normal (3), Be (3) and He
+        for (int j=0;j<n;j++)
+        {
+            const std::vector<links *> &NLinks = pv[v0+j]->GetVLinkList();
+            for (std::vector<links *>::const_iterator it = NLinks.begin() ; it != NLinks.end(); ++it)
+                if((*it)->GetMirrorFlag()==true)
+                {
+                    Vec3D ve=(*it)->GetNormal();
+                    Vec3D Be=(*it)->GetBe();
+                    double r[7] = {ve(0), ve(1), ve(2), Be(0), Be(1), Be(2), (*it)->GetHe()};
+                    ring.insert(ring.end(), r, r+7);
+                }
+            first[j+1] = ring.size()/7;
+        }
 
-    }
-    else if (fabs(delta)<0.0001)
-    {
+        //=== area, normal and shape operator of each vertex
+        for (int j=0;j<n;j++)
+        {
+            St[j] = 0;
+            const std::vector<triangle *> &Ntr = pv[v0+j]->GetVTraingleList();
+            double nx=0, ny=0, nz=0, Area=0.0;
+            for (std::vector<triangle *>::const_iterator it = Ntr.begin() ; it != Ntr.end(); ++it)
+            {
+                Vec3D t=(*it)->GetNormalVector();
+                double a=(*it)->GetArea();
+                nx=nx+t(0)*a;
+                ny=ny+t(1)*a;
+                nz=nz+t(2)*a;
+                Area+=a;
+            }
+            Area=Area/3.0;
+            if(Area<=0)
+            {
+                St[j] = (Area==0) ? 1 : 2;
+                Delta[j] = Ntr.size();
+                N[0][j]=N[1][j]=N[2][j]=0; A[j]=1;
+                SV[0][j]=SV[1][j]=SV[2][j]=SV[3][j]=SV[4][j]=SV[5][j]=0;
+                continue;
+            }
+            double no=1.0/sqrt(nx*nx+ny*ny+nz*nz);
+            nx=nx*no;
+            ny=ny*no;
+            nz=nz*no;
+            N[0][j]=nx; N[1][j]=ny; N[2][j]=nz; A[j]=Area;
+
+            // P = I - N N^T is symmetric
+            double p00=1.0-nx*nx, p01=0.0-nx*ny, p02=0.0-nx*nz;
+            double p11=1.0-ny*ny, p12=0.0-ny*nz, p22=1.0-nz*nz;
+            double s00=0, s01=0, s02=0, s11=0, s12=0, s22=0;
+            for (int l=first[j];l<first[j+1];l++)
+            {
+                const double *r = &ring[7*l];
+                double we=nx*r[0]+ny*r[1]+nz*r[2];
+                double x=p00*r[3]+p01*r[4]+p02*r[5];
+                double y=p01*r[3]+p11*r[4]+p12*r[5];
+                double z=p02*r[3]+p12*r[4]+p22*r[5];
+                // ff should be 1 but just for sake of numerical errors
+                double ff=sqrt(x*x+y*y+z*z);
+                if(ff==0)
+                {
+                    St[j] = 3;
+                    break;
+                }
+                ff=1.0/ff;
+                x=x*ff; y=y*ff; z=z*ff;
+                double w=we*r[6];
+                s00=s00+(x*x)*w; s01=s01+(x*y)*w; s02=s02+(x*z)*w;
+                s11=s11+(y*y)*w; s12=s12+(y*z)*w; s22=s22+(z*z)*w;
+            }
+            SV[0][j]=s00; SV[1][j]=s01; SV[2][j]=s02; SV[3][j]=s11; SV[4][j]=s12; SV[5][j]=s22;
+        }
 
-    c1=0.5*b;
-    c2=c1;
+        //=== Householder frame, curvature in the local frame and its eigenvectors; no calls and no jumps, so it can be vectorized
+        for (int j=0;j<n;j++)
+        {
+            double nx=N[0][j], ny=N[1][j], nz=N[2][j];
+            double z0=0+nx, z1=0+ny, z2=1.0+nz;
+            double zn=1.0/sqrt(z0*z0+z1*z1+z2*z2);
+            z0=z0*zn; z1=z1*zn; z2=z2*zn;
+            double H[9]={(1.0-z0*z0*2)*(-1), (0.0-z0*z1*2)*(-1), (0.0-z0*z2*2)*(-1),
+                         (0.0-z1*z0*2)*(-1), (1.0-z1*z1*2)*(-1), (0.0-z1*z2*2)*(-1),
+                         (0.0-z2*z0*2)*(-1), (0.0-z2*z1*2)*(-1), (1.0-z2*z2*2)*(-1)};
+            double S[9]={SV[0][j], SV[1][j], SV[2][j], SV[1][j], SV[3][j], SV[4][j], SV[2][j], SV[4][j], SV[5][j]};
+
+            // LSV = H^T (SV H); only its upper 2x2 is needed
+            double T[6];
+            for (int k=0;k<3;k++)
+                for (int c=0;c<2;c++)
+                    T[2*k+c]=((0+S[3*k]*H[c])+S[3*k+1]*H[3+c])+S[3*k+2]*H[6+c];
+            double L[4];
+            for (int r=0;r<2;r++)
+                for (int c=0;c<2;c++)
+                    L[2*r+c]=((0+H[r]*T[c])+H[3+r]*T[2+c])+H[6+r]*T[4+c];
+
+            double b=L[0]+L[3];
+            double c=L[0]*L[3]-L[2]*L[1];
+            double delta=b*b-4*c;
+            double sd=sqrt(delta>0.0 ? delta : 0.0);
+            double c1=(delta>0.0) ? 0.5*(b+sd) : ((fabs(delta)<0.0001) ? 0.5*b : 0);      // c1 always will be larger then c2
+            double c2=(delta>0.0) ? 0.5*(b-sd) : c1;
+            St[j]=(St[j]==0 && !(delta>0.0) && !(fabs(delta)<0.0001)) ? 4 : St[j];
+            Delta[j]=(St[j]==4) ? delta : Delta[j];
+
+            // The Eigenvectors can be calculated using LSV*R=c1*R
+            double p=L[0];
+            double q=L[1];
+            double size=sqrt(q*q+(c1-p)*(c1-p));
+            q=(size==0.0) ? 1 : q;
+            size=(size==0.0) ? 1 : size;
+            double E[9]={q/size, -((c1-p)/size), 0, (c1-p)/size, q/size, 0, 0, 0, 1};
+
+            // H*E transfers vectors from the local to the global frame
+            for (int r=0;r<3;r++)
+                for (int k=0;k<3;k++)
+                    LG[3*r+k][j]=((0+H[3*r]*E[k])+H[3*r+1]*E[3+k])+H[3*r+2]*E[6+k];
+            C1[j]=c1/A[j];
+            C2[j]=c2/A[j];
+        }
 
-    }
-    else
-    {
-        c1=0;
-        c2=0;
-        std::cout<<"WARNING: faild to find curvature on vertex "<<pvertex->GetVID()<<"  because delta is "<<delta<<"  c1 and c2 are set to 100 \n";
-        std::cout<<" if you face this too much, you should stop the job and .... \n";
-    }
+        //=== back to the vertices
+        for (int j=0;j<n;j++)
+        {
+            status[v0+j] = St[j];
+            if(St[j]==1 || St[j]==2)
+                failed[v0+j] = Delta[j];
+            if(St[j]!=0 && St[j]!=4)
+                continue;
+            if(St[j]==4)
+                failed[v0+j] = Delta[j];
+            vertex *v = pv[v0+j];
+            Tensor2 TransferMatLG(Vec3D(LG[0][j],LG[1][j],LG[2][j]), Vec3D(LG[3][j],LG[4][j],LG[5][j]), Vec3D(LG[6][j],LG[7][j],LG[8][j]));
+            v->UpdateNormal_Area(Vec3D(N[0][j],N[1][j],N[2][j]),A[j]);
+            v->UpdateL2GTransferMatrix(TransferMatLG);
+            v->UpdateG2LTransferMatrix(TransferMatLG.Transpose(TransferMatLG));
+            v->UpdateCurvature(C1[j],C2[j]);
+        }
+    });
 
-    // if(true) in general we do not need this, only if we have directional inclsuions
+    //=== warnings and errors in vertex order, the first error stops as before
+    for (long i=0;i<nv;i++)
     {
-    Tensor2 EigenvMat('O');
-
-    double p=LSV(0,0);
-    double q=LSV(0,1);
-
-
-    double size=sqrt(q*q+(c1-p)*(c1-p));                   // The Eigenvectors can be calculated using this equation LSV*R=c1*R
-
-
-        if(size == 0.0){
-            size = 1;
-            q = 1;
+        if(status[i]==4)
+        {
+            std::cout<<"WARNING: faild to find curvature on vertex "<<pv[i]->GetVID()<<"  because delta is "<<failed[i]<<"  c1 and c2 are set to 100 \n";
+            std::cout<<" if you face this too much, you should stop the job and .... \n";
+        }
+        else if(status[i]==1)
+        {
+            std::cout<<long(failed[i])<<"\n";
+            std::cout<<" error----> vertex has a zero area \n"<<"\n";
+            ToolExit::Exit(0);
+        }
+        else if(status[i]==2)
+        {
+            std::cout<<" error----> vertex has a negetive area \n"<<"\n";
+            ToolExit::Exit(0);
+        }
+        else if(status[i]==3)
+        {
+            std::cout<<"-----> Error: projection is zero error"<<"\n";
+            ToolExit::Exit(0);
         }
-
-    if(size == 0.0){
-        size = 1;
-        q = 1;
-    }
-
-    EigenvMat(0,0)=q/size;                                  // only one of them needs to be calculated, one is normal vector and the other is perpendicular to first one
-    EigenvMat(1,0)=(c1-p)/size;
-    EigenvMat(0,1)=-EigenvMat(1,0);
-    EigenvMat(1,1)=EigenvMat(0,0);
-    EigenvMat(2,2)=1;
-        // std::cout<<(Hous*Normal)(0)<<"   "<<(Hous*Normal)(1)<<"   "<<(Hous*Normal)(2)<<"   \n";
-
- // Tensor2 TransferMatGL=EigenvMat*Hous;   /// This matrix transfers vectors from Global coordinate to local coordinate//
- // Tensor2 TransferMatLG = TransferMatGL.Transpose(TransferMatGL);//// This matrix transfers vectors from local coordinate to global coordinate
-
-
-        ///  this is correct, We can check by applying transpose(E)*t1 = (1,0,0)
-
-     Tensor2 TransferMatLG=Hous*EigenvMat;   /// This matrix transfers vectors from local coordinate to global coordinate
-
-       /* std::cout<<"===============\n";
-        std::cout<<TransferMatLG(0,0)<<" "<<TransferMatLG(0,1)<<" "<<TransferMatLG(0,2)<<" \n";
-        std::cout<<TransferMatLG(1,0)<<" "<<TransferMatLG(1,1)<<" "<<TransferMatLG(1,2)<<" \n";
-        std::cout<<TransferMatLG(2,0)<<" "<<TransferMatLG(2,1)<<" "<<TransferMatLG(2,2)<<" \n";
-        */
-
-     Tensor2 TransferMatGL=TransferMatLG.Transpose(TransferMatLG);   /// This matrix transfers vectors from Global coordinate to local coordinate
-
-        m_pVertex->UpdateL2GTransferMatrix(TransferMatLG);
-        m_pVertex->UpdateG2LTransferMatrix(TransferMatGL);
     }
-    c1=c1/Area;
-    c2=c2/Area;
-    m_pVertex->UpdateCurvature(c1,c2);
-
 }
 void Curvature::EdgeVertexCurvature(vertex * pvertex)
 {
@@ -219,7 +227,7 @@ void Curvature::EdgeVertexCurvature(vertex * pvertex)
         std::cout<<Ntr.size()<<"\n";
         std::string sms=" error----> bad area for vertex \n";
         std::cout<<sms<<"\n";
-        exit(0);
+        ToolExit::Exit(0);
     }
     double no=Normal.norm();
     no=1.0/no;
@@ -281,47 +289,6 @@ void Curvature::EdgeVertexCurvature(vertex * pvertex)
 
 
 
-}
-Tensor2 Curvature::Householder(Vec3D N)
-{
-
-    Tensor2 Hous;
-    Vec3D Zk;
-    Zk(2)=1.0;
-    Zk=Zk+N;
-    Zk=Zk*(1.0/Zk.norm());
-
-    Tensor2 I('I');
-    Tensor2 W=Hous.makeTen(Zk);
-    Hous=(I-W*2)*(-1);
-
-    return Hous;
-
-
-
-
-    /*
-    Zk(0) = 0;Zk(1) = 0;
-    Zk(2)=1.0;
-    double SignT=1;
-    if((1+N(2))>(1-N(2)))   // 1+/-Normal(2) is always larger then 1
-    {
-     Zk=Zk+N;
-    SignT=-1;
-     }
-    else if((1+N(2))<=(1-N(2)))
-     Zk=Zk-N;
-    Zk=Zk*(1.0/Zk.norm());
-    W=Hous.makeTen(Zk);
-    Hous=(I-W*2)*(SignT);
-
-
-    std::cout<<"====== old ===========\n";
-    std::cout<<Hous(0,0)<<"   "<<Hous(0,1)<<"   "<<Hous(0,2)<<"\n";
-    std::cout<<Hous(1,0)<<"   "<<Hous(1,1)<<"   "<<Hous(1,2)<<"\n";
-    std::cout<<Hous(2,0)<<"   "<<Hous(2,1)<<"   "<<Hous(2,2)<<"\n";*/
-   // double SignT=1;
-
 }
 /// normal vector update
 Vec3D Curvature::Calculate_Vertex_Normal(vertex *pvertex)
@@ -346,13 +313,13 @@ Vec3D Curvature::Calculate_Vertex_Normal(vertex *pvertex)
         std::cout<<Ntr.size()<<"\n";
         std::string sms=" error----> vertex has a zero area \n";
         std::cout<<sms<<"\n";
-        exit(0);
+        ToolExit::Exit(0);
     }
     else if(Area<0)
     {
         std::string sms=" error----> vertex has a negetive area \n";
         std::cout<<sms<<"\n";
-        exit(0);
+        ToolExit::Exit(0);
     }
     double no=Normal.norm();
     no=1.0/no;
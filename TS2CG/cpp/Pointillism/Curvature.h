@@ -10,6 +10,10 @@
  Copyright (c) Weria Pezeshkian
  An class to obtain curvature of a single vertex
  This class only give the correct answer if the area of each triangle has been calculated correclty.
+ SurfVertexCurvature of a vertex list works on blocks of vertices (in parallel with -nt): the one ring of
+ a block is gathered into flat arrays, the shape operator is summed in a symmetric 3x3 on the stack and
+ the 2x2 eigen problem is solved in closed form for the whole block. The operations are done in the same
+ order as the Tensor2 version, so the numbers are the same; warnings and errors come in vertex order.
  */
 class Curvature
 {
@@ -21,12 +25,12 @@ public:
 public:
     
     void SurfVertexCurvature(vertex *p);
+    void SurfVertexCurvature(const std::vector<vertex *> &pv);
     void EdgeVertexCurvature(vertex *p);
 
 private:
     vertex * m_pVertex;
 private:
-    Tensor2 Householder(Vec3D N);
     Vec3D Calculate_Vertex_Normal(vertex *p);
 };
 
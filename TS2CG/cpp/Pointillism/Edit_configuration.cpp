@@ -2,6 +2,10 @@
 
 #include <time.h>
 #include <stdio.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
 #include <cstdlib>
 #include <cstdlib>
 #include "Edit_configuration.h"
@@ -13,12 +17,24 @@
 #include "Surface_Mosaicing.h"
 #include "In_OR_Out.h"
 #include "Traj_XXX.h"
+#include "PointStore.h"
+#include "PhaseReport.h"
+#include "Parallel.h"
+#include "MeshPatches.h"
+#include "PointFolderCache.h"
+#include "MeshCheck.h"
+#include "JSONString.h"
+#include "ToolExit.h"
+
+#define PATCH_HALO 2            // rings of base triangles around a patch (-patches)
+#define PATCH_RECORD 17         // doubles per point in the scratch file
+#define PATCH_CHUNK 65536       // points written to the .dat file at a time
 
 
 /*
  This has been updated in Sept 2023. This software is now both backmapping and also input generator.
  */
-Edit_configuration::Edit_configuration( std::vector <std::string> Arguments) :
+Edit_configuration::Edit_configuration() :
                     m_LessOutPut (false),           // print as you wish
                     m_smooth (false),               // Smoothing flag
                     m_Folder("point"),               // Default output folder name
@@ -29,9 +45,18 @@ Edit_configuration::Edit_configuration( std::vector <std::string> Arguments) :
                     m_BilayerThickness(3.8),       // Default bilayer thickness
                     m_Iteration(1),               // Default degree of meshing
                     m_calculate_iteration(true),
+                    m_InMemory(false),
+                    m_Patches(0),                 // refine the whole layer at once
+                    m_CacheSize(-1),              // no cache
+                    m_VisFormat("ascii"),         // text vtu and tsi files
+                    m_VisLevel(-1),               // visualisation from the finest mesh
+                    m_VertexFormat("csv"),
                     m_MeshFileName("TS.q"),        // Default mesh file name
                     m_AP(0.62),                    // Default area per lipid
                     m_BoxDist(4)
+{
+}
+Edit_configuration::Edit_configuration( std::vector <std::string> Arguments) : Edit_configuration()
 {
     // Initialize the Variables to their default values
     InitializeVariables();
@@ -39,7 +64,7 @@ Edit_configuration::Edit_configuration( std::vector <std::string> Arguments) :
     UpdateVariables(Arguments);
     if(!ValidateVariable()){
         std::cout << "---> error: bad inputs.\n";
-        exit(0);
+        ToolExit::Exit(0);
     }
     
     
@@ -53,6 +78,18 @@ Edit_configuration::Edit_configuration( std::vector <std::string> Arguments) :
   {
         check(m_MeshFileName);
   }
+  else if(m_TaskName=="validate")
+  {
+        // streams the TS file once, without the mesh objects; the result goes to the screen as JSON
+        MeshCheck validate(m_MeshFileName);
+        validate.WriteJSON(stdout);
+        // the exit code makes validate usable as a gate in scripts
+        if(!validate.GetValid())
+        {
+            fflush(stdout);
+            ToolExit::Exit(1);
+        }
+  }
   else if(m_TaskName=="minimize")
   {
         Minimize(m_MeshFileName);
@@ -64,29 +101,102 @@ Edit_configuration::Edit_configuration( std::vector <std::string> Arguments) :
   }
   else if (m_TaskName=="PLM")
   {
+        PhaseReport::Get().Start("PLM");
         double H=m_BilayerThickness/2.0;
         const int dir_err = system(("mkdir -p "+m_Folder).c_str());
         if (-1 == dir_err)
         {
             std::cout<<"error--> creating directory  "<<m_Folder<<"\n";
-            exit(1);
+            ToolExit::Exit(1);
         }
         if(!m_LessOutPut){
           const int dir_err2 = system(("mkdir -p "+m_Folder+"visualization_data").c_str());
           if (-1 == dir_err2)
           {
             std::cout<<"error--> creating directory  visualization_data"<<"\n";
-            exit(1);
+            ToolExit::Exit(1);
           }
         }
+        PointFolderCache cache(m_MeshFileName, CacheOptions(), m_CacheSize);
+        if(m_CacheSize>=0 && !cache.GetState())
+        {
+            std::cout<<"---> warning: -cache is ignored, the environment variable TS2CG_CACHE_DIR (the cache folder) is not set \n";
+            m_CacheSize = -1;
+        }
+        if(m_CacheSize>=0)
+            cache.Release(m_Folder, !m_LessOutPut);    // never write through a link into the cache
+        if(m_CacheSize>=0 && cache.Fetch(m_Folder, !m_LessOutPut))
+        {
+            std::cout<<"---> the point folder is taken from the cache "<<cache.GetEntry()<<"\n";
+        }
+        else
+        {
                 BackMapOneLayer(1 , m_MeshFileName, H);
                 if(m_monolayer==0)
                 BackMapOneLayer(-1 , m_MeshFileName, H);
+                if(m_CacheSize>=0)
+                cache.Store(m_Folder, !m_LessOutPut);
+        }
+        PhaseReport::Get().Write("plm_report.json");    // next to plm.log
   }
   else {
       std::cout<<" error--> unrecognized Task \n";
   }
 }
+Edit_configuration::Edit_configuration(const std::vector <std::string> &Arguments, const MeshBluePrint &blueprint, PointLayer &outer, PointLayer &inner) : Edit_configuration()
+{
+    // in-process use (python module): same options as the command line, the mesh comes from memory and nothing is written
+    m_InMemory = true;
+    m_LessOutPut = true;
+    InitializeVariables();
+    UpdateVariables(Arguments);
+    if(!ValidateVariable()){
+        std::cout << "---> error: bad inputs.\n";
+        ToolExit::Exit(1);
+    }
+    RefinedSurface surface;
+    RefineInMemory(blueprint, surface);
+    outer = std::move(surface.Outer);
+    inner = std::move(surface.Inner);
+}
+Edit_configuration::Edit_configuration(const std::vector <std::string> &Arguments, RefinedSurface &surface) : Edit_configuration()
+{
+    // in-process use (PCG -TSfile): the mesh is read from the TS file, the point folder stays in memory
+    m_InMemory = true;
+    m_LessOutPut = true;
+    InitializeVariables();
+    UpdateVariables(Arguments);
+    if(!ValidateVariable()){
+        std::cout << "---> error: bad inputs.\n";
+        ToolExit::Exit(0);
+    }
+    if (!Nfunction::FileExist(m_MeshFileName)) {
+        std::cout << "---> error: TS file " << m_MeshFileName << " does not exist in the folder.\n";
+        ToolExit::Exit(0);
+    }
+    CreateMashBluePrint BluePrint;
+    MeshBluePrint meshblueprint = BluePrint.MashBluePrintFromInput_Top(m_MeshFileName,m_MeshFileName);
+    RefineInMemory(meshblueprint, surface);
+}
+void Edit_configuration::RefineInMemory(const MeshBluePrint &blueprint, RefinedSurface &surface)
+{
+    double H=m_BilayerThickness/2.0;
+    {
+        MESH Mesh;
+        std::vector <Surface_Mosaicing> Vmos;
+        MESH *pMesh = RefineLayer(blueprint, 1, H, Mesh, Vmos);
+        GetPointLayer(pMesh, 1, surface.Outer);
+        GetIncExcData(pMesh, surface);
+    }
+    surface.Inner.clear();
+    if(m_monolayer==0)
+    {
+        MESH Mesh;
+        std::vector <Surface_Mosaicing> Vmos;
+        MESH *pMesh = RefineLayer(blueprint, -1, H, Mesh, Vmos);
+        GetPointLayer(pMesh, -1, surface.Inner);
+    }
+}
 Edit_configuration::~Edit_configuration()
 {
 
@@ -129,8 +239,7 @@ void  Edit_configuration::UpdateGeometry(MESH *pmesh)
             (*it)->UpdateShapeOperator(m_pBox);
     }
     //======= Prepare vertex:  area and normal vector and curvature of surface vertices not the edge one
-    for (std::vector<vertex *>::iterator it = (pmesh->m_pSurfV).begin() ; it != (pmesh->m_pSurfV).end(); ++it)
-        CurvatureCalculations.SurfVertexCurvature(*it);
+    CurvatureCalculations.SurfVertexCurvature(pmesh->m_pSurfV);
     //====== edge links should be updated
     for (std::vector<links *>::iterator it = (pmesh->m_pEdgeL).begin() ; it != (pmesh->m_pEdgeL).end(); ++it)
             (*it)->UpdateEdgeVector(m_pBox);
@@ -186,14 +295,20 @@ void Edit_configuration::VertexInfo(std::string file){
     m_pBox=m_pMesh->m_pBox;
     
         UpdateGeometry(m_pMesh);
+        if(!m_VertexList.empty())
+        {
+            // batch mode (-vertices): all requested vertices from the same geometry, into one file
+            WriteVertexInfo(VertexIDs(m_VertexList, (m_pMesh->m_pActiveV).size()));
+            return;
+        }
         int index;
         std::cout<<" Please provide the index of the vertex (note, it will start from zero): \n";
         std::cin>>index;
         
-        if(index<0 || index>(m_pMesh->m_pActiveV).size())
+        if(index<0 || size_t(index)>=(m_pMesh->m_pActiveV).size())
         {
             std::cout<<" ---> error:the index number is invalid \n";
-            exit(0);
+            ToolExit::Exit(0);
         }
         vertex *pv = (m_pMesh->m_pActiveV).at(index);
         
@@ -203,7 +318,6 @@ void Edit_configuration::VertexInfo(std::string file){
         double z = pv->GetVZPos();
         double A = pv->GetArea();
         Tensor2  L2GT = pv->GetL2GTransferMatrix();
-        Tensor2  G2LT = pv->GetG2LTransferMatrix();
         Vec3D normal  = pv->GetNormalVector();
         std::vector <double> C = pv->GetCurvature();
         
@@ -223,6 +337,128 @@ void Edit_configuration::VertexInfo(std::string file){
         std::cout<<" normal "<<N(0)<<"  "<<N(1)<<"  "<<N(2)<<" \n ";
 }
 
+std::vector<int> Edit_configuration::VertexIDs(const std::string &list, int nv)
+{
+    std::vector<int> ids;
+    if(list=="all")
+    {
+        for (int i=0;i<nv;i++)
+            ids.push_back(i);
+        return ids;
+    }
+    // a file of ids, or ids and ranges separated by commas; the ids of a file may also be ranges
+    std::string text = list;
+    if(Nfunction::FileExist(list))
+    {
+        std::ifstream in(list.c_str());
+        std::stringstream all;
+        all<<in.rdbuf();
+        text = all.str();
+    }
+    std::replace(text.begin(), text.end(), ',', ' ');
+    std::istringstream items(text);
+    std::string item;
+    while(items>>item)
+    {
+        size_t dash = item.find('-', 1);
+        char *end1 = NULL, *end2 = NULL;
+        long first = strtol(item.c_str(), &end1, 10);
+        long last = first;
+        if(dash!=std::string::npos)
+            last = strtol(item.c_str()+dash+1, &end2, 10);
+        bool good = (dash==std::string::npos) ? (*end1=='\0') : (end1==item.c_str()+dash && *end2=='\0');
+        if(!good || first>last)
+        {
+            std::cout<<"---> error: "<<item<<" is not a vertex id or a range of ids (first-last) \n";
+            ToolExit::Exit(0);
+        }
+        if(first<0 || last>=nv)
+        {
+            std::cout<<"---> error: vertex "<<((first<0) ? first : last)<<" does not exist, the ids go from 0 to "<<nv-1<<" \n";
+            ToolExit::Exit(0);
+        }
+        for (long i=first;i<=last;i++)
+            ids.push_back(i);
+    }
+    return ids;
+}
+void Edit_configuration::WriteVertexInfo(const std::vector<int> &ids)
+{
+    std::vector<vertex *> &V = m_pMesh->m_pActiveV;
+    // position, area, normal, T1, T2, C1 and C2 of the vertex, 15 numbers; edge vertices have no curvature (NaN)
+    auto values = [&](int i, double *r) {
+        vertex *pv = V[ids[i]];
+        Tensor2 L2GT = pv->GetL2GTransferMatrix();
+        Vec3D normal = pv->GetNormalVector();
+        Vec3D T1 = L2GT*Vec3D(1,0,0);
+        Vec3D T2 = L2GT*Vec3D(0,1,0);
+        std::vector <double> C = pv->GetCurvature();
+        if(C.size()<2)
+            C.assign(2, std::numeric_limits<double>::quiet_NaN());
+        double v[15] = {pv->GetVXPos(), pv->GetVYPos(), pv->GetVZPos(), pv->GetArea(), normal(0), normal(1), normal(2),
+                        T1(0), T1(1), T1(2), T2(0), T2(1), T2(2), C[0], C[1]};
+        std::copy(v, v+15, r);
+    };
+    std::string file = "vertexinfo."+std::string((m_VertexFormat=="binary") ? "bin" : m_VertexFormat);
+    FILE *out = fopen(file.c_str(), (m_VertexFormat=="binary") ? "wb" : "w");
+    if(out==NULL)
+    {
+        std::cout<<"---> error: can not open "<<file<<"\n";
+        ToolExit::Exit(0);
+    }
+    if(m_VertexFormat=="csv")
+    {
+        fprintf(out, "id,x,y,z,area,nx,ny,nz,t1x,t1y,t1z,t2x,t2y,t2z,c1,c2\n");
+        Parallel::Write(out, ids.size(), [&](int i, std::string &text) {
+            double r[15];
+            values(i, r);
+            char line[512];
+            text.append(line, snprintf(line, sizeof(line), "%d", ids[i]));
+            for (int k=0;k<15;k++)
+                text.append(line, snprintf(line, sizeof(line), ",%.10g", r[k]));
+            text += "\n";
+        });
+    }
+    else if(m_VertexFormat=="json")
+    {
+        fprintf(out, "{\n  \"file\": %s,\n  \"vertices\": [", JSONString(m_MeshFileName).c_str());
+        Parallel::Write(out, ids.size(), [&](int i, std::string &text) {
+            double r[15];
+            values(i, r);
+            char line[768];
+            text.append(line, snprintf(line, sizeof(line), "%s\n    {\"id\": %d, \"position\": [%.10g, %.10g, %.10g], \"area\": %.10g, \"normal\": [%.10g, %.10g, %.10g], "
+                        "\"t1\": [%.10g, %.10g, %.10g], \"t2\": [%.10g, %.10g, %.10g]", (i==0) ? "" : ",", ids[i],
+                        r[0], r[1], r[2], r[3], r[4], r[5], r[6], r[7], r[8], r[9], r[10], r[11], r[12]));
+            // JSON has no NaN, the curvature of an edge vertex is null
+            for (int k=13;k<15;k++)
+            {
+                if(std::isnan(r[k]))
+                    text.append(line, snprintf(line, sizeof(line), ", \"c%d\": null", k-12));
+                else
+                    text.append(line, snprintf(line, sizeof(line), ", \"c%d\": %.10g", k-12, r[k]));
+            }
+            text += "}";
+        });
+        fprintf(out, "\n  ]\n}\n");
+    }
+    else
+    {
+        // layout in SimDef.h (VertexInfo_Magic), the doubles in the order of the csv columns
+        int order = BinaryTSI_Order;
+        long long n = ids.size();
+        fwrite(VertexInfo_Magic, 1, 8, out);
+        fwrite(&order, sizeof(int), 1, out);
+        fwrite(&n, sizeof(long long), 1, out);
+        Parallel::Write(out, ids.size(), [&](int i, std::string &text) {
+            double r[15];
+            values(i, r);
+            text.append((const char*)&ids[i], sizeof(int));
+            text.append((const char*)r, 15*sizeof(double));
+        });
+    }
+    fclose(out);
+    std::cout<<"---> the geometry of "<<ids.size()<<" vertices is written to "<<file<<"\n";
+}
 
 /// ====== Updates in 2025
 void Edit_configuration::UpdateVariables(const std::vector<std::string>& Arguments) {
@@ -233,15 +469,18 @@ void Edit_configuration::UpdateVariables(const std::vector<std::string>& Argumen
     for (size_t i = 1; i < Arguments.size(); ++i) {
         if (Arguments[i] == Def_HelpCall) {
             help helpmessage(SoftWareVersion, Arguments[0]);
-            exit(0);  // Exit without generating a log file
+            ToolExit::Exit(0);  // Exit without generating a log file
         }
     }
 
-    // Open log file
-    std::ofstream log("plm.log");
-    if (!log.is_open()) {
-        std::cout << "---> error: Could not open log file.\n";
-        return;
+    // Open log file (not for in-process runs)
+    std::ofstream log;
+    if (!m_InMemory) {
+        log.open("plm.log");
+        if (!log.is_open()) {
+            std::cout << "---> error: Could not open log file.\n";
+            return;
+        }
     }
 
     // Log the command used to generate outputs
@@ -288,6 +527,20 @@ void Edit_configuration::UpdateVariables(const std::vector<std::string>& Argumen
             } else if (Arguments[i] == Def_PrintLessPutput) {
                     m_LessOutPut = true;
                     --i;  // No additional argument for this flag
+            } else if (Arguments[i] == Def_Threads) {
+                Parallel::SetThreads(f.String_to_Int(Arguments.at(i + 1)));
+            } else if (Arguments[i] == Def_Patches) {
+                m_Patches = f.String_to_Int(Arguments.at(i + 1));
+            } else if (Arguments[i] == Def_Cache) {
+                m_CacheSize = f.String_to_Double(Arguments.at(i + 1));
+            } else if (Arguments[i] == Def_VisFormat) {
+                m_VisFormat = Arguments.at(i + 1);
+            } else if (Arguments[i] == Def_VisLevel) {
+                m_VisLevel = f.String_to_Int(Arguments.at(i + 1));
+            } else if (Arguments[i] == Def_Vertices) {
+                m_VertexList = Arguments.at(i + 1);
+            } else if (Arguments[i] == Def_VertexFormat) {
+                m_VertexFormat = Arguments.at(i + 1);
             } else {
                 std::string error = "---> error: Unrecognized argument < " + Arguments[i] + " >";
                 v_error.push_back(error);
@@ -308,16 +561,16 @@ void Edit_configuration::UpdateVariables(const std::vector<std::string>& Argumen
             log << v_error[i] << "\n";
         }
         log.close();
-        exit(0);
+        ToolExit::Exit(0);
     }
 
     // Validate TS file existence
-    if (!Nfunction::FileExist(m_MeshFileName)) {
+    if (!m_InMemory && !Nfunction::FileExist(m_MeshFileName)) {
         std::string error = "---> error: TS file " + m_MeshFileName + " does not exist in the folder.";
         std::cout << error << "\n";
         log << error << "\n";
         log.close();
-        exit(0);
+        ToolExit::Exit(0);
     }
 
     log.close();
@@ -337,6 +590,32 @@ bool Edit_configuration::ValidateVariable(){
         std::cout << "---> error: monolayer should be either 0, or 1, it is set to = "<<m_monolayer<<" \n";
         return false;
     }
+    if (m_Patches < 0 ) {
+        std::cout << "---> error: the number of patches should not be negative. \n";
+        return false;
+    }
+    if (m_VisFormat != "ascii" && m_VisFormat != "binary" && m_VisFormat != "zlib") {
+        std::cout << "---> error: -visformat should be ascii, binary or zlib, it is set to = "<<m_VisFormat<<" \n";
+        return false;
+    }
+    if (m_VisLevel < -1 ) {
+        std::cout << "---> error: -vislevel should be -1 (the finest mesh) or a number of mosaicing rounds. \n";
+        return false;
+    }
+    if (m_VertexFormat != "csv" && m_VertexFormat != "json" && m_VertexFormat != "binary") {
+        std::cout << "---> error: -vertexformat should be csv, json or binary, it is set to = "<<m_VertexFormat<<" \n";
+        return false;
+    }
+    if (!m_VertexList.empty() && m_TaskName != "vertexinfo") {
+        std::cout << "---> error: -vertices can only be used with -r vertexinfo. \n";
+        return false;
+    }
+#if !defined(TS2CG_ZLIB)
+    if (m_VisFormat == "zlib") {
+        std::cout << "---> error: this PLM was built without zlib, use -visformat binary. \n";
+        return false;
+    }
+#endif
     if (m_AP <= 0 ) {
         std::cout << "---> error: area per molecules should be larger then zero. \n";
         return false;
@@ -355,6 +634,14 @@ bool Edit_configuration::ValidateVariable(){
 
     return true;
 }
+std::string Edit_configuration::CacheOptions()
+{
+    std::ostringstream options;
+    options.precision(17);
+    options<<m_BilayerThickness<<" "<<m_Zoom(0)<<" "<<m_Zoom(1)<<" "<<m_Zoom(2)<<" "<<(m_calculate_iteration ? -1 : m_Iteration)<<" ";
+    options<<m_AP<<" "<<m_MosAlType<<" "<<m_smooth<<" "<<m_FindnewBox<<" "<<m_BoxDist<<" "<<m_monolayer<<" "<<m_Patches<<" "<<m_VisFormat<<" "<<m_VisLevel;
+    return options.str();
+}
 void Edit_configuration::InitializeVariables() {
     // Initialize variables with default values
     m_Zoom(0) = 1;                  // Default zoom factor in x-direction
@@ -487,18 +774,19 @@ void Edit_configuration::UpdateBoxSize(MESH* pmesh, double edge_distance)
 }
 //=== the backmapping function
 //==================================
-void Edit_configuration::BackMapOneLayer(int layer , std::string file, double H)
+int Edit_configuration::PrepareLayer(const MeshBluePrint &meshblueprint, int layer, double H, MESH &Mesh)
 {
-    
+    PhaseReport &report = PhaseReport::Get();
 //----> generating the mesh
-    CreateMashBluePrint BluePrint;
-    MeshBluePrint meshblueprint;
-    meshblueprint = BluePrint.MashBluePrintFromInput_Top(file,file);
-    MESH Mesh;
+    report.Begin("mesh generation");
     Mesh.GenerateMesh(meshblueprint);
     MESH *pMesh =&Mesh;
     // Mesh is ready
     m_pBox=pMesh->m_pBox;
+    report.Count("vertices", (pMesh->m_pActiveV).size());
+    report.Count("triangles", (pMesh->m_pActiveT).size());
+    report.End();
+    report.Begin("geometry update");
     Rescaling(m_Zoom,pMesh);
     UpdateGeometry(pMesh);
     
@@ -540,8 +828,17 @@ void Edit_configuration::BackMapOneLayer(int layer , std::string file, double H)
         (*it)->UpdateVZPos(z);
     }
     UpdateGeometry(pMesh);
+    report.Count("vertices", (pMesh->m_pActiveV).size());
+    report.End();
+    return Iteration;
+}
+MESH *Edit_configuration::RefineLayer(const MeshBluePrint &meshblueprint, int layer, double H, MESH &Mesh, std::vector <Surface_Mosaicing> &Vmos)
+{
+    PhaseReport &report = PhaseReport::Get();
+    int Iteration = PrepareLayer(meshblueprint, layer, H, Mesh);
+    MESH *pMesh = &Mesh;
 //-----------> increasing the number of points, i.e., vertices
-    std::vector <Surface_Mosaicing> Vmos;
+    Vmos.clear();
     for (int j=0;j<Iteration;j++)
     {
         Surface_Mosaicing  MOS(m_MosAlType,m_smooth);
@@ -553,139 +850,91 @@ void Edit_configuration::BackMapOneLayer(int layer , std::string file, double H)
         std::cout<<" Iteration number "<<j+1<<" total is "<<Iteration<<"\n";
 
         // Here will cause error when
+        ScopedPhase phase("mosaicing round "+std::to_string(j+1));
         (Vmos.at(j)).PerformMosaicing(pMesh);
         pMesh = (Vmos.at(j)).m_pMesh;
+        report.Count("vertices", (pMesh->m_pActiveV).size());
+        report.Count("triangles", (pMesh->m_pActiveT).size());
     }
   
     m_pBox = pMesh->m_pBox;
-
-    double Lx=(*m_pBox)(0);
-    double Ly=(*m_pBox)(1);
-    double Lz=(*m_pBox)(2);
-   
-    if(!m_LessOutPut) {
-        Vec3D BoxSides=(*m_pBox);
-        std::string filename;
-        
-        if(layer==1)
-        filename=m_Folder+"visualization_data/Upper";
-        if(layer==-1)
-        filename=m_Folder+"visualization_data/Lower";
-        VMDOutput GRO(BoxSides, pMesh->m_pActiveV , pMesh->m_pActiveL, filename);
-        GRO.WriteGro();
-        GRO.WriteGro2();
-        WriteFiles vtu(m_pBox);
-        std::string fi;
-        if(layer==1)
-        fi=m_Folder+"visualization_data/Upper.vtu";
-        if(layer==-1)
-        fi=m_Folder+"visualization_data/Lower.vtu";
-        vtu.Writevtu(pMesh->m_pActiveV,pMesh->m_pActiveT,pMesh->m_pActiveL,fi);
-        Traj_XXX TSI(m_pBox);
-        TSI.WriteTSI(0,"extended.tsi",pMesh->m_pActiveV,pMesh->m_pActiveT,pMesh->m_pInclusion,pMesh->m_pExclusion);
-
-    }
-    //=============
-    std::string     UFUpper = m_Folder+"/OuterBM.dat";
-    std::string     UFInner = m_Folder+"/InnerBM.dat";
-
-    FILE *BMFile1;
-    if(layer==1)
-    BMFile1 = fopen(UFUpper.c_str(), "w");
-    FILE *BMFile2;
-    if(layer==-1)
-    BMFile2 = fopen(UFInner.c_str(), "w");
-
-    const char* Cbox="Box";
-  
-    if(layer==1)
-    fprintf(BMFile1,  "%s%12.3f%12.3f%12.3f\n",Cbox,Lx,Ly,Lz);
-    if(layer==2)
-    fprintf(BMFile2,  "%s%12.3f%12.3f%12.3f\n",Cbox,Lx,Ly,Lz);
-    
-    const char* STR1="< Point NoPoints";
-    const char* STR2=">";
-    
-    int NoPoints=(pMesh->m_pActiveV).size();
-    if(layer==1)
-    fprintf(BMFile1,  "%s%10d%s\n",STR1,NoPoints,STR2);
-    if(layer==-1)
-    fprintf(BMFile2,  "%s%10d%s\n",STR1,NoPoints,STR2);
-    const char* Cont="< id domain_id area X Y Z Nx Ny Nz P1x P1y P1z P2x P2y P2z C1 C2 vtype >";
+    return pMesh;
+}
+void Edit_configuration::WriteVisualization(MESH *pMesh, int layer)
+{
+    Vec3D BoxSides=*(pMesh->m_pBox);
+    std::string filename;
     if(layer==1)
-    fprintf(BMFile1,  "%s\n",Cont);
+    filename=m_Folder+"visualization_data/Upper";
     if(layer==-1)
-    fprintf(BMFile2,  "%s\n",Cont);
-    
+    filename=m_Folder+"visualization_data/Lower";
+    VMDOutput GRO(BoxSides, pMesh->m_pActiveV , pMesh->m_pActiveL, filename);
+    GRO.WriteTop();     // the .gro of WriteGro is replaced by the one of WriteGro2 anyway
+    GRO.WriteGro2();
+    WriteFiles vtu(pMesh->m_pBox);
+    Traj_XXX TSI(pMesh->m_pBox);
+    if(m_VisFormat=="ascii")
     {
-        const char* lay="< Outer >";
-        if(layer==1)
-        fprintf(BMFile1,  "%s\n",lay);
+        vtu.Writevtu(pMesh->m_pActiveV,pMesh->m_pActiveT,pMesh->m_pActiveL,filename+".vtu");
+        TSI.WriteTSI(0,"extended.tsi",pMesh->m_pActiveV,pMesh->m_pActiveT,pMesh->m_pInclusion,pMesh->m_pExclusion);
     }
+    else
     {
-        const char* lay="< Inner >";
-        if(layer==-1)
-        fprintf(BMFile2,  "%s\n",lay);
-    }
-    int i = 0;
-    double dr = 1;
-    if (m_monolayer==-1){
-        dr = -1;
+        vtu.WriteBinaryvtu(pMesh->m_pActiveV,pMesh->m_pActiveT,pMesh->m_pActiveL,filename+".vtu",m_VisFormat=="zlib");
+        TSI.WriteBinaryTSI("extended.btsi",pMesh->m_pActiveV,pMesh->m_pActiveT,pMesh->m_pInclusion,pMesh->m_pExclusion);
     }
-   for (std::vector<vertex *>::iterator it = (pMesh->m_pActiveV).begin() ; it != (pMesh->m_pActiveV).end(); ++it)
+}
+void Edit_configuration::BackMapOneLayer(int layer , std::string file, double H)
+{
+    ScopedPhase layerphase((layer==1) ? "outer layer" : "inner layer");
+    PhaseReport::Get().Begin("mesh read");
+    CreateMashBluePrint BluePrint;
+    MeshBluePrint meshblueprint;
+    meshblueprint = BluePrint.MashBluePrintFromInput_Top(file,file);
+    PhaseReport::Get().End();
+    if(m_Patches>1)
     {
-        double area=(*it)->GetArea();
-        Vec3D normal=(*it)->GetNormalVector();
-        normal = normal*(layer)*(dr);
-        //    inclusion* inc = (*it)->GetInclusion();
-        Tensor2  L2G = (*it)->GetL2GTransferMatrix();
-        Vec3D LD1(layer,0,0);
-        Vec3D GD1 = L2G * LD1;
-        Vec3D LD2(0,layer,0);
-        Vec3D GD2 = L2G * LD2;
-        double x=(*it)->GetVXPos();
-        double y=(*it)->GetVYPos();
-        double z=(*it)->GetVZPos();
-        int domain = (*it)->GetDomainID();
-        int vtype = (*it)->m_VertexType;
-        double c1,c2;
-        if((*it)->m_VertexType==0)
-        {
-            std::vector <double> curvature = (*it)->GetCurvature();
-            c1 = curvature[0];
-            c2 = curvature[1];
-        }
-        else
-        {
-            c1 = (*it)->m_Normal_Curvature;
-            c2 = 0;
-        }
-        
-        if(layer==1)
-        {
+        BackMapOneLayerInPatches(layer, meshblueprint, H);
+        return;
+    }
+    MESH Mesh;
+    std::vector <Surface_Mosaicing> Vmos;   // owns the refined meshes
+    MESH *pMesh = RefineLayer(meshblueprint, layer, H, Mesh, Vmos);
+    ScopedPhase writephase("write");
 
-            fprintf(BMFile1,"%10d%5d%10.3f%10.3f%10.3f%10.3f%8.3f%8.3f%8.3f%8.3f%8.3f%8.3f%8.3f%8.3f%8.3f%8.3f%8.3f%10d\n",i,domain,area,x,y,z,normal(0),normal(1),normal(2),GD1(0),GD1(1),GD1(2),GD2(0),GD2(1),GD2(2),c1,c2,vtype);
-        }
-        if(layer==-1)
-        {
-            fprintf(BMFile2,"%10d%5d%10.3f%10.3f%10.3f%10.3f%8.3f%8.3f%8.3f%8.3f%8.3f%8.3f%8.3f%8.3f%8.3f%8.3f%8.3f%10d\n",i,domain,area,x,y,z,normal(0),normal(1),normal(2),GD1(0),GD1(1),GD1(2),GD2(0),GD2(1),GD2(2),c1,c2,vtype);
-        }
-        
-        i++;
-        
+    if(!m_LessOutPut)
+    {
+        // -vislevel: the visualisation files come from the mesh of that mosaicing round
+        int level = (m_VisLevel<0 || m_VisLevel>int(Vmos.size())) ? int(Vmos.size()) : m_VisLevel;
+        WriteVisualization((level==0) ? &Mesh : Vmos[level-1].m_pMesh, layer);
+    }
+    //=============
+    PointLayer points;
+    GetPointLayer(pMesh, layer, points);
+    PhaseReport::Get().Count("points", points.size());
+    if(layer==1)
+    points.Write(m_Folder+"/OuterBM.dat", "Outer");
+    if(layer==-1)
+    points.Write(m_Folder+"/InnerBM.dat", "Inner");
+    if(layer==1)
+    {
+        std::vector<Tensor2> L2G;
+        for (std::vector<inclusion *>::iterator it = (pMesh->m_pInclusion).begin() ; it != (pMesh->m_pInclusion).end(); ++it)
+            L2G.push_back(((*it)->Getvertex())->GetL2GTransferMatrix());
+        WriteIncExcData(pMesh->m_pInclusion, L2G, pMesh->m_pExclusion);
     }
-if(layer==1)
+}
+//=== IncData.dat and ExcData.dat; L2G is the local frame of the vertex of each inclusion
+void Edit_configuration::WriteIncExcData(const std::vector<inclusion *> &inc, const std::vector<Tensor2> &L2G, const std::vector<exclusion *> &exc)
 {
-    
-    
-   if ((pMesh->m_pInclusion).size()!=0){
+    int i = 0;
+    int NoPoints = 0;
+   if (inc.size()!=0){
     FILE *IncFile;
     IncFile = fopen((m_Folder+"/IncData.dat").c_str(), "w");
     
-    
-    
     const char* CHAR1 ="< Inclusion NoInc   ";
-    NoPoints=((pMesh->m_pInclusion)).size();
+    NoPoints=inc.size();
     const char* CHAR2 ="   >";
     
     fprintf(IncFile,  "%s%5d%s\n",CHAR1,NoPoints,CHAR2);
@@ -693,34 +942,30 @@ if(layer==1)
     const char* CHAR3 ="< id typeid pointid lx ly lz  >";
     fprintf(IncFile,  "%s\n",CHAR3);
     
-    
-    
     i=0;
       
-    for (std::vector<inclusion *>::iterator it = (pMesh->m_pInclusion).begin() ; it != (pMesh->m_pInclusion).end(); ++it)
+    for (std::vector<inclusion *>::const_iterator it = inc.begin() ; it != inc.end(); ++it)
     {
         
         int intypeid = ((*it)->GetInclusionTypeID());
         vertex* ver = (*it)->Getvertex();
-        Tensor2  L2G = ver->GetL2GTransferMatrix();
         Vec3D LD = (*it)->GetLDirection();
-        Vec3D GD = L2G*LD;
+        Vec3D GD = L2G[i]*LD;
         int verid=ver->GetVID();
         fprintf(IncFile,  "%12d%12d%12d%8.3f%8.3f%8.3f\n",i,intypeid,verid,GD(0),GD(1),GD(2));
         i++;
     }
+    fclose(IncFile);
    }
     //==== We write Exclusion data
     
-    if((pMesh->m_pExclusion).size()!=0)
+    if(exc.size()!=0)
     {
     FILE *ExcFile;
     ExcFile = fopen((m_Folder+"/ExcData.dat").c_str(), "w");
     
-    
-    
     const char* CHAR1 ="< Exclusion NoExc   ";
-    NoPoints=(pMesh->m_pExclusion).size();
+    NoPoints=exc.size();
     const char* CHAR2 ="   >";
     
     fprintf(ExcFile,  "%s%5d%s\n",CHAR1,NoPoints,CHAR2);
@@ -728,11 +973,9 @@ if(layer==1)
     const char* CHAR3 ="< id  pointid r >";
     fprintf(ExcFile,  "%s\n",CHAR3);
     
-    
-    
     i=0;
     
-    for (std::vector<exclusion *>::iterator it = (pMesh->m_pExclusion).begin() ; it != (pMesh->m_pExclusion).end(); ++it)
+    for (std::vector<exclusion *>::const_iterator it = exc.begin() ; it != exc.end(); ++it)
     {
         
         vertex* ver = (*it)->Getvertex();
@@ -741,11 +984,213 @@ if(layer==1)
         fprintf(ExcFile,  "%5d%10d%8.3f\n",i,verid,R);
         i++;
     }
+    fclose(ExcFile);
     }
 }
+//=== the layer refined one patch at a time (-patches): the layer shifted base mesh is cut into patches, each one is
+//=== refined with a halo around it and its points go to a scratch file at their final id; the .dat file is then
+//=== written from it in order. Only the base mesh and one refined patch are in memory.
+void Edit_configuration::BackMapOneLayerInPatches(int layer, const MeshBluePrint &meshblueprint, double H)
+{
+    PhaseReport &report = PhaseReport::Get();
+    MESH Base;
+    int Iteration = PrepareLayer(meshblueprint, layer, H, Base);
+    Vec3D Box = *(Base.m_pBox);
+    report.Begin("patches");
+    MeshPatches patches(Base.Convert_Mesh_2_BluePrint(&Base), m_Patches, Iteration, PATCH_HALO);
+    long N = patches.GetNoPoints();
+    report.Count("patches", patches.GetNoPatches());
+    report.End();
 
+    std::string file = m_Folder+((layer==1) ? "/OuterBM.dat" : "/InnerBM.dat");
+    std::string scratch = file+".tmp";
+    FILE *pScratch = fopen(scratch.c_str(), "w+b");
+    if(pScratch==NULL)
+    {
+        std::cout<<"---> error: could not open the scratch file "<<scratch<<"\n";
+        ToolExit::Exit(0);
+    }
+    std::vector<bool> made(N, false);
+    std::vector<Tensor2> L2G((Base.m_pInclusion).size());
+    for (int p=0;p<patches.GetNoPatches();p++)
+    {
+        std::cout<<" Patch number "<<p+1<<" total is "<<patches.GetNoPatches()<<"\n";
+        ScopedPhase phase("patch "+std::to_string(p+1));
+        MESH Mesh;
+        Mesh.GenerateMesh(patches.Patch(p));
+        m_pBox = Mesh.m_pBox;
+        UpdateGeometry(&Mesh);
+        MESH *pMesh = &Mesh;
+        std::vector <Surface_Mosaicing> Vmos(Iteration, Surface_Mosaicing(m_MosAlType,m_smooth));
+        for (int j=0;j<Iteration;j++)
+        {
+            // the outer halo vertices are edge vertices of the patch; Type2 also reads their curvature
+            for (std::vector<vertex *>::iterator it = (pMesh->m_pEdgeV).begin() ; it != (pMesh->m_pEdgeV).end(); ++it)
+                if(((*it)->GetCurvature()).size()==0)
+                    (*it)->UpdateCurvature((*it)->m_Normal_Curvature, 0);
+            patches.Refine(pMesh);
+            (Vmos.at(j)).PerformMosaicing(pMesh);
+            pMesh = (Vmos.at(j)).m_pMesh;
+        }
+
+        //=== the points of this patch by id, written as runs of consecutive ids
+        PointLayer points;
+        GetPointLayer(pMesh, layer, points);
+        std::vector<std::pair<long, int> > own;
+        for (int i=0;i<points.size();i++)
+        {
+            long id = patches.PointID(i);
+            if(id>=0)
+                own.push_back(std::make_pair(id, i));
+        }
+        std::sort(own.begin(), own.end());
+        std::vector<double> rec;
+        for (size_t a=0;a<own.size();)
+        {
+            size_t b = a+1;
+            while(b<own.size() && own[b].first==own[b-1].first+1)
+                b++;
+            rec.resize(PATCH_RECORD*(b-a));
+            for (size_t k=a;k<b;k++)
+            {
+                int i = own[k].second;
+                double *r = &rec[PATCH_RECORD*(k-a)];
+                r[0] = points.Domain[i];
+                r[1] = points.Area[i];
+                for (int d=0;d<3;d++)
+                {
+                    r[2+d] = points.X[3*i+d];
+                    r[5+d] = points.Normal[3*i+d];
+                    r[8+d] = points.P1[3*i+d];
+                    r[11+d] = points.P2[3*i+d];
+                }
+                r[14] = points.C1[i];
+                r[15] = points.C2[i];
+                r[16] = points.VType[i];
+                made[own[k].first] = true;
+            }
+            if(fseek(pScratch, own[a].first*PATCH_RECORD*long(sizeof(double)), SEEK_SET)!=0 || fwrite(rec.data(), sizeof(double), rec.size(), pScratch)!=rec.size())
+            {
+                std::cout<<"---> error: could not write the scratch file "<<scratch<<"\n";
+                ToolExit::Exit(0);
+            }
+            a = b;
+        }
+        for (size_t k=0;k<L2G.size();k++)
+        {
+            int vid = ((Base.m_pInclusion)[k]->Getvertex())->GetVID();
+            if(patches.GetVertexOwner(vid)==p)
+                L2G[k] = ((pMesh->m_pActiveV)[patches.LocalVertex(vid)])->GetL2GTransferMatrix();
+        }
+        report.Count("vertices", (pMesh->m_pActiveV).size());
+        report.Count("points", own.size());
+    }
+
+    //=== the .dat file in id order
+    ScopedPhase writephase("write");
+    FILE *pFile = PointLayer::OpenWrite(file, (layer==1) ? "Outer" : "Inner", N, (layer==1) ? &Box : NULL);
+    if(pFile==NULL)
+    {
+        std::cout<<"---> error: could not open "<<file<<" for writing \n";
+        ToolExit::Exit(0);
+    }
+    rewind(pScratch);
+    std::vector<double> rec;
+    for (long first=0;first<N;first+=PATCH_CHUNK)
+    {
+        long n = std::min(long(PATCH_CHUNK), N-first);
+        rec.resize(PATCH_RECORD*n);
+        if(fread(rec.data(), sizeof(double), rec.size(), pScratch)!=rec.size())
+        {
+            std::cout<<"---> error: could not read the scratch file "<<scratch<<"\n";
+            ToolExit::Exit(0);
+        }
+        PointLayer points;
+        points.reserve(n);
+        for (long k=0;k<n;k++)
+        {
+            if(!made[first+k])
+            {
+                std::cout<<"---> error: no patch made point "<<first+k<<", report to developer and send this id: PLM7730416 \n";
+                ToolExit::Exit(1);
+            }
+            const double *r = &rec[PATCH_RECORD*k];
+            points.push_back(first+k, int(r[0]), r[1], Vec3D(r[2],r[3],r[4]), Vec3D(r[5],r[6],r[7]), Vec3D(r[8],r[9],r[10]), Vec3D(r[11],r[12],r[13]), r[14], r[15], int(r[16]));
+        }
+        points.Append(pFile);
+    }
+    fclose(pFile);
+    fclose(pScratch);
+    remove(scratch.c_str());
+    report.Count("points", N);
+
+    if(layer==1)
+        WriteIncExcData(Base.m_pInclusion, L2G, Base.m_pExclusion);
 }
 void Edit_configuration::Minimize(std::string file){
     std::cout<<" error---> this function has been removed \n";
-    exit(0);
+    ToolExit::Exit(0);
+}
+void Edit_configuration::GetPointLayer(MESH *pMesh, int layer, PointLayer &points)
+{
+    points.clear();
+    points.Box = *(pMesh->m_pBox);
+    points.HasBox = (layer==1);     // only OuterBM.dat carries the box
+    points.reserve((pMesh->m_pActiveV).size());
+    int i = 0;
+    double dr = 1;
+    if (m_monolayer==-1){
+        dr = -1;
+    }
+   for (std::vector<vertex *>::iterator it = (pMesh->m_pActiveV).begin() ; it != (pMesh->m_pActiveV).end(); ++it)
+    {
+        double area=(*it)->GetArea();
+        Vec3D normal=(*it)->GetNormalVector();
+        normal = normal*(layer)*(dr);
+        Tensor2  L2G = (*it)->GetL2GTransferMatrix();
+        Vec3D LD1(layer,0,0);
+        Vec3D GD1 = L2G * LD1;
+        Vec3D LD2(0,layer,0);
+        Vec3D GD2 = L2G * LD2;
+        Vec3D X((*it)->GetVXPos(),(*it)->GetVYPos(),(*it)->GetVZPos());
+        int domain = (*it)->GetDomainID();
+        int vtype = (*it)->m_VertexType;
+        double c1,c2;
+        if((*it)->m_VertexType==0)
+        {
+            std::vector <double> curvature = (*it)->GetCurvature();
+            c1 = curvature[0];
+            c2 = curvature[1];
+        }
+        else
+        {
+            c1 = (*it)->m_Normal_Curvature;
+            c2 = 0;
+        }
+        points.push_back(i,domain,area,X,normal,GD1,GD2,c1,c2,vtype);
+        i++;
+    }
+}
+void Edit_configuration::GetIncExcData(MESH *pMesh, RefinedSurface &surface)
+{
+    // what WriteIncExcData writes, the inclusion directions in the global frame of their vertex
+    surface.IncType.clear();
+    surface.IncPoint.clear();
+    surface.IncDirection.clear();
+    for (std::vector<inclusion *>::iterator it = (pMesh->m_pInclusion).begin() ; it != (pMesh->m_pInclusion).end(); ++it)
+    {
+        vertex* ver = (*it)->Getvertex();
+        Vec3D GD = (ver->GetL2GTransferMatrix())*((*it)->GetLDirection());
+        surface.IncType.push_back((*it)->GetInclusionTypeID());
+        surface.IncPoint.push_back(ver->GetVID());
+        for (int k=0;k<3;k++)
+            surface.IncDirection.push_back(GD(k));
+    }
+    surface.ExcPoint.clear();
+    surface.ExcRadius.clear();
+    for (std::vector<exclusion *>::iterator it = (pMesh->m_pExclusion).begin() ; it != (pMesh->m_pExclusion).end(); ++it)
+    {
+        surface.ExcPoint.push_back(((*it)->Getvertex())->GetVID());
+        surface.ExcRadius.push_back((*it)->GetRadius());
+    }
 }
@@ -11,12 +11,19 @@
 #include "exclusion.h"
 #include "MESH.h"
 #include "CreateMashBluePrint.h"
+#include "Surface_Mosaicing.h"
+#include "PointStore.h"
+#include "RefinedSurface.h"
 
 class Edit_configuration
 {
 public:
     
 	Edit_configuration( std::vector <std::string> arg);
+    // in-process refinement: options as on the command line, mesh from memory, results in outer/inner, no files
+	Edit_configuration(const std::vector <std::string> &arg, const MeshBluePrint &blueprint, PointLayer &outer, PointLayer &inner);
+    // in-process run of the TS file of arg (PCG -TSfile): the point folder is kept in surface, no files
+	Edit_configuration(const std::vector <std::string> &arg, RefinedSurface &surface);
 	 ~Edit_configuration();
 
 private:
@@ -37,9 +44,31 @@ private:
     void Rescaling(Vec3D zoom , MESH *pMesh);   // rescale the position and the box based on a vector
     void UpdateGeometry(MESH *pmesh);  // updates curvature, area etc of each triangle, vertex etc
     std::string m_MosAlType;
+    Edit_configuration();   // default values of all the options
     void BackMapOneLayer(int layer , std::string file, double);
+    // generates the mesh, shifts it to the layer and subdivides it; the refined meshes live in Vmos
+    MESH *RefineLayer(const MeshBluePrint &blueprint, int layer, double H, MESH &Mesh, std::vector <Surface_Mosaicing> &Vmos);
+    // generates the mesh, rescales it and shifts it to the layer; returns the number of mosaicing rounds
+    int PrepareLayer(const MeshBluePrint &blueprint, int layer, double H, MESH &Mesh);
+    void GetPointLayer(MESH *pMesh, int layer, PointLayer &points);    // point data as it goes into OuterBM.dat/InnerBM.dat
+    void GetIncExcData(MESH *pMesh, RefinedSurface &surface);         // data as it goes into IncData.dat/ExcData.dat
+    void RefineInMemory(const MeshBluePrint &blueprint, RefinedSurface &surface);   // both layers, nothing written
+    // BackMapOneLayer with the base mesh cut into m_Patches patches that are refined one at a time (-patches)
+    void BackMapOneLayerInPatches(int layer, const MeshBluePrint &blueprint, double H);
+    void WriteIncExcData(const std::vector<inclusion *> &inc, const std::vector<Tensor2> &L2G, const std::vector<exclusion *> &exc);
+    bool m_InMemory;
+    int m_Patches;
+    double m_CacheSize;             // -cache budget in MB (0: no limit), negative: no cache
+    std::string m_VisFormat;        // -visformat: ascii, binary or zlib
+    int m_VisLevel;                 // -vislevel: mosaicing rounds of the visualisation mesh, -1 for the finest
+    void WriteVisualization(MESH *pMesh, int layer);   // the files of visualization_data and extended.tsi
+    std::string CacheOptions();     // the values of the options that change the points, for the cache key
     bool check(std::string file);     // a function to check how the ts file looklike and do nothing
     void VertexInfo(std::string file);     // gives info about a vertex 
+    std::string m_VertexList;       // -vertices: all, ids and ranges or a file of them; empty: ask for one vertex
+    std::string m_VertexFormat;     // -vertexformat: csv, json or binary
+    std::vector<int> VertexIDs(const std::string &list, int nv);   // the ids of -vertices, checked against nv vertices
+    void WriteVertexInfo(const std::vector<int> &ids);              // vertexinfo.csv, .json or .bin
 
     void Minimize(std::string file);   // may not work well, needs optimization
     
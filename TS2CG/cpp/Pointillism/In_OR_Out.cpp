@@ -117,8 +117,7 @@ void  In_OR_Out::UpdateGeometry(MESH *pmesh)
     }
 
     //======= Prepare vertex:  area and normal vector and curvature of surface vertices not the edge one
-    for (std::vector<vertex *>::iterator it = (pmesh->m_pSurfV).begin() ; it != (pmesh->m_pSurfV).end(); ++it)
-        CurvatureCalculations.SurfVertexCurvature(*it);
+    CurvatureCalculations.SurfVertexCurvature(pmesh->m_pSurfV);
         
     //====== edge links should be updated
     for (std::vector<links *>::iterator it = (pmesh->m_pEdgeL).begin() ; it != (pmesh->m_pEdgeL).end(); ++it)
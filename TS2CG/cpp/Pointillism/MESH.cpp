@@ -1,4 +1,5 @@
 #include "MESH.h"
+#include "ToolExit.h"
 
 /*
  Weria Pezeshkian (weria.pezeshkian@gmail.com)
@@ -64,7 +65,7 @@ void MESH::GenerateMesh(MeshBluePrint meshblueprint)
         if(m_Vertex.size()<it->vid+1)
         {
         std::cout<<"----> Error: Inclusion vertex id is out of range "<<std::endl;
-            exit(0);
+            ToolExit::Exit(0);
         }
         Tinc.Updatevertex(&(m_Vertex.at(it->vid)));
         Tinc.UpdateInclusionTypeID(it->tid);
@@ -80,7 +81,7 @@ void MESH::GenerateMesh(MeshBluePrint meshblueprint)
         if(m_Vertex.size()<it->vid+1)
         {
         std::cout<<"----> error: exclusion vertex id is out of range "<<std::endl;
-            exit(0);
+            ToolExit::Exit(0);
         }
         Texc.Updatevertex(&(m_Vertex.at(it->vid)));
         Texc.UpdateRadius(it->R);
@@ -265,7 +266,7 @@ void MESH::GenerateMesh(MeshBluePrint meshblueprint)
     if(no_repeated_link!=0)
     {
         std::cout<<" error---> approximatly  "<<no_repeated_link/3<<" triangles was found to be inconsisent in their orientation \n";
-        exit(0);
+        ToolExit::Exit(0);
     }
 }
 //===========================================================
@@ -0,0 +1,526 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <fstream>
+#include <algorithm>
+#include "MeshCheck.h"
+#include "SimDef.h"
+#include "JSONString.h"
+
+namespace {
+// reads a text file token by token; Number and Integer do not go past the end of the line
+struct Cursor
+{
+    const char *p;
+    bool Blank()
+    {
+        while(*p==' ' || *p=='\t' || *p=='\r')
+            p++;
+        return *p=='\0' || *p=='\n';
+    }
+    bool Number(double &x)
+    {
+        if(Blank())
+            return false;
+        char *e;
+        x = strtod(p, &e);
+        if(e==p)
+            return false;
+        p = e;
+        return true;
+    }
+    bool Integer(long &x)
+    {
+        if(Blank())
+            return false;
+        char *e;
+        x = strtol(p, &e, 10);
+        if(e==p)
+            return false;
+        p = e;
+        return true;
+    }
+    bool Word(std::string &w)
+    {
+        while(*p==' ' || *p=='\t' || *p=='\r' || *p=='\n')
+            p++;
+        const char *s = p;
+        while(*p!='\0' && *p!=' ' && *p!='\t' && *p!='\r' && *p!='\n')
+            p++;
+        w.assign(s, p-s);
+        return !w.empty();
+    }
+    void NextLine()
+    {
+        while(*p!='\0' && *p!='\n')
+            p++;
+        if(*p=='\n')
+            p++;
+    }
+};
+bool Load(const std::string &file, std::string &text)
+{
+    FILE *f = fopen(file.c_str(), "rb");
+    if(f==NULL)
+        return false;
+    char buf[1<<16];
+    size_t n;
+    while((n = fread(buf, 1, sizeof(buf), f))>0)
+        text.append(buf, n);
+    fclose(f);
+    return true;
+}
+// the shortest image of a difference, as in triangle::UpdateNormal_Area
+double Wrap(double d, double L)
+{
+    if(fabs(d)>L/2.0)
+    {
+        if(d<0)
+            d = L+d;
+        else if(d>0)
+            d = d-L;
+    }
+    return d;
+}
+int Find(std::vector<int> &parent, int i)
+{
+    while(parent[i]!=i)
+    {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+void Union(std::vector<int> &parent, int a, int b)
+{
+    a = Find(parent, a);
+    b = Find(parent, b);
+    if(a!=b)
+        parent[std::max(a, b)] = std::min(a, b);
+}
+}
+MeshCheck::MeshCheck(const std::string &file) :
+                    m_File(file),
+                    m_Exclusions(0),
+                    m_Area(0), m_Volume(0), m_Periodic(false),
+                    m_Faces(0), m_Edges(0), m_BoundaryE(0), m_NonManifoldE(0), m_FlippedE(0),
+                    m_InvalidT(0), m_DegenerateT(0), m_UsedV(0), m_InvalidInc(0),
+                    m_Components(0), m_BoundaryLoops(0), m_Domains(0)
+{
+    m_Box[0] = m_Box[1] = m_Box[2] = 1;
+    std::string ext = file.substr(file.find_last_of(".") + 1);
+    bool good = false;
+    if(ext=="tsi")
+        good = ReadTSI(file);
+    else if(ext=="btsi")
+        good = ReadBinaryTSI(file);
+    else if(ext=="q")
+        good = ReadQ(file);
+    else if(ext=="top")
+        good = ReadTop(file);
+    else
+        m_Error = "unknown file type ."+ext+" (tsi, btsi, q or top)";
+    if(good && m_T.empty())
+        m_Error = "the file has no triangles";
+    else if(good)
+        Analyse();
+}
+MeshCheck::~MeshCheck()
+{
+
+}
+bool MeshCheck::ReadTSI(const std::string &file)
+{
+    std::string text;
+    if(!Load(file, text))
+    {
+        m_Error = "can not open "+file;
+        return false;
+    }
+    Cursor c = {text.c_str()};
+    std::string word;
+    bool box = false, vertex = false, triangle = false;
+    while(c.Word(word))
+    {
+        long n = 0, id, v[3];
+        double x[3];
+        if(word=="version")
+        {
+            c.NextLine();
+            continue;
+        }
+        if(word=="box")
+        {
+            if(!c.Number(m_Box[0]) || !c.Number(m_Box[1]) || !c.Number(m_Box[2]))
+            {
+                m_Error = "the box line is not complete";
+                return false;
+            }
+            box = true;
+            c.NextLine();
+            continue;
+        }
+        if(!c.Integer(n) || n<0)
+        {
+            m_Error = "no number after "+word;
+            return false;
+        }
+        c.NextLine();
+        if(word=="vertex")
+        {
+            vertex = true;
+            m_X.reserve(3*n);
+            m_Domain.reserve(n);
+            for (long i=0;i<n;i++)
+            {
+                if(!c.Integer(id) || !c.Number(x[0]) || !c.Number(x[1]) || !c.Number(x[2]))
+                {
+                    m_Error = "vertex line "+std::to_string(i)+" is not complete";
+                    return false;
+                }
+                m_X.insert(m_X.end(), x, x+3);
+                m_Domain.push_back(c.Integer(id) ? id : 0);
+                c.NextLine();
+            }
+        }
+        else if(word=="triangle")
+        {
+            triangle = true;
+            m_T.reserve(3*n);
+            for (long i=0;i<n;i++)
+            {
+                if(!c.Integer(id) || !c.Integer(v[0]) || !c.Integer(v[1]) || !c.Integer(v[2]))
+                {
+                    m_Error = "triangle line "+std::to_string(i)+" is not complete";
+                    return false;
+                }
+                m_T.insert(m_T.end(), v, v+3);
+                c.NextLine();
+            }
+        }
+        else if(word=="inclusion")
+        {
+            for (long i=0;i<n;i++)
+            {
+                if(!c.Integer(id) || !c.Integer(v[0]) || !c.Integer(v[1]) || !c.Number(x[0]) || !c.Number(x[1]))
+                {
+                    m_Error = "inclusion line "+std::to_string(i)+" is not complete";
+                    return false;
+                }
+                m_IncVertex.push_back(v[1]);
+                c.NextLine();
+            }
+        }
+        else if(word=="exclusion")
+        {
+            for (long i=0;i<n;i++)
+            {
+                if(!c.Integer(id) || !c.Integer(v[0]) || !c.Number(x[0]))
+                {
+                    m_Error = "exclusion line "+std::to_string(i)+" is not complete";
+                    return false;
+                }
+                m_Exclusions++;
+                c.NextLine();
+            }
+        }
+        else
+        {
+            m_Error = word+" is not a key word of tsi files";
+            return false;
+        }
+    }
+    // an empty or cut off file: the sections CreateMashBluePrint::Read_TSIFile needs
+    if(!box || !vertex || !triangle)
+    {
+        m_Error = std::string("the file has no ")+(!box ? "box line" : (!vertex ? "vertex section" : "triangle section"));
+        return false;
+    }
+    return true;
+}
+bool MeshCheck::ReadBinaryTSI(const std::string &file)
+{
+    // the layout of BinaryTSI_Magic in SimDef.h
+    std::string text;
+    if(!Load(file, text))
+    {
+        m_Error = "can not open "+file;
+        return false;
+    }
+    size_t pos = 8;
+    int order = 0;
+    if(text.size()<12 || text.compare(0, 8, BinaryTSI_Magic)!=0)
+    {
+        m_Error = "not a binary tsi file";
+        return false;
+    }
+    memcpy(&order, &text[pos], sizeof(int));
+    pos += sizeof(int);
+    if(order!=BinaryTSI_Order)
+    {
+        m_Error = "written on a machine with another byte order";
+        return false;
+    }
+    const size_t record[4] = {sizeof(int)+3*sizeof(double)+sizeof(int), 4*sizeof(int), 3*sizeof(int)+2*sizeof(double), 2*sizeof(int)+sizeof(double)};
+    if(pos+3*sizeof(double)>text.size())
+    {
+        m_Error = "the file ends in the header";
+        return false;
+    }
+    memcpy(m_Box, &text[pos], 3*sizeof(double));
+    pos += 3*sizeof(double);
+    for (int s=0;s<4;s++)
+    {
+        long long n = 0;
+        if(pos+sizeof(n)>text.size())
+        {
+            m_Error = "the file ends before all sections";
+            return false;
+        }
+        memcpy(&n, &text[pos], sizeof(n));
+        pos += sizeof(n);
+        if(n<0 || (text.size()-pos)/record[s]<(unsigned long long)n)
+        {
+            m_Error = "the file is shorter than its header says";
+            return false;
+        }
+        for (long long i=0;i<n;i++)
+        {
+            const char *r = &text[pos];
+            int iv[3];
+            if(s==0)
+            {
+                double x[3];
+                memcpy(x, r+sizeof(int), 3*sizeof(double));
+                memcpy(iv, r+sizeof(int)+3*sizeof(double), sizeof(int));
+                m_X.insert(m_X.end(), x, x+3);
+                m_Domain.push_back(iv[0]);
+            }
+            else if(s==1)
+            {
+                memcpy(iv, r+sizeof(int), 3*sizeof(int));
+                m_T.insert(m_T.end(), iv, iv+3);
+            }
+            else if(s==2)
+            {
+                memcpy(iv, r+2*sizeof(int), sizeof(int));
+                m_IncVertex.push_back(iv[0]);
+            }
+            else
+                m_Exclusions++;
+            pos += record[s];
+        }
+    }
+    return true;
+}
+bool MeshCheck::ReadQ(const std::string &file)
+{
+    // as CreateMashBluePrint::Read_Mult_QFile: the largest box of all q files; the triangles use the
+    // vertex numbers of their own file
+    std::string text;
+    if(!Load(file, text))
+    {
+        m_Error = "can not open "+file;
+        return false;
+    }
+    Cursor c = {text.c_str()};
+    double b[3];
+    long n, id, v[3];
+    if(!c.Number(b[0]) || !c.Number(b[1]) || !c.Number(b[2]))
+    {
+        m_Error = "box information in the file "+file+" is not correct";
+        return false;
+    }
+    for (int k=0;k<3;k++)
+        m_Box[k] = std::max(m_Box[k], b[k]);
+    c.NextLine();
+    if(!c.Integer(n) || n<0)
+    {
+        m_Error = "number of vertices in the file "+file+" is not correct";
+        return false;
+    }
+    c.NextLine();
+    for (long i=0;i<n;i++)
+    {
+        if(!c.Integer(id) || !c.Number(b[0]) || !c.Number(b[1]) || !c.Number(b[2]))
+        {
+            m_Error = "vertex line "+std::to_string(i)+" of "+file+" is not complete";
+            return false;
+        }
+        m_X.insert(m_X.end(), b, b+3);
+        m_Domain.push_back(c.Integer(id) ? id : 0);
+        c.NextLine();
+    }
+    if(!c.Integer(n) || n<0)
+    {
+        m_Error = "number of triangles in the file "+file+" is not correct";
+        return false;
+    }
+    c.NextLine();
+    for (long i=0;i<n;i++)
+    {
+        if(!c.Integer(id) || !c.Integer(v[0]) || !c.Integer(v[1]) || !c.Integer(v[2]))
+        {
+            m_Error = "triangle line "+std::to_string(i)+" of "+file+" is not complete";
+            return false;
+        }
+        m_T.insert(m_T.end(), v, v+3);
+        c.NextLine();
+    }
+    return true;
+}
+bool MeshCheck::ReadTop(const std::string &file)
+{
+    std::ifstream top(file.c_str());
+    if(!top.is_open())
+    {
+        m_Error = "can not open "+file;
+        return false;
+    }
+    std::string qfile, rest;
+    int id;
+    while(top>>qfile>>id)
+    {
+        if(!ReadQ(qfile))
+            return false;
+        getline(top, rest);
+    }
+    return true;
+}
+void MeshCheck::Analyse()
+{
+    long nv = m_X.size()/3;
+    long nt = m_T.size()/3;
+    std::vector<char> used(nv, 0);
+
+    //=== the edge table: open addressing, key (lower vertex+1)<<32 | higher vertex
+    int bits = 4;
+    while((size_t(1)<<bits)<4*size_t(nt))
+        bits++;
+    size_t capacity = size_t(1)<<bits;
+    std::vector<unsigned long long> key(capacity, 0);
+    std::vector<int> count(capacity, 0);
+    std::vector<int> direction(capacity, 0);
+    const int next[3] = {1, 2, 0};
+    for (long t=0;t<nt;t++)
+    {
+        const int *v = &m_T[3*t];
+        if(v[0]<0 || v[1]<0 || v[2]<0 || v[0]>=nv || v[1]>=nv || v[2]>=nv)
+        {
+            m_InvalidT++;
+            continue;
+        }
+        if(v[0]==v[1] || v[1]==v[2] || v[0]==v[2])
+        {
+            m_DegenerateT++;
+            continue;
+        }
+        m_Faces++;
+        const double *x1 = &m_X[3*v[0]], *x2 = &m_X[3*v[1]], *x3 = &m_X[3*v[2]];
+        double e1[3], e2[3], e3[3], n[3];
+        for (int k=0;k<3;k++)
+        {
+            e1[k] = Wrap(x2[k]-x1[k], m_Box[k]);
+            e2[k] = Wrap(x3[k]-x1[k], m_Box[k]);
+            e3[k] = Wrap(x3[k]-x2[k], m_Box[k]);
+            if(e1[k]!=x2[k]-x1[k] || e2[k]!=x3[k]-x1[k] || e3[k]!=x3[k]-x2[k])
+                m_Periodic = true;
+        }
+        n[0] = e1[1]*e2[2]-e1[2]*e2[1];
+        n[1] = e1[2]*e2[0]-e1[0]*e2[2];
+        n[2] = e1[0]*e2[1]-e1[1]*e2[0];
+        double a = sqrt(n[0]*n[0]+n[1]*n[1]+n[2]*n[2]);
+        double l1 = sqrt(e1[0]*e1[0]+e1[1]*e1[1]+e1[2]*e1[2]);
+        double l2 = sqrt(e2[0]*e2[0]+e2[1]*e2[1]+e2[2]*e2[2]);
+        if(!(a>1e-12*l1*l2))
+            m_DegenerateT++;
+        m_Area += 0.5*a;
+        // Volume::SingleTriangleVolume: area*(R.N)/3 with R the first vertex
+        m_Volume += (x1[0]*n[0]+x1[1]*n[1]+x1[2]*n[2])/6.0;
+        for (int k=0;k<3;k++)
+        {
+            used[v[k]] = 1;
+            unsigned long long a0 = v[k], a1 = v[next[k]];
+            int dir = (a0<a1) ? 1 : -1;
+            unsigned long long h = ((std::min(a0, a1)+1)<<32) | std::max(a0, a1);
+            size_t slot = (h*0x9E3779B97F4A7C15ULL)>>(64-bits);
+            while(key[slot]!=0 && key[slot]!=h)
+                slot = (slot+1)&(capacity-1);
+            if(key[slot]==0)
+            {
+                key[slot] = h;
+                m_Edges++;
+            }
+            count[slot]++;
+            direction[slot] += dir;
+        }
+    }
+    //=== edges, components and boundary loops
+    std::vector<int> all(nv), boundary(nv);
+    for (long i=0;i<nv;i++)
+        all[i] = boundary[i] = i;
+    std::vector<char> onboundary(nv, 0);
+    for (size_t s=0;s<capacity;s++)
+    {
+        if(key[s]==0)
+            continue;
+        int a = int((key[s]>>32)-1), b = int(key[s]&0xffffffffULL);
+        Union(all, a, b);
+        if(count[s]==1)
+        {
+            m_BoundaryE++;
+            Union(boundary, a, b);
+            onboundary[a] = onboundary[b] = 1;
+        }
+        else if(count[s]>2)
+            m_NonManifoldE++;
+        else if(direction[s]!=0)
+            m_FlippedE++;
+    }
+    for (long i=0;i<nv;i++)
+    {
+        if(used[i])
+        {
+            m_UsedV++;
+            if(Find(all, i)==i)
+                m_Components++;
+        }
+        if(onboundary[i] && Find(boundary, i)==i)
+            m_BoundaryLoops++;
+    }
+    for (size_t i=0;i<m_IncVertex.size();i++)
+        if(m_IncVertex[i]<0 || m_IncVertex[i]>=nv)
+            m_InvalidInc++;
+    std::vector<int> domains(m_Domain);
+    std::sort(domains.begin(), domains.end());
+    m_Domains = std::unique(domains.begin(), domains.end())-domains.begin();
+}
+void MeshCheck::WriteJSON(FILE *out) const
+{
+    fprintf(out, "{\n  \"file\": ");
+    WriteJSONString(out, m_File);
+    fprintf(out, ",\n  \"valid\": %s", GetValid() ? "true" : "false");
+    if(!m_Error.empty())
+    {
+        fprintf(out, ",\n  \"error\": ");
+        WriteJSONString(out, m_Error);
+        fprintf(out, "\n}\n");
+        return;
+    }
+    long euler = m_UsedV-m_Edges+m_Faces;
+    bool closed = (m_BoundaryE==0 && m_NonManifoldE==0);
+    fprintf(out, ",\n  \"vertices\": %ld,\n  \"used_vertices\": %ld,\n  \"triangles\": %ld,\n  \"edges\": %ld,", long(m_X.size()/3), m_UsedV, long(m_T.size()/3), m_Edges);
+    fprintf(out, "\n  \"inclusions\": %ld,\n  \"exclusions\": %d,\n  \"domains\": %d,", long(m_IncVertex.size()), m_Exclusions, m_Domains);
+    fprintf(out, "\n  \"box\": [%.10g, %.10g, %.10g],", m_Box[0], m_Box[1], m_Box[2]);
+    fprintf(out, "\n  \"area\": %.10g,", m_Area);
+    if(closed && !m_Periodic)
+        fprintf(out, "\n  \"volume\": %.10g,", m_Volume);
+    else
+        fprintf(out, "\n  \"volume\": null,");
+    fprintf(out, "\n  \"periodic\": %s,\n  \"closed\": %s,", m_Periodic ? "true" : "false", closed ? "true" : "false");
+    fprintf(out, "\n  \"euler_characteristic\": %ld,\n  \"components\": %ld,\n  \"boundary_loops\": %ld,", euler, m_Components, m_BoundaryLoops);
+    fprintf(out, "\n  \"genus\": %g,", (2.0*m_Components-euler-m_BoundaryLoops)/2.0);
+    fprintf(out, "\n  \"boundary_edges\": %ld,\n  \"non_manifold_edges\": %ld,\n  \"flipped_edges\": %ld,", m_BoundaryE, m_NonManifoldE, m_FlippedE);
+    fprintf(out, "\n  \"invalid_triangles\": %ld,\n  \"degenerate_triangles\": %ld,\n  \"invalid_inclusions\": %ld", m_InvalidT, m_DegenerateT, m_InvalidInc);
+    fprintf(out, "\n}\n");
+}
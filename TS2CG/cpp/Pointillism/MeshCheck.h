@@ -0,0 +1,57 @@
+#if !defined(AFX_MeshCheck_H_6D3E21B8_C13C_5648_BF23_124095086243__INCLUDED_)
+#define AFX_MeshCheck_H_6D3E21B8_C13C_5648_BF23_124095086243__INCLUDED_
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+/*
+ Weria Pezeshkian (weria.pezeshkian@gmail.com)
+ Copyright (c) Weria Pezeshkian
+ Validation of a TS file without building the mesh (PLM -r validate).
+
+ The file (.tsi, .btsi, .q, or a .top file of q files) is read once into flat arrays. The edges are
+ kept in one hash table with, for each edge, the number of triangles on it and the sum of the directions
+ in which they pass it. From these: area and volume (the formulas of triangle::UpdateNormal_Area and
+ Volume::SingleTriangleVolume), Euler characteristic, connected components, boundary loops and genus,
+ and the problems: triangles with a vertex that does not exist, degenerate triangles (a vertex twice or
+ no area), edges on more than two triangles (non-manifold) and edges both triangles pass in the same
+ direction (flipped orientation). The result is written as JSON. A file without a box, vertex or
+ triangle section, or without triangles, can not be read and is not valid.
+*/
+class MeshCheck
+{
+public:
+    MeshCheck(const std::string &file);
+    ~MeshCheck();
+
+    inline bool GetValid()          const {return m_Error.empty() && m_InvalidT==0 && m_DegenerateT==0 && m_NonManifoldE==0 && m_FlippedE==0;}
+    void WriteJSON(FILE *out) const;
+
+private:
+    std::string m_File;
+    std::string m_Error;                // why the file could not be read; empty if it was read
+    double m_Box[3];
+    std::vector<double> m_X;            // 3 per vertex
+    std::vector<int> m_Domain;
+    std::vector<int> m_T;               // 3 per triangle
+    std::vector<int> m_IncVertex;
+    int m_Exclusions;
+
+    // results
+    double m_Area;
+    double m_Volume;
+    bool m_Periodic;                    // an edge crosses the box
+    long m_Faces;                       // triangles in the topology: not invalid, no vertex twice
+    long m_Edges, m_BoundaryE, m_NonManifoldE, m_FlippedE;
+    long m_InvalidT, m_DegenerateT, m_UsedV, m_InvalidInc;
+    long m_Components, m_BoundaryLoops;
+    int  m_Domains;
+
+    bool ReadTSI(const std::string &file);
+    bool ReadBinaryTSI(const std::string &file);
+    bool ReadQ(const std::string &file);
+    bool ReadTop(const std::string &file);
+    void Analyse();
+};
+
+#endif
@@ -0,0 +1,310 @@
+#include <algorithm>
+#include "MeshPatches.h"
+#include "ToolExit.h"
+
+MeshPatches::MeshPatches(const MeshBluePrint &base, int npatch, int rounds, int halo)
+            : m_Rounds(rounds),
+              m_Halo(halo),
+              m_Current(-1),
+              m_Triangle(base.btriangle)
+{
+    m_Vertex = base.bvertex;
+    m_Box = base.simbox;
+    int nv = m_Vertex.size();
+    int nt = m_Triangle.size();
+    m_NoPatches = std::max(1, std::min(npatch, nt));
+
+    //=== triangles of each vertex
+    m_VTFirst.assign(nv+1, 0);
+    for (int t=0;t<nt;t++)
+    {
+        m_VTFirst[m_Triangle[t].v1+1]++;
+        m_VTFirst[m_Triangle[t].v2+1]++;
+        m_VTFirst[m_Triangle[t].v3+1]++;
+    }
+    for (int v=0;v<nv;v++)
+        m_VTFirst[v+1] += m_VTFirst[v];
+    m_VT.resize(m_VTFirst[nv]);
+    {
+        std::vector<int> next(m_VTFirst.begin(), m_VTFirst.end()-1);
+        for (int t=0;t<nt;t++)
+        {
+            m_VT[next[m_Triangle[t].v1]++] = t;
+            m_VT[next[m_Triangle[t].v2]++] = t;
+            m_VT[next[m_Triangle[t].v3]++] = t;
+        }
+    }
+
+    //=== edges: the neighbours of u with a larger id, edge ids in the order of (u,v)
+    m_EFirst.assign(nv+1, 0);
+    for (int u=0;u<nv;u++)
+    {
+        std::vector<int> up;
+        for (int k=m_VTFirst[u];k<m_VTFirst[u+1];k++)
+        {
+            const Triangle_Map &T = m_Triangle[m_VT[k]];
+            int w[3] = {T.v1, T.v2, T.v3};
+            for (int c=0;c<3;c++)
+                if(w[c]>u)
+                    up.push_back(w[c]);
+        }
+        std::sort(up.begin(), up.end());
+        up.erase(std::unique(up.begin(), up.end()), up.end());
+        m_E.insert(m_E.end(), up.begin(), up.end());
+        m_EFirst[u+1] = m_E.size();
+    }
+    long n = 1L<<m_Rounds;
+    m_NoPoints = nv+long(m_E.size())*(n-1)+long(nt)*(n-1)*(n-2)/2;
+
+    //=== patches: recursive bisection of the triangle centres (with the minimum image, back in the box)
+    std::vector<Vec3D> centre(nt);
+    for (int t=0;t<nt;t++)
+    {
+        const Vertex_Map &A = m_Vertex[m_Triangle[t].v1];
+        const Vertex_Map &B = m_Vertex[m_Triangle[t].v2];
+        const Vertex_Map &C = m_Vertex[m_Triangle[t].v3];
+        double a[3] = {A.x, A.y, A.z}, b[3] = {B.x, B.y, B.z}, c[3] = {C.x, C.y, C.z};
+        for (int k=0;k<3;k++)
+        {
+            double L = m_Box(k);
+            double db = b[k]-a[k], dc = c[k]-a[k];
+            if(L>0)
+            {
+                db -= L*floor(db/L+0.5);
+                dc -= L*floor(dc/L+0.5);
+            }
+            double x = a[k]+(db+dc)/3.0;
+            if(L>0)
+                x -= L*floor(x/L);
+            centre[t](k) = x;
+        }
+    }
+    std::vector<int> order(nt);
+    for (int t=0;t<nt;t++)
+        order[t] = t;
+    m_Patch.assign(nt, 0);
+    if(nt>0)
+        Bisect(centre, order.data(), order.data()+nt, 0, m_NoPatches);
+
+    m_VOwner.assign(nv, m_NoPatches);
+    for (int v=0;v<nv;v++)
+        for (int k=m_VTFirst[v];k<m_VTFirst[v+1];k++)
+            m_VOwner[v] = std::min(m_VOwner[v], m_Patch[m_VT[k]]);
+}
+MeshPatches::~MeshPatches()
+{
+
+}
+void MeshPatches::Bisect(const std::vector<Vec3D> &centre, int *t0, int *t1, int p0, int np)
+{
+    if(np==1)
+    {
+        for (int *t=t0;t<t1;t++)
+            m_Patch[*t] = p0;
+        return;
+    }
+    Vec3D lo = centre[*t0], hi = centre[*t0];
+    for (int *t=t0;t<t1;t++)
+        for (int k=0;k<3;k++)
+        {
+            lo(k) = std::min(lo(k), centre[*t](k));
+            hi(k) = std::max(hi(k), centre[*t](k));
+        }
+    int axis = 0;
+    for (int k=1;k<3;k++)
+        if(hi(k)-lo(k)>hi(axis)-lo(axis))
+            axis = k;
+    int nleft = np/2;
+    int *mid = t0+long(t1-t0)*nleft/np;
+    std::nth_element(t0, mid, t1, [&](int a, int b) {
+        return centre[a](axis)<centre[b](axis) || (centre[a](axis)==centre[b](axis) && a<b);
+    });
+    Bisect(centre, t0, mid, p0, nleft);
+    Bisect(centre, mid, t1, p0+nleft, np-nleft);
+}
+MeshBluePrint MeshPatches::Patch(int p)
+{
+    int nv = m_Vertex.size();
+    int nt = m_Triangle.size();
+    m_Current = p;
+
+    //=== the core and m_Halo rings of triangles around it
+    std::vector<char> intri(nt, 0), inv(nv, 0);
+    std::vector<int> tri, ring;
+    for (int t=0;t<nt;t++)
+        if(m_Patch[t]==p)
+            tri.push_back(t);
+    for (int h=0;h<=m_Halo;h++)
+    {
+        std::vector<int> added;
+        for (size_t i=0;i<tri.size();i++)
+        {
+            if(intri[tri[i]])
+                continue;
+            intri[tri[i]] = 1;
+            const Triangle_Map &T = m_Triangle[tri[i]];
+            int w[3] = {T.v1, T.v2, T.v3};
+            for (int c=0;c<3;c++)
+                if(inv[w[c]]==0)
+                {
+                    inv[w[c]] = 1;
+                    added.push_back(w[c]);
+                }
+        }
+        tri.clear();
+        if(h==m_Halo)
+            break;
+        for (size_t i=0;i<added.size();i++)
+            for (int k=m_VTFirst[added[i]];k<m_VTFirst[added[i]+1];k++)
+                if(intri[m_VT[k]]==0)
+                    tri.push_back(m_VT[k]);
+    }
+
+    //=== local numbering in the order of the base ids
+    std::vector<int> local(nv, -1);
+    m_Local.clear();
+    for (int v=0;v<nv;v++)
+        if(inv[v])
+        {
+            local[v] = m_Local.size();
+            m_Local.push_back(v);
+        }
+    MeshBluePrint blueprint;
+    blueprint.simbox = m_Box;
+    for (size_t i=0;i<m_Local.size();i++)
+    {
+        Vertex_Map v = m_Vertex[m_Local[i]];
+        v.id = i;
+        blueprint.bvertex.push_back(v);
+    }
+    for (int t=0;t<nt;t++)
+        if(intri[t])
+        {
+            Triangle_Map T = m_Triangle[t];
+            T.id = blueprint.btriangle.size();
+            T.v1 = local[T.v1];
+            T.v2 = local[T.v2];
+            T.v3 = local[T.v3];
+            blueprint.btriangle.push_back(T);
+        }
+    m_Lineage.resize(m_Local.size());
+    for (size_t i=0;i<m_Local.size();i++)
+    {
+        Lineage &L = m_Lineage[i];
+        L.V[0] = m_Local[i]; L.V[1] = -1; L.V[2] = -1;
+        L.W[0] = 1; L.W[1] = 0; L.W[2] = 0;
+    }
+    return blueprint;
+}
+int MeshPatches::LocalVertex(int v) const
+{
+    std::vector<int>::const_iterator it = std::lower_bound(m_Local.begin(), m_Local.end(), v);
+    if(it==m_Local.end() || *it!=v)
+        return -1;
+    return it-m_Local.begin();
+}
+void MeshPatches::Refine(MESH *pMesh)
+{
+    //=== the new vertices come after the old ones, one per link in the order m_pHL then m_pEdgeL (Surface_Mosaicing)
+    size_t nold = (pMesh->m_pActiveV).size();
+    if(nold!=m_Lineage.size())
+    {
+        std::cout<<"---> error: something wrong here, report to developer and send this id: PLM7730412 \n";
+        ToolExit::Exit(1);
+    }
+    for (size_t i=0;i<nold;i++)
+        for (int k=0;k<3;k++)
+            m_Lineage[i].W[k] *= 2;
+    std::vector<links *> vlink = pMesh->m_pHL;
+    vlink.insert(vlink.end(), (pMesh->m_pEdgeL).begin(), (pMesh->m_pEdgeL).end());
+    m_Lineage.resize(nold+vlink.size());
+    for (size_t l=0;l<vlink.size();l++)
+    {
+        const Lineage &A = m_Lineage[(vlink[l]->GetV1())->GetVID()];
+        const Lineage &B = m_Lineage[(vlink[l]->GetV2())->GetVID()];
+        Lineage M = A;
+        for (int k=0;k<3;k++)
+            M.W[k] = A.W[k]/2;
+        for (int j=0;j<3 && B.W[j]>0;j++)
+        {
+            int k = 0;
+            while(k<3 && M.W[k]>0 && M.V[k]!=B.V[j])
+                k++;
+            if(k==3)
+            {
+                std::cout<<"---> error: a refined vertex is not on one base triangle, PLM7730413 \n";
+                ToolExit::Exit(1);
+            }
+            M.V[k] = B.V[j];
+            M.W[k] += B.W[j]/2;
+        }
+        m_Lineage[nold+l] = M;
+    }
+}
+long MeshPatches::PointID(int i) const
+{
+    //=== the base vertices of the point in increasing id
+    const Lineage &L = m_Lineage[i];
+    int V[3], W[3], s = 0;
+    for (int k=0;k<3;k++)
+        if(L.W[k]>0)
+        {
+            V[s] = L.V[k];
+            W[s] = L.W[k];
+            s++;
+        }
+    for (int a=0;a<s;a++)
+        for (int b=a+1;b<s;b++)
+            if(V[b]<V[a])
+            {
+                std::swap(V[a], V[b]);
+                std::swap(W[a], W[b]);
+            }
+    long n = 1L<<m_Rounds;
+    long nv = m_Vertex.size();
+    if(s==1)
+        return (m_VOwner[V[0]]==m_Current) ? V[0] : -1;
+    else if(s==2)
+    {
+        int owner = m_NoPatches;
+        for (int k=m_VTFirst[V[0]];k<m_VTFirst[V[0]+1];k++)
+        {
+            const Triangle_Map &T = m_Triangle[m_VT[k]];
+            if(T.v1==V[1] || T.v2==V[1] || T.v3==V[1])
+                owner = std::min(owner, m_Patch[m_VT[k]]);
+        }
+        if(owner!=m_Current)
+            return -1;
+        return nv+long(FindEdge(V[0], V[1]))*(n-1)+(W[1]-1);
+    }
+    int t = FindTriangle(V[0], V[1], V[2]);
+    if(m_Patch[t]!=m_Current)
+        return -1;
+    long b = W[1], c = W[2];
+    return nv+long(m_E.size())*(n-1)+long(t)*(n-1)*(n-2)/2+(b-1)*(n-1)-(b-1)*b/2+(c-1);
+}
+int MeshPatches::FindEdge(int u, int v) const
+{
+    std::vector<int>::const_iterator first = m_E.begin()+m_EFirst[u];
+    std::vector<int>::const_iterator last = m_E.begin()+m_EFirst[u+1];
+    std::vector<int>::const_iterator it = std::lower_bound(first, last, v);
+    if(it==last || *it!=v)
+    {
+        std::cout<<"---> error: a refined vertex is not on a base edge, PLM7730414 \n";
+        ToolExit::Exit(1);
+    }
+    return it-m_E.begin();
+}
+int MeshPatches::FindTriangle(int u, int v, int w) const
+{
+    for (int k=m_VTFirst[u];k<m_VTFirst[u+1];k++)
+    {
+        const Triangle_Map &T = m_Triangle[m_VT[k]];
+        int a[3] = {T.v1, T.v2, T.v3};
+        std::sort(a, a+3);
+        if(a[0]==u && a[1]==v && a[2]==w)
+            return m_VT[k];
+    }
+    std::cout<<"---> error: a refined vertex is not in a base triangle, PLM7730415 \n";
+    ToolExit::Exit(1);
+}
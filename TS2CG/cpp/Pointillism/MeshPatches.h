@@ -0,0 +1,66 @@
+#if !defined(AFX_MeshPatches_H_3D7A21B8_C13C_5648_BF23_124095086241__INCLUDED_)
+#define AFX_MeshPatches_H_3D7A21B8_C13C_5648_BF23_124095086241__INCLUDED_
+
+#include "SimDef.h"
+#include "CreateMashBluePrint.h"
+#include "MESH.h"
+/*
+ Weria Pezeshkian (weria.pezeshkian@gmail.com)
+ Copyright (c) Weria Pezeshkian
+ Splits a (layer shifted) base mesh into patches that are refined one at a time (PLM -patches).
+
+ The triangles are cut into patches by recursive bisection of their centres; a patch is refined with a halo of
+ triangles around it, so its own vertices have their full neighbourhood. Every refined vertex is followed back to
+ the base mesh: it is a weighted sum of at most three base vertices (one base vertex, a point on a base edge or a
+ point inside a base triangle). This gives each point an id that does not depend on the patches,
+
+   base vertices | 2^R-1 points per base edge | (2^R-1)(2^R-2)/2 points per base triangle
+
+ (R rounds), so the base vertices keep their ids (inclusions, exclusions). A point shared by patches is written by
+ the lowest patch that has a triangle touching its vertex, edge or triangle in its core.
+*/
+class MeshPatches
+{
+public:
+    MeshPatches(const MeshBluePrint &base, int npatch, int rounds, int halo);
+    ~MeshPatches();
+
+    inline int  GetNoPatches()                  const {return m_NoPatches;}
+    inline long GetNoPoints()                   const {return m_NoPoints;}
+    inline int  GetVertexOwner(int v)           const {return m_VOwner[v];}
+
+    // the mesh of patch p (core and halo), vertices numbered locally in the order of the base ids
+    MeshBluePrint Patch(int p);
+    int  LocalVertex(int v) const;              // local id of base vertex v in the current patch, -1 if not there
+    // to be called with the mesh of the current patch just before each mosaicing round
+    void Refine(MESH *pMesh);
+    // the point id of vertex i of the refined patch, or -1 if another patch writes it
+    long PointID(int i) const;
+
+private:
+    struct Lineage                              // weights (sum 2^round) of up to three base vertices
+    {
+        int V[3];
+        int W[3];
+    };
+    int m_NoPatches;
+    int m_Rounds;
+    int m_Halo;
+    int m_Current;
+    long m_NoPoints;
+    std::vector<Triangle_Map> m_Triangle;
+    std::vector<Vertex_Map> m_Vertex;
+    Vec3D m_Box;
+    std::vector<int> m_Patch;                   // patch of each base triangle
+    std::vector<int> m_VOwner;                  // lowest patch of the triangles of a base vertex
+    std::vector<int> m_VTFirst, m_VT;           // triangles of each base vertex (CSR)
+    std::vector<int> m_EFirst, m_E;             // upper neighbours of each base vertex (CSR), edge id = position
+    std::vector<int> m_Local;                   // base id of each local vertex of the current patch
+    std::vector<Lineage> m_Lineage;             // of each vertex of the current patch
+
+    void Bisect(const std::vector<Vec3D> &centre, int *t0, int *t1, int p0, int np);
+    int  FindEdge(int u, int v) const;
+    int  FindTriangle(int u, int v, int w) const;
+};
+
+#endif
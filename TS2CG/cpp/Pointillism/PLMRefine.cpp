@@ -0,0 +1,10 @@
+/* PLM as a library for PCG -TSfile: refine a TS file and keep the point folder in memory.
+   Built into the shared library PLMRefine, which exports only PLMRefineSurface (see RefinedSurface.h).
+ */
+#include "Edit_configuration.h"
+#include "RefinedSurface.h"
+
+extern "C" void PLMRefineSurface(const std::vector<std::string> &args, RefinedSurface &surface)
+{
+    Edit_configuration plm(args, surface);
+}
@@ -0,0 +1,399 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <utime.h>
+#if defined(__linux__)
+#include <sys/ioctl.h>
+#include <linux/fs.h>
+#endif
+#include "PointFolderCache.h"
+
+#define PLMCACHE_MAGIC "TS2CGPC1"     // change the last character when the entry layout changes
+
+namespace {
+const char *PointFiles[] = {"OuterBM.dat", "InnerBM.dat", "IncData.dat", "ExcData.dat"};
+const char *VisFiles[] = {"Upper.gro", "Upper.top", "Upper.vtu", "Lower.gro", "Lower.top", "Lower.vtu"};
+
+unsigned long long Fnv(unsigned long long h, const char *data, size_t n)
+{
+    for (size_t i=0;i<n;i++)
+    {
+        h ^= (unsigned char)(data[i]);
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+// FNV-1a of the content of a file (added to h); false if it can not be read
+bool HashFile(const std::string &file, unsigned long long &h, long long &size)
+{
+    FILE *f = fopen(file.c_str(), "rb");
+    if(f==NULL)
+        return false;
+    std::vector<char> buf(1<<20);
+    size = 0;
+    size_t n;
+    while((n = fread(buf.data(), 1, buf.size(), f))>0)
+    {
+        h = Fnv(h, buf.data(), n);
+        size += n;
+    }
+    bool good = (ferror(f)==0);
+    fclose(f);
+    return good;
+}
+bool IsFile(const std::string &file)
+{
+    struct stat st;
+    return stat(file.c_str(), &st)==0 && S_ISREG(st.st_mode);
+}
+// the two names are the same file
+bool SameFile(const std::string &file1, const std::string &file2)
+{
+    struct stat st1, st2;
+    return stat(file1.c_str(), &st1)==0 && stat(file2.c_str(), &st2)==0 && st1.st_dev==st2.st_dev && st1.st_ino==st2.st_ino;
+}
+// removes the file unless it is the TS file
+void Remove(const std::string &file, const std::string &tsfile)
+{
+    struct stat st;
+    if(lstat(file.c_str(), &st)!=0 || SameFile(file, tsfile))
+        return;
+    unlink(file.c_str());
+}
+// reflink: the two files share blocks until one of them is written (btrfs, xfs, ...)
+bool Reflink(const std::string &src, const std::string &dst)
+{
+    bool good = false;
+#if defined(FICLONE)
+    int in = open(src.c_str(), O_RDONLY);
+    if(in<0)
+        return false;
+    int out = open(dst.c_str(), O_WRONLY|O_CREAT|O_TRUNC, 0644);
+    if(out>=0)
+    {
+        good = (ioctl(out, FICLONE, in)==0);
+        close(out);
+        if(!good)
+            unlink(dst.c_str());
+    }
+    close(in);
+#endif
+    return good;
+}
+bool CopyFile(const std::string &src, const std::string &dst)
+{
+    int in = open(src.c_str(), O_RDONLY);
+    if(in<0)
+        return false;
+    int out = open(dst.c_str(), O_WRONLY|O_CREAT|O_TRUNC, 0644);
+    if(out<0)
+    {
+        close(in);
+        return false;
+    }
+    std::vector<char> buf(1<<20);
+    ssize_t n = 0;
+    bool good = true;
+    while(good && (n = read(in, buf.data(), buf.size()))>0)
+        good = (write(out, buf.data(), n)==n);
+    if(n<0)
+        good = false;
+    close(in);
+    if(close(out)!=0)
+        good = false;
+    if(!good)
+        unlink(dst.c_str());
+    return good;
+}
+// the files of an entry directory (no sub directories)
+std::vector<std::string> ListDir(const std::string &dir)
+{
+    std::vector<std::string> names;
+    DIR *d = opendir(dir.c_str());
+    if(d==NULL)
+        return names;
+    struct dirent *e;
+    while((e = readdir(d))!=NULL)
+    {
+        std::string name = e->d_name;
+        if(name!="." && name!="..")
+            names.push_back(name);
+    }
+    closedir(d);
+    return names;
+}
+void RemoveDir(const std::string &dir)
+{
+    std::vector<std::string> names = ListDir(dir);
+    for (size_t i=0;i<names.size();i++)
+        unlink((dir+"/"+names[i]).c_str());
+    rmdir(dir.c_str());
+}
+}
+
+PointFolderCache::PointFolderCache(const std::string &tsfile, const std::string &options, double budget)
+                : m_TSFile(tsfile),
+                  m_Key(1469598103934665603ULL),
+                  m_Budget(budget)
+{
+    const char *dir = getenv("TS2CG_CACHE_DIR");
+    if(dir==NULL || dir[0]=='\0')
+        return;
+    m_Dir = dir;
+
+    //=== the key: the TS file, the q files of a .top file, and the options
+    long long size = 0;
+    m_Key = Fnv(m_Key, PLMCACHE_MAGIC, 8);
+    HashFile(tsfile, m_Key, size);
+    if(tsfile.substr(tsfile.find_last_of(".") + 1)=="top")
+    {
+        // the same reading as CreateMashBluePrint::Read_Mult_QFile
+        std::ifstream top(tsfile.c_str());
+        std::string str;
+        int id;
+        while (true)
+        {
+            top>>str>>id;
+            if(top.eof())
+                break;
+            m_Key = Fnv(m_Key, str.c_str(), str.size()+1);
+            HashFile(str, m_Key, size);
+            getline(top,str);
+        }
+    }
+    m_Key = Fnv(m_Key, options.c_str(), options.size());
+    char name[64];
+    snprintf(name, sizeof(name), "/plm_%016llx", m_Key);
+    m_Entry = m_Dir+name;
+}
+PointFolderCache::~PointFolderCache()
+{
+
+}
+std::string PointFolderCache::Target(const std::string &folder, const Record &r)
+{
+    if(r.Place=="point")
+        return folder+"/"+r.Name;
+    if(r.Place=="vis")
+        return folder+"visualization_data/"+r.Name;
+    return r.Name;
+}
+std::vector<PointFolderCache::Record> PointFolderCache::Outputs(bool visualization)
+{
+    std::vector<Record> records;
+    for (int i=0;i<4;i++)
+    {
+        Record r = {"point", PointFiles[i], 0, 0};
+        records.push_back(r);
+    }
+    if(visualization)
+    {
+        for (int i=0;i<6;i++)
+        {
+            Record r = {"vis", VisFiles[i], 0, 0};
+            records.push_back(r);
+        }
+        for (int i=0;i<2;i++)
+        {
+            Record r = {"cwd", (i==0) ? "extended.tsi" : "extended.btsi", 0, 0};
+            records.push_back(r);
+        }
+    }
+    return records;
+}
+void PointFolderCache::Clear(const std::string &folder, bool visualization, bool linked) const
+{
+    //=== with linked, a file is removed only if it is the same file (device and inode) as the file of an entry;
+    //    other hard links of the user are left alone
+    std::vector<std::string> entries;
+    if(linked)
+    {
+        std::vector<std::string> names = ListDir(m_Dir);
+        for (size_t i=0;i<names.size();i++)
+            if(names[i].compare(0, 4, "plm_")==0 && names[i].find(".tmp")==std::string::npos)
+                entries.push_back(m_Dir+"/"+names[i]);
+    }
+    std::vector<Record> records = Outputs(visualization);
+    for (size_t i=0;i<records.size();i++)
+    {
+        std::string file = Target(folder, records[i]);
+        bool cached = !linked;
+        for (size_t j=0;j<entries.size() && !cached;j++)
+            cached = SameFile(file, entries[j]+"/"+records[i].Place+"_"+records[i].Name);
+        if(cached)
+            Remove(file, m_TSFile);
+    }
+}
+void PointFolderCache::Release(const std::string &folder, bool visualization) const
+{
+    Clear(folder, visualization, true);
+}
+bool PointFolderCache::ReadManifest(std::vector<Record> &records, bool &visualization) const
+{
+    std::ifstream in((m_Entry+"/manifest").c_str());
+    std::string magic;
+    unsigned long long key = 0;
+    int vis = 0;
+    in>>magic>>std::hex>>key>>std::dec>>vis;
+    if(!in.good() || magic!=PLMCACHE_MAGIC || key!=m_Key)
+        return false;
+    visualization = (vis==1);
+    Record r;
+    while(in>>r.Place>>r.Name>>r.Size>>std::hex>>r.Hash>>std::dec)
+        records.push_back(r);
+    return in.eof() && !records.empty();
+}
+bool PointFolderCache::Fetch(const std::string &folder, bool visualization)
+{
+    if(!GetState())
+        return false;
+    struct stat st;
+    if(stat(m_Entry.c_str(), &st)!=0)
+        return false;
+    std::vector<Record> records;
+    bool hasvis = false;
+    if(!ReadManifest(records, hasvis))
+    {
+        std::cout<<"---> warning: the cache entry "<<m_Entry<<" has no valid manifest, it is removed \n";
+        RemoveDir(m_Entry);
+        return false;
+    }
+    if(visualization && !hasvis)
+        return false;               // stored by a -less run; stored again with the visualization files
+
+    //=== every file must have its size and hash, otherwise the entry is damaged
+    for (size_t i=0;i<records.size();i++)
+    {
+        unsigned long long h = 1469598103934665603ULL;
+        long long size = -1;
+        std::string file = m_Entry+"/"+records[i].Place+"_"+records[i].Name;
+        if(!HashFile(file, h, size) || size!=records[i].Size || h!=records[i].Hash)
+        {
+            std::cout<<"---> warning: the cache entry "<<m_Entry<<" is damaged ("<<records[i].Name<<"), it is removed \n";
+            RemoveDir(m_Entry);
+            return false;
+        }
+    }
+    Clear(folder, visualization, false);
+    for (size_t i=0;i<records.size();i++)
+    {
+        const Record &r = records[i];
+        if(r.Place!="point" && !visualization)
+            continue;
+        std::string src = m_Entry+"/"+r.Place+"_"+r.Name;
+        std::string dst = Target(folder, r);
+        if(SameFile(dst, m_TSFile))
+        {
+            std::cout<<"---> note: "<<dst<<" is the TS file, it is not replaced from the cache \n";
+            continue;
+        }
+        if(!Reflink(src, dst) && link(src.c_str(), dst.c_str())!=0 && !CopyFile(src, dst))
+        {
+            std::cout<<"---> warning: can not take "<<dst<<" from the cache \n";
+            return false;
+        }
+    }
+    utime((m_Entry+"/manifest").c_str(), NULL);    // last use, for the eviction
+    return true;
+}
+void PointFolderCache::Store(const std::string &folder, bool visualization)
+{
+    if(!GetState())
+        return;
+    mkdir(m_Dir.c_str(), 0755);
+    std::vector<Record> records = Outputs(visualization);
+    // built next to the final name and renamed, so a run in parallel never sees half an entry
+    std::ostringstream tmp;
+    tmp<<m_Entry<<".tmp"<<getpid();
+    RemoveDir(tmp.str());
+    if(mkdir(tmp.str().c_str(), 0755)!=0)
+    {
+        std::cout<<"---> warning: can not write the cache entry "<<m_Entry<<"\n";
+        return;
+    }
+    std::ostringstream manifest;
+    manifest<<PLMCACHE_MAGIC<<" "<<std::hex<<m_Key<<std::dec<<" "<<(visualization ? 1 : 0)<<"\n";
+    bool good = true;
+    for (size_t i=0;i<records.size() && good;i++)
+    {
+        Record &r = records[i];
+        std::string src = Target(folder, r);
+        if(!IsFile(src))
+            continue;
+        std::string dst = tmp.str()+"/"+r.Place+"_"+r.Name;
+        r.Hash = 1469598103934665603ULL;
+        good = (Reflink(src, dst) || CopyFile(src, dst)) && HashFile(dst, r.Hash, r.Size);
+        manifest<<r.Place<<" "<<r.Name<<" "<<r.Size<<" "<<std::hex<<r.Hash<<std::dec<<"\n";
+    }
+    if(good)
+    {
+        std::ofstream out((tmp.str()+"/manifest").c_str());
+        out<<manifest.str();
+        out.close();
+        good = out.good();
+    }
+    if(good)
+    {
+        RemoveDir(m_Entry);
+        good = (rename(tmp.str().c_str(), m_Entry.c_str())==0);
+    }
+    if(!good)
+    {
+        std::cout<<"---> warning: can not write the cache entry "<<m_Entry<<"\n";
+        RemoveDir(tmp.str());
+        return;
+    }
+    Evict();
+}
+void PointFolderCache::Evict() const
+{
+    if(m_Budget<=0)
+        return;
+    //=== the entries, least recently used first
+    std::vector<std::pair<time_t, std::string> > entries;
+    std::vector<long long> size;
+    long long total = 0;
+    std::vector<std::string> names = ListDir(m_Dir);
+    for (size_t i=0;i<names.size();i++)
+    {
+        if(names[i].compare(0, 4, "plm_")!=0 || names[i].find(".tmp")!=std::string::npos)
+            continue;
+        std::string entry = m_Dir+"/"+names[i];
+        struct stat st;
+        if(stat((entry+"/manifest").c_str(), &st)!=0)
+            continue;
+        entries.push_back(std::make_pair(st.st_mtime, entry));
+    }
+    std::sort(entries.begin(), entries.end());
+    for (size_t i=0;i<entries.size();i++)
+    {
+        long long s = 0;
+        std::vector<std::string> files = ListDir(entries[i].second);
+        for (size_t j=0;j<files.size();j++)
+        {
+            struct stat st;
+            if(stat((entries[i].second+"/"+files[j]).c_str(), &st)==0)
+                s += st.st_size;
+        }
+        size.push_back(s);
+        total += s;
+    }
+    long long budget = (long long)(m_Budget*1024*1024);
+    for (size_t i=0;i<entries.size() && total>budget;i++)
+    {
+        if(entries[i].second==m_Entry)
+            continue;
+        RemoveDir(entries[i].second);
+        total -= size[i];
+        std::cout<<"---> note: the cache entry "<<entries[i].second<<" is removed (cache size) \n";
+    }
+}
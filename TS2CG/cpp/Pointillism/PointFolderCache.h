@@ -0,0 +1,58 @@
+#if !defined(AFX_PointFolderCache_H_5B3C21B8_C13C_5648_BF23_124095086242__INCLUDED_)
+#define AFX_PointFolderCache_H_5B3C21B8_C13C_5648_BF23_124095086242__INCLUDED_
+
+#include <string>
+#include <vector>
+/*
+ Weria Pezeshkian (weria.pezeshkian@gmail.com)
+ Copyright (c) Weria Pezeshkian
+ Cache of PLM results (-cache), kept in the folder of the environment variable TS2CG_CACHE_DIR.
+
+ The key is a 64 bit FNV-1a hash of the TS file (for a .top file also of its q files) and of the options
+ that change the points. An entry plm_<key> holds the files of the point folder (and, for runs without
+ -less, the visualization files and extended.tsi or extended.btsi) with a manifest of their sizes and hashes. On a hit the
+ files are checked against the manifest and put in place as reflinks, hard links or copies; an entry that
+ does not match is removed and PLM runs again. After a new entry is stored, the least recently used
+ entries are removed until all entries fit in the size budget.
+*/
+class PointFolderCache
+{
+public:
+    // options: the values of the options that change the points; budget in MB, 0 for no limit
+    PointFolderCache(const std::string &tsfile, const std::string &options, double budget);
+    ~PointFolderCache();
+
+    inline bool GetState()                  const {return !m_Dir.empty();}     // TS2CG_CACHE_DIR is set
+    inline const std::string &GetEntry()    const {return m_Entry;}
+
+    // removes the files PLM is about to write that are links to a file of a cache entry, so nothing is
+    // written through a link into the cache; the TS file and all other files are left alone
+    void Release(const std::string &folder, bool visualization) const;
+    // puts the stored files of this key in place; false if there is no (good) entry
+    bool Fetch(const std::string &folder, bool visualization);
+    // stores the files PLM has written and evicts old entries
+    void Store(const std::string &folder, bool visualization);
+
+private:
+    struct Record                               // one file of an entry
+    {
+        std::string Place;                      // point, vis or cwd
+        std::string Name;
+        long long Size;
+        unsigned long long Hash;
+    };
+    std::string m_Dir;
+    std::string m_TSFile;
+    std::string m_Entry;                        // m_Dir/plm_<key>
+    unsigned long long m_Key;
+    double m_Budget;
+
+    static std::string Target(const std::string &folder, const Record &r);
+    static std::vector<Record> Outputs(bool visualization);    // the files of an entry, without sizes and hashes
+    // removes the files a Fetch puts in place (linked: only the links into an entry), never the TS file
+    void Clear(const std::string &folder, bool visualization, bool linked) const;
+    bool ReadManifest(std::vector<Record> &records, bool &visualization) const;
+    void Evict() const;
+};
+
+#endif
@@ -27,6 +27,13 @@
 #define Def_resizeboxdist           "-b_dist"
 #define Def_Monolayer           "-monolayer"
 #define Def_PrintLessPutput           "-less"
+#define Def_Threads           "-nt"
+#define Def_Patches           "-patches"
+#define Def_Cache             "-cache"    // reuse point folders from TS2CG_CACHE_DIR, the value is the size budget in MB
+#define Def_VisLevel          "-vislevel"     // mosaicing rounds of the mesh the visualisation files are written from
+#define Def_VisFormat         "-visformat"    // ascii, binary or zlib: format of the vtu and tsi visualisation files
+#define Def_Vertices          "-vertices"     // -r vertexinfo for many vertices: all, ids and ranges (0,4,10-20) or a file of them
+#define Def_VertexFormat      "-vertexformat" // csv, json or binary: format of the -vertices output
 
 
 #define KBT 1
@@ -42,6 +49,15 @@
 
 
 #define G_tsiPrecision     "18.10"
+// binary tsi (.btsi), in the byte order of the machine: the magic (8 characters), the int BinaryTSI_Order,
+// the box (3 doubles), then the vertices, triangles, inclusions and exclusions, each as a long long count
+// and packed records: vertex int id, double x y z, int domain; triangle int id v1 v2 v3; inclusion int id type vertex,
+// double direction (2); exclusion int id vertex, double radius
+#define BinaryTSI_Magic    "TSIBIN02"
+#define BinaryTSI_Order    0x01020304
+// -vertices binary output (vertexinfo.bin): the magic, the int BinaryTSI_Order, a long long count, then per vertex
+// int id and 15 doubles: x y z, area, normal, T1, T2, C1 C2
+#define VertexInfo_Magic   "VTXINF01"
 
 
 
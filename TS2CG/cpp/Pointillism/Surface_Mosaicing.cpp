@@ -6,6 +6,175 @@
 #include "VMDOutput.h"
 #include "WriteFiles.h"
 #include "Curvature.h"
+#include "Parallel.h"
+#include "ToolExit.h"
+
+#define MOSAIC_BLOCK 4096       // vertices, links or triangles handed to a thread at a time
+
+//=== f(i) for i = 0..n-1, in blocks on all threads
+template <class F> static void ForEach(long n, F f)
+{
+    Parallel::For((n+MOSAIC_BLOCK-1)/MOSAIC_BLOCK, [&](int b) {
+        long end = std::min(n, long(b+1)*MOSAIC_BLOCK);
+        for (long i=long(b)*MOSAIC_BLOCK;i<end;i++)
+            f(i);
+    });
+}
+
+//=== the old vertices as arrays by vertex id, read by the mid point kernels
+struct VertexFrames
+{
+    std::vector<double> X;          // x y z
+    std::vector<double> G2L;        // 9 per vertex, row major
+    std::vector<double> L2G;
+    std::vector<double> N;          // normal (Type2)
+    std::vector<double> C;          // the two principal curvatures (Type2)
+};
+static inline void Mult(const double *M, const double *A, double *R)     // R = M A, as Tensor2*Vec3D
+{
+    R[0] = M[0]*A[0]+M[1]*A[1]+M[2]*A[2];
+    R[1] = M[3]*A[0]+M[4]*A[1]+M[5]*A[2];
+    R[2] = M[6]*A[0]+M[7]*A[1]+M[8]*A[2];
+}
+static inline double Norm(const double *A)
+{
+    return sqrt(A[0]*A[0]+A[1]*A[1]+A[2]*A[2]);
+}
+//=== the mid points of n links (vertex ids i1[k], i2[k]) written to out as x y z; rough[k] is set if the surface is
+//=== very rough there. Type is 0, 1 or 2 (-AlgType); the operations are those of the one link version, in the same order.
+template <int Type> static void MidPointKernel(const VertexFrames &F, const int *i1, const int *i2, int n, const Vec3D &box, bool smooth, bool warn, double *out, char *rough)
+{
+    //--- mid point and link vector with the minimum image, one component at a time over the block
+    std::vector<double> mid(3*n), dir(3*n), a(n), c(n);
+    for (int k=0;k<3;k++)
+    {
+        double b = box(k);
+        double half = box(k)/2;
+        for (int i=0;i<n;i++)
+        {
+            a[i] = F.X[3*i1[i]+k];
+            c[i] = F.X[3*i2[i]+k];
+        }
+        double *m = mid.data()+k*n;
+        double *d = dir.data()+k*n;
+        for (int i=0;i<n;i++)
+        {
+            double dd = c[i]-a[i];
+            double mm = (a[i]+c[i])/2.0;
+            bool wrap = fabs(a[i]-c[i])>half;
+            m[i] = wrap ? mm+half : mm;
+            d[i] = wrap ? ((dd<0) ? dd+b : dd-b) : dd;
+        }
+    }
+    for (int i=0;i<n;i++)
+    {
+        double *X = out+3*i;
+        X[0] = mid[i];
+        X[1] = mid[n+i];
+        X[2] = mid[2*n+i];
+        rough[i] = 0;
+        if(Type==0)
+            continue;
+
+        double g[3] = {dir[i], dir[n+i], dir[2*n+i]};
+        double Linklenght = Norm(g);
+        double s = 1/Norm(g);
+        for (int k=0;k<3;k++)
+            g[k] = g[k]*s;
+
+        //--- the link direction in the tangent plane of each vertex, back in the global frame
+        double Lo1[3], Lo2[3], Glo1[3], Glo2[3];
+        Mult(&F.G2L[9*i1[i]], g, Lo1);
+        Lo1[2] = 0;
+        s = 1/Norm(Lo1);
+        for (int k=0;k<3;k++)
+            Lo1[k] = Lo1[k]*s;
+        Mult(&F.L2G[9*i1[i]], Lo1, Glo1);
+        Mult(&F.G2L[9*i2[i]], g, Lo2);
+        Lo2[2] = 0;
+        s = 1/Norm(Lo2);
+        for (int k=0;k<3;k++)
+            Lo2[k] = Lo2[k]*s;
+        Mult(&F.L2G[9*i2[i]], Lo2, Glo2);
+
+        //--- Householder frame with the link along z
+        double Nl[3] = {g[0], g[1], g[2]};
+        if(Nl[2]==-1)
+        {
+            Nl[1] = 0.00000001;
+            s = 1/Norm(Nl);
+            for (int k=0;k<3;k++)
+                Nl[k] = Nl[k]*s;
+        }
+        double Zk[3] = {0.0+Nl[0], 0.0+Nl[1], 1.0+Nl[2]};
+        s = 1.0/Norm(Zk);
+        for (int k=0;k<3;k++)
+            Zk[k] = Zk[k]*s;
+        double Hous[9];
+        for (int r=0;r<3;r++)
+            for (int q=0;q<3;q++)
+                Hous[3*r+q] = (((r==q) ? 1.0 : 0.0)-(Zk[r]*Zk[q])*2)*(-1);
+
+        double t_1[3], t_2[3];
+        Mult(Hous, Glo2, t_2);
+        Mult(Hous, Glo1, t_1);
+        s = 1/t_2[2];
+        for (int k=0;k<3;k++)
+            t_2[k] = t_2[k]*s;
+        s = 1/t_1[2];
+        for (int k=0;k<3;k++)
+            t_1[k] = t_1[k]*s;
+        for (int k=0;k<3;k++)
+        {
+            t_2[k] = t_2[k]*(Linklenght/2.0);
+            t_1[k] = t_1[k]*(Linklenght/2.0);
+        }
+
+        double Dr[3] = {0, 0, 0};
+        if(Type==2)
+        {
+            const double *N1 = &F.N[3*i1[i]];
+            const double *N2 = &F.N[3*i2[i]];
+            const double *C1 = &F.C[2*i1[i]];
+            const double *C2 = &F.C[2*i2[i]];
+            double Curve1=C1[0]*Lo1[0]*Lo1[0]+C1[1]*Lo1[1]*Lo1[1];
+            double Curve2=C2[0]*Lo2[0]*Lo2[0]+C2[1]*Lo2[1]*Lo2[1];
+            double tt1 = t_1[0]*t_1[0]+t_1[1]*t_1[1]+t_1[2]*t_1[2];
+            double tt2 = t_2[0]*t_2[0]+t_2[1]*t_2[1]+t_2[2]*t_2[2];
+            double D2X_1=Curve1*tt1*(2*N1[2]*t_1[0]/Linklenght-N1[0]);
+            double D2Y_1=Curve1*tt1*(2*N1[2]*t_1[1]/Linklenght-N1[1]);
+            double D2X_2=Curve2*tt2*(2*N2[2]*t_2[0]/Linklenght-N2[0]);
+            double D2Y_2=Curve2*tt2*(2*N2[2]*t_2[1]/Linklenght-N2[1]);
+            Dr[0]=(D2X_1+D2X_2+5*(t_1[0]-t_2[0]))/16.0;
+            Dr[1]=(D2Y_1+D2Y_2+5*(t_1[1]-t_2[1]))/16.0;
+        }
+        else
+        {
+            Dr[0]=(t_1[0]-t_2[0])/4;
+            Dr[1]=(t_1[1]-t_2[1])/4;
+        }
+        // For highly rough surfaces
+        double drsize = Norm(Dr);
+        if(smooth)
+        {
+            if(drsize>0.5*Linklenght)
+            {
+                s = 0.2*Linklenght/drsize;
+                for (int k=0;k<3;k++)
+                    Dr[k] = Dr[k]*s;
+            }
+        }
+        else if(drsize>0.5*Linklenght && warn)
+            rough[i] = 1;
+
+        double GDr[3];
+        for (int k=0;k<3;k++)
+            GDr[k] = Hous[k]*Dr[0]+Hous[3+k]*Dr[1]+Hous[6+k]*Dr[2];
+        if(!isnan(GDr[0]) && !isnan(GDr[1]) && !isnan(GDr[2]))
+            for (int k=0;k<3;k++)
+                X[k] = X[k]+GDr[k];
+    }
+}
 
 Surface_Mosaicing::Surface_Mosaicing(std::string altype, bool smooth)
 {
@@ -32,28 +201,85 @@ void Surface_Mosaicing::PerformMosaicing(MESH * pMesh)
 Surface_Mosaicing::~Surface_Mosaicing() {
     
 }
-void  Surface_Mosaicing::GenerateMidVForAllLinks(std::vector<links *> vlink)
+void  Surface_Mosaicing::GenerateMidVForAllLinks(const std::vector<vertex *> &oldV, const std::vector<links *> &vlink)
 {
     //=========================================
-        //===== for each link, generate a mid vertex
+        //===== for each link, generate a mid vertex; the slots after the old vertices are already there
     //=========================================
-        int inisize = (m_Mesh.m_Vertex).size();
-        int id=inisize;
-        for (std::vector<links *>::iterator it = vlink.begin() ; it != vlink.end(); ++it)
+        int inisize = (m_Mesh.m_Vertex).size()-vlink.size();
+        long nl = vlink.size();
+
+    //=== the kernel of the algorithm, chosen once
+        void (*kernel)(const VertexFrames &, const int *, const int *, int, const Vec3D &, bool, bool, double *, char *) = NULL;
+        if(m_AlgorithmType == "Type2")
+            kernel = MidPointKernel<2>;
+        else if(m_AlgorithmType == "Type1")
+            kernel = MidPointKernel<1>;
+        else if(m_AlgorithmType == "Type0")
+            kernel = MidPointKernel<0>;
+        else
         {
-                double x,y,z;
-                BestEstimateOfMidPointPossition((*it), &x, &y,&z);
-                if(isnan(x))
-                {
-                    std::cout<<"error---> estimate of the mid point is bad "<<x<<"  "<<y<<"  "<<z<<"\n";
-                    exit(1);
-                }
-                vertex v(id,x,y,z);
+            std::cout<<"---> error: something wrong here, report to developer and send this id: PLM0983741 \n";
+            ToolExit::Exit(1);
+        }
+        bool type2 = (m_AlgorithmType == "Type2");
+
+    //=== the old vertices as arrays
+        int nid = 0;
+        for (size_t i=0;i<oldV.size();i++)
+            nid = std::max(nid, oldV[i]->GetVID()+1);
+        VertexFrames F;
+        F.X.resize(3*nid);
+        F.G2L.resize(9*nid);
+        F.L2G.resize(9*nid);
+        if(type2)
+        {
+            F.N.resize(3*nid);
+            F.C.resize(2*nid);
+        }
+        ForEach(oldV.size(), [&](long i) {
+            vertex *v = oldV[i];
+            int id = v->GetVID();
+            F.X[3*id] = v->GetVXPos();
+            F.X[3*id+1] = v->GetVYPos();
+            F.X[3*id+2] = v->GetVZPos();
+            Tensor2 G2L = v->GetG2LTransferMatrix();
+            Tensor2 L2G = v->GetL2GTransferMatrix();
+            std::copy(G2L.data(), G2L.data()+9, &F.G2L[9*id]);
+            std::copy(L2G.data(), L2G.data()+9, &F.L2G[9*id]);
+            if(type2)
+            {
+                Vec3D N = v->GetNormalVector();
+                std::vector<double> C = v->GetCurvature();
+                for (int k=0;k<3;k++)
+                    F.N[3*id+k] = N(k);
+                F.C[2*id] = C.at(0);
+                F.C[2*id+1] = C.at(1);
+            }
+        });
+        std::vector<int> i1(nl), i2(nl);
+        ForEach(nl, [&](long i) {
+            i1[i] = (vlink[i]->GetV1())->GetVID();
+            i2[i] = (vlink[i]->GetV2())->GetVID();
+        });
+
+    //=== the mid points, a block of links at a time
+        std::vector<double> X(3*nl);
+        std::vector<char> rough(nl, 0);
+        Parallel::For((nl+MOSAIC_BLOCK-1)/MOSAIC_BLOCK, [&](int b) {
+            long first = long(b)*MOSAIC_BLOCK;
+            int n = std::min(nl-first, long(MOSAIC_BLOCK));
+            kernel(F, &i1[first], &i2[first], n, *m_pBox, m_smooth, m_Mash_IS_Smooth, &X[3*first], &rough[first]);
+        });
+
+        ForEach(nl, [&](long i) {
+                links *l = vlink[i];
+                vertex v(inisize+i,X[3*i],X[3*i+1],X[3*i+2]);
                 v.UpdateBox(m_pBox);
             //==== for version 1.1 and above
-                int dom1 = ((*it)->GetV1())->GetDomainID();
-                int dom2 = ((*it)->GetV2())->GetDomainID();
-                if((*it)->GetV1()->m_VertexType == 1 && (*it)->GetV2()->m_VertexType == 1) {
+                int dom1 = (l->GetV1())->GetDomainID();
+                int dom2 = (l->GetV2())->GetDomainID();
+                if(l->GetV1()->m_VertexType == 1 && l->GetV2()->m_VertexType == 1) {
                     v.m_VertexType = 1;
                 }
                 else{
@@ -67,8 +293,8 @@ void  Surface_Mosaicing::GenerateMidVForAllLinks(std::vector<links *> vlink)
                 else
                 {
                     v.UpdateIsFullDomain(false);
-                    bool dtype1 =  ((*it)->GetV1())->GetIsFullDomain();
-                    bool dtype2 =  ((*it)->GetV2())->GetIsFullDomain();
+                    bool dtype1 =  (l->GetV1())->GetIsFullDomain();
+                    bool dtype2 =  (l->GetV2())->GetIsFullDomain();
                     if(dtype2==false)
                         domain = dom1;
                     else if(dtype1==false)
@@ -77,51 +303,58 @@ void  Surface_Mosaicing::GenerateMidVForAllLinks(std::vector<links *> vlink)
                         domain = dom1;
                 }
                 v.UpdateDomainID(domain);
-            (m_Mesh.m_Vertex).push_back(v);
-            id++;
-        }
-    // note, we should first find all the link mid point and then copy them
-    id=inisize;
-    for (std::vector<links *>::iterator it = vlink.begin() ; it != vlink.end(); ++it)
+            (m_Mesh.m_Vertex)[inisize+i] = v;
+            l->UpdateV0(&((m_Mesh.m_Vertex)[inisize+i]));
+            if(l->GetMirrorFlag()==true)
+                (l->GetMirrorLink())->UpdateV0(&((m_Mesh.m_Vertex)[inisize+i]));
+        });
+    //=== the messages in link order
+    for (size_t i=0;i<vlink.size();i++)
     {
-
-        (*it)->UpdateV0(&((m_Mesh.m_Vertex)[id]));
-        if((*it)->GetMirrorFlag()==true)
+        if(rough[i])
+            std::cout << "---> Warning: The surface is very rough. Consider using the '-smooth' option.\n";
+        vertex &v = (m_Mesh.m_Vertex)[inisize+i];
+        if(isnan(v.GetVXPos()))
         {
-        ((*it)->GetMirrorLink())->UpdateV0(&((m_Mesh.m_Vertex)[id]));
+            std::cout<<"error---> estimate of the mid point is bad "<<v.GetVXPos()<<"  "<<v.GetVYPos()<<"  "<<v.GetVZPos()<<"\n";
+            ToolExit::Exit(1);
         }
-        id++;
     }
 }
 void Surface_Mosaicing::MosaicOneRound(MESH * pMesh)
 {    ///
-//---> First we copy the old vertices into the new vertices only the position, box and incs
+//---> Every array of the new mesh is allocated first and its items are found by index: the old vertices, one mid vertex
+//---> per half link, 4 triangles per old triangle and 3 links per triangle. The loops then fill them in parallel
+//---> and the mesh is the same as the one made item by item.
     m_Mesh.m_Inclusion = pMesh->m_Inclusion;
     m_Mesh.m_Exclusion = pMesh->m_Exclusion;
 
-    for (std::vector<vertex *>::iterator it = (pMesh->m_pActiveV).begin() ; it != (pMesh->m_pActiveV).end(); ++it)
-    {
-        double x=(*it)->GetVXPos();
-        double y=(*it)->GetVYPos();
-        double z=(*it)->GetVZPos();
-        int id=(*it)->GetVID();
-        vertex v(id,x,y,z);
-        if((*it)->VertexOwnInclusion()==true)
+    std::vector<vertex *> &oldV = pMesh->m_pActiveV;
+    std::vector<links *> vlink = pMesh->m_pHL;
+    std::vector<links *> elink = pMesh->m_pEdgeL;
+    vlink.insert(vlink.end(), elink.begin(), elink.end());
+    long nv = oldV.size()+vlink.size();
+    (m_Mesh.m_Vertex).assign(nv, vertex());
+    vertex *pV = (m_Mesh.m_Vertex).data();
+
+//---> First we copy the old vertices into the new vertices only the position, box, incs and domain
+    ForEach(oldV.size(), [&](long i) {
+        vertex *ov = oldV[i];
+        vertex v(ov->GetVID(),ov->GetVXPos(),ov->GetVYPos(),ov->GetVZPos());
+        if(ov->VertexOwnInclusion()==true)
         {
             v.UpdateOwnInclusion(true);
-            int incid = ((*it)->GetInclusion())->GetID();
+            int incid = (ov->GetInclusion())->GetID();
             v.UpdateInclusion(&((m_Mesh.m_Inclusion)[incid]));
         }
-        v.UpdateDomainID((*it)->GetDomainID());
+        v.UpdateDomainID(ov->GetDomainID());
+        v.UpdateIsFullDomain(ov->GetIsFullDomain());
         v.UpdateBox(m_pBox);
-        (m_Mesh.m_Vertex).push_back(v);
-    }
+        pV[i] = v;
+    });
 
 //------> finding the mid point
-    std::vector<links *> vlink = pMesh->m_pHL;
-    std::vector<links *> elink = pMesh->m_pEdgeL;
-    vlink.insert(vlink.end(), elink.begin(), elink.end());
-    GenerateMidVForAllLinks(vlink);
+    GenerateMidVForAllLinks(oldV, vlink);
 //-------> Now we have all the vertices
 //-------> we can give the inclusions a vertex
     for (std::vector<inclusion>::iterator it = (m_Mesh.m_Inclusion).begin() ; it != (m_Mesh.m_Inclusion).end(); ++it)
@@ -129,7 +362,7 @@ void Surface_Mosaicing::MosaicOneRound(MESH * pMesh)
         int vid = (it->Getvertex())->GetVID();
         if(vid>=(m_Mesh.m_Vertex).size()){
                 std::cout<<"---> error: something wrong here, report to developer and send this id: PLM9942340 \n";
-                exit(1);
+                ToolExit::Exit(1);
         }
         it->Updatevertex(&((m_Mesh.m_Vertex)[vid]));
         (m_Mesh.m_pInclusion).push_back(&(*it));
@@ -140,151 +373,130 @@ void Surface_Mosaicing::MosaicOneRound(MESH * pMesh)
         int vid = (it->Getvertex())->GetVID();
         if(vid>=(m_Mesh.m_Vertex).size()){
             std::cout<<"---> error: something wrong here, report to developer and send this id: PLM9942333 \n";
-            exit(1);
+            ToolExit::Exit(1);
         }
         it->Updatevertex(&((m_Mesh.m_Vertex)[vid]));
         (m_Mesh.m_pExclusion).push_back(&(*it));
 
     }
 
-//----> generate new triangles
-    
-        int tid=0;
-        for (std::vector<links *>::iterator it = (pMesh->m_pActiveL).begin() ; it != (pMesh->m_pActiveL).end(); ++it)
+//----> generate new triangles; the first link of each old triangle makes its 4 triangles
+    std::vector<links *> &oldL = pMesh->m_pActiveL;
+    std::vector<long> slot(oldL.size(), -1);
+    long nt = 0;
+    for (size_t i=0;i<oldL.size();i++)
+    {
+        triangle *t1=oldL[i]->GetTriangle();
+        if(t1->GetGotMashed()==false)
         {
-            triangle *t1=(*it)->GetTriangle();
-            if(t1->GetGotMashed()==false)
-            {
-                links * l1 = (*it)->GetNeighborLink1();
-                links * l2 = (*it)->GetNeighborLink2();
-                vertex *V1=&((m_Mesh.m_Vertex)[(((*it)->GetV1())->GetVID())]);
-                vertex *V2=&((m_Mesh.m_Vertex)[(((*it)->GetV2())->GetVID())]);
-                vertex *V3=&((m_Mesh.m_Vertex)[(((*it)->GetV3())->GetVID())]);
-                vertex *VM0=(*it)->GetV0();
-                vertex *VM1=l1->GetV0();
-                vertex *VM2=l2->GetV0();
-                triangle T1(tid,V1,VM0,VM2);
-                tid++;
-                triangle T2(tid,VM0,V2,VM1);
-                tid++;
-                triangle T3(tid,VM0,VM1,VM2);
-                tid++;
-                triangle T4(tid,VM2,VM1,V3);
-                tid++;
-                (m_Mesh.m_Triangle).push_back(T1);
-                (m_Mesh.m_Triangle).push_back(T2);
-                (m_Mesh.m_Triangle).push_back(T3);
-                (m_Mesh.m_Triangle).push_back(T4);
-                t1->UpdateGotMashed(true);
-            }
+            slot[i] = 4*nt;
+            nt++;
+            t1->UpdateGotMashed(true);
         }
-    //===
-    for (std::vector<vertex >::iterator it = (m_Mesh.m_Vertex).begin() ; it != (m_Mesh.m_Vertex).end(); ++it)
-    {
-        (m_Mesh.m_pActiveV).push_back(&(*it));
-    }
-    for (std::vector<triangle >::iterator it = (m_Mesh.m_Triangle).begin() ; it != (m_Mesh.m_Triangle).end(); ++it)
-    {
-        (m_Mesh.m_pActiveT).push_back(&(*it));
-    }
-    
-    
-    int li=-1;
-    
-    for (std::vector<triangle*>::iterator it = (m_Mesh.m_pActiveT).begin() ; it != (m_Mesh.m_pActiveT).end(); ++it)
-    {
-        ((*it)->GetV1())->AddtoTraingleList((*it));
-        ((*it)->GetV1())->AddtoNeighbourVertex(((*it)->GetV2()));
-        ((*it)->GetV2())->AddtoTraingleList((*it));
-        ((*it)->GetV2())->AddtoNeighbourVertex(((*it)->GetV3()));
-        ((*it)->GetV3())->AddtoTraingleList((*it));
-        ((*it)->GetV3())->AddtoNeighbourVertex(((*it)->GetV1()));
-        
-        /// create links
-        li++;
-        int id1=li;
-        li++;
-        int id2=li;
-        li++;
-        int id3=li;
-        
-        links l1(id1,(*it)->GetV1(),(*it)->GetV2(),(*it));
-        l1.UpdateV3((*it)->GetV3());
-        
-        links l2(id2,(*it)->GetV2(),(*it)->GetV3(),(*it));
-        l2.UpdateV3((*it)->GetV1());
-        
-        links l3(id3,(*it)->GetV3(),(*it)->GetV1(),(*it));
-        l3.UpdateV3((*it)->GetV2());
-        (m_Mesh.m_Links).push_back(l1);
-        (m_Mesh.m_Links).push_back(l2);
-        (m_Mesh.m_Links).push_back(l3);
-        
-    }
-    li=-1;
-    for (std::vector<triangle*>::iterator it = (m_Mesh.m_pActiveT).begin() ; it != (m_Mesh.m_pActiveT).end(); ++it)
-    {
-        li++;
-        int id1=li;
-        li++;
-        int id2=li;
-        li++;
-        int id3=li;
-        links * l1=&((m_Mesh.m_Links).at(id1));
-        links * l2=&((m_Mesh.m_Links).at(id2));
-        links * l3=&((m_Mesh.m_Links).at(id3));
-        l1->UpdateNeighborLink1(l2);
-        l1->UpdateNeighborLink2(l3);
-        l2->UpdateNeighborLink1(l3);
-        l2->UpdateNeighborLink2(l1);
-        l3->UpdateNeighborLink1(l1);
-        l3->UpdateNeighborLink2(l2);
-        
-        
-        ((*it)->GetV1())->AddtoLinkList(l1);
-        ((*it)->GetV2())->AddtoLinkList(l2);
-        ((*it)->GetV3())->AddtoLinkList(l3);
-        
     }
-    for (std::vector<links>::iterator it = (m_Mesh.m_Links).begin() ; it != (m_Mesh.m_Links).end(); ++it)
+    nt *= 4;
+    (m_Mesh.m_Triangle).assign(nt, triangle(0));
+    triangle *pT = (m_Mesh.m_Triangle).data();
+    ForEach(oldL.size(), [&](long i) {
+        if(slot[i]<0)
+            return;
+        links *l = oldL[i];
+        vertex *V1=&(pV[(l->GetV1())->GetVID()]);
+        vertex *V2=&(pV[(l->GetV2())->GetVID()]);
+        vertex *V3=&(pV[(l->GetV3())->GetVID()]);
+        vertex *VM0=l->GetV0();
+        vertex *VM1=(l->GetNeighborLink1())->GetV0();
+        vertex *VM2=(l->GetNeighborLink2())->GetV0();
+        long tid = slot[i];
+        pT[tid] = triangle(tid,V1,VM0,VM2);
+        pT[tid+1] = triangle(tid+1,VM0,V2,VM1);
+        pT[tid+2] = triangle(tid+2,VM0,VM1,VM2);
+        pT[tid+3] = triangle(tid+3,VM2,VM1,V3);
+    });
+    //===
+    (m_Mesh.m_pActiveV).resize(nv);
+    ForEach(nv, [&](long i) {(m_Mesh.m_pActiveV)[i] = pV+i;});
+    (m_Mesh.m_pActiveT).resize(nt);
+    ForEach(nt, [&](long i) {(m_Mesh.m_pActiveT)[i] = pT+i;});
+
+    //=== the links of triangle k are 3k (V1->V2), 3k+1 (V2->V3) and 3k+2 (V3->V1)
+    (m_Mesh.m_Links).assign(3*nt, links(0));
+    links *pL = (m_Mesh.m_Links).data();
+    ForEach(nt, [&](long k) {
+        triangle *t = pT+k;
+        vertex *v[3] = {t->GetV1(), t->GetV2(), t->GetV3()};
+        for (int c=0;c<3;c++)
+        {
+            links l(3*k+c, v[c], v[(c+1)%3], t);
+            l.UpdateV3(v[(c+2)%3]);
+            l.UpdateNeighborLink1(pL+3*k+(c+1)%3);
+            l.UpdateNeighborLink2(pL+3*k+(c+2)%3);
+            pL[3*k+c] = l;
+        }
+    });
+    (m_Mesh.m_pActiveL).resize(3*nt);
+    ForEach(3*nt, [&](long i) {(m_Mesh.m_pActiveL)[i] = pL+i;});
+
+    //=== the triangles, neighbours and links of each vertex are in triangle order; corner j=3k+c of triangle k
+    //=== is where link j starts, so a counting sort of the corners by vertex gives all three lists
+    std::vector<long> first(nv+1, 0);
+    for (long j=0;j<3*nt;j++)
+        first[(pL[j].GetV1()-pV)+1]++;
+    for (long i=0;i<nv;i++)
+        first[i+1] += first[i];
+    std::vector<long> corner(3*nt);
     {
-        (m_Mesh.m_pActiveL).push_back(&(*it));
+        std::vector<long> next(first.begin(), first.end()-1);
+        for (long j=0;j<3*nt;j++)
+            corner[next[pL[j].GetV1()-pV]++] = j;
     }
-    for (std::vector<links>::iterator it = (m_Mesh.m_Links).begin() ; it != (m_Mesh.m_Links).end(); ++it)
+    ForEach(nv, [&](long i) {
+        pV[i].ReserveLists(first[i+1]-first[i]);
+        for (long n=first[i];n<first[i+1];n++)
+        {
+            pV[i].AddtoTraingleList(pT+corner[n]/3);
+            pV[i].AddtoNeighbourVertex(pL[corner[n]].GetV2());
+        }
+        for (long n=first[i];n<first[i+1];n++)
+            pV[i].AddtoLinkList(pL+corner[n]);
+    });
+
+    //=== the mirror of link j (a->b) is the first link of b that goes to a
+    std::vector<long> partner(3*nt, -1);
+    ForEach(3*nt, [&](long j) {
+        long b = pL[j].GetV2()-pV;
+        int a = (pL[j].GetV1())->GetVID();
+        for (long n=first[b];n<first[b+1];n++)
+            if((pL[corner[n]].GetV2())->GetVID()==a)
+            {
+                partner[j] = corner[n];
+                break;
+            }
+    });
+    for (long j=0;j<3*nt;j++)
     {
-        bool foundM=false;
-        if((it)->GetMirrorFlag()==true)
+        links *it = pL+j;
+        if(it->GetMirrorFlag()==true)
         {
             (m_Mesh.m_pMHL).push_back(it->GetMirrorLink());
-            (m_Mesh.m_pHL).push_back(&(*it));
-            foundM = true;
+            (m_Mesh.m_pHL).push_back(it);
         }
-        else
+        else if(partner[j]>=0)
         {
-            vertex *v1=it->GetV1();
-            vertex *v2=it->GetV2();
-            
-            std::vector<links*>  lList = v2->GetVLinkList();
-            for (std::vector<links*>::iterator it2 = lList.begin() ; it2 != lList.end(); ++it2)
-            {
-                if(((*it2)->GetV2())->GetVID()==v1->GetVID())
-                {
-                    it->UpdateMirrorLink((*it2));
-                    (*it2)->UpdateMirrorLink(&(*it));
-                    it->UpdateMirrorFlag(true);
-                    (*it2)->UpdateMirrorFlag(true);
-                    foundM = true;
-                    break;
-                }
-            }
+            links *it2 = pL+partner[j];
+            it->UpdateMirrorLink(it2);
+            it2->UpdateMirrorLink(it);
+            it->UpdateMirrorFlag(true);
+            it2->UpdateMirrorFlag(true);
         }
-        if(foundM == false)
+        else
         {
-            (m_Mesh.m_pEdgeL).push_back(&(*it));
+            (m_Mesh.m_pEdgeL).push_back(it);
             it->m_LinkType = 1;
         }
     }
     //==== Getting the edge vertex from link
+    std::vector<char> isedge(nv, 0);
     for (std::vector<links*>::iterator it = (m_Mesh.m_pEdgeL).begin() ; it != (m_Mesh.m_pEdgeL).end(); ++it)
     {
         (m_Mesh.m_pEdgeV).push_back((*it)->GetV1());
@@ -292,178 +504,14 @@ void Surface_Mosaicing::MosaicOneRound(MESH * pMesh)
         ((*it)->GetV2())->m_pPrecedingEdgeLink = *it;
         ((*it)->GetV2())->AddtoNeighbourVertex((*it)->GetV1());
         ((*it)->GetV1())->m_VertexType = 1;
+        isedge[(*it)->GetV1()-pV] = 1;
     }
-    for (std::vector<vertex*>::iterator it = (m_Mesh.m_pActiveV).begin() ; it != (m_Mesh.m_pActiveV).end(); ++it)
-    {
-        bool isedge = false;
-        for (std::vector<vertex*>::iterator it2 = (m_Mesh.m_pEdgeV).begin() ; it2 != (m_Mesh.m_pEdgeV).end(); ++it2)
-        {
-            if((*it2)->GetVID()==(*it)->GetVID())
-                isedge = true;
-        }
-        if(isedge==false)
-        (m_Mesh.m_pSurfV).push_back(*it);
-    }
+    for (long i=0;i<nv;i++)
+        if(isedge[i]==0)
+            (m_Mesh.m_pSurfV).push_back(pV+i);
     m_pMesh = &m_Mesh;
 }
 
-void Surface_Mosaicing::BestEstimateOfMidPointPossition(links *l, double *X, double *Y,double *Z)
-{
-    double x=0;
-    double y=0;
-    double z=0;
-    vertex * pv1=l->GetV1();
-    vertex * pv2=l->GetV2();
-
-    Vec3D *pBox=pv1->GetBox();
-    double x1=pv1->GetVXPos();
-    double y1=pv1->GetVYPos();
-    double z1=pv1->GetVZPos();
-               
-    double x2=pv2->GetVXPos();
-    double y2=pv2->GetVYPos();
-    double z2=pv2->GetVZPos();
-
-    double xmid=(x1+x2)/2.0;
-    double ymid=(y1+y2)/2.0;
-    double zmid=(z1+z2)/2.0;
-
-
-        if(fabs(x1-x2)>(*pBox)(0)/2)
-                xmid=xmid+(*pBox)(0)/2;
-        if(fabs(y1-y2)>(*pBox)(1)/2)
-                ymid=ymid+(*pBox)(1)/2;
-        if(fabs(z1-z2)>(*pBox)(2)/2)
-            zmid=zmid+(*pBox)(2)/2;
-
-     Vec3D geodesic_dir(x2-x1,y2-y1,z2-z1);
-     for (int i=0;i<3;i++)
-     {
-         if(fabs(geodesic_dir(i))>(*pBox)(i)/2)
-         {
-             if(geodesic_dir(i)<0)
-             geodesic_dir(i)=geodesic_dir(i)+(*pBox)(i);
-             else if(geodesic_dir(i)>0)
-             geodesic_dir(i)=geodesic_dir(i)-(*pBox)(i);
-         }
-     }
-
-    double Linklenght= geodesic_dir.norm();
-    geodesic_dir = geodesic_dir*(1/geodesic_dir.norm());
-
-     Vec3D Lo_geoV1=(pv1->GetG2LTransferMatrix())*geodesic_dir;
-     Lo_geoV1(2)=0;
-     Lo_geoV1=Lo_geoV1*(1/(Lo_geoV1.norm()));
-     Vec3D Glo_geoV1=(pv1->GetL2GTransferMatrix())*Lo_geoV1;
-    
-    Vec3D Lo_geoV2=(pv2->GetG2LTransferMatrix())*geodesic_dir;
-    Lo_geoV2(2)=0;
-    Lo_geoV2=Lo_geoV2*(1/(Lo_geoV2.norm()));
-    Vec3D Glo_geoV2=(pv2->GetL2GTransferMatrix())*Lo_geoV2;
-
-    
-    Tensor2 Hous = NormalCoord(geodesic_dir);
-
-    Vec3D t_2=Hous*Glo_geoV2;
-    Vec3D t_1=Hous*Glo_geoV1;
-
-
-    t_2=t_2*(1/t_2(2));
-    t_1=t_1*(1/t_1(2));
-
-    t_2=t_2*(Linklenght/2.0);
-    t_1=t_1*(Linklenght/2.0);
-    
-    /// test case to see if inclduign curvature make it better
-    Vec3D Dr(0,0,0);
-
-    if(m_AlgorithmType == "Type2")
-    {
-
-
-    Vec3D N1=pv1->GetNormalVector();
-    Vec3D N2=pv2->GetNormalVector();
-    std::vector <double> C1=pv1->GetCurvature();
-    std::vector <double> C2=pv2->GetCurvature();
-
-        double Cos1=Lo_geoV1(0);
-        double Sin1=Lo_geoV1(1);
-        
-        double Cos2=Lo_geoV2(0);
-        double Sin2=Lo_geoV2(1);
-
-        double Curve1=C1.at(0)*Cos1*Cos1+C1.at(1)*Sin1*Sin1;
-        double Curve2=C2.at(0)*Cos2*Cos2+C2.at(1)*Sin2*Sin2;
-        
-        
-        double D2X_1=Curve1*(t_1.dot(t_1,t_1))*(2*N1(2)*t_1(0)/Linklenght-N1(0));
-        double D2Y_1=Curve1*(t_1.dot(t_1,t_1))*(2*N1(2)*t_1(1)/Linklenght-N1(1));
-        double D2X_2=Curve2*(t_2.dot(t_2,t_2))*(2*N2(2)*t_2(0)/Linklenght-N2(0));
-        double D2Y_2=Curve2*(t_2.dot(t_2,t_2))*(2*N2(2)*t_2(1)/Linklenght-N2(1));
-    double X_0=(D2X_1+D2X_2+5*(t_1(0)-t_2(0)))/16.0;
-    double Y_0=(D2Y_1+D2Y_2+5*(t_1(1)-t_2(1)))/16.0;
-  
-        
-        Dr(0)=X_0;
-        Dr(1)=Y_0;
-    }
-  else if(m_AlgorithmType == "Type1")
-  {
- 
-      Dr(0)=(t_1(0)-t_2(0))/4;
-      Dr(1)=(t_1(1)-t_2(1))/4;
-
-  }
-  else if(m_AlgorithmType == "Type0")
-  {
- 
-      Dr(0)= 0;
-      Dr(1)= 0;
-
-  }
-  else {
-      std::cout<<"---> error: something wrong here, report to developer and send this id: PLM0983741 \n";
-      exit(1);
-  }
-    // For highly rough surfaces
-    {
-        double drsize=Dr.norm();
-       // std::cout<<drsize<<"   "<<Linklenght <<"\n";
-     if(m_smooth==true)
-     {
-         if(drsize>0.5*Linklenght)
-         {
-             
-             Dr = Dr*(0.2*Linklenght/drsize);
-         }
-     }
-    else
-    {
-        if(drsize>0.5*Linklenght && m_Mash_IS_Smooth) {
-            std::cout << "---> Warning: The surface is very rough. Consider using the '-smooth' option.\n";
-        }
-    }
-        
-        
-    }
-    Vec3D GDr = (Hous.Transpose(Hous))*Dr;
-    
-    if(isnan(GDr(0)) || isnan(GDr(1)) || isnan(GDr(2))){
-        x=xmid;
-        y=ymid;
-        z=zmid;
-    }
-    else{
-        x = xmid + GDr(0);
-        y = ymid + GDr(1);
-        z = zmid + GDr(2);
-    }
-
-    *X=x;
-    *Y=y;
-    *Z=z;
-    
-}
 void  Surface_Mosaicing::UpdateGeometry(MESH *pmesh)
 {
     Curvature CurvatureCalculations;
@@ -479,8 +527,7 @@ void  Surface_Mosaicing::UpdateGeometry(MESH *pmesh)
             (*it)->UpdateShapeOperator(m_pBox);
     }
     //======= Prepare vertex:  area and normal vector and curvature of surface vertices not the edge one
-    for (std::vector<vertex *>::iterator it = (pmesh->m_pSurfV).begin() ; it != (pmesh->m_pSurfV).end(); ++it)
-        CurvatureCalculations.SurfVertexCurvature(*it);
+    CurvatureCalculations.SurfVertexCurvature(pmesh->m_pSurfV);
     //====== edge links should be updated
     for (std::vector<links *>::iterator it = (pmesh->m_pEdgeL).begin() ; it != (pmesh->m_pEdgeL).end(); ++it)
             (*it)->UpdateEdgeVector(m_pBox);
@@ -612,7 +659,7 @@ void Surface_Mosaicing::RoughnessOfALink(links *l, double *linklength, double *m
     else
     {
         std::cout<<"---> error: something wrong here, report to developer and send this id: PLM2342340 \n";
-        exit(1);
+        ToolExit::Exit(1);
     }
 
         double drsize=Dr.norm();
@@ -621,25 +668,3 @@ void Surface_Mosaicing::RoughnessOfALink(links *l, double *linklength, double *m
 
     
 }
-Tensor2 Surface_Mosaicing::NormalCoord(Vec3D N)
-{
-
-    Tensor2 Hous;
-    if(N(2)==-1)
-    {
-        N(1)=0.00000001;
-        N=N*(1/N.norm());
-        
-    }
-        Vec3D Zk;
-        Zk(2)=1.0;
-        Zk=Zk+N;
-        Zk=Zk*(1.0/Zk.norm());
-        
-        Tensor2 I('I');
-        Tensor2 W=Hous.makeTen(Zk);
-        Hous=(I-W*2)*(-1);
-    return Hous;
-    
-}
-
@@ -38,8 +38,6 @@ Vec3D *m_pBox;
 private:
     void UpdateGeometry(MESH *pmesh);
     void MosaicOneRound(MESH * pMesh);
-    void BestEstimateOfMidPointPossition(links *, double *x, double *y,double *z);
-    Tensor2 NormalCoord(Vec3D N);
 
 private:
     std::vector<inclusion* > m_Inc;
@@ -55,7 +53,7 @@ public:
     
     // since 2023
 private:
-    void  GenerateMidVForAllLinks(std::vector<links *> vlink);
+    void  GenerateMidVForAllLinks(const std::vector<vertex *> &oldV, const std::vector<links *> &vlink);
 
 //---
     bool m_Mash_IS_Smooth;
@@ -2,6 +2,7 @@
 #include <time.h>
 #include <iomanip>
 #include "Traj_XXX.h"
+#include "Parallel.h"
 
 
 Traj_XXX::Traj_XXX(Vec3D *pBox)
@@ -20,7 +21,12 @@ void Traj_XXX::WriteTSI(int step ,  std::string filename , std::vector< vertex*
 {
     FILE * output;
     output = fopen((filename).c_str(), "w");
-    std::string format = "%"+m_tsiPrecision+"lf%"+m_tsiPrecision+"lf%"+m_tsiPrecision+"lf\n";
+    if(output==NULL)
+    {
+        std::cout<<"---> error: can not open "<<filename<<"\n";
+        return;
+    }
+    std::string format;
     const char* version=SoftWareVersion;
     fprintf(output,"%s\n",version);
 //------
@@ -28,30 +34,36 @@ void Traj_XXX::WriteTSI(int step ,  std::string filename , std::vector< vertex*
     format = "%s%"+m_tsiPrecision+"lf%"+m_tsiPrecision+"lf%"+m_tsiPrecision+"lf\n";
     fprintf(output,format.c_str(),box,(*m_pBox)(0),(*m_pBox)(1),(*m_pBox)(2));
 
+    // the lines are formatted in blocks on all threads (Parallel::Write)
     const char* ver="vertex";
     int size=pver.size();
     fprintf(output,"%s%20d\n",ver,size);
-    format = "%5d%"+m_tsiPrecision+"lf%"+m_tsiPrecision+"lf%"+m_tsiPrecision+"lf\n";
-    for (std::vector<vertex *>::iterator it = pver.begin() ; it != pver.end(); ++it)
-        fprintf(output,format.c_str(),(*it)->GetVID(),(*it)->GetVXPos(),(*it)->GetVYPos(),(*it)->GetVZPos());
-    
+    // the domain of the vertices is a fifth column, only if there is more than domain 0
+    bool domain = false;
+    for (int i=0;i<size && !domain;i++)
+        domain = (pver[i]->GetDomainID()!=0);
+    format = "%5d%"+m_tsiPrecision+"lf%"+m_tsiPrecision+"lf%"+m_tsiPrecision+"lf"+(domain ? "%5d\n" : "\n");
+    Parallel::Write(output, size, [&](int i, std::string &text) {
+        char line[128];
+        text.append(line, snprintf(line, sizeof(line), format.c_str(), pver[i]->GetVID(), pver[i]->GetVXPos(), pver[i]->GetVYPos(), pver[i]->GetVZPos(), pver[i]->GetDomainID()));
+    });
+
     const char* tri="triangle";
     size = ptriangle.size();
     fprintf(output,"%s%20d\n",tri,size);
-    for (std::vector<triangle *>::iterator it = ptriangle.begin() ; it != ptriangle.end(); ++it)
-        fprintf(output,"%10d%10d%10d%10d\n",(*it)->GetTriID(),((*it)->GetV1())->GetVID(),((*it)->GetV2())->GetVID(),((*it)->GetV3())->GetVID());
-    
-    
+    Parallel::Write(output, size, [&](int i, std::string &text) {
+        char line[128];
+        triangle *t = ptriangle[i];
+        text.append(line, snprintf(line, sizeof(line), "%10d%10d%10d%10d\n", t->GetTriID(), (t->GetV1())->GetVID(), (t->GetV2())->GetVID(), (t->GetV3())->GetVID()));
+    });
+
     const char* inc="inclusion";
     size = pinc.size();
     fprintf(output,"%s%20d\n",inc,size);
     format = "%10d%10d%10d%"+m_tsiPrecision+"lf%"+m_tsiPrecision+"lf\n";
-    
-
-    
     for (std::vector<inclusion *>::iterator it = pinc.begin() ; it != pinc.end(); ++it)
         fprintf(output,format.c_str(),(*it)->GetID(),((*it)->GetInclusionTypeID()),((*it)->Getvertex())->GetVID(),((*it)->GetLDirection())(0),((*it)->GetLDirection())(1));
-    
+
     if(pexc.size()!=0)
     {
         const char* exc="exclusion";
@@ -61,11 +73,64 @@ void Traj_XXX::WriteTSI(int step ,  std::string filename , std::vector< vertex*
         for (std::vector<exclusion *>::iterator it = pexc.begin() ; it != pexc.end(); ++it)
         fprintf(output,format.c_str(),(*it)->GetID(),((*it)->Getvertex())->GetVID(),(*it)->GetRadius());
     }
-    
-    
-    
-    
     fclose(output);
-    
 }
-
+namespace {
+template <class T> void Put(std::string &text, T value)
+{
+    text.append((const char*)&value, sizeof(T));
+}
+}
+void Traj_XXX::WriteBinaryTSI(std::string filename , std::vector< vertex* > pver, std::vector< triangle* > ptriangle,  std::vector< inclusion* > pinc , std::vector< exclusion* > pexc)
+{
+    FILE * output;
+    output = fopen((filename).c_str(), "wb");
+    if(output==NULL)
+    {
+        std::cout<<"---> error: can not open "<<filename<<"\n";
+        return;
+    }
+    // layout: see BinaryTSI_Magic in SimDef.h
+    std::string text(BinaryTSI_Magic);
+    Put<int>(text, BinaryTSI_Order);
+    for (int k=0;k<3;k++)
+        Put<double>(text, (*m_pBox)(k));
+    Put<long long>(text, pver.size());
+    fwrite(text.data(), 1, text.size(), output);
+    Parallel::Write(output, pver.size(), [&](int i, std::string &text) {
+        Put<int>(text, pver[i]->GetVID());
+        Put<double>(text, pver[i]->GetVXPos());
+        Put<double>(text, pver[i]->GetVYPos());
+        Put<double>(text, pver[i]->GetVZPos());
+        Put<int>(text, pver[i]->GetDomainID());
+    });
+    text.clear();
+    Put<long long>(text, ptriangle.size());
+    fwrite(text.data(), 1, text.size(), output);
+    Parallel::Write(output, ptriangle.size(), [&](int i, std::string &text) {
+        triangle *t = ptriangle[i];
+        Put<int>(text, t->GetTriID());
+        Put<int>(text, (t->GetV1())->GetVID());
+        Put<int>(text, (t->GetV2())->GetVID());
+        Put<int>(text, (t->GetV3())->GetVID());
+    });
+    text.clear();
+    Put<long long>(text, pinc.size());
+    for (std::vector<inclusion *>::iterator it = pinc.begin() ; it != pinc.end(); ++it)
+    {
+        Put<int>(text, (*it)->GetID());
+        Put<int>(text, (*it)->GetInclusionTypeID());
+        Put<int>(text, ((*it)->Getvertex())->GetVID());
+        Put<double>(text, ((*it)->GetLDirection())(0));
+        Put<double>(text, ((*it)->GetLDirection())(1));
+    }
+    Put<long long>(text, pexc.size());
+    for (std::vector<exclusion *>::iterator it = pexc.begin() ; it != pexc.end(); ++it)
+    {
+        Put<int>(text, (*it)->GetID());
+        Put<int>(text, ((*it)->Getvertex())->GetVID());
+        Put<double>(text, (*it)->GetRadius());
+    }
+    fwrite(text.data(), 1, text.size(), output);
+    fclose(output);
+}
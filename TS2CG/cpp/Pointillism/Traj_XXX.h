@@ -33,6 +33,8 @@ public:
 public:
 
 void WriteTSI(int step ,  std::string filename, std::vector< vertex* > pver, std::vector< triangle* > ptriangle,   std::vector< inclusion* > pinc, std::vector< exclusion* > pexc);
+// the same data in the binary tsi format (.btsi, -visformat binary/zlib)
+void WriteBinaryTSI(std::string filename, std::vector< vertex* > pver, std::vector< triangle* > ptriangle,   std::vector< inclusion* > pinc, std::vector< exclusion* > pexc);
 
 
 
@@ -4,6 +4,7 @@
 
 #include "VMDOutput.h"
 #include "Nfunction.h"
+#include "Parallel.h"
 
 
 VMDOutput::VMDOutput(Vec3D Box, std::vector<vertex* > pver , std::vector<links* > plinks, std::string Filename)
@@ -17,144 +18,8 @@ VMDOutput::~VMDOutput()
 {
     
 }
-void VMDOutput::WriteGro()
+void VMDOutput::MarkVisualize()
 {
-    Nfunction f;
-        for (std::vector<links *>::iterator it = m_pLinks.begin() ; it != m_pLinks.end(); ++it)
-        {
-		(*it)->UpdateVisualize(true);
-	}
-        for (std::vector<links *>::iterator it = m_pLinks.begin() ; it != m_pLinks.end(); ++it)
-        {
-		vertex * v1=(*it)->GetV1();
-		vertex * v2=(*it)->GetV2();
-        vertex * v3=(*it)->GetV3();
-
-
-		double x1=v1->GetVXPos();
-		double x2=v2->GetVXPos();
-		double y1=v1->GetVYPos();
-		double y2=v2->GetVYPos();
-		double z1=v1->GetVZPos();
-		double z2=v2->GetVZPos();
-		double dx=x2-x1;
-		double dy=y2-y1;
-		double dz=z2-z1;
-		bool rep=true;
-
-		if(fabs(dx)>m_Box(0)/2.0)
-		{
-			rep=false;
-		}
-		else if(fabs(dy)>m_Box(1)/2.0)
-		{
-			rep=false;
-		}
-		else if(fabs(dz)>m_Box(2)/2.0)
-		{
-			rep=false;
-		} 
-		if(rep==false)
-		{
-			(*it)->UpdateVisualize(rep);
-		}
-	}
-std::string Filename=m_Filename+".gro";
-	FILE *fgro;
-    fgro = fopen(Filename.c_str(), "w");
-
-    
-                                            
-    							/// resid  res name   noatom   x   y   z
-                                                     const char* Title="Network";
-                                                     int Size=m_pVers.size();
-                                                     
-                                                       fprintf(fgro,  "%s\n",Title);
-                                                       fprintf(fgro, "%5d\n",Size);
-                                                     int i=0;
-          for (std::vector<vertex *>::iterator it = m_pVers.begin() ; it != m_pVers.end(); ++it)
-           {
-               i++;
-                double x=(*it)->GetVXPos();
-                double y=(*it)->GetVYPos();
-                double z=(*it)->GetVZPos();
-
-                if((*it)->VertexOwnInclusion()==false)
-                {
-                        const char* B="C";
-                        const char* A="Ver";
-                        int resid=0;
-                        fprintf(fgro, "%5d%5s%5s%5d%8.3f%8.3f%8.3f%8.4f%8.4f%8.4f\n",resid,A,B,i,x/5.0,y/5.0,z/5.0,0.0,0.0,0.0 );
-                }
-                else
-                {
-                        const char* B="O";
-                        int resid = ((*it)->GetInclusion())->GetInclusionTypeID();
-                        std::string resname = "pro"+f.Int_to_String(resid);
-                        const char* A=resname.c_str();
-                        fprintf(fgro, "%5d%5s%5s%5d%8.3f%8.3f%8.3f%8.4f%8.4f%8.4f\n",resid,A,B,i,x/5.0,y/5.0,z/5.0,0.0,0.0,0.0 );
-                }
-               if(i>20000)
-                   i=0;
-           }
-   fprintf(fgro,  "%10.5f%10.5f%10.5f%10.5f%10.5f%10.5f%10.5f%10.5f%10.5f\n",m_Box(0)/5,m_Box(1)/5,m_Box(2)/5,0.0,0.0,0.0,0.0,0.0,0.0 );
-   fclose(fgro);
-//=================================== 
-//========= make the topology file
-//=======================
-std::string topfile=m_Filename+".top";
-
-                                  std::ofstream Topfile;
-                                  Topfile.open(topfile.c_str());
-
-
-Topfile<<"[ defaults ] \n";
-Topfile<<"1 1 \n";
-Topfile<<"[ atomtypes ] \n";
-Topfile<<"CT1 72.0 0.000 A 0.0 0.0  \n";
-
-
-
-
-
-Topfile<<"[ moleculetype ] \n";
-Topfile<<" surface    1 \n";
-Topfile<<" [atoms] \n";
-i=0;
-          for (std::vector<vertex *>::iterator it = m_pVers.begin() ; it != m_pVers.end(); ++it)
-           {
-		i++;
-               int resid=(*it)->GetGroup();
-
-		Topfile<<i<<" 	CT1 	"<<resid <<"	Sur 	C 	"<<i<<" 	0  \n";
-
-           }
-Topfile<<" [bonds] \n";
-
-          for (std::vector<links *>::iterator it = m_pLinks.begin() ; it != m_pLinks.end(); ++it)
-           {
-		i++;
-		if((*it)->GetVisualize()==true)
-		{
-		int id1=((*it)->GetV1())->GetVID();
-		int id2=((*it)->GetV2())->GetVID();
-		Topfile<<id1+1<<"   "<<id2+1<<" 	1 	1  	20000\n";
-		}
-
-        }
-Topfile<<"[ system ] \n";
-Topfile<<" triangluated surface \n";
-
-Topfile<<"[ molecules ] \n";
-Topfile<<" surface 1 \n";
-}
-
-/////////////////////////
-void VMDOutput::WriteGro2()
-{
-    
-    Nfunction f;
-
     for (std::vector<links *>::iterator it = m_pLinks.begin() ; it != m_pLinks.end(); ++it)
     {
         (*it)->UpdateVisualize(true);
@@ -163,97 +28,106 @@ void VMDOutput::WriteGro2()
     {
         vertex * v1=(*it)->GetV1();
         vertex * v2=(*it)->GetV2();
-        vertex * v3=(*it)->GetV3();
-        
-        
-        double x1=v1->GetVXPos();
-        double x2=v2->GetVXPos();
-        double y1=v1->GetVYPos();
-        double y2=v2->GetVYPos();
-        double z1=v1->GetVZPos();
-        double z2=v2->GetVZPos();
-        double dx=x2-x1;
-        double dy=y2-y1;
-        double dz=z2-z1;
-        bool rep=true;
-        
-        if(fabs(dx)>m_Box(0)/2.0)
-        {
-            rep=false;
-        }
-        else if(fabs(dy)>m_Box(1)/2.0)
-        {
-            rep=false;
-        }
-        else if(fabs(dz)>m_Box(2)/2.0)
-        {
-            rep=false;
-        }
-        if(rep==false)
+
+        double dx=v2->GetVXPos()-v1->GetVXPos();
+        double dy=v2->GetVYPos()-v1->GetVYPos();
+        double dz=v2->GetVZPos()-v1->GetVZPos();
+        if(fabs(dx)>m_Box(0)/2.0 || fabs(dy)>m_Box(1)/2.0 || fabs(dz)>m_Box(2)/2.0)
         {
-            
-            (*it)->UpdateVisualize(rep);
-            
-            
+            (*it)->UpdateVisualize(false);
         }
-        
-        
     }
-    
-    
-    
-    
+}
+void VMDOutput::WriteGro()
+{
+    MarkVisualize();
+    WriteGroFile(5);
+    WriteTopFile();
+}
+void VMDOutput::WriteGro2()
+{
+    MarkVisualize();
+    WriteGroFile(1);
+}
+void VMDOutput::WriteTop()
+{
+    MarkVisualize();
+    WriteTopFile();
+}
+void VMDOutput::WriteGroFile(double unit)
+{
     std::string Filename=m_Filename+".gro";
-    
-    
     FILE *fgro;
     fgro = fopen(Filename.c_str(), "w");
-    
-    
-    
+    if(fgro==NULL)
+    {
+        std::cout<<"---> error: can not open "<<Filename<<"\n";
+        return;
+    }
     /// resid  res name   noatom   x   y   z
     const char* Title="Network";
     int Size=m_pVers.size();
-    
+
     fprintf(fgro,  "%s\n",Title);
     fprintf(fgro, "%5d\n",Size);
-    int i=0;
-    for (std::vector<vertex *>::iterator it = m_pVers.begin() ; it != m_pVers.end(); ++it)
-    {
-        i++;
-        double x=(*it)->GetVXPos();
-        double y=(*it)->GetVYPos();
-        double z=(*it)->GetVZPos();
-        
-        if((*it)->VertexOwnInclusion()==false)
+    // the atom number runs from 1 to 20001 and starts again; the lines are formatted on all threads
+    Parallel::Write(fgro, Size, [&](int j, std::string &text) {
+        vertex *v = m_pVers[j];
+        int i = j%20001+1;
+        double x=v->GetVXPos()/unit;
+        double y=v->GetVYPos()/unit;
+        double z=v->GetVZPos()/unit;
+        char line[160];
+        if(v->VertexOwnInclusion()==false)
         {
-            const char* B="C";
-            const char* A="Ver";
-            int resid=0;
-            fprintf(fgro, "%5d%5s%5s%5d%8.3f%8.3f%8.3f%8.4f%8.4f%8.4f\n",resid,A,B,i,x,y,z,0.0,0.0,0.0 );
+            text.append(line, snprintf(line, sizeof(line), "%5d%5s%5s%5d%8.3f%8.3f%8.3f%8.4f%8.4f%8.4f\n",0,"Ver","C",i,x,y,z,0.0,0.0,0.0));
         }
         else
         {
-            const char* B="O";
-            int resid = ((*it)->GetInclusion())->GetInclusionTypeID();
-            std::string resname = "pro"+f.Int_to_String(resid);
-            const char* A=resname.c_str();
-            
-            fprintf(fgro, "%5d%5s%5s%5d%8.3f%8.3f%8.3f%8.4f%8.4f%8.4f\n",resid,A,B,i,x,y,z,0.0,0.0,0.0 );
+            int resid = (v->GetInclusion())->GetInclusionTypeID();
+            char resname[32];
+            snprintf(resname, sizeof(resname), "pro%d", resid);
+            text.append(line, snprintf(line, sizeof(line), "%5d%5s%5s%5d%8.3f%8.3f%8.3f%8.4f%8.4f%8.4f\n",resid,resname,"O",i,x,y,z,0.0,0.0,0.0));
         }
-        
-        if(i>20000)
-            i=0;
-    }
-    
-    
-    
-    
-    fprintf(fgro,  "%10.5f%10.5f%10.5f%10.5f%10.5f%10.5f%10.5f%10.5f%10.5f\n",m_Box(0),m_Box(1),m_Box(2),0.0,0.0,0.0,0.0,0.0,0.0 );
+    });
+    fprintf(fgro,  "%10.5f%10.5f%10.5f%10.5f%10.5f%10.5f%10.5f%10.5f%10.5f\n",m_Box(0)/unit,m_Box(1)/unit,m_Box(2)/unit,0.0,0.0,0.0,0.0,0.0,0.0 );
     fclose(fgro);
- 
-    
-    
+}
+void VMDOutput::WriteTopFile()
+{
+    std::string topfile=m_Filename+".top";
+    FILE *Topfile = fopen(topfile.c_str(), "w");
+    if(Topfile==NULL)
+    {
+        std::cout<<"---> error: can not open "<<topfile<<"\n";
+        return;
+    }
+    fprintf(Topfile, "[ defaults ] \n");
+    fprintf(Topfile, "1 1 \n");
+    fprintf(Topfile, "[ atomtypes ] \n");
+    fprintf(Topfile, "CT1 72.0 0.000 A 0.0 0.0  \n");
+    fprintf(Topfile, "[ moleculetype ] \n");
+    fprintf(Topfile, " surface    1 \n");
+    fprintf(Topfile, " [atoms] \n");
+    Parallel::Write(Topfile, m_pVers.size(), [&](int j, std::string &text) {
+        char line[128];
+        text.append(line, snprintf(line, sizeof(line), "%d \tCT1 \t%d\tSur \tC \t%d \t0  \n", j+1, m_pVers[j]->GetGroup(), j+1));
+    });
+    fprintf(Topfile, " [bonds] \n");
+    Parallel::Write(Topfile, m_pLinks.size(), [&](int j, std::string &text) {
+        if(m_pLinks[j]->GetVisualize()==true)
+        {
+            char line[128];
+            int id1=(m_pLinks[j]->GetV1())->GetVID();
+            int id2=(m_pLinks[j]->GetV2())->GetVID();
+            text.append(line, snprintf(line, sizeof(line), "%d   %d \t1 \t1  \t20000\n", id1+1, id2+1));
+        }
+    });
+    fprintf(Topfile, "[ system ] \n");
+    fprintf(Topfile, " triangluated surface \n");
+    fprintf(Topfile, "[ molecules ] \n");
+    fprintf(Topfile, " surface 1 \n");
+    fclose(Topfile);
 }
 #endif
 
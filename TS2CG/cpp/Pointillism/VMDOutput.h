@@ -18,8 +18,9 @@ public:
 
 public:
 
-void WriteGro();
-void WriteGro2();
+void WriteGro();        // .gro in nm (the positions /5) and .top
+void WriteGro2();       // .gro with the positions as they are
+void WriteTop();        // only the .top of WriteGro
 void WriteXTC();
 
 private:
@@ -29,6 +30,9 @@ std::vector<vertex* > m_pVers;
 std::vector<links* > m_pLinks; 
 private:
 std::string m_Filename;
+void MarkVisualize();   // bonds that cross the box are not drawn
+void WriteGroFile(double unit);   // the positions and the box are divided by unit
+void WriteTopFile();
   
 
 
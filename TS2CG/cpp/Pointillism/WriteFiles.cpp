@@ -1,7 +1,15 @@
 
 
 
+#include <algorithm>
+#if defined(TS2CG_ZLIB)
+#include <zlib.h>
+#endif
 #include "WriteFiles.h"
+#include "Parallel.h"
+
+#define VTU_BLOCK 16384         // vertices (or triangles) per block when the binary arrays are filled
+#define ZLIB_BLOCK 32768        // bytes per compressed block (-visformat zlib)
 
 
 WriteFiles::WriteFiles(Vec3D *Box)
@@ -27,12 +35,10 @@ WriteFiles::~WriteFiles()
 
 }
 
-void WriteFiles::Writevtu(std::vector< vertex* > ver, std::vector< triangle* > triangle1,  std::vector< links* > links1, std::string Filename)
+int WriteFiles::MarkRepresentation(std::vector< triangle* > &triangle1,  std::vector< links* > &links1)
 {
-
     Vec3D m_Box=*m_pBox;
 
-
     // First make all the triangles visualizable
     for (std::vector<triangle *>::iterator it = triangle1.begin() ; it != triangle1.end(); ++it)
     {
@@ -44,164 +50,259 @@ void WriteFiles::Writevtu(std::vector< vertex* > ver, std::vector< triangle* > t
     {
         vertex * v1=(*it)->GetV1();
         vertex * v2=(*it)->GetV2();
-        vertex * v3=(*it)->GetV3();
-
-
-        double x1=v1->GetVXPos();
-        double x2=v2->GetVXPos();
-        double y1=v1->GetVYPos();
-        double y2=v2->GetVYPos();
-        double z1=v1->GetVZPos();
-        double z2=v2->GetVZPos();
-        double dx=x2-x1;
-        double dy=y2-y1;
-        double dz=z2-z1;
-
 
-        bool rep=true;
+        double dx=v2->GetVXPos()-v1->GetVXPos();
+        double dy=v2->GetVYPos()-v1->GetVYPos();
+        double dz=v2->GetVZPos()-v1->GetVZPos();
 
         if(fabs(dx)>m_Box(0)/2.0 || fabs(dy)>m_Box(1)/2.0 || fabs(dz)>m_Box(2)/2.0)
         {
-
-            rep=false;
+            ((*it)->GetTriangle())->UpdateRepresentation(false);
         }
-        if(rep==false)
-        {
-            ((*it)->GetTriangle())->UpdateRepresentation(rep);
-
-        }
-
     }
-
-
-
-
-
-    int numv=ver.size();
-    int numtri=triangle1.size();
     int numtrirep=0;
-
     for (int i=0;i<triangle1.size();i++)
     {
-        triangle* a=triangle1.at(i);
-        if(a->GetRepresentation()==true)
+        if(triangle1.at(i)->GetRepresentation()==true)
         {numtrirep++;}
-
     }
-
-
-
-    std::ofstream Output;
-    Output.open(Filename.c_str());
-
-
-
-
-    Output<<"<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"BigEndian\">"<<"\n";
-    Output<<"  <UnstructuredGrid>"<<"\n";
-    Output<<"    <Piece NumberOfPoints=\""<<numv<<"\" NumberOfCells=\""<<numtrirep<<"\">"<<"\n";
-    Output<<"      <PointData Scalars=\"scalars\">"<<"\n";
-
-        Output<<"        <DataArray type=\"Float32\" Name=\"inc\" Format=\"ascii\">"<<"\n";
-
-        for (int i=0;i<numv;i++)
+    return numtrirep;
+}
+void WriteFiles::Writevtu(std::vector< vertex* > ver, std::vector< triangle* > triangle1,  std::vector< links* > links1, std::string Filename)
+{
+    int numv=ver.size();
+    int numtri=triangle1.size();
+    int numtrirep=MarkRepresentation(triangle1, links1);
+
+    FILE *Output = fopen(Filename.c_str(), "w");
+    if(Output==NULL)
+    {
+        std::cout<<"---> error: can not open "<<Filename<<"\n";
+        return;
+    }
+    // the lines are formatted in blocks on all threads (Parallel::Write); the numbers are printed as the
+    // stream did: integers as they are, the directions and points fixed with Precision digits
+    char line[256];
+    fprintf(Output,"<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"BigEndian\">\n");
+    fprintf(Output,"  <UnstructuredGrid>\n");
+    fprintf(Output,"    <Piece NumberOfPoints=\"%d\" NumberOfCells=\"%d\">\n",numv,numtrirep);
+    fprintf(Output,"      <PointData Scalars=\"scalars\">\n");
+
+    fprintf(Output,"        <DataArray type=\"Float32\" Name=\"inc\" Format=\"ascii\">\n");
+    Parallel::Write(Output, numv, [&](int i, std::string &text) {
+        text += (ver[i]->VertexOwnInclusion()==true) ? "          1\n" : "          0\n";
+    });
+    fprintf(Output,"        </DataArray>\n");
+
+    fprintf(Output,"        <DataArray type=\"Float32\" Name=\"vtype\" Format=\"ascii\">\n");
+    Parallel::Write(Output, numv, [&](int i, std::string &text) {
+        char l[64];
+        text.append(l, snprintf(l, sizeof(l), "          %d\n", ver[i]->m_VertexType));
+    });
+    fprintf(Output,"        </DataArray>\n");
+
+    fprintf(Output,"        <DataArray type=\"Float32\" Name=\"domain\" Format=\"ascii\">\n");
+    Parallel::Write(Output, numv, [&](int i, std::string &text) {
+        char l[64];
+        text.append(l, snprintf(l, sizeof(l), "          %d\n", ver[i]->GetDomainID()));
+    });
+    fprintf(Output,"        </DataArray>\n");
+
+    fprintf(Output,"        <DataArray type=\"Float32\" Name=\"dir\"  NumberOfComponents=\"3\" Format=\"ascii\">\n");
+    snprintf(line, sizeof(line), "  %.*f    %.*f    %.*f\n", Precision, 0.0, Precision, 0.0, Precision, 0.0);
+    std::string nodir = line;
+    Parallel::Write(Output, numv, [&](int i, std::string &text) {
+        if(ver[i]->VertexOwnInclusion()==true)
         {
-            vertex* a=ver.at(i);
-            if(a->VertexOwnInclusion()==true)
-            {
-                    Output<<"          "<<1<<"\n";
-            }
-            else
-                Output<<"          "<<0<<"\n";
-
+            Vec3D D=(ver[i]->GetL2GTransferMatrix())*((ver[i]->GetInclusion())->GetLDirection());
+            char l[160];
+            text.append(l, snprintf(l, sizeof(l), "  %.*f      %.*f      %.*f\n", Precision, D(0), Precision, D(1), Precision, D(2)));
         }
-        Output<<"        </DataArray>"<<"\n";
-
-    Output<<"        <DataArray type=\"Float32\" Name=\"vtype\" Format=\"ascii\">"<<"\n";
-
-    for (int i=0;i<numv;i++)
-    {
-        vertex* a=ver.at(i);
-
-                Output<<"          "<<a->m_VertexType<<"\n";
-
-
-    }
-    Output<<"        </DataArray>"<<"\n";
-
-    WriteInclusion("dir", ver, &Output);
-
-
-
-
-    Output<<"      </PointData>"<<"\n";
-    Output<<"      <Points>"<<"\n";
-    Output<<"        <DataArray type=\"Float32\" NumberOfComponents=\"3\" Format=\"ascii\">"<<"\n";
-
-
-    for (int i=0;i<numv;i++)
-    {
-        vertex* a=ver.at(i);
-        Output<<"          "<<a->GetVXPos()<<" "<<a->GetVYPos()<<" "<<a->GetVZPos()<<" "<<"\n";
-
-
-    }
-    Output<<"        </DataArray>"<<"\n";
-    Output<<"      </Points>"<<"\n";
-
-    Output<<"      <Cells>"<<"\n";
-    Output<<"        <DataArray type=\"Int32\" Name=\"connectivity\" Format=\"ascii\">"<<"\n";
-
-
-    for (int i=0;i<numtri;i++)
-    {
-
-
-        triangle* a=triangle1.at(i);
-
+        else
+            text += nodir;
+    });
+    fprintf(Output,"        </DataArray>\n");
+
+    fprintf(Output,"      </PointData>\n");
+    fprintf(Output,"      <Points>\n");
+    fprintf(Output,"        <DataArray type=\"Float32\" NumberOfComponents=\"3\" Format=\"ascii\">\n");
+    Parallel::Write(Output, numv, [&](int i, std::string &text) {
+        char l[160];
+        text.append(l, snprintf(l, sizeof(l), "          %.*f %.*f %.*f \n", Precision, ver[i]->GetVXPos(), Precision, ver[i]->GetVYPos(), Precision, ver[i]->GetVZPos()));
+    });
+    fprintf(Output,"        </DataArray>\n");
+    fprintf(Output,"      </Points>\n");
+
+    fprintf(Output,"      <Cells>\n");
+    fprintf(Output,"        <DataArray type=\"Int32\" Name=\"connectivity\" Format=\"ascii\">\n");
+    Parallel::Write(Output, numtri, [&](int i, std::string &text) {
+        triangle* a=triangle1[i];
         if(a->GetRepresentation()==true)
-            Output<<"           "<<(a->GetV1())->GetVID()<<" "<<(a->GetV2())->GetVID()<<" "<<(a->GetV3())->GetVID()<<" "<<"\n";
-
-
-    }
-    Output<<"        </DataArray>"<<"\n";
-    Output<<"        <DataArray type=\"Int32\" Name=\"offsets\" Format=\"ascii\">"<<"\n";
-    int ofset=3;
-    Output<<"          ";
-    for (int i=0;i<numtrirep;i++)
-    {
-
-        Output<<ofset+3*i<<" ";
-
-
-    }
-    Output<<"\n";
-
-    Output<<"        </DataArray>"<<"\n";
-    Output<<"        <DataArray type=\"Int32\" Name=\"types\" Format=\"ascii\">"<<"\n";
-    Output<<"          ";
-    for (int i=0;i<numtrirep;i++)
-    {
-
-        Output<<5<<" ";
-
-
-    }
-    Output<<"\n";
-
-
-
-
-
-
-
-    Output<<"        </DataArray>"<<"\n";
-    Output<<"      </Cells>"<<"\n";
-    Output<<"    </Piece>"<<"\n";
-    Output<<"  </UnstructuredGrid>"<<"\n";
-    Output<<"</VTKFile> "<<"\n";
-
+        {
+            char l[96];
+            text.append(l, snprintf(l, sizeof(l), "           %d %d %d \n", (a->GetV1())->GetVID(), (a->GetV2())->GetVID(), (a->GetV3())->GetVID()));
+        }
+    });
+    fprintf(Output,"        </DataArray>\n");
+    fprintf(Output,"        <DataArray type=\"Int32\" Name=\"offsets\" Format=\"ascii\">\n");
+    fprintf(Output,"          ");
+    Parallel::Write(Output, numtrirep, [&](int i, std::string &text) {
+        char l[32];
+        text.append(l, snprintf(l, sizeof(l), "%d ", 3+3*i));
+    });
+    fprintf(Output,"\n");
+    fprintf(Output,"        </DataArray>\n");
+    fprintf(Output,"        <DataArray type=\"Int32\" Name=\"types\" Format=\"ascii\">\n");
+    fprintf(Output,"          ");
+    Parallel::Write(Output, numtrirep, [&](int, std::string &text) {
+        text += "5 ";
+    });
+    fprintf(Output,"\n");
+    fprintf(Output,"        </DataArray>\n");
+    fprintf(Output,"      </Cells>\n");
+    fprintf(Output,"    </Piece>\n");
+    fprintf(Output,"  </UnstructuredGrid>\n");
+    fprintf(Output,"</VTKFile> \n");
+    fclose(Output);
+}
+void WriteFiles::WriteBinaryvtu(std::vector< vertex* > ver, std::vector< triangle* > triangle1,  std::vector< links* > links1, std::string Filename, bool compress)
+{
+    int numv=ver.size();
+    int numtrirep=MarkRepresentation(triangle1, links1);
+    std::vector<triangle*> rep;
+    rep.reserve(numtrirep);
+    for (size_t i=0;i<triangle1.size();i++)
+        if(triangle1[i]->GetRepresentation()==true)
+            rep.push_back(triangle1[i]);
+
+    //=== the arrays in the order of the header; each one is filled in blocks on all threads
+    std::vector<VTUArray> arrays(8);
+    arrays[0].Header = "<DataArray type=\"Float32\" Name=\"inc\"";
+    arrays[1].Header = "<DataArray type=\"Float32\" Name=\"vtype\"";
+    arrays[2].Header = "<DataArray type=\"Float32\" Name=\"domain\"";
+    arrays[3].Header = "<DataArray type=\"Float32\" Name=\"dir\" NumberOfComponents=\"3\"";
+    arrays[4].Header = "<DataArray type=\"Float32\" NumberOfComponents=\"3\"";
+    arrays[5].Header = "<DataArray type=\"Int32\" Name=\"connectivity\"";
+    arrays[6].Header = "<DataArray type=\"Int32\" Name=\"offsets\"";
+    arrays[7].Header = "<DataArray type=\"UInt8\" Name=\"types\"";
+    arrays[0].Data.resize(numv*sizeof(float));
+    arrays[1].Data.resize(numv*sizeof(float));
+    arrays[2].Data.resize(numv*sizeof(float));
+    arrays[3].Data.resize(3*numv*sizeof(float));
+    arrays[4].Data.resize(3*numv*sizeof(float));
+    arrays[5].Data.resize(3*numtrirep*sizeof(int));
+    arrays[6].Data.resize(numtrirep*sizeof(int));
+    arrays[7].Data.resize(numtrirep, 5);
+    float *inc = (float*)arrays[0].Data.data();
+    float *vtype = (float*)arrays[1].Data.data();
+    float *domain = (float*)arrays[2].Data.data();
+    float *dir = (float*)arrays[3].Data.data();
+    float *points = (float*)arrays[4].Data.data();
+    int *connectivity = (int*)arrays[5].Data.data();
+    int *offsets = (int*)arrays[6].Data.data();
+    Parallel::For((numv+VTU_BLOCK-1)/VTU_BLOCK, [&](int b) {
+        int end = std::min(numv, (b+1)*VTU_BLOCK);
+        for (int i=b*VTU_BLOCK;i<end;i++)
+        {
+            vertex *a = ver[i];
+            Vec3D D;
+            if(a->VertexOwnInclusion()==true)
+                D=(a->GetL2GTransferMatrix())*((a->GetInclusion())->GetLDirection());
+            inc[i] = (a->VertexOwnInclusion()==true) ? 1 : 0;
+            vtype[i] = a->m_VertexType;
+            domain[i] = a->GetDomainID();
+            for (int k=0;k<3;k++)
+                dir[3*i+k] = D(k);
+            points[3*i] = a->GetVXPos();
+            points[3*i+1] = a->GetVYPos();
+            points[3*i+2] = a->GetVZPos();
+        }
+    });
+    Parallel::For((numtrirep+VTU_BLOCK-1)/VTU_BLOCK, [&](int b) {
+        int end = std::min(numtrirep, (b+1)*VTU_BLOCK);
+        for (int i=b*VTU_BLOCK;i<end;i++)
+        {
+            connectivity[3*i] = (rep[i]->GetV1())->GetVID();
+            connectivity[3*i+1] = (rep[i]->GetV2())->GetVID();
+            connectivity[3*i+2] = (rep[i]->GetV3())->GetVID();
+            offsets[i] = 3+3*i;
+        }
+    });
+    // appended data: each array is a UInt64 byte count and the bytes, or with zlib the block header
+    // (number of blocks, block size, size of the last block, compressed sizes) and the compressed blocks
+    for (size_t j=0;j<arrays.size();j++)
+        if(compress)
+            Compress(arrays[j]);
+        else
+        {
+            unsigned long long n = arrays[j].Data.size();
+            arrays[j].Prefix.assign((const char*)&n, sizeof(n));
+        }
 
+    FILE *Output = fopen(Filename.c_str(), "wb");
+    if(Output==NULL)
+    {
+        std::cout<<"---> error: can not open "<<Filename<<"\n";
+        return;
+    }
+    unsigned short one = 1;
+    const char *order = (*(const char*)&one==1) ? "LittleEndian" : "BigEndian";
+    fprintf(Output,"<?xml version=\"1.0\"?>\n");
+    fprintf(Output,"<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"%s\" header_type=\"UInt64\"%s>\n", order, compress ? " compressor=\"vtkZLibDataCompressor\"" : "");
+    fprintf(Output,"  <UnstructuredGrid>\n");
+    fprintf(Output,"    <Piece NumberOfPoints=\"%d\" NumberOfCells=\"%d\">\n",numv,numtrirep);
+    unsigned long long offset = 0;
+    for (size_t j=0;j<arrays.size();j++)
+    {
+        if(j==0)
+            fprintf(Output,"      <PointData Scalars=\"scalars\">\n");
+        if(j==4)
+            fprintf(Output,"      </PointData>\n      <Points>\n");
+        if(j==5)
+            fprintf(Output,"      </Points>\n      <Cells>\n");
+        fprintf(Output,"        %s format=\"appended\" offset=\"%llu\"/>\n", arrays[j].Header.c_str(), offset);
+        offset += arrays[j].Prefix.size()+arrays[j].Data.size();
+    }
+    fprintf(Output,"      </Cells>\n");
+    fprintf(Output,"    </Piece>\n");
+    fprintf(Output,"  </UnstructuredGrid>\n");
+    fprintf(Output,"  <AppendedData encoding=\"raw\">\n   _");
+    for (size_t j=0;j<arrays.size();j++)
+    {
+        fwrite(arrays[j].Prefix.data(), 1, arrays[j].Prefix.size(), Output);
+        fwrite(arrays[j].Data.data(), 1, arrays[j].Data.size(), Output);
+    }
+    fprintf(Output,"\n  </AppendedData>\n");
+    fprintf(Output,"</VTKFile>\n");
+    fclose(Output);
+}
+void WriteFiles::Compress(VTUArray &array)
+{
+#if defined(TS2CG_ZLIB)
+    // the blocks are compressed on all threads
+    unsigned long long n = array.Data.size();
+    int nblock = (n+ZLIB_BLOCK-1)/ZLIB_BLOCK;
+    std::vector<std::string> blocks(nblock);
+    Parallel::For(nblock, [&](int b) {
+        uLong size = std::min<unsigned long long>(ZLIB_BLOCK, n-(unsigned long long)b*ZLIB_BLOCK);
+        uLongf csize = compressBound(size);
+        blocks[b].resize(csize);
+        compress2((Bytef*)&blocks[b][0], &csize, (const Bytef*)array.Data.data()+(size_t)b*ZLIB_BLOCK, size, Z_BEST_SPEED);
+        blocks[b].resize(csize);
+    });
+    std::vector<unsigned long long> header(3+nblock);
+    header[0] = nblock;
+    header[1] = ZLIB_BLOCK;
+    header[2] = (nblock==0) ? 0 : n-(unsigned long long)(nblock-1)*ZLIB_BLOCK;
+    std::vector<char> data;
+    for (int b=0;b<nblock;b++)
+    {
+        header[3+b] = blocks[b].size();
+        data.insert(data.end(), blocks[b].begin(), blocks[b].end());
+    }
+    array.Prefix.assign((const char*)header.data(), header.size()*sizeof(unsigned long long));
+    array.Data.swap(data);
+#endif
 }
 /////////////////////////
 
@@ -20,6 +20,8 @@ public:
 public:
 
 void Writevtu(std::vector<vertex* > ver, std::vector<triangle* > triangle,  std::vector<links* > , std::string Filename);
+// the same data as Writevtu in binary (appended raw) arrays, with compress in zlib blocks (-visformat)
+void WriteBinaryvtu(std::vector<vertex* > ver, std::vector<triangle* > triangle,  std::vector<links* > , std::string Filename, bool compress);
 
 void WritevtuNochange(std::vector<vertex* > ver, std::vector<triangle* > triangle,  std::vector<links* > , std::string Filename);
 void Writefullvtu(std::vector<vertex* > ver, std::vector<triangle* > triangle,  std::vector<links* > , std::string Filename);
@@ -27,6 +29,15 @@ void WriteInclusion(std::string id, std::vector<vertex* > ver, std::ofstream *Ou
     void    Writevtunew(std::vector< vertex* > ver, std::vector< triangle* > triangle1,  std::string Filename);
 private:
 
+struct VTUArray
+{
+    std::string Header;         // the DataArray tag without format and offset
+    std::string Prefix;         // byte count, or the block header of a compressed array
+    std::vector<char> Data;
+};
+// marks the triangles that cross the box as not represented; returns the number of the others
+int MarkRepresentation(std::vector<triangle* > &triangle,  std::vector<links* > &links);
+void Compress(VTUArray &array);
 
 Vec3D *m_pBox;
 
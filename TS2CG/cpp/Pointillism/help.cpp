@@ -64,7 +64,7 @@ help::help(std::string version, std::string exe)
         std::cout << std::left << std::setw(20) << Def_TaskName
                   << std::setw(15) << "string"
                   << std::setw(20) << "PLM"
-                  << "function(PLM/in_out/check/add_pbc)\n";
+                  << "function(PLM/in_out/check/validate/add_pbc)\n";
 
         std::cout << std::left << std::setw(20) << Def_SmoothingFlag
                   << std::setw(15) << "------"
@@ -100,6 +100,41 @@ help::help(std::string version, std::string exe)
                   << std::setw(15) << "bool"
                   << std::setw(20) << "false"
                   << "print less outputs\n";
+
+        std::cout << std::left << std::setw(20) << Def_Threads
+                  << std::setw(15) << "int"
+                  << std::setw(20) << "all cores"
+                  << "number of threads (also TS2CG_NUM_THREADS)\n";
+
+        std::cout << std::left << std::setw(20) << Def_Patches
+                  << std::setw(15) << "int"
+                  << std::setw(20) << "0"
+                  << "refine the surface in this many patches, one at a time, to save memory\n";
+
+        std::cout << std::left << std::setw(20) << Def_Cache
+                  << std::setw(15) << "double"
+                  << std::setw(20) << "off"
+                  << "reuse point folders from TS2CG_CACHE_DIR, size budget in MB (0: no limit)\n";
+
+        std::cout << std::left << std::setw(20) << Def_VisFormat
+                  << std::setw(15) << "string"
+                  << std::setw(20) << "ascii"
+                  << "format of the vtu files and extended.tsi (ascii/binary/zlib)\n";
+
+        std::cout << std::left << std::setw(20) << Def_VisLevel
+                  << std::setw(15) << "int"
+                  << std::setw(20) << "-1"
+                  << "write the visualisation files from the mesh after this many Mosaicing rounds (-1: finest)\n";
+
+        std::cout << std::left << std::setw(20) << Def_Vertices
+                  << std::setw(15) << "string"
+                  << std::setw(20) << "none"
+                  << "with -r vertexinfo: vertices to report, all, ids and ranges (0,4,10-20) or a file of them\n";
+
+        std::cout << std::left << std::setw(20) << Def_VertexFormat
+                  << std::setw(15) << "string"
+                  << std::setw(20) << "csv"
+                  << "format of the -vertices output, vertexinfo.csv/.json/.bin (csv/json/binary)\n";
         
         std::cout << std::left << std::setw(20) << Def_AlgType
                   << std::setw(15) << "string"
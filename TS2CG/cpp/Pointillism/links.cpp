@@ -1,6 +1,7 @@
 
 
 #include "links.h"
+#include "ToolExit.h"
 
 links::links(int id, vertex *v1, vertex *v2, triangle *t1)
 {
@@ -90,7 +91,7 @@ void links::UpdateNormal()
        if(norm==0)
        {
            std::cout<<"error 2022----> one of the normals has zero size; normal link cannot be defined  \n";
-           exit(0);
+           ToolExit::Exit(0);
        }
        m_mirorlink->PutNormal(m_Normal);
     }
@@ -99,7 +100,7 @@ void links::UpdateNormal()
         // this is an edge link
         std::cout<<" link type "<<m_LinkType<<" \n";
         std::cout<<"error ----> normal vector for edge links has not been defined   \n";
-        exit(0);
+        ToolExit::Exit(0);
     }
 
 }
@@ -137,7 +138,7 @@ void links::UpdateShapeOperator(Vec3D *pBox)
        else
        {
            std::cout<<" error 7634---> this should not happen \n";
-           exit(0);
+           ToolExit::Exit(0);
        }
        Be=Be*size;
        Vec3D Nf1=(m_mirorlink->GetTriangle())->GetNormalVector();
@@ -174,7 +175,7 @@ void links::UpdateShapeOperator(Vec3D *pBox)
        else if(tangle>1.01)
        {
            std::cout<<"error--->: somthing wrong with this link \n";
-           exit(0);
+           ToolExit::Exit(0);
        }
 	
        m_Be=Be;
@@ -318,7 +319,7 @@ void links::Flip()
     else
     {
         std::cout<<"error---> a link without a mirror, possibly an edge link, is asked to be flipped, such an action is not possible \n";
-        exit(0);
+        ToolExit::Exit(0);
     }
     
 }
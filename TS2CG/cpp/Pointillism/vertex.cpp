@@ -8,6 +8,7 @@
 #include "Nfunction.h"
 vertex::vertex()
 {
+    m_IsFullDomain = false;
 }
 vertex::vertex(int id, double x, double y, double z)
 {
@@ -30,6 +31,7 @@ m_kappa=1.0;
     m_VertexType = 0;
     m_VLength = 0;                       // length of the vertex
     m_Lambda = 0;                   // line tension
+    m_IsFullDomain = false;
     
     
 }
@@ -54,6 +56,7 @@ m_kappa=1.0;
     m_VertexType = 0;
     m_VLength = 0;                       // length of the vertex
     m_Lambda = 0;                   // line tension
+    m_IsFullDomain = false;
 
 }
 vertex::~vertex()
@@ -153,6 +156,12 @@ void vertex::AddtoNeighbourVertex(vertex* z)
 {
 m_VNeighbourVertex.push_back(z);
 }
+void vertex::ReserveLists(int n)
+{
+m_VLinkList.reserve(n);
+m_VTraingleList.reserve(n);
+m_VNeighbourVertex.reserve(n+1);
+}
 void vertex::RemoveFromNeighbourVertex(vertex* z)
 {
 m_VNeighbourVertex.erase(std::remove(m_VNeighbourVertex.begin(), m_VNeighbourVertex.end(), z), m_VNeighbourVertex.end());
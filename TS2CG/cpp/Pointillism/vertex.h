@@ -34,9 +34,9 @@ public:
         inline Vec3D GetNormalVector()                      {return m_Normal;}
         inline std::vector <double> GetCurvature()          {return m_Curvature;}// surface curvature
         inline double GetEnergy()                           {return m_Energy;}
-        inline std::vector <links *> GetVLinkList()             {return m_VLinkList;}
-        inline std::vector <triangle *> GetVTraingleList()         {return m_VTraingleList;}
-        inline std::vector <vertex *> GetVNeighbourVertex()     {return m_VNeighbourVertex;}
+        inline const std::vector <links *> &GetVLinkList()      {return m_VLinkList;}
+        inline const std::vector <triangle *> &GetVTraingleList() {return m_VTraingleList;}
+        inline const std::vector <vertex *> &GetVNeighbourVertex() {return m_VNeighbourVertex;}
         inline inclusion* GetInclusion()                    {return m_pInclusion;}
         inline bool VertexOwnInclusion()                    {return m_OwnInclusion;}
         inline Vec3D *GetBox()                              {return m_pBox;}
@@ -65,6 +65,7 @@ public:
   void AddtoLinkList(links* z);
   void AddtoTraingleList(triangle * z);
   void AddtoNeighbourVertex(vertex* z);
+  void ReserveLists(int n);       // room for n links, triangles and neighbours
   void RemoveFromLinkList(links* z);
   void RemoveFromTraingleList(triangle * z);
   void RemoveFromNeighbourVertex(vertex* z);
@@ -0,0 +1,223 @@
+/* In-process PCG: build the membrane on points held in python (the same placement as the command line),
+   place copies of a molecule template on points (the rigid-body kernel of that placement), assign
+   domains, geodesic distances, or run PCG with command line arguments.
+ */
+#include <memory>
+#include "PyHelpers.h"
+#include "Job.h"
+#include "Argument.h"
+#include "BackMap.h"
+#include "RefinedSurface.h"
+#include "Tensor2.h"
+#include "RigidTransform.h"
+#include "DomainAssigner.h"
+#include "Geodesic.h"
+
+// one layer of a points dict (as _plm.refine and read_points give it) as a view; keep holds the arrays
+static PointLayerView LayerView(py::handle layer, std::vector<py::object> &keep)
+{
+    py::dict d = layer.cast<py::dict>();
+    PointLayerView v;
+    v.N = -1;
+    // width 0: int column, 1: float column, 3: (n, 3) float
+    auto column = [&](const char *key, int width) -> const void * {
+        if (!d.contains(key))
+            throw std::invalid_argument(std::string("points: no ") + key);
+        py::array a = (width == 0) ? py::array(IArray::ensure(d[key])) : py::array(DArray::ensure(d[key]));
+        if (!a)
+            throw std::invalid_argument(std::string("points: ") + key + " is not a numeric array");
+        py::ssize_t n = a.ndim() ? a.shape(0) : 0;
+        if (v.N < 0)
+            v.N = n;
+        if (n != v.N || (width == 3 && (a.ndim() != 2 || a.shape(1) != 3)) || (width != 3 && a.ndim() != 1))
+            throw std::invalid_argument(std::string("points: ") + key + " does not fit the other columns");
+        keep.push_back(a);
+        return a.data();
+    };
+    v.ID = static_cast<const int *>(column("ids", 0));
+    v.Domain = static_cast<const int *>(column("domain_ids", 0));
+    v.Area = static_cast<const double *>(column("area", 1));
+    v.X = static_cast<const double *>(column("coordinates", 3));
+    v.Normal = static_cast<const double *>(column("normals", 3));
+    v.P1 = static_cast<const double *>(column("p1", 3));
+    v.P2 = static_cast<const double *>(column("p2", 3));
+    v.C1 = static_cast<const double *>(column("c1", 1));
+    v.C2 = static_cast<const double *>(column("c2", 1));
+    if (d.contains("edges"))
+        v.VType = static_cast<const int *>(column("edges", 0));
+    if (d.contains("box"))
+        v.Box = ToBox(DArray::ensure(d["box"]));
+    return v;
+}
+// PCG on the points of a dict {"outer": layer, "inner": layer or None, "inclusions": ..., "exclusions": ...};
+// returns the beads of the gro file. The gro and top files are written too, as by the command line.
+static py::dict Place(py::dict points, const std::vector<std::string> &args, const std::string &cwd)
+{
+    std::vector<py::object> keep;
+    RefinedSurfaceView surface;
+    if (!points.contains("outer"))
+        throw std::invalid_argument("points: no outer layer");
+    surface.Outer = LayerView(points["outer"], keep);
+    if (points.contains("inner") && !points["inner"].is_none())
+        surface.Inner = LayerView(points["inner"], keep);
+    if (points.contains("inclusions") && !points["inclusions"].is_none())
+    {
+        py::dict inc = points["inclusions"].cast<py::dict>();
+        IArray type = IArray::ensure(inc["type"]), point = IArray::ensure(inc["point"]);
+        DArray dir = DArray::ensure(inc["direction"]);
+        if (!type || !point || !dir || point.size() != type.size() || dir.size() != 3*type.size())
+            throw std::invalid_argument("inclusions: type, point and direction (n, 3) must have the same length");
+        surface.IncType.assign(type.data(), type.data() + type.size());
+        surface.IncPoint.assign(point.data(), point.data() + point.size());
+        surface.IncDirection.assign(dir.data(), dir.data() + dir.size());
+    }
+    if (points.contains("exclusions") && !points["exclusions"].is_none())
+    {
+        py::dict exc = points["exclusions"].cast<py::dict>();
+        IArray point = IArray::ensure(exc["point"]);
+        DArray radius = DArray::ensure(exc["radius"]);
+        if (!point || !radius || point.size() != radius.size())
+            throw std::invalid_argument("exclusions: point and radius must have the same length");
+        surface.ExcPoint.assign(point.data(), point.data() + point.size());
+        surface.ExcRadius.assign(radius.data(), radius.data() + radius.size());
+    }
+
+    std::vector<std::string> argument(1, "PCG");
+    argument.insert(argument.end(), args.begin(), args.end());
+    std::vector<std::string> name, resname;
+    std::vector<int> resid;
+    std::vector<double> X;
+    WorkingDirectory dir(cwd);
+    RunTool("PCG", [&]() {
+        Argument arg(argument);
+        arg.SetSurface(&surface);
+        BackMap B(&arg);
+        const std::vector<bead> &beads = B.GetBeads();
+        name.reserve(beads.size());
+        resname.reserve(beads.size());
+        resid.reserve(beads.size());
+        X.reserve(3*beads.size());
+        for (std::vector<bead>::const_iterator it = beads.begin(); it != beads.end(); ++it)
+        {
+            name.push_back(it->GetBeadName());
+            resname.push_back(it->GetResName());
+            resid.push_back(it->GetResid());
+            X.push_back(it->GetXPos()); X.push_back(it->GetYPos()); X.push_back(it->GetZPos());
+        }
+    });
+    py::ssize_t n = resid.size();
+    py::dict out;
+    out["names"] = py::cast(name);
+    out["resnames"] = py::cast(resname);
+    out["resids"] = ToNumpy(std::move(resid), {n});
+    out["coordinates"] = ToNumpy(std::move(X), {n, 3});
+    return out;
+}
+// the same local->global frame as BackMap::TransferMatLG
+static py::array_t<double> Transform(const DArray &tem, const DArray &pos, const DArray &normal, const DArray &p1, const DArray &p2, const DArray &box)
+{
+    if (tem.ndim() != 2 || tem.shape(1) != 3)
+        throw std::invalid_argument("template must have shape (n, 3)");
+    py::ssize_t m = pos.shape(0);
+    for (const DArray *a : {&pos, &normal, &p1, &p2})
+        if (a->ndim() != 2 || a->shape(1) != 3 || a->shape(0) != m)
+            throw std::invalid_argument("positions, normals, p1 and p2 must all have shape (m, 3)");
+    Vec3D B = ToBox(box);
+    int n = tem.shape(0);
+    std::vector<double> out(3*n*m);
+    {
+        py::gil_scoped_release release;
+        // the kernel takes the template as x, y and z columns; a template is a few beads
+        std::vector<double> X(n), Y(n), Z(n);
+        for (int i = 0; i < n; i++)
+        {
+            X[i] = tem.data()[3*i]; Y[i] = tem.data()[3*i+1]; Z[i] = tem.data()[3*i+2];
+        }
+        std::vector<double> ox(n), oy(n), oz(n);
+        const Vec3D *P = AsVec3D(pos, "positions"), *N = AsVec3D(normal, "normals"), *T1 = AsVec3D(p1, "p1"), *T2 = AsVec3D(p2, "p2");
+        for (py::ssize_t k = 0; k < m; k++)
+        {
+            Tensor2 GL(T1[k], T2[k], N[k]);
+            Tensor2 LG = GL.Transpose(GL);
+            RigidTransform::Apply(X.data(), Y.data(), Z.data(), n, LG, P[k], B, ox.data(), oy.data(), oz.data());
+            double *o = &out[3*n*k];
+            for (int i = 0; i < n; i++)
+            {
+                o[3*i] = ox[i]; o[3*i+1] = oy[i]; o[3*i+2] = oz[i];
+            }
+        }
+    }
+    return ToNumpy(std::move(out), {py::ssize_t(m*n), 3});
+}
+// DomainAssigner on arrays; the same numbers PCG -domainspec gives for the same seed and stream
+static py::array_t<int> AssignDomains(const DArray &H, const DArray &area, const IArray &domain_ids, const DArray &percentage,
+                                      const DArray &curvature, double k, bool area_weighted, int seed, unsigned stream)
+{
+    py::ssize_t nl = domain_ids.size();
+    if (percentage.size() != nl || curvature.size() != nl)
+        throw std::invalid_argument("domain_ids, percentages and curvatures must have the same length");
+    if (area.size() != H.size())
+        throw std::invalid_argument("mean_curvature and area must have the same length");
+    std::vector<DomainLipidSpec> specs(nl);
+    for (py::ssize_t i = 0; i < nl; i++)
+    {
+        specs[i].DomainID = domain_ids.data()[i];
+        specs[i].Percentage = percentage.data()[i];
+        specs[i].Curvature = curvature.data()[i];
+        specs[i].Density = 0;
+    }
+    std::vector<int> domain;
+    RunTool("PCG", [&]() { DomainAssigner(specs, k, area_weighted, seed).Assign(H.data(), area.data(), H.size(), domain, stream); });
+    py::ssize_t n = domain.size();
+    return ToNumpy(std::move(domain), {n});
+}
+// geodesic graph of a point layer; built once, then any number of distance fields
+static Geodesic *MakeGeodesic(const DArray &coordinates, const DArray &box, double edge_cutoff, int neighbours)
+{
+    const Vec3D *pos = AsVec3D(coordinates, "coordinates");
+    int n = coordinates.shape(0);
+    Vec3D B = ToBox(box);
+    std::unique_ptr<Geodesic> g(new Geodesic);
+    {
+        py::gil_scoped_release release;
+        g->Build(pos, n, B, edge_cutoff, neighbours);
+    }
+    return g.release();
+}
+static py::tuple GeodesicDistances(const Geodesic &g, const IArray &sources, double cutoff)
+{
+    std::vector<double> dist;
+    std::vector<int> nearest;
+    {
+        py::gil_scoped_release release;
+        g.Distances(sources.data(), sources.size(), cutoff, dist, nearest);
+    }
+    py::ssize_t n = dist.size();
+    return py::make_tuple(ToNumpy(std::move(dist), {n}), ToNumpy(std::move(nearest), {n}));
+}
+PYBIND11_MODULE(_pcg, m)
+{
+    m.doc() = "PCG (membrane builder) in-process";
+    m.def("place", &Place, py::arg("points"), py::arg("args"), py::arg("cwd") = std::string(),
+          "Build the membrane on points held in python, as PCG does on a point folder.\n"
+          "points is a dict like the one _plm.refine and _plm.read_points return ({'outer': layer, 'inner': layer or None}),\n"
+          "optionally with 'inclusions' ({'type', 'point', 'direction'}) and 'exclusions' ({'point', 'radius'}).\n"
+          "args are PCG command line options, e.g. ['-str', 'input.str', '-LLIB', 'Martini3.LIB', '-defout', 'system'].\n"
+          "Returns the beads of the gro file (names, resnames, resids, coordinates); the gro and top files are written in cwd.");
+    m.def("transform", &Transform, py::arg("template"), py::arg("positions"), py::arg("normals"), py::arg("p1"), py::arg("p2"), py::arg("box"),
+          "Place one copy of template (n, 3) on each of the m points with the rigid-body kernel of PCG;\n"
+          "returns (m*n, 3) coordinates wrapped into the box.");
+    m.def("assign_domains", &AssignDomains, py::arg("mean_curvature"), py::arg("area"), py::arg("domain_ids"),
+          py::arg("percentages"), py::arg("curvatures"), py::arg("k") = 1.0, py::arg("area_weighted") = false,
+          py::arg("seed") = 9474, py::arg("stream") = 1,
+          "Curvature driven domain id per point (native DOP). Pass the sign flipped mean curvature for an inner leaflet;\n"
+          "PCG uses stream 1 for the outer and 2 for the inner leaflet.");
+    py::class_<Geodesic>(m, "Geodesic", "Path distances on a point layer (k nearest neighbour graph, periodic box)")
+        .def(py::init(&MakeGeodesic), py::arg("coordinates"), py::arg("box"), py::arg("edge_cutoff") = 5.0, py::arg("neighbours") = 12)
+        .def("distances", &GeodesicDistances, py::arg("sources"), py::arg("cutoff") = 0.0,
+             "One multi-source pass; returns (distance, nearest source index), both -1 beyond cutoff (cutoff<=0: no limit).")
+        .def_property_readonly("edges", &Geodesic::GetNumberOfEdges);
+    m.def("run", [](const std::vector<std::string> &args, const std::string &cwd) { RunInProcess<Job>("PCG", args, cwd); },
+          py::arg("args"), py::arg("cwd") = std::string(), "Run PCG with command line arguments in this process.");
+    m.attr("kernel") = RigidTransform::ISA();
+}
@@ -0,0 +1,85 @@
+/* In-process PLM: refine a triangulated surface given as numpy arrays and get the point data back
+   as numpy arrays, read a point folder, or run PLM with command line arguments.
+ */
+#include "PyHelpers.h"
+#include "Job.h"
+#include "Edit_configuration.h"
+#include "CreateMashBluePrint.h"
+
+static py::dict Refine(const DArray &vertices, const IArray &triangles, const DArray &box, py::object domains, const std::vector<std::string> &options)
+{
+    if (vertices.ndim() != 2 || vertices.shape(1) != 3)
+        throw std::invalid_argument("vertices must have shape (n, 3)");
+    if (triangles.ndim() != 2 || triangles.shape(1) != 3)
+        throw std::invalid_argument("triangles must have shape (m, 3)");
+    py::ssize_t nv = vertices.shape(0);
+    IArray dom;
+    const int *vdomain = NULL;      // a default IArray is an empty array, not a missing one
+    if (!domains.is_none())
+    {
+        dom = IArray::ensure(domains);
+        if (!dom || dom.size() != nv)
+            throw std::invalid_argument("domains must have one entry per vertex");
+        vdomain = dom.data();
+    }
+    MeshBluePrint blueprint;
+    blueprint.simbox = ToBox(box);
+    const double *x = vertices.data();
+    for (py::ssize_t i = 0; i < nv; i++)
+    {
+        Vertex_Map v;
+        v.x = x[3*i]; v.y = x[3*i+1]; v.z = x[3*i+2];
+        v.id = i;
+        v.domain = vdomain ? vdomain[i] : 0;
+        v.include = true;
+        blueprint.bvertex.push_back(v);
+    }
+    const int *t = triangles.data();
+    for (py::ssize_t i = 0; i < triangles.shape(0); i++)
+    {
+        if (t[3*i] < 0 || t[3*i] >= nv || t[3*i+1] < 0 || t[3*i+1] >= nv || t[3*i+2] < 0 || t[3*i+2] >= nv)
+            throw std::invalid_argument("triangle " + std::to_string(i) + " refers to a vertex that does not exist");
+        Triangle_Map tm;
+        tm.id = i; tm.v1 = t[3*i]; tm.v2 = t[3*i+1]; tm.v3 = t[3*i+2];
+        blueprint.btriangle.push_back(tm);
+    }
+    std::vector<std::string> args(1, "PLM");
+    args.insert(args.end(), options.begin(), options.end());
+    PointLayer outer, inner;
+    RunTool("PLM", [&]() { Edit_configuration plm(args, blueprint, outer, inner); });
+    py::dict out;
+    out["outer"] = LayerToDict(std::move(outer));
+    if (inner.size() != 0)
+        out["inner"] = LayerToDict(std::move(inner));
+    else
+        out["inner"] = py::none();
+    return out;
+}
+static py::dict ReadPoints(const std::string &folder)
+{
+    PointLayer outer, inner;
+    if (!outer.Read(folder + "/OuterBM.dat"))
+        throw std::runtime_error("could not read " + folder + "/OuterBM.dat");
+    py::dict out;
+    Vec3D box = outer.Box;
+    out["outer"] = LayerToDict(std::move(outer));
+    if (inner.Read(folder + "/InnerBM.dat"))
+    {
+        inner.Box = box;    // InnerBM.dat has no box line
+        out["inner"] = LayerToDict(std::move(inner));
+    }
+    else
+        out["inner"] = py::none();
+    return out;
+}
+PYBIND11_MODULE(_plm, m)
+{
+    m.doc() = "PLM (pointillism) in-process";
+    m.def("refine", &Refine, py::arg("vertices"), py::arg("triangles"), py::arg("box"), py::arg("domains") = py::none(),
+          py::arg("options") = std::vector<std::string>(),
+          "Refine a triangulated surface and return the point data of the outer and inner layer.\n"
+          "options are PLM command line options, e.g. ['-bilayerThickness', '3.8', '-rescalefactor', '4', '4', '4'].");
+    m.def("read_points", &ReadPoints, py::arg("folder"), "Read OuterBM.dat/InnerBM.dat of a point folder into numpy arrays.");
+    m.def("run", [](const std::vector<std::string> &args, const std::string &cwd) { RunInProcess<Job>("PLM", args, cwd); },
+          py::arg("args"), py::arg("cwd") = std::string(), "Run PLM with command line arguments in this process.");
+}
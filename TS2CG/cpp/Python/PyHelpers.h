@@ -0,0 +1,146 @@
+#if !defined(AFX_PyHelpers_H_9B4E21B8_C13C_5648_BF23_124095086895__INCLUDED_)
+#define AFX_PyHelpers_H_9B4E21B8_C13C_5648_BF23_124095086895__INCLUDED_
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+#include "Vec3D.h"
+#include "PointStore.h"
+#include "ToolExit.h"
+#include "Parallel.h"
+/*
+ Small helpers shared by the python modules.
+ - Input arrays are DArray/IArray. A float64 (int32) c-contiguous numpy array comes in as it is, a view of
+   its buffer, and the kernels read that buffer directly; numpy only converts arrays of another dtype
+   or layout. (n, 3) arrays are read as Vec3D without a copy (AsVec3D).
+ - ToNumpy hands a std::vector over to numpy: the vector is moved to the heap and owned by a capsule,
+   so no element is copied.
+ - RunTool runs a tool. When the tool stops on bad input (ToolExit::Exit) python gets a RuntimeError
+   and keeps running. WorkingDirectory changes the directory for one run and always changes it back,
+   also when the run fails.
+ - The tools change state of the whole process: the working directory, the rand() seed, the number of
+   threads (-nt) and the phase report. A run therefore keeps the GIL from WorkingDirectory to the end
+   of RunTool, so runs from different python threads, also of different modules, never overlap (each
+   module has its own copy of the C++ statics, so a mutex in here would not be enough). The thread
+   count is set back after each run. The kernels without such state (transform, Geodesic) release
+   the GIL.
+*/
+namespace py = pybind11;
+
+typedef py::array_t<double, py::array::c_style | py::array::forcecast> DArray;
+typedef py::array_t<int, py::array::c_style | py::array::forcecast> IArray;
+
+static_assert(sizeof(Vec3D) == 3*sizeof(double), "Vec3D must be three packed doubles");
+
+template <class T>
+py::array_t<T> ToNumpy(std::vector<T> &&v, std::vector<py::ssize_t> shape)
+{
+    std::vector<T> *heap = new std::vector<T>(std::move(v));
+    py::capsule owner(heap, [](void *p) { delete reinterpret_cast<std::vector<T> *>(p); });
+    return py::array_t<T>(shape, heap->data(), owner);
+}
+// (n,3) float64 array -> the same memory as n Vec3D
+inline const Vec3D *AsVec3D(const DArray &a, const char *name)
+{
+    if (a.ndim() != 2 || a.shape(1) != 3)
+        throw std::invalid_argument(std::string(name) + " must have shape (n, 3)");
+    return reinterpret_cast<const Vec3D *>(a.data());
+}
+inline Vec3D ToBox(const DArray &a)
+{
+    if (a.size() != 3)
+        throw std::invalid_argument("box must have 3 elements");
+    return Vec3D(a.data()[0], a.data()[1], a.data()[2]);
+}
+// point layer -> dict with the same names as TS2CG.core.membrane.Membrane
+inline py::dict LayerToDict(PointLayer &&L)
+{
+    py::ssize_t n = L.size();
+    py::dict d;
+    d["box"] = ToNumpy(std::vector<double>{L.Box(0), L.Box(1), L.Box(2)}, {3});
+    d["ids"] = ToNumpy(std::move(L.ID), {n});
+    d["domain_ids"] = ToNumpy(std::move(L.Domain), {n});
+    d["area"] = ToNumpy(std::move(L.Area), {n});
+    d["coordinates"] = ToNumpy(std::move(L.X), {n, 3});
+    d["normals"] = ToNumpy(std::move(L.Normal), {n, 3});
+    d["p1"] = ToNumpy(std::move(L.P1), {n, 3});
+    d["p2"] = ToNumpy(std::move(L.P2), {n, 3});
+    d["c1"] = ToNumpy(std::move(L.C1), {n});
+    d["c2"] = ToNumpy(std::move(L.C2), {n});
+    d["edges"] = ToNumpy(std::move(L.VType), {n});
+    return d;
+}
+// the directory of the process is changed for the lifetime of this object; "" keeps the current one
+class WorkingDirectory
+{
+public:
+    explicit WorkingDirectory(const std::string &dir)
+    {
+        if (dir.empty())
+            return;
+        char *old = getcwd(NULL, 0);
+        if (old == NULL)
+            throw std::runtime_error("could not read the current directory");
+        m_Old = old;
+        free(old);
+        if (chdir(dir.c_str()) != 0)
+            throw std::runtime_error("could not change directory to " + dir);
+    }
+    ~WorkingDirectory()
+    {
+        if (!m_Old.empty() && chdir(m_Old.c_str()) != 0)
+            std::cerr << "---> warning: could not change back to " << m_Old << "\n";
+    }
+    WorkingDirectory(const WorkingDirectory &) = delete;
+    WorkingDirectory &operator=(const WorkingDirectory &) = delete;
+
+private:
+    std::string m_Old;
+};
+// the -nt of one run does not carry over to the next
+class ThreadSetting
+{
+public:
+    ThreadSetting() : m_Threads(Parallel::GetThreadSetting()) {}
+    ~ThreadSetting() { Parallel::SetThreads(m_Threads); }
+    ThreadSetting(const ThreadSetting &) = delete;
+    ThreadSetting &operator=(const ThreadSetting &) = delete;
+
+private:
+    int m_Threads;
+};
+// runs f() holding the GIL (see above); a tool that stops raises RuntimeError instead of ending the interpreter
+template <class F>
+void RunTool(const std::string &tool, F f)
+{
+    ToolExit::ThrowScope scope;
+    ThreadSetting threads;
+    try
+    {
+        f();
+    }
+    catch (const ToolExit &e)
+    {
+        std::cout.flush();
+        throw std::runtime_error(tool + " stopped with exit code " + std::to_string(e.GetCode()) + ", see its output");
+    }
+    std::cout.flush();
+}
+// runs a tool's Job in the given working directory, as the command line would
+template <class JOB>
+void RunInProcess(const std::string &binary, const std::vector<std::string> &args, const std::string &cwd)
+{
+    std::vector<std::string> argument;
+    argument.push_back(binary);
+    argument.insert(argument.end(), args.begin(), args.end());
+    WorkingDirectory dir(cwd);
+    RunTool(binary, [&]() { JOB job(argument); });
+}
+
+#endif
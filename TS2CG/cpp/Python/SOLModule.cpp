@@ -0,0 +1,43 @@
+/* In-process SOL: fill the free space of a box with copies of a solvent template, or run SOL with
+   command line arguments.
+ */
+#include "PyHelpers.h"
+#include "Job.h"
+#include "Solvate.h"
+
+static py::dict Fill(const DArray &system, const DArray &box, const DArray &tem, const DArray &tembox,
+                     double cutoff, double db, double cellsize, int npos, int nneg, int seed)
+{
+    const Vec3D *sys = AsVec3D(system, "system"), *t = AsVec3D(tem, "template");
+    Vec3D B = ToBox(box), TB = ToBox(tembox);
+    std::vector<Vec3D> pos;
+    std::vector<int> temid, order, kind;
+    RunTool("SOL", [&]() { Solvate::TileTemplate(sys, system.shape(0), B, t, tem.shape(0), TB, cutoff, db, cellsize, pos, temid); });
+    int n = pos.size();
+    if (npos + nneg > n)
+        throw std::invalid_argument("more ions requested than solvent beads could be placed");
+    Solvate::IonOrder(n, npos, nneg, seed, order, kind);
+    std::vector<double> X(3*n);
+    std::vector<int> id(n);
+    for (int i = 0; i < n; i++)
+    {
+        const Vec3D &p = pos[order[i]];
+        X[3*i] = p(0); X[3*i+1] = p(1); X[3*i+2] = p(2);
+        id[i] = temid[order[i]];
+    }
+    py::dict out;
+    out["coordinates"] = ToNumpy(std::move(X), {n, 3});
+    out["template_index"] = ToNumpy(std::move(id), {n});
+    out["kind"] = ToNumpy(std::move(kind), {n});
+    return out;
+}
+PYBIND11_MODULE(_sol, m)
+{
+    m.doc() = "SOL (solvate) in-process";
+    m.def("fill", &Fill, py::arg("system"), py::arg("box"), py::arg("template"), py::arg("template_box"),
+          py::arg("cutoff") = 0.4, py::arg("db") = 0.05, py::arg("cellsize") = 2.0,
+          py::arg("npos") = 0, py::arg("nneg") = 0, py::arg("seed") = 9474,
+          "Solvent positions in the order SOL writes them; kind is 0 solvent, 1 positive and 2 negative ion.");
+    m.def("run", [](const std::vector<std::string> &args, const std::string &cwd) { RunInProcess<Job>("SOL", args, cwd); },
+          py::arg("args"), py::arg("cwd") = std::string(), "Run SOL with command line arguments in this process.");
+}
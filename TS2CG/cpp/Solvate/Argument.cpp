@@ -1,6 +1,7 @@
 #include "Argument.h"
 #include "help.h"
 #include "Nfunction.h"
+#include "ToolExit.h"
 
 Argument::Argument(std::vector<std::string> argument) {
     m_Argument = argument;
@@ -28,7 +29,7 @@ Argument::Argument(std::vector<std::string> argument) {
             // Help message should be called
             help helpmessage(m_Argument.at(0));
             m_ArgCon = 0;
-            exit(0);
+            ToolExit::Exit(0);
         } else if (Arg1 == "-db") {
             m_DB = f.String_to_Double(m_Argument.at(i + 1));
         } else if (Arg1 == "-nname") {
@@ -55,7 +56,7 @@ Argument::Argument(std::vector<std::string> argument) {
             std::cout << "---> error: Wrong command: " << Arg1;
             std::cout << "\n" << "For more information and tips execute SOL -h" << "\n";
             m_ArgCon = 0;
-            exit(0);
+            ToolExit::Exit(0);
         }
     }
 }
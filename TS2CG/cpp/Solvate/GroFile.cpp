@@ -1,6 +1,7 @@
 #include <iostream>
 #include "GroFile.h"
 #include "Nfunction.h"
+#include "GroIO.h"
 // a class that has functions to read and write gro files
 GroFile::GroFile(std::string gmxfilename) {
     m_GroFileName = gmxfilename;
@@ -28,8 +29,6 @@ void GroFile::UpdateBox(Vec3D box) {
 }
 
 void GroFile::ReadGroFile(std::string file) {
-    Nfunction f;
-    char str[1000];
     if (file.size() < 4) {
         file = file + ".gro";
     } else if (file.at(file.size() - 1) == 'o' && file.at(file.size() - 2) == 'r' && file.at(file.size() - 3) == 'g') {
@@ -37,74 +36,23 @@ void GroFile::ReadGroFile(std::string file) {
         file = file + ".gro";
     }
 
-    std::ifstream FGRO;
-    FGRO.open(file.c_str());
-    std::string str1;
-    getline(FGRO, str1);
-    getline(FGRO, str1);
-    FILE *fgro;
-    fgro = fopen(file.c_str(), "r");
-
-    if (fgro == NULL) {
+    std::vector<GroAtom> atoms;
+    Vec3D box;
+    if (!GroIO::Read(file, m_Title, atoms, box)) {
         printf(" Error: Could not open file %s", file.c_str());
     }
 
-    bool check = fgets(str, 1000, fgro);
-    m_Title = str;
-    m_Title.pop_back();
-    check = fgets(str, 1000, fgro);
-
-    int NoBeads = atoi(str);
-
-    float x, y, z, v1, v2, v3;
-    char *A1;
-    char *A2;
-
-    char a[200];
-    char b[200];
-    int resid, beadid;
     std::string beadtype = "MDBeads";
-
-    for (int i = 0; i < NoBeads; i++) {
-        getline(FGRO, str1);
-        std::vector<std::string> l = f.split(str1);
-
-        int readafile = fscanf(fgro, "%d%s%s%d%f%f%f", &resid, a, b, &beadid, &x, &y, &z);
-        check = fgets(str, 1000, fgro);
-
-        if (l.size() == 7 || l.size() == 10) {
-            x = atof((l.at(4)).c_str());
-            y = atof((l.at(5)).c_str());
-            z = atof((l.at(6)).c_str());
-        } else if (l.size() == 6 || l.size() == 9) {
-            x = atof((l.at(3)).c_str());
-            y = atof((l.at(4)).c_str());
-            z = atof((l.at(5)).c_str());
-        } else if (l.size() == 5 || l.size() == 8) {
-            x = atof((l.at(2)).c_str());
-            y = atof((l.at(3)).c_str());
-            z = atof((l.at(4)).c_str());
-        } else {
-            std::cout << "Warning: Perhaps error, something wrong with " << file << " file \n";
-        }
-
-        std::string bt = b;
-        std::string beadname;
-        if (bt.size() > 0)
-            beadname.push_back(bt.at(0));
-        if (bt.size() > 1)
-            beadname.push_back(bt.at(1));
-
-        std::string resname = a;
-        bead Be(i, beadname, beadtype, resname, resid, x, y, z);
+    m_AllBeads.reserve(atoms.size());
+    for (size_t i = 0; i < atoms.size(); i++) {
+        const GroAtom &a = atoms[i];
+        float x = a.x, y = a.y, z = a.z;
+        std::string beadname = a.name.substr(0, 2);
+        bead Be(i, beadname, beadtype, a.resname, a.resid, x, y, z);
         m_AllBeads.push_back(Be);
     }
 
-    FGRO.close();
-    float Lx, Ly, Lz;
-    int readafile = fscanf(fgro, "%f%f%f", &Lx, &Ly, &Lz);
-
-    fclose(fgro);
+    float Lx = box(0), Ly = box(1), Lz = box(2);
 
     m_Box(0) = Lx;
     m_Box(1) = Ly;
@@ -128,30 +76,18 @@ void GroFile::WriteGroFile(std::string file) {
         file = file + ".gro";
     }
 
-    FILE *fgro;
-    fgro = fopen(file.c_str(), "w");
-
-    if (!fgro) {
+    GroWriter gro;
+    if (!gro.Open(file, "dmc gmx file handler", m_AllBeads.size())) {
         std::cout << "Error opening file: " << file << std::endl;
         return;
     }
 
-    const char *Title = "dmc gmx file handler";
-    int Size = m_AllBeads.size();
-
-    fprintf(fgro, "%s\n", Title);
-    fprintf(fgro, "%5d\n", Size);
-
     int i = 0;
     for (std::vector<bead>::iterator it = m_AllBeads.begin(); it != m_AllBeads.end(); ++it) {
         i++;
-        double x = (*it).GetXPos();
-        double y = (*it).GetYPos();
-        double z = (*it).GetZPos();
         i = i % 100000;
-        fprintf(fgro, "%5d%5s%5s%5d%8.3f%8.3f%8.3f\n", i, ((*it).GetResName()).c_str(), ((*it).GetBeadName()).c_str(), i, x, y, z);
+        gro.Write(i, (*it).GetResName(), (*it).GetBeadName(), i, (*it).GetXPos(), (*it).GetYPos(), (*it).GetZPos());
     }
 
-    fprintf(fgro, "%10.5f%10.5f%10.5f\n", m_Box(0), m_Box(1), m_Box(2));
-    fclose(fgro);
+    gro.Close(m_Box);
 }
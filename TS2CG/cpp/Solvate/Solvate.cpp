@@ -5,8 +5,11 @@
 #include "Solvate.h"
 #include "Nfunction.h"
 #include "GroFile.h"
-#include "GenerateUnitCells.h"
+#include "CellList.h"
+#include "PhaseReport.h"
+#include <algorithm>
 #include "Solvate.h"
+#include "ToolExit.h"
 
 Solvate::Solvate(Argument *pArg)
 {
@@ -29,60 +32,57 @@ Solvate::Solvate(Argument *pArg)
     if(f.FileExist(ingrofilename)==false)
     {
         std::cout<<"---> error: file "<<ingrofilename<< " do not exist. \n";
-        exit(0);
+        ToolExit::Exit(0);
     }
     if(f.FileExist(temfilename)==false)
     {
         std::cout<<"file "<<temfilename<< " do not exist. Error: template file should be given  \n";
-        exit(0);
+        ToolExit::Exit(0);
     }
-
+        PhaseReport &report = PhaseReport::Get();  // timing, counters and memory per phase, written to sol_report.json
+        report.Start("SOL");
+        report.Begin("read");
         GroFile InGro = GroFile(ingrofilename); // read the gro file
         std::vector<bead*> Sysbead = InGro.GetpAllBeads(); // get all the beads in the system gro file in the vector=
         Vec3D *FBox = InGro.GetBox(); // get the box info
         Bring2Box(Sysbead,FBox);  // removing box crossing of the beads. Grofile could have it
 
-    //-- generate unit cells to check the distance between the created solvent beads and the system beads.
-        GenerateUnitCells UCELL(Sysbead,pArg,FBox, cutoff, usize);
-        
         //==  read the template water gro file that will be used to put water beads
         GroFile TemGro = GroFile(temfilename);
         std::vector<bead*> Wbead = TemGro.GetpAllBeads();
         Vec3D *WBox = TemGro.GetBox();  // box of the template water beads box. much smaller then FBox
         Bring2Box(Wbead,WBox); // removing box crossing of the water beads. Grofile could have it
-    //-- info to see how many copy of the water box is needed. some will go out of the box size, so it should be counted for after
-        int nBox_X = int((*FBox)(0)/(*WBox)(0))+1;
-        int nBox_Y = int((*FBox)(1)/(*WBox)(1))+1;
-        int nBox_Z = int((*FBox)(2)/(*WBox)(2))+1;
-        
+        report.Count("system beads", Sysbead.size());
+        report.Count("template beads", Wbead.size());
+        report.End();
+
+    //-- copies of the template that do not overlap with the system beads
+        std::vector<Vec3D> SysPos, TemPos, WaterPos;
+        std::vector<int> WaterTemID;
+        for (std::vector<bead *>::iterator it = Sysbead.begin() ; it != Sysbead.end(); ++it)
+            SysPos.push_back(Vec3D((*it)->GetXPos(),(*it)->GetYPos(),(*it)->GetZPos()));
+        for (std::vector<bead *>::iterator it = Wbead.begin() ; it != Wbead.end(); ++it)
+            TemPos.push_back(Vec3D((*it)->GetXPos(),(*it)->GetYPos(),(*it)->GetZPos()));
+        report.Begin("solvation");
+        TileTemplate(SysPos, *FBox, TemPos, *WBox, cutoff, db, usize, WaterPos, WaterTemID);
+        std::cout<<"----> We could make the cells  \n";
+
     //-- a vector to store all the generated water beads
         std::vector<bead> FullWaterBead;
-        for (int i=0;i<nBox_X;i++)
-        for (int j=0;j<nBox_Y;j++)
-        for (int k=0;k<nBox_Z;k++)
+        FullWaterBead.reserve(WaterPos.size());
+        for (size_t i=0;i<WaterPos.size();i++)
         {
-            for (std::vector<bead *>::iterator it = Wbead.begin() ; it != Wbead.end(); ++it)
-            {
-                double x=(*it)->GetXPos()+((*WBox)(0))*double(i)+db;
-                double y=(*it)->GetYPos()+((*WBox)(1))*double(j)+db;
-                double z=(*it)->GetZPos()+((*WBox)(2))*double(k)+db;
-
-                Vec3D Pos(x,y,z);
-                if(UCELL.anythingaround (Pos)!=true)// remove beads that overlaps with system beads
-                if(x>0 && y>0 && z>0 && x<(*FBox)(0) && y<(*FBox)(1) && z<(*FBox)(2))// remove beads that are not inside the box
-                {
-
-                        bead TB = *(*it);
-                
-                        TB.UpdatePos(FBox,x,y,z);
-                        FullWaterBead.push_back(TB);
-                }
-            }
-        }///
+            bead TB = *(Wbead.at(WaterTemID[i]));
+            TB.UpdatePos(FBox,WaterPos[i](0),WaterPos[i](1),WaterPos[i](2));
+            FullWaterBead.push_back(TB);
+        }
+        report.Count("solvent beads", FullWaterBead.size());
+        report.End();
 //== FullWaterBead is now being filled with water beads; note beads that are crossing the box is removed and also the one which overlaps with the system beads
     //create a function for ion placement, we may choose different placement
     
     // adding ions
+    report.Begin("ions");
     std::vector<bead> PreBeads = InGro.GetAllBeads();
     // generate ions and return ions and water beads.
     std::vector<bead> pWaterIonBeads = AddIons(FullWaterBead, ion.at(0),ion.at(1), PosName, NegName, seed);
@@ -90,10 +90,16 @@ Solvate::Solvate(Argument *pArg)
     for (std::vector<bead>::iterator it = pWaterIonBeads.begin() ; it != pWaterIonBeads.end(); ++it)
             PreBeads.push_back(*it);
     
+    report.Count("ions", ion.at(0)+ion.at(1));
+    report.End();
     // write the final file
+    report.Begin("write");
     TemGro.RenewBeads(PreBeads);
     TemGro.UpdateBox(*FBox);
     TemGro.WriteGroFile(outgrofilename);
+    report.Count("beads", PreBeads.size());
+    report.End();
+    report.Write("sol_report.json");
 }
 Solvate::~Solvate()
 {
@@ -126,36 +132,33 @@ std::vector<bead> Solvate::AddIons(std::vector<bead>& FullWaterBead, int Nposion
         std::cout << "---> error: total number of requested ions is larger than the total generated water beads\n";
         std::cout << "   ---> total requested ions " << numer_of_total_ions << "\n";
         std::cout << "   ---> total requested water beads " << numer_of_water << "\n";
-        exit(0);
+        ToolExit::Exit(0);
     }
 
     // shuffle the water beads to select ions without being localaized
-    std::srand(seed);
-    std::random_shuffle(FullWaterBead.begin(), FullWaterBead.end());
+    std::vector<int> order, kind;
+    IonOrder(numer_of_water, Nposion, Nnegion, seed, order, kind);
 
     int nn = 0;
     int np = 0;
-    int id = 1;
-
-    for (std::vector<bead>::iterator it = FullWaterBead.begin(); it != FullWaterBead.end(); ++it) {
-        if (id > numer_of_water - numer_of_total_ions && id <= numer_of_water - numer_of_total_ions + Nposion) {
-            it->UpdateBeadName(pName);
-            it->UpdateResName("ION");
+    outBeads.reserve(numer_of_water);
+    for (int i = 0; i < numer_of_water; i++) {
+        bead b = FullWaterBead[order[i]];
+        if (kind[i] == 1) {
+            b.UpdateBeadName(pName);
+            b.UpdateResName("ION");
             ++np;
-        } else if (id > numer_of_water - numer_of_total_ions) {
-            it->UpdateBeadName(nName);
-            it->UpdateResName("ION");
+        } else if (kind[i] == 2) {
+            b.UpdateBeadName(nName);
+            b.UpdateResName("ION");
             ++nn;
         }
-        ++id;
+        outBeads.push_back(b);
     }
 
     // just to check that the number of requested is equal to the generated one
     std::cout << "---> created ions " << np << " positive  " << nn << " negative ions\n";
 
-    // Store all the beads in a new container to maintain the order.
-    outBeads = FullWaterBead;
-
     // Report some info about numbers
     std::ofstream info("info.txt");
     if (info.is_open()) {
@@ -180,3 +183,51 @@ std::vector<bead> Solvate::AddIons(std::vector<bead>& FullWaterBead, int Nposion
     return outBeads;
 }
 
+void Solvate::IonOrder(int nwater, int Nposion, int Nnegion, int seed, std::vector<int> &order, std::vector<int> &kind) {
+    // the same shuffle as shuffling the water beads themselves; the last Nposion+Nnegion become ions
+    order.resize(nwater);
+    for (int i = 0; i < nwater; i++)
+        order[i] = i;
+    std::srand(seed);
+    std::random_shuffle(order.begin(), order.end());
+    kind.assign(nwater, 0);
+    const int first = nwater - Nposion - Nnegion;
+    for (int i = std::max(first, 0); i < nwater; i++)
+        kind[i] = (i < first + Nposion) ? 1 : 2;
+}
+void Solvate::TileTemplate(const Vec3D *system, int nsystem, const Vec3D &box, const Vec3D *tem, int ntem, const Vec3D &tembox,
+                           double cutoff, double db, double usize, std::vector<Vec3D> &pos, std::vector<int> &temid) {
+    pos.clear();
+    temid.clear();
+    //-- cell list to check the distance between the created solvent beads and the system beads.
+    CellList cells;
+    cells.Build(system, nsystem, box, cutoff, usize);
+    //-- info to see how many copy of the water box is needed. some will go out of the box size, so it should be counted for after
+    int nBox_X = int(box(0)/tembox(0))+1;
+    int nBox_Y = int(box(1)/tembox(1))+1;
+    int nBox_Z = int(box(2)/tembox(2))+1;
+    long inside = 0;
+    for (int i=0;i<nBox_X;i++)
+    for (int j=0;j<nBox_Y;j++)
+    for (int k=0;k<nBox_Z;k++)
+    {
+        for (int t=0;t<ntem;t++)
+        {
+            double x=tem[t](0)+(tembox(0))*double(i)+db;
+            double y=tem[t](1)+(tembox(1))*double(j)+db;
+            double z=tem[t](2)+(tembox(2))*double(k)+db;
+            Vec3D Pos(x,y,z);
+            if(x>0 && y>0 && z>0 && x<box(0) && y<box(1) && z<box(2))// remove beads that are not inside the box
+            {
+                inside++;
+                if(cells.AnyWithin(Pos)!=true)// remove beads that overlaps with system beads
+                {
+                    pos.push_back(Pos);
+                    temid.push_back(t);
+                }
+            }
+        }
+    }
+    PhaseReport::Get().Count("cells", cells.GetNumberOfCells());
+    PhaseReport::Get().Count("rejections", inside-long(pos.size()));
+}
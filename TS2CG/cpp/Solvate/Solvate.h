@@ -3,6 +3,8 @@
 
 #include "Def.h"
 #include "bead.h"
+#include "Argument.h"
+#include "Vec3D.h"
 
 class Solvate
 {
@@ -11,6 +13,18 @@ public:
       Solvate(Argument *pArg);
 	 ~Solvate();
 
+    // copies of the template box over the whole box; keeps the template beads that are inside the box and
+    // not within cutoff of a system bead. temid is the template index of each kept position
+    static void TileTemplate(const Vec3D *system, int nsystem, const Vec3D &box, const Vec3D *tem, int ntem, const Vec3D &tembox,
+                             double cutoff, double db, double usize, std::vector<Vec3D> &pos, std::vector<int> &temid);
+    static inline void TileTemplate(const std::vector<Vec3D> &system, const Vec3D &box, const std::vector<Vec3D> &tem, const Vec3D &tembox,
+                             double cutoff, double db, double usize, std::vector<Vec3D> &pos, std::vector<int> &temid)
+    {
+        TileTemplate(system.data(), system.size(), box, tem.data(), tem.size(), tembox, cutoff, db, usize, pos, temid);
+    }
+    // the order the water beads are written in (a seeded shuffle) and, for each slot, 0 water, 1 positive or 2 negative ion
+    static void IonOrder(int nwater, int Nposion, int Nnegion, int seed, std::vector<int> &order, std::vector<int> &kind);
+
 private:
     void Bring2Box(std::vector<bead*> &Sysbead, Vec3D *Box);
     std::vector<bead> AddIons(std::vector<bead>& FullWaterBead, int Nposion, int Nnegion, const std::string& pName, const std::string& nName, int seed);
@@ -45,7 +45,4 @@ void bead::UpdatePos(double x, double y, double z) {
     UpdateZPos(z);
 }
 
-void bead::UpdateBeadUnitCell(UnitCell* z) {
-    m_BeadUnitCell = z;
-}
 
@@ -1,12 +1,11 @@
 #if !defined(AFX_bead_H_334B21B8_C13C_5648_BF23_124095086234__INCLUDED_)
 #define AFX_bead_H_334B21B8_C13C_5648_BF23_124095086234__INCLUDED_
 /* A bead object encapsulates the following attributes:
-1) ID 2) Name 3) Type 4) Residue name 5-7) Position coordinates 8) Residue ID 9) A pointer to a unit cell.
-The unit cell pointer enables efficient neighbor bead queries. While it's possible to perform such queries without the unit cell pointer, having it as a member function enhances convenience. */
+1) ID 2) Name 3) Type 4) Residue name 5-7) Position coordinates 8) Residue ID.
+Neighbor bead queries go through the shared CellList (TS2CGCore). */
 #include <string>
 // Forward declaration to reduce unnecessary inclusion of headers
 class Vec3D;
-class UnitCell;
 
 class bead {
 public:
@@ -24,7 +23,6 @@ public:
     inline const std::string& GetResName() const { return m_ResName; }
     inline int GetResid() const { return m_Resid; }
     inline const std::string& GetBeadName() const { return m_BeadName; }
-    inline UnitCell* GetBeadUnitCell() const { return m_BeadUnitCell; }
 
     // Update functions
     void UpdateXPos(double x);
@@ -35,7 +33,6 @@ public:
     void UpdateResName(const std::string& name);
     void UpdatePos(Vec3D* B, double x, double y, double z);
     void UpdatePos(double x, double y, double z);
-    void UpdateBeadUnitCell(UnitCell* z);
 
 private:
     bool m_hasMol;
@@ -48,7 +45,6 @@ private:
     int m_Resid;
     int m_ID;
     Vec3D* m_pBox;
-    UnitCell* m_BeadUnitCell;
 };
 
 #endif
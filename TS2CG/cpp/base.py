@@ -1,4 +1,5 @@
 import subprocess
+import importlib
 from pathlib import Path
 from typing import List, Union, Optional
 import logging
@@ -57,3 +58,13 @@ class CPPModule:
                 logger.error(msg)
 
         return result
+
+    def extension(self):
+        """The in-process module of this binary (TS2CG.cpp._plm, _pcg or _sol), or None if it was not built.
+
+        The module works directly on numpy arrays (no files, no extra process); see its docstrings.
+        """
+        try:
+            return importlib.import_module(f"{__package__}._{self.binary_name.lower()}")
+        except ImportError:
+            return None
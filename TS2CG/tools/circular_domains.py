@@ -10,6 +10,7 @@ from scipy.spatial import KDTree
 import networkx as nx
 
 from ..core.point import Point
+from ..core.geodesic import GEODESIC_EDGE_CUTOFF, GEODESIC_NEIGHBOURS, native_engine
 
 logger = logging.getLogger(__name__)
 
@@ -34,8 +35,12 @@ def get_domain_centers(membrane: Point, protein_type: Optional[int] = None,
 
 def assign_circular_domains(membrane: Point, radius: float, domain_centers: List[int],
                           domain_id: int, leaflet: str = "both", use_path_distance: bool = False,
-                          edge_cutoff: float = 5) -> None:
-    """Assign domain IDs to all points within radius of domain centers."""
+                          edge_cutoff: float = GEODESIC_EDGE_CUTOFF, neighbours: int = GEODESIC_NEIGHBOURS) -> None:
+    """Assign domain IDs to all points within radius of domain centers.
+
+    Path distances use the C++ geodesic engine when it is available: one multi-source pass over a
+    graph that links each point to its `neighbours` nearest points within edge_cutoff (0: all of them).
+    """
 
     # Determine which leaflets to process
     leaflets_to_process = []
@@ -51,10 +56,30 @@ def assign_circular_domains(membrane: Point, radius: float, domain_centers: List
     for leaflet_name, membrane_leaflet in leaflets_to_process:
         logger.info(f"Processing {leaflet_name} leaflet")
 
-        # Build KDTree from point coordinates
         box_dims = np.array(membrane.box)
         coordinates = membrane_leaflet.coordinates
+
+        engine = native_engine() if use_path_distance else None
+        if engine is not None:
+            logger.info("Using path distance (C++ geodesic engine) for domain assignment")
+            centers = [c for c in domain_centers if c < len(coordinates)]
+            for c in set(domain_centers) - set(centers):
+                logger.warning(f"Domain center {c} does not exist in {leaflet_name} leaflet")
+            graph = engine.Geodesic(coordinates, box_dims, edge_cutoff, neighbours)
+            distance, _ = graph.distances(np.array(centers, dtype=np.int32), radius)
+            points_within_radius = np.nonzero(distance >= 0)[0]
+            membrane_leaflet.domain_ids[points_within_radius] = domain_id
+            logger.info(f"Assigned domain {domain_id} to {len(points_within_radius)} points")
+            logger.info(f"Finished processing {leaflet_name} leaflet")
+            continue
+
+        # Build KDTree from point coordinates
         tree = KDTree(coordinates, boxsize=box_dims)
+        G = None
+        if use_path_distance:
+            # the graph is the same for all centers
+            dist_matrix = KDTree.sparse_distance_matrix(tree, tree, max_distance=edge_cutoff)
+            G = nx.from_scipy_sparse_array(dist_matrix)
 
         for center_idx in domain_centers:
             if center_idx >= len(coordinates):
@@ -64,12 +89,6 @@ def assign_circular_domains(membrane: Point, radius: float, domain_centers: List
             if use_path_distance:
                 logger.info(f"Using path distance (Dijkstra) for domain assignment")
 
-                # Create sparse distance matrix
-                dist_matrix = KDTree.sparse_distance_matrix(tree, tree, max_distance=edge_cutoff)
-
-                # Convert to networkx graph
-                G = nx.from_scipy_sparse_array(dist_matrix)
-
                 # Find shortest paths within radius
                 shortest_paths = nx.single_source_dijkstra_path_length(
                     G, center_idx, cutoff=radius
@@ -111,9 +130,12 @@ def DAI(args: List[str]) -> None:
                        help="Skip creating backup when overwriting input")
     parser.add_argument('--path-distance', action='store_true',
                        help="Use path distance (Dijkstra) instead of euclidean distance for curved membranes")
-    parser.add_argument('--edge-cutoff', type=float, default=5.0,
+    parser.add_argument('--edge-cutoff', type=float, default=GEODESIC_EDGE_CUTOFF,
                         help="Maximum distance (nm) for graph edges in path distance mode. "
                              "Edges longer than this are excluded, preventing shortcuts across membrane folds")
+    parser.add_argument('--neighbours', type=int, default=GEODESIC_NEIGHBOURS,
+                        help="Edges per point in the C++ geodesic engine, the nearest ones within --edge-cutoff "
+                             "(0: all within --edge-cutoff, as the networkx fallback does)")
 
     args = parser.parse_args(args)
 
@@ -140,7 +162,7 @@ def DAI(args: List[str]) -> None:
 
     # Assign domains
     assign_circular_domains(membrane, args.radius, domain_centers, args.domain_id,
-                           args.leaflet, args.path_distance, args.edge_cutoff)
+                           args.leaflet, args.path_distance, args.edge_cutoff, args.neighbours)
 
     # Save results
     output_dir = args.output_dir if args.output_dir else args.point_dir
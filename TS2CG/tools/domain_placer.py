@@ -10,6 +10,7 @@ from dataclasses import dataclass
 from typing import List, Optional, Sequence
 
 from ..core.point import Point
+from ..core.geodesic import native_engine
 
 logger = logging.getLogger(__name__)
 
@@ -117,11 +118,17 @@ def calculate_curvature_weights(local_curvature: float, lipids: Sequence[LipidSp
     return weights
 
 def assign_domains(membrane: Point, lipids: Sequence[LipidSpec], leaflet: str = "both",
-                  k_factor: float = 1.0, area_weighted: bool = False, seed: Optional[int] = None) -> None:
-    """Assign lipids to domains based on curvature preferences"""
+                  k_factor: float = 1.0, area_weighted: bool = False, seed: Optional[int] = None,
+                  native: bool = True) -> None:
+    """Assign lipids to domains based on curvature preferences
+
+    With native=True the C++ engine of PCG (-domainspec) is used when it is available; it gives the
+    same quotas and weights but processes the points in parallel blocks.
+    """
 
     # Set random seed
     rng = np.random.default_rng(seed)
+    engine = native_engine() if native else None
 
     # Determine leaflets to process
     leaflets = []
@@ -144,6 +151,18 @@ def assign_domains(membrane: Point, lipids: Sequence[LipidSpec], leaflet: str =
         if leaflet_name == "inner":
             curvatures = -curvatures
 
+        if engine is not None:
+            native_seed = int(rng.integers(2**31)) if seed is None else seed
+            membrane_leaflet.domain_ids = engine.assign_domains(
+                curvatures, membrane_leaflet.area, [l.domain_id for l in lipids],
+                [l.percentage for l in lipids], [l.curvature for l in lipids],
+                k_factor, area_weighted, native_seed, 1 if leaflet_name == "outer" else 2)
+            for lipid in lipids:
+                actual_count = np.sum(membrane_leaflet.domain_ids == lipid.domain_id)
+                logger.info(f"{lipid.name}: {actual_count/n_points*100:.1f}% "
+                            f"(target: {lipid.percentage*100:.1f}%)")
+            continue
+
         # Initialize domain assignments and tracking
         new_domains = np.full(n_points, -1)
         remaining_counts = {i: int(lipid.percentage * n_points)
@@ -214,6 +233,8 @@ def DOP(args: List[str]) -> None:
                        help="Consider area of each point for weight calculation")
     parser.add_argument('--seed', type=int,
                        help="Random seed for reproducibility")
+    parser.add_argument('--python', action='store_true',
+                       help="Use the python loop instead of the C++ engine")
 
     args = parser.parse_args(args)
 
@@ -228,7 +249,7 @@ def DOP(args: List[str]) -> None:
     lipids = parse_lipid_file(Path(args.lipid_specs))
 
     # Assign domains
-    assign_domains(membrane, lipids, args.leaflet, args.k_factor, args.area, args.seed)
+    assign_domains(membrane, lipids, args.leaflet, args.k_factor, args.area, args.seed, native=not args.python)
 
     # Write input.str file
     old_input_path = Path(args.old_input) if args.old_input else None
@@ -10,17 +10,39 @@ from scipy.special import logsumexp
 from scipy.spatial import KDTree
 
 from ..core.point import Point
+from ..core.geodesic import GEODESIC_EDGE_CUTOFF, GEODESIC_NEIGHBOURS, native_engine
 
 logger = logging.getLogger(__name__)
 
 
-def get_excluded_points(membrane: Point, radius: float) -> Set[int]:
-    """Get points too close to existing proteins."""
+def _geodesic_graph(membrane: Point, edge_cutoff: float):
+    """C++ geodesic graph of the outer leaflet, or None if the python modules were not built"""
+    engine = native_engine()
+    if engine is None:
+        logger.warning("C++ modules not available, using euclidean distances")
+        return None
+    return engine.Geodesic(membrane.outer.coordinates, np.array(membrane.box), edge_cutoff, GEODESIC_NEIGHBOURS)
+
+
+def _points_within(graph, point_id: int, radius: float) -> np.ndarray:
+    """Points with a path distance below radius from point_id"""
+    distance, _ = graph.distances(np.array([point_id], dtype=np.int32), radius)
+    return np.nonzero(distance >= 0)[0]
+
+
+def get_excluded_points(membrane: Point, radius: float, graph=None) -> Set[int]:
+    """Get points too close to existing proteins (path distance if a geodesic graph is given)."""
     excluded = set()
 
     if not membrane.inclusions:
         return excluded
 
+    if graph is not None:
+        for inclusion in membrane.inclusions:
+            if inclusion['point_id'] < len(membrane.outer.coordinates):
+                excluded.update(_points_within(graph, inclusion['point_id'], radius).tolist())
+        return excluded
+
     box_dims = np.array(membrane.box)
 
     # Shift and wrap coordinates for KDTree
@@ -55,8 +77,13 @@ def calculate_placement_weights(curvatures: np.ndarray, target_curvature: Option
 
 def place_proteins(membrane: Point, protein_type: int, radius: float, num_proteins: int,
                   target_curvature: Optional[float] = None, k_factor: float = 1.0,
-                  seed: Optional[int] = None) -> None:
-    """Place proteins in outer membrane leaflet."""
+                  seed: Optional[int] = None, path_distance: bool = False,
+                  edge_cutoff: float = GEODESIC_EDGE_CUTOFF) -> None:
+    """Place proteins in outer membrane leaflet.
+
+    With path_distance the exclusion radius is measured along the membrane (C++ geodesic engine),
+    so proteins on the two sides of a tight fold do not exclude each other.
+    """
 
     # Set random seed
     rng = np.random.default_rng(seed)
@@ -68,8 +95,11 @@ def place_proteins(membrane: Point, protein_type: int, radius: float, num_protei
     coordinates = membrane.outer.coordinates + box_dims / 2
     coordinates = coordinates % box_dims
 
+    graph = _geodesic_graph(membrane, edge_cutoff) if path_distance else None
+    tree = KDTree(coordinates, boxsize=box_dims) if graph is None else None
+
     # Get excluded points
-    excluded = get_excluded_points(membrane, radius)
+    excluded = get_excluded_points(membrane, radius, graph)
     logger.info(f"Placing {num_proteins} proteins of type {protein_type} with radius {radius}")
 
     placed_total = 0
@@ -97,11 +127,11 @@ def place_proteins(membrane: Point, protein_type: int, radius: float, num_protei
             point_id=chosen_idx
         )
 
-        # Update excluded points using KDTree
-        tree = KDTree(coordinates, boxsize=box_dims)
-        center_coord = coordinates[chosen_idx]
-        nearby_indices = tree.query_ball_point(center_coord, radius)
-        excluded.update(nearby_indices)
+        # Update excluded points
+        if graph is not None:
+            excluded.update(_points_within(graph, chosen_idx, radius).tolist())
+        else:
+            excluded.update(tree.query_ball_point(coordinates[chosen_idx], radius))
 
         placed_total += 1
         logger.info(f"Placed protein {placed_total} at point {chosen_idx}")
@@ -131,6 +161,10 @@ def INU(args: List[str]) -> None:
                        help="Skip creating backup when overwriting input")
     parser.add_argument('--seed', type=int,
                        help="Random seed for reproducibility")
+    parser.add_argument('--path-distance', action='store_true',
+                       help="Measure the exclusion radius along the membrane instead of through space")
+    parser.add_argument('--edge-cutoff', type=float, default=GEODESIC_EDGE_CUTOFF,
+                       help="Longest graph edge (nm) for --path-distance; keep it below the distance between folds")
 
     args = parser.parse_args(args)
 
@@ -149,7 +183,9 @@ def INU(args: List[str]) -> None:
         num_proteins=args.num_proteins,
         target_curvature=args.curvature,
         k_factor=args.k_factor,
-        seed=args.seed
+        seed=args.seed,
+        path_distance=args.path_distance,
+        edge_cutoff=args.edge_cutoff
     )
 
     # Save results
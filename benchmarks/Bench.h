@@ -0,0 +1,103 @@
+#if !defined(AFX_Bench_H_4D1E21B8_C13C_5648_BF23_124095086897__INCLUDED_)
+#define AFX_Bench_H_4D1E21B8_C13C_5648_BF23_124095086897__INCLUDED_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <map>
+#include <algorithm>
+#include "Vec3D.h"
+/*
+ Small helpers shared by the benchmark executables: a timer, one output line per measurement and
+ a procedural icosphere (no input files needed).
+ Every measurement is printed as
+   <name> <items> <unit> <seconds> s <throughput> <unit>/s
+ so that runs of two versions can be compared with diff or a spreadsheet.
+*/
+class BenchTimer
+{
+public:
+    BenchTimer() : m_T0(std::chrono::steady_clock::now()) {}
+    inline void Reset()                 {m_T0 = std::chrono::steady_clock::now();}
+    inline double Seconds() const       {return std::chrono::duration<double>(std::chrono::steady_clock::now()-m_T0).count();}
+private:
+    std::chrono::steady_clock::time_point m_T0;
+};
+inline void BenchReport(const std::string &name, double items, const std::string &unit, double seconds)
+{
+    printf("%-32s %14.6g %-7s %10.4f s %14.4g %s/s\n", name.c_str(), items, unit.c_str(), seconds,
+           (seconds>0) ? items/seconds : 0.0, unit.c_str());
+    fflush(stdout);
+}
+// number of repetitions so that a kernel on n items runs for a measurable time
+inline int BenchRepeats(long n, long work = 4000000)
+{
+    long r = work/std::max(n, 1L);
+    return int(std::max(1L, std::min(r, 1000L)));
+}
+// icosahedron subdivided level times and projected on a sphere of radius R around c;
+// triangles are counter-clockwise seen from outside (normals point out, as in the tutorial TSI files).
+// nv = 10*4^level+2
+inline void Icosphere(int level, double R, const Vec3D &c, std::vector<Vec3D> &v, std::vector<int> &tri)
+{
+    const double t = (1.0+sqrt(5.0))/2.0;
+    const double iv[12][3] = {{-1,t,0},{1,t,0},{-1,-t,0},{1,-t,0},{0,-1,t},{0,1,t},{0,-1,-t},{0,1,-t},
+                              {t,0,-1},{t,0,1},{-t,0,-1},{-t,0,1}};
+    const int it[20][3] = {{0,11,5},{0,5,1},{0,1,7},{0,7,10},{0,10,11},{1,5,9},{5,11,4},{11,10,2},{10,7,6},{7,1,8},
+                           {3,9,4},{3,4,2},{3,2,6},{3,6,8},{3,8,9},{4,9,5},{2,4,11},{6,2,10},{8,6,7},{9,8,1}};
+    v.clear();
+    tri.clear();
+    for (int i=0;i<12;i++)
+    {
+        Vec3D X(iv[i][0],iv[i][1],iv[i][2]);
+        X.normalize();
+        v.push_back(X);
+    }
+    for (int i=0;i<20;i++)
+        for (int k=0;k<3;k++)
+            tri.push_back(it[i][k]);
+    for (int l=0;l<level;l++)
+    {
+        std::map<std::pair<int,int>, int> mid;
+        std::vector<int> newtri;
+        newtri.reserve(4*tri.size());
+        for (size_t i=0;i<tri.size();i+=3)
+        {
+            int m[3];
+            for (int k=0;k<3;k++)
+            {
+                int a = tri[i+k], b = tri[i+(k+1)%3];
+                std::pair<int,int> key(std::min(a,b), std::max(a,b));
+                std::map<std::pair<int,int>, int>::iterator f = mid.find(key);
+                if(f==mid.end())
+                {
+                    Vec3D X = (v[a]+v[b])*0.5;
+                    X.normalize();
+                    v.push_back(X);
+                    m[k] = v.size()-1;
+                    mid[key] = m[k];
+                }
+                else
+                    m[k] = f->second;
+            }
+            int a = tri[i], b = tri[i+1], cc = tri[i+2];
+            int nt[12] = {a,m[0],m[2], b,m[1],m[0], cc,m[2],m[1], m[0],m[1],m[2]};
+            newtri.insert(newtri.end(), nt, nt+12);
+        }
+        tri.swap(newtri);
+    }
+    for (size_t i=0;i<v.size();i++)
+        v[i] = c+v[i]*R;
+}
+// smallest icosphere level with at least n vertices
+inline int IcosphereLevel(double n)
+{
+    int level = 0;
+    while(10.0*pow(4.0, level)+2<n)
+        level++;
+    return level;
+}
+
+#endif
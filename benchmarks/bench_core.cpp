@@ -0,0 +1,164 @@
+/*
+ Microbenchmarks of the TS2CGCore kernels: cell list build/query, gro write/parse, the rigid body
+ transform used by PCG to place lipids (BackMap::GenLipid) and the geodesic distance engine.
+ usage: bench_core [max number of points, default 1000000]
+ Sizes run from 10^4 up to the maximum in steps of 10.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <random>
+#include "Bench.h"
+#include "CellList.h"
+#include "GroIO.h"
+#include "RigidTransform.h"
+#include "Tensor2.h"
+#include "Geodesic.h"
+
+static void CellListBench(long n, std::mt19937 &rng)
+{
+    // bead density of a coarse grained system, ~10 beads/nm^3
+    double L = cbrt(double(n)/10.0);
+    Vec3D box(L, L, L);
+    std::uniform_real_distribution<double> u(0, L);
+    std::vector<Vec3D> pos(n), query(n);
+    for (long i=0;i<n;i++)
+    {
+        pos[i] = Vec3D(u(rng), u(rng), u(rng));
+        query[i] = Vec3D(u(rng), u(rng), u(rng));
+    }
+    CellList cells;
+    int rep = BenchRepeats(n);
+    BenchTimer t;
+    for (int r=0;r<rep;r++)
+        cells.Build(pos, box, 0.4, 1.0);
+    BenchReport("celllist_build", double(n)*rep, "points", t.Seconds());
+
+    long hit = 0;
+    long nq = std::min(n, 200000L);
+    t.Reset();
+    for (long i=0;i<nq;i++)
+        hit += cells.AnyWithin(query[i]);
+    BenchReport("celllist_anywithin", double(nq), "queries", t.Seconds());
+
+    long pairs = 0;
+    t.Reset();
+    for (long i=0;i<nq;i++)
+        cells.ForEachWithin(query[i], [&pairs](int, double) {pairs++;});
+    BenchReport("celllist_foreachwithin", double(nq), "queries", t.Seconds());
+    if(hit<0 || pairs<0)
+        printf("%ld %ld\n", hit, pairs);
+}
+static void GroBench(long n, std::mt19937 &rng)
+{
+    std::string file = "bench_core.gro";
+    double L = cbrt(double(n)/10.0);
+    std::uniform_real_distribution<double> u(0, L);
+    BenchTimer t;
+    GroWriter w;
+    if(!w.Open(file, "benchmark", n))
+    {
+        printf("---> error: could not write %s \n", file.c_str());
+        return;
+    }
+    for (long i=0;i<n;i++)
+        w.Write(i/12+1, "POPC", "C1A", i+1, u(rng), u(rng), u(rng));
+    w.Close(Vec3D(L, L, L));
+    double sw = t.Seconds();
+    FILE *f = fopen(file.c_str(), "rb");
+    fseek(f, 0, SEEK_END);
+    double mb = ftell(f)/1.0e6;
+    fclose(f);
+    BenchReport("gro_write", mb, "MB", sw);
+
+    std::string title;
+    std::vector<GroAtom> atoms;
+    Vec3D box;
+    t.Reset();
+    GroIO::Read(file, title, atoms, box);
+    double sr = t.Seconds();
+    BenchReport("gro_parse", mb, "MB", sr);
+    BenchReport("gro_parse_atoms", double(atoms.size()), "atoms", sr);
+    remove(file.c_str());
+}
+// one 12 bead lipid template placed at n random frames, as in BackMap::GenLipid
+static void GenLipidBench(long n, std::mt19937 &rng)
+{
+    const int nb = 12;
+    std::vector<double> x(nb), y(nb), z(nb), ox(nb), oy(nb), oz(nb);
+    for (int i=0;i<nb;i++)
+    {
+        x[i] = 0.1*(i%3); y[i] = 0.1*(i%2); z[i] = 2.0-0.3*i;
+    }
+    double L = sqrt(double(n));
+    Vec3D box(L, L, 10);
+    std::uniform_real_distribution<double> u(0, 1);
+    std::vector<Tensor2> R(n);
+    std::vector<Vec3D> T(n);
+    for (long k=0;k<n;k++)
+    {
+        Vec3D N(u(rng)-0.5, u(rng)-0.5, u(rng)-0.5);
+        N.normalize();
+        Vec3D t1 = N*Vec3D(0, 0, 1);
+        if(t1.norm()<1e-6)
+            t1 = Vec3D(1, 0, 0);
+        t1.normalize();
+        Vec3D t2 = N*t1;
+        Tensor2 GL(t1, t2, N);
+        R[k] = GL.Transpose(GL);
+        T[k] = Vec3D(L*u(rng), L*u(rng), 5);
+    }
+    double sum = 0;
+    int rep = BenchRepeats(n*nb, 20000000);
+    BenchTimer t;
+    for (int r=0;r<rep;r++)
+        for (long k=0;k<n;k++)
+        {
+            RigidTransform::Apply(x.data(), y.data(), z.data(), nb, R[k], T[k], box, ox.data(), oy.data(), oz.data());
+            sum += ox[0];
+        }
+    BenchReport(std::string("genlipid_transform_")+RigidTransform::ISA(), double(n)*nb*rep, "beads", t.Seconds());
+    if(sum==-1)
+        printf("%f\n", sum);
+}
+// a flat sheet with ~1 point/nm^2 (like OuterBM.dat); 100 domains of radius 5 nm and one full field
+static void GeodesicBench(long n, std::mt19937 &rng)
+{
+    int nx = int(sqrt(double(n)));
+    std::uniform_real_distribution<double> u(-0.2, 0.2);
+    std::vector<Vec3D> pos;
+    for (int i=0;i<nx;i++)
+        for (int j=0;j<nx;j++)
+            pos.push_back(Vec3D(i+0.5+u(rng), j+0.5+u(rng), 5+u(rng)));
+    Vec3D box(nx, nx, 10);
+    BenchTimer t;
+    Geodesic g;
+    g.Build(pos, box, 1.8, 12);
+    BenchReport("geodesic_build", double(pos.size()), "points", t.Seconds());
+
+    std::vector<int> sources;
+    std::uniform_int_distribution<int> pick(0, int(pos.size())-1);
+    for (int s=0;s<100;s++)
+        sources.push_back(pick(rng));
+    std::vector<double> dist;
+    std::vector<int> nearest;
+    t.Reset();
+    g.Distances(sources, 5.0, dist, nearest);
+    BenchReport("geodesic_domains_r5", 100.0, "sources", t.Seconds());
+    t.Reset();
+    g.Distances(sources, 0, dist, nearest);
+    BenchReport("geodesic_full_field", double(pos.size()), "points", t.Seconds());
+}
+int main(int argc, char *argv[])
+{
+    long nmax = (argc>1) ? atol(argv[1]) : 1000000;
+    std::mt19937 rng(9474);
+    for (long n=10000;n<=nmax;n*=10)
+    {
+        printf("---- n = %ld \n", n);
+        CellListBench(n, rng);
+        GroBench(n, rng);
+        GenLipidBench(n, rng);
+        GeodesicBench(n, rng);
+    }
+    return 0;
+}
@@ -0,0 +1,89 @@
+/*
+ Microbenchmarks of the PLM kernels on a procedural icosphere: each round of Surface_Mosaicing
+ (MosaicOneRound followed by the geometry update of the refined mesh, which is what PerformMosaicing
+ does) and Curvature::SurfVertexCurvature over all vertices of the refined mesh.
+ usage: bench_plm [max number of vertices, default 1000000]
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "Bench.h"
+#include "MESH.h"
+#include "Curvature.h"
+#include "Surface_Mosaicing.h"
+
+static MeshBluePrint IcosphereBluePrint(int level, double &R)
+{
+    std::vector<Vec3D> v;
+    std::vector<int> tri;
+    R = 20;
+    Vec3D box(2*R+10, 2*R+10, 2*R+10);
+    Icosphere(level, R, box*0.5, v, tri);
+    MeshBluePrint bp;
+    bp.simbox = box;
+    for (size_t i=0;i<v.size();i++)
+    {
+        Vertex_Map m;
+        m.x = v[i](0); m.y = v[i](1); m.z = v[i](2);
+        m.id = i; m.domain = 0; m.include = true;
+        bp.bvertex.push_back(m);
+    }
+    for (size_t i=0;i<tri.size()/3;i++)
+    {
+        Triangle_Map t;
+        t.id = i; t.v1 = tri[3*i]; t.v2 = tri[3*i+1]; t.v3 = tri[3*i+2];
+        bp.btriangle.push_back(t);
+    }
+    return bp;
+}
+// the part of the geometry update that has to be done before the vertex curvature
+static void PrepareTrianglesAndLinks(MESH *pMesh)
+{
+    for (std::vector<triangle *>::iterator it = (pMesh->m_pActiveT).begin() ; it != (pMesh->m_pActiveT).end(); ++it)
+        (*it)->UpdateNormal_Area(pMesh->m_pBox);
+    for (std::vector<links *>::iterator it = (pMesh->m_pHL).begin() ; it != (pMesh->m_pHL).end(); ++it)
+    {
+        (*it)->UpdateNormal();
+        (*it)->UpdateShapeOperator(pMesh->m_pBox);
+    }
+}
+int main(int argc, char *argv[])
+{
+    long nmax = (argc>1) ? atol(argv[1]) : 1000000;
+    // PLM meshes are small and reach their size by mosaicing, so the benchmark does the same:
+    // a level 2 icosphere (162 vertices) refined round by round until it has more than nmax vertices
+    double R;
+    BenchTimer t;
+    MeshBluePrint bp = IcosphereBluePrint(2, R);
+    MESH mesh;
+    mesh.GenerateMesh(bp);
+    BenchReport("mesh_generate", double((mesh.m_pActiveV).size()), "points", t.Seconds());
+    PrepareTrianglesAndLinks(&mesh);
+    Curvature curvature;
+    for (std::vector<vertex *>::iterator it = (mesh.m_pSurfV).begin() ; it != (mesh.m_pSurfV).end(); ++it)
+        curvature.SurfVertexCurvature(*it);
+
+    // only the last two meshes are kept (PLM keeps all of them)
+    Surface_Mosaicing mos[2];
+    MESH *pMesh = &mesh;
+    for (int j=0;10.0*pow(4.0, j+3)+2<=std::max(nmax, 10242L);j++)
+    {
+        mos[j%2] = Surface_Mosaicing("Type1", false);
+        t.Reset();
+        mos[j%2].PerformMosaicing(pMesh);
+        double sm = t.Seconds();
+        pMesh = mos[j%2].m_pMesh;
+        double nv = (pMesh->m_pActiveV).size();
+        if(nv<10000)
+            continue;
+        printf("---- round %d: %.0f vertices \n", int(j+1), nv);
+        BenchReport("mosaic_one_round", nv, "points", sm);
+
+        int rep = BenchRepeats(long(nv), 1000000);
+        t.Reset();
+        for (int r=0;r<rep;r++)
+            for (std::vector<vertex *>::iterator it = (pMesh->m_pSurfV).begin() ; it != (pMesh->m_pSurfV).end(); ++it)
+                curvature.SurfVertexCurvature(*it);
+        BenchReport("surfvertexcurvature", nv*rep, "points", t.Seconds());
+    }
+    return 0;
+}
@@ -0,0 +1,46 @@
+/*
+ Writes a procedural icosphere as a TSI file, the input of the end to end PLM -> PCG scaling runs.
+ usage: make_icosphere <number of vertices> <area per vertex (nm^2)> <output.tsi>
+ The sphere is refined until it has at least the requested number of vertices (10*4^level+2) and
+ its radius is chosen so that each vertex carries the requested area.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "Bench.h"
+
+int main(int argc, char *argv[])
+{
+    if(argc<4)
+    {
+        printf("usage: %s <number of vertices> <area per vertex (nm^2)> <output.tsi> \n", argv[0]);
+        return 1;
+    }
+    double n = atof(argv[1]);
+    double ap = atof(argv[2]);
+    int level = IcosphereLevel(n);
+    double nv = 10.0*pow(4.0, level)+2;
+    double R = sqrt(nv*ap/(4*acos(-1.0)));
+    Vec3D box(2*R+20, 2*R+20, 2*R+20);
+    std::vector<Vec3D> v;
+    std::vector<int> tri;
+    Icosphere(level, R, box*0.5, v, tri);
+
+    FILE *f = fopen(argv[3], "w");
+    if(f==NULL)
+    {
+        printf("---> error: could not open %s \n", argv[3]);
+        return 1;
+    }
+    fprintf(f, "version 1.1\n");
+    fprintf(f, "box %18.10f%18.10f%18.10f\n", box(0), box(1), box(2));
+    fprintf(f, "vertex %20d\n", int(v.size()));
+    for (size_t i=0;i<v.size();i++)
+        fprintf(f, "%10d %17.10f %17.10f %17.10f\n", int(i), v[i](0), v[i](1), v[i](2));
+    fprintf(f, "triangle %18d\n", int(tri.size()/3));
+    for (size_t i=0;i<tri.size()/3;i++)
+        fprintf(f, "%10d %10d %10d %10d\n", int(i), tri[3*i], tri[3*i+1], tri[3*i+2]);
+    fprintf(f, "inclusion %17d\n", 0);
+    fclose(f);
+    printf("%s: level %d, %d vertices, %d triangles, R = %.3f nm \n", argv[3], level, int(v.size()), int(tri.size()/3), R);
+    return 0;
+}
@@ -0,0 +1,150 @@
+"""End to end scaling runs of PCG and PLM (python standard library only, runs offline).
+
+For every size from 10^4 points up to --max (steps of 10) it
+  * builds each of PCG's analytical shapes (Flat, Sphere, Cylinder, 1D_PBC_Fourier) with the box
+    scaled to the requested number of points per layer,
+  * writes an icosphere TSI mesh (make_icosphere), refines it with PLM and builds it with PCG,
+and prints the throughput of each phase from the *_report.json files the tools write.
+Use --json to store all numbers for comparing two versions.
+"""
+import argparse
+import json
+import math
+import os
+import subprocess
+import sys
+import time
+
+LIPIDS = """[Lipids List]
+Domain  0
+POPC 1  1  0.64
+End
+"""
+DENSITY = 3.0       # points per nm^2 of the analytical shapes
+THICKNESS = 4.0
+
+
+def shape_data(shape, n):
+    """[Shape Data] block of a shape with about n points per layer"""
+    area = n / DENSITY
+    if shape == "Flat":
+        lx = math.sqrt(area)
+        box, extra = (lx, lx, 20.0), []
+    elif shape == "1D_PBC_Fourier":
+        # the generator samples x with a step of 0.0002/Lx, so Lx stays fixed and y carries the size
+        lx = 30.0
+        box, extra = (lx, area / lx, 30.0), ["Mode 1.5   1   0"]
+    elif shape == "Sphere":
+        r = math.sqrt(area / (4 * math.pi))
+        box, extra = (2 * r + 20,) * 3, [f"Radius {r:.3f}"]
+    elif shape == "Cylinder":
+        r = 10.0
+        lz = area / (2 * math.pi * r)
+        box, extra = (2 * r + 20, 2 * r + 20, lz), [f"Radius {r:.3f}"]
+    else:
+        raise ValueError(shape)
+    lines = ["[Shape Data]", f"ShapeType {shape}", "Box {:.3f} {:.3f} {:.3f}".format(*box),
+             f"Density {DENSITY} 1", f"Thickness {THICKNESS}"] + extra + ["End"]
+    return "\n".join(lines) + "\n"
+
+
+def run(cmd, cwd):
+    t0 = time.perf_counter()
+    r = subprocess.run(cmd, cwd=cwd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+    wall = time.perf_counter() - t0
+    if r.returncode != 0 or "error" in r.stdout.lower():
+        print(r.stdout[-2000:])
+        raise RuntimeError(f"{' '.join(cmd)} failed")
+    return wall
+
+
+def phases(report_file):
+    with open(report_file) as f:
+        rep = json.load(f)
+    out = {}
+    for p in rep["phases"]:
+        d = out.setdefault(p["name"], {"seconds": 0.0, "counters": {}})
+        d["seconds"] += p["seconds"]
+        for k, v in p["counters"].items():
+            d["counters"][k] = d["counters"].get(k, 0) + v
+    return rep, out
+
+
+def line(case, n, what, items, unit, seconds):
+    rate = items / seconds if seconds > 0 else 0.0
+    print(f"{case:<16} {n:>10.0e} {what:<20} {items:>13.0f} {unit:<6} {seconds:>9.3f} s {rate:>12.4g} {unit}/s")
+    return {"case": case, "n": n, "what": what, "items": items, "unit": unit, "seconds": seconds, "rate": rate}
+
+
+def pcg_lines(case, n, folder, name):
+    rep, ph = phases(os.path.join(folder, f"{name}_report.json"))
+    rows = []
+    pr = ph["point read"]
+    npts = pr["counters"].get("upper points", 0) + pr["counters"].get("lower points", 0)
+    rows.append(line(case, n, "PCG points", npts, "points", pr["seconds"]))
+    lp = ph.get("lipid placement")
+    if lp:
+        rows.append(line(case, n, "PCG lipid placement", lp["counters"].get("beads", 0), "beads", lp["seconds"]))
+    wr = ph["write"]
+    mb = os.path.getsize(os.path.join(folder, f"{name}.gro")) / 1e6
+    rows.append(line(case, n, "PCG write", mb, "MB", wr["seconds"]))
+    rows.append(line(case, n, "PCG total", wr["counters"].get("beads", 0), "beads", rep["total_seconds"]))
+    rows[-1]["peak_rss_kb"] = rep["peak_rss_kb"]
+    return rows
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("--pcg", required=True)
+    ap.add_argument("--plm", required=True)
+    ap.add_argument("--icosphere", required=True, help="make_icosphere executable")
+    ap.add_argument("--min", type=float, default=1e4)
+    ap.add_argument("--max", type=float, default=1e6, help="points per layer of the largest run (up to 1e8)")
+    ap.add_argument("--shapes", default="Flat,Sphere,Cylinder,1D_PBC_Fourier")
+    ap.add_argument("--workdir", default="scaling")
+    ap.add_argument("--json", help="write all rows to this file")
+    args = ap.parse_args()
+    args.pcg, args.plm, args.icosphere = (os.path.abspath(p) for p in (args.pcg, args.plm, args.icosphere))
+
+    os.makedirs(args.workdir, exist_ok=True)
+    rows = []
+    n = args.min
+    while n <= args.max * 1.0001:
+        for shape in args.shapes.split(","):
+            folder = os.path.join(args.workdir, f"{shape}_{n:.0e}")
+            os.makedirs(folder, exist_ok=True)
+            with open(os.path.join(folder, "input.str"), "w") as f:
+                f.write(LIPIDS + "\n" + shape_data(shape, n))
+            run([args.pcg, "-str", "input.str", "-function", "analytical_shape", "-defout", "system"], folder)
+            rows += pcg_lines(shape, n, folder, "system")
+
+        # icosphere: a coarse TSI (at most 642 vertices, PLM meshes are small) refined by PLM in
+        # k rounds to about n points per layer
+        level = 0
+        while 10 * 4 ** level + 2 < n:
+            level += 1
+        k = max(1, level - 3)
+        folder = os.path.join(args.workdir, f"icosphere_{n:.0e}")
+        os.makedirs(folder, exist_ok=True)
+        run([args.icosphere, str(n / 4 ** k), str(4 ** k / DENSITY), "ico.tsi"], folder)
+        run([args.plm, "-TSfile", "ico.tsi", "-Mashno", str(k), "-bilayerThickness", str(THICKNESS), "-less"], folder)
+        rep, ph = phases(os.path.join(folder, "plm_report.json"))
+        wr = ph["write"]
+        rows.append(line("icosphere", n, "PLM total", wr["counters"].get("points", 0), "points", rep["total_seconds"]))
+        for name, d in ph.items():
+            if name.startswith("mosaicing round"):
+                rows.append(line("icosphere", n, "PLM " + name, d["counters"].get("vertices", 0), "points", d["seconds"]))
+        with open(os.path.join(folder, "input.str"), "w") as f:
+            f.write(LIPIDS)
+        run([args.pcg, "-str", "input.str", "-defout", "system"], folder)
+        rows += pcg_lines("icosphere", n, folder, "system")
+        n *= 10
+
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(rows, f, indent=1)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -23,6 +23,12 @@ class CMakeBuild(build_ext):
             f'-DPYTHON_EXECUTABLE={sys.executable}',
             '-DCMAKE_BUILD_TYPE=Release'
         ]
+        # the in-process python modules are built when pybind11 is available
+        try:
+            import pybind11
+            cmake_args.append(f'-Dpybind11_DIR={pybind11.get_cmake_dir()}')
+        except ImportError:
+            pass
 
         build_temp = Path(self.build_temp)
         build_temp.mkdir(parents=True, exist_ok=True)
@@ -46,7 +52,7 @@ setup(
     ext_modules=[CMakeExtension('TS2CG')],
     cmdclass={'build_ext': CMakeBuild},
     package_data={
-        'TS2CG': ['SOL', 'PLM', 'PCG', 'CMakeLists.txt',
+        'TS2CG': ['SOL', 'PLM', 'PCG', 'libPLMRefine.*', 'CMakeLists.txt',
                   'core/*', 'tools/*', 'cpp/*'],
     },
     include_package_data=True,
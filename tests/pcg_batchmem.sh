@@ -0,0 +1,21 @@
+#!/bin/sh
+# PCG -batch with -batchmem on a small vesicle of tutorial 1: a budget below the memory of one job lets only
+# one job run at a time (so the job times add up to no more than the batch time), every job is done, and
+# each job gives the same files as a single PCG run with its seed and options.
+# usage: pcg_batchmem.sh PLM PCG TUTORIAL_DIR WORK_DIR
+PLM=$1; PCG=$2; TUT=$3; WORK=$4
+rm -rf "$WORK"; mkdir -p "$WORK"; cd "$WORK" || exit 1
+cp "$TUT/Sphere.tsi" "$TUT/input.str" .
+"$PLM" -TSfile Sphere.tsi -bilayerThickness 3.8 -rescalefactor 2 2 2 -less > plm.txt || exit 1
+pcg() { "$PCG" -str input.str -Bondlength 0.2 -LLIB "$TUT/files/Martini3.LIB" "$@"; }
+printf 'input.str 11 j1\ninput.str 12 j2\n; a comment\ninput.str 13 j3 -renorm\n' > jobs.txt
+pcg -batch jobs.txt -batchjobs 3 -batchmem 1 -defout batch > batch.txt || exit 1
+[ "$(grep -c '"status": "done"' batch_batch.json)" = "3" ] || { echo "not all jobs are done"; cat batch_batch.json; exit 1; }
+awk -F'"seconds": ' '/"total_seconds"/{split($0, a, ": "); total=a[2]+0} NF>1{split($2, b, ","); sum+=b[1]}
+     END{if(sum>total) {print "the jobs overlap: " sum " s of jobs in " total " s"; exit 1}}' batch_batch.json || exit 1
+pcg -seed 11 -defout s1 > s1.txt || exit 1
+pcg -seed 12 -defout s2 > s2.txt || exit 1
+pcg -seed 13 -defout s3 -renorm > s3.txt || exit 1
+for i in 1 2 3; do
+    cmp s$i.gro j$i.gro && cmp s$i.top j$i.top || { echo "job j$i is not the same as a single run"; exit 1; }
+done
@@ -0,0 +1,25 @@
+#!/bin/sh
+# The lipid library cache of PCG (TS2CG_CACHE_DIR) on a small vesicle of tutorial 1: the first run stores the
+# parsed library, the next run loads it instead of parsing (the file is not written again), a cut-off file is
+# parsed again and replaced, another -Bondlength is another entry, and the structure is always the same.
+# usage: pcg_libcache.sh PLM PCG TUTORIAL_DIR WORK_DIR
+PLM=$1; PCG=$2; TUT=$3; WORK=$4
+rm -rf "$WORK"; mkdir -p "$WORK"; cd "$WORK" || exit 1
+cp "$TUT/Sphere.tsi" "$TUT/input.str" .
+"$PLM" -TSfile Sphere.tsi -bilayerThickness 3.8 -rescalefactor 2 2 2 -less > plm.txt || exit 1
+pcg() { "$PCG" -str input.str -LLIB "$TUT/files/Martini3.LIB" "$@"; }
+pcg -Bondlength 0.2 -defout plain > plain.txt || exit 1
+export TS2CG_CACHE_DIR="$WORK/cache"; mkdir cache
+pcg -Bondlength 0.2 -defout store > store.txt || exit 1
+[ "$(ls cache | grep -c '^lib_.*\.bin$')" = "1" ] || { echo "the library is not stored: $(ls cache)"; exit 1; }
+LIB=cache/$(ls cache); INODE=$(ls -i "$LIB" | awk '{print $1}'); SIZE=$(wc -c < "$LIB")
+pcg -Bondlength 0.2 -defout load > load.txt || exit 1
+[ "$(ls -i "$LIB" | awk '{print $1}')" = "$INODE" ] || { echo "the stored library is parsed again"; exit 1; }
+head -c 100 "$LIB" > cut.bin; mv cut.bin "$LIB"
+pcg -Bondlength 0.2 -defout cut > cut.txt || exit 1
+[ "$(wc -c < "$LIB")" -eq "$SIZE" ] || { echo "a cut-off library file is not replaced"; exit 1; }
+for run in store load cut; do
+    cmp plain.gro $run.gro && cmp plain.top $run.top || { echo "$run: the structure depends on the cache"; exit 1; }
+done
+pcg -Bondlength 0.25 -defout bond > bond.txt || exit 1
+[ "$(ls cache | grep -c '^lib_.*\.bin$')" = "2" ] || { echo "-Bondlength is not part of the key: $(ls cache)"; exit 1; }
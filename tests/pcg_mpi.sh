@@ -0,0 +1,19 @@
+#!/bin/sh
+# PCG_MPI on the analytic shape of tutorial 6: one rank writes the files of PCG byte for byte, three ranks
+# the same number of atoms and of each lipid (the top file then has one block per rank).
+# usage: pcg_mpi.sh PCG PCG_MPI MPIEXEC NUMPROC_FLAG TUTORIAL_DIR WORK_DIR
+PCG=$1; PCGMPI=$2; MPIEXEC=$3; NP=$4; TUT=$5; WORK=$6
+rm -rf "$WORK"; mkdir -p "$WORK"; cd "$WORK" || exit 1
+cp "$TUT/input.str" .
+OPT="-str input.str -Bondlength 0.2 -LLIB $TUT/files/Martini3.LIB -function analytical_shape"
+"$PCG" $OPT -defout serial > serial.txt || exit 1
+"$MPIEXEC" $NP 1 "$PCGMPI" $OPT -defout np1 > np1.txt || exit 1
+cmp serial.gro np1.gro || { echo "-np 1 does not write the gro file of PCG"; exit 1; }
+cmp serial.top np1.top || { echo "-np 1 does not write the top file of PCG"; exit 1; }
+"$MPIEXEC" $NP 3 "$PCGMPI" $OPT -defout np3 > np3.txt || exit 1
+[ "$(sed -n 2p serial.gro)" = "$(sed -n 2p np3.gro)" ] || { echo "-np 3 changes the number of atoms"; exit 1; }
+[ "$(grep -c . np3.gro)" = "$(grep -c . serial.gro)" ] || { echo "np3.gro does not have all atom lines"; exit 1; }
+# molecules of each name, summed over the blocks of the top file
+count() { awk '/\[ *molecules *\]/{m=1; next} m && NF==2 && $1!~/^;/ {n[$1]+=$2} END{for(k in n) print k, n[k]}' "$1" | sort; }
+[ -n "$(count serial.top)" ] || { echo "no molecules in serial.top"; exit 1; }
+[ "$(count serial.top)" = "$(count np3.top)" ] || { echo "-np 3 changes the number of lipids"; count serial.top; count np3.top; exit 1; }
@@ -0,0 +1,21 @@
+#!/bin/sh
+# PCG -relax on a small vesicle of tutorial 1: the relaxation must remove close pairs without changing the
+# molecules in the topology, must not depend on the number of threads, and -relax 0 must be the plain build.
+# usage: pcg_relax.sh PLM PCG TUTORIAL_DIR WORK_DIR
+PLM=$1; PCG=$2; TUT=$3; WORK=$4
+rm -rf "$WORK"; mkdir -p "$WORK"; cd "$WORK" || exit 1
+cp "$TUT/Sphere.tsi" "$TUT/input.str" .
+"$PLM" -TSfile Sphere.tsi -bilayerThickness 3.8 -rescalefactor 2 2 2 -less > plm.txt || exit 1
+pcg() { "$PCG" -str input.str -Bondlength 0.2 -LLIB "$TUT/files/Martini3.LIB" "$@"; }
+pcg -defout plain > plain.txt || exit 1
+pcg -defout off -relax 0 > off.txt || exit 1
+pcg -defout one -relax 5 -nt 1 > one.txt || exit 1
+pcg -defout four -relax 5 -nt 4 > four.txt || exit 1
+cmp plain.gro off.gro || { echo "-relax 0 changes the structure"; exit 1; }
+cmp one.gro four.gro || { echo "the relaxation depends on the number of threads"; exit 1; }
+cmp plain.top one.top || { echo "the relaxation changes the topology"; exit 1; }
+cmp -s plain.gro one.gro && { echo "-relax 5 does not move any bead"; exit 1; }
+[ "$(sed -n 2p plain.gro)" = "$(sed -n 2p one.gro)" ] || { echo "the relaxation changes the number of beads"; exit 1; }
+# ---> bead pairs closer than 0.36 nm: <before> before and <after> after 5 steps
+set -- $(sed -n 's/.*closer than .* nm: \([0-9]*\) before and \([0-9]*\) after.*/\1 \2/p' one.txt)
+[ $# -eq 2 ] && [ "$2" -lt "$1" ] || { echo "close pairs before and after: $*"; exit 1; }
@@ -0,0 +1,38 @@
+#!/bin/sh
+# PLM -cache on the vesicle of tutorial 1: the first run stores an entry (miss), the same input is taken from
+# the cache (hit) with the same point files, other options are another entry, a damaged entry is removed and
+# refined again, a hard link of the user among the outputs is not removed, and without TS2CG_CACHE_DIR the
+# option is ignored with a warning.
+# usage: plm_cache.sh PLM TUTORIAL_DIR WORK_DIR
+PLM=$1; TUT=$2; WORK=$3
+rm -rf "$WORK"; mkdir -p "$WORK"; cd "$WORK" || exit 1
+cp "$TUT/Sphere.tsi" .
+plm() { "$PLM" -TSfile Sphere.tsi -bilayerThickness 3.8 -rescalefactor 4 4 4 -less "$@"; }
+unset TS2CG_CACHE_DIR
+plm -cache 0 > nodir.txt || exit 1
+grep -q "warning: -cache is ignored" nodir.txt || { echo "no warning without TS2CG_CACHE_DIR"; exit 1; }
+mv point plain
+export TS2CG_CACHE_DIR="$WORK/cache"
+same() { for f in OuterBM InnerBM; do cmp "$1/$f.dat" "$2/$f.dat" || return 1; done; }
+plm -cache 0 > miss.txt || exit 1
+grep -q "taken from the cache" miss.txt && { echo "the first run is a hit"; exit 1; }
+[ "$(ls cache | grep -c '^plm_')" = "1" ] || { echo "the first run stores no entry: $(ls cache)"; exit 1; }
+same plain point || { echo "the first run with -cache differs"; exit 1; }
+plm -cache 0 > hit.txt || exit 1
+grep -q "taken from the cache" hit.txt || { echo "the second run is not a hit"; exit 1; }
+same plain point || { echo "the point files from the cache differ"; exit 1; }
+# a hard link of the user is left alone, a link into the cache is replaced before PLM writes
+rm point/InnerBM.dat; echo mine > mine.dat; ln mine.dat point/InnerBM.dat
+plm -cache 0 -bilayerThickness 4.0 > other.txt || exit 1
+grep -q "taken from the cache" other.txt && { echo "other options are a hit"; exit 1; }
+[ "$(ls cache | grep -c '^plm_')" = "2" ] || { echo "other options are not another entry: $(ls cache)"; exit 1; }
+cmp -s mine.dat point/InnerBM.dat || { echo "the hard link of the user was removed"; exit 1; }
+# a damaged entry is removed and the surface is refined again
+ENTRY=$(ls -d cache/plm_* | head -1)
+printf 'x' >> "$ENTRY/point_OuterBM.dat"
+plm -cache 0 > damaged1.txt || exit 1
+plm -cache 0 -bilayerThickness 4.0 > damaged2.txt || exit 1
+grep -q "is damaged" damaged1.txt damaged2.txt || { echo "the damaged entry is not found"; exit 1; }
+plm -cache 0 > again.txt || exit 1
+grep -q "taken from the cache" again.txt || { echo "the entry is not stored again"; exit 1; }
+same plain point || { echo "the point files differ after a damaged entry"; exit 1; }
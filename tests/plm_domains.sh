@@ -0,0 +1,15 @@
+#!/bin/sh
+# PLM on the domain vesicle of tutorial 3: the point files must not depend on the number of threads or on
+# the contents of fresh memory, and each domain must keep its number of points.
+# usage: plm_domains.sh PLM TUTORIAL_DIR WORK_DIR
+PLM=$1; TUT=$2; WORK=$3
+rm -rf "$WORK"; mkdir -p "$WORK/a" "$WORK/b"
+cp "$TUT/Sphere.tsi" "$WORK/a/"; cp "$TUT/Sphere.tsi" "$WORK/b/"
+(cd "$WORK/a" && "$PLM" -TSfile Sphere.tsi -bilayerThickness 3.8 -rescalefactor 4 4 4 -nt 1 > plm.txt) || exit 1
+(cd "$WORK/b" && MALLOC_PERTURB_=165 "$PLM" -TSfile Sphere.tsi -bilayerThickness 3.8 -rescalefactor 4 4 4 -nt 4 > plm.txt) || exit 1
+for layer in OuterBM InnerBM; do
+    cmp "$WORK/a/point/$layer.dat" "$WORK/b/point/$layer.dat" || { echo "$layer.dat depends on the run"; exit 1; }
+done
+count() { awk 'NR>4{n[$2]++} END{printf "%d %d %d", n[0], n[1], n[2]}' "$WORK/a/point/$1.dat"; }
+[ "$(count OuterBM)" = "7640 326 228" ] || { echo "OuterBM.dat domains: $(count OuterBM)"; exit 1; }
+[ "$(count InnerBM)" = "7639 326 228" ] || { echo "InnerBM.dat domains: $(count InnerBM)"; exit 1; }
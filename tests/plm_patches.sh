@@ -0,0 +1,39 @@
+#!/bin/sh
+# PLM -patches on the vesicle with inclusions of tutorial 4: the inclusion and exclusion files must be the same
+# as without patches, and each layer must have the same points. Only the order of the points that are not
+# input vertices changes, and the values agree to the printed precision (one in the last digit).
+# usage: plm_patches.sh PLM TUTORIAL_DIR WORK_DIR
+PLM=$1; TUT=$2; WORK=$3
+rm -rf "$WORK"; mkdir -p "$WORK/whole" "$WORK/patches"
+cp "$TUT/Sphere.tsi" "$WORK/whole/"; cp "$TUT/Sphere.tsi" "$WORK/patches/"
+(cd "$WORK/whole" && "$PLM" -TSfile Sphere.tsi -bilayerThickness 3.8 -rescalefactor 4 4 4 -less > plm.txt) || exit 1
+(cd "$WORK/patches" && "$PLM" -TSfile Sphere.tsi -bilayerThickness 3.8 -rescalefactor 4 4 4 -less -patches 4 > plm.txt) || exit 1
+for file in IncData ExcData; do
+    cmp "$WORK/whole/point/$file.dat" "$WORK/patches/point/$file.dat" || { echo "$file.dat changes with -patches"; exit 1; }
+done
+for layer in OuterBM InnerBM; do
+    [ -f "$WORK/patches/point/$layer.dat.tmp" ] && { echo "the scratch file $layer.dat.tmp is left"; exit 1; }
+    cmp -s "$WORK/whole/point/$layer.dat" "$WORK/patches/point/$layer.dat" && continue
+    # every point of one file must have a point of the other at its place, with the same domain and type
+    # and all other values within 0.0015; the points are at least 0.1 nm apart, so the match is unique
+    awk 'function bin(x) {return int(x/0.5)}
+         FNR==1 {file++}
+         FNR<=4 {if(FNR==2) n[file]=$3+0; next}
+         file==1 {line[FNR]=$0; b=bin($4)" "bin($5)" "bin($6); cell[b]=cell[b]" "FNR; next}
+         {
+             found=0
+             for (i=-1;i<=1 && !found;i++) for (j=-1;j<=1 && !found;j++) for (k=-1;k<=1 && !found;k++) {
+                 m=split(cell[bin($4)+i" "bin($5)+j" "bin($6)+k], ids, " ")
+                 for (c=1;c<=m && !found;c++) {
+                     split(line[ids[c]], a, " ")
+                     if(a[2]!=$2 || a[18]!=$18 || a[1] in used) continue
+                     good=1
+                     for (f=3;f<=17;f++) { d=a[f]-$f; if(d>0.0015 || d<-0.0015) good=0 }
+                     if(good) {found=1; used[a[1]]=1}
+                 }
+             }
+             if(!found) {print "no match for point " $1; bad=1; exit}
+         }
+         END{if(!bad && n[1]!=n[2]) {print "the numbers of points differ: " n[1] " " n[2]; bad=1} exit bad}' \
+        "$WORK/whole/point/$layer.dat" "$WORK/patches/point/$layer.dat" || { echo "$layer.dat changes with -patches"; exit 1; }
+done
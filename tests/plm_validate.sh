@@ -0,0 +1,27 @@
+#!/bin/sh
+# PLM -r validate on the vesicle of tutorial 4 and on broken copies of it: a good mesh (closed or open) is
+# valid and exits 0; a flipped triangle, a cut-off file and an empty file are not valid and exit 1.
+# usage: plm_validate.sh PLM TUTORIAL_DIR WORK_DIR
+PLM=$1; TUT=$2; WORK=$3
+rm -rf "$WORK"; mkdir -p "$WORK"; cd "$WORK" || exit 1
+cp "$TUT/Sphere.tsi" .
+# the first triangle with two of its vertices swapped: its three edges have the wrong orientation
+awk 'f==1{t=$3; $3=$4; $4=t; f=2} /^triangle/{f=1} {print}' Sphere.tsi > Flip.tsi
+# one triangle less: an open surface, which is allowed
+awk '/^triangle/{n=$2; start=NR; $0=$1" "n-1} start && NR==start+n{next} {print}' Sphere.tsi > Open.tsi
+head -c 3000 Sphere.tsi > Cut.tsi
+: > Empty.tsi
+check() {   # file, exit code, lines the output must have
+    file=$1; code=$2; shift 2
+    "$PLM" -TSfile "$file" -r validate > "$file.json"
+    rc=$?
+    [ $rc -eq "$code" ] || { echo "$file: exit code $rc, not $code"; exit 1; }
+    for line in "$@"; do
+        grep -qF "$line" "$file.json" || { echo "$file: no $line"; cat "$file.json"; exit 1; }
+    done
+}
+check Sphere.tsi 0 '"valid": true' '"closed": true' '"genus": 0' '"inclusions": 3' '"exclusions": 1'
+check Open.tsi 0 '"valid": true' '"closed": false' '"boundary_loops": 1'
+check Flip.tsi 1 '"valid": false' '"flipped_edges": 3'
+check Cut.tsi 1 '"valid": false' '"error": "vertex line 48 is not complete"'
+check Empty.tsi 1 '"valid": false' '"error": "the file has no box line"'
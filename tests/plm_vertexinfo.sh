@@ -0,0 +1,18 @@
+#!/bin/sh
+# PLM -r vertexinfo -vertices all on the vesicle of tutorial 1 with its last triangle removed: the three vertices
+# of the hole are edge vertices and have no curvature (nan in csv and binary, null in json).
+# usage: plm_vertexinfo.sh PLM TUTORIAL_DIR WORK_DIR
+PLM=$1; TUT=$2; WORK=$3
+rm -rf "$WORK"; mkdir -p "$WORK"; cd "$WORK" || exit 1
+# one triangle less: the count goes down by one and the line before the inclusion section goes
+awk '/^triangle/{$0=$1" "$2-1} {line[NR]=$0} /^inclusion/{last=NR-1} END{for(i=1;i<=NR;i++) if(i!=last) print line[i]}' \
+    "$TUT/Sphere.tsi" > Open.tsi
+"$PLM" -TSfile Open.tsi -r vertexinfo -vertices all > csv.txt || exit 1
+[ "$(grep -c '^[0-9]' vertexinfo.csv)" = "130" ] || { echo "vertexinfo.csv does not have 130 vertices"; exit 1; }
+[ "$(grep -c ',nan,nan$' vertexinfo.csv)" = "3" ] || { echo "vertexinfo.csv does not have 3 edge vertices"; exit 1; }
+"$PLM" -TSfile Open.tsi -r vertexinfo -vertices all -vertexformat json > json.txt || exit 1
+[ "$(grep -c '"c1": null, "c2": null' vertexinfo.json)" = "3" ] || { echo "vertexinfo.json does not have 3 edge vertices"; exit 1; }
+grep -q nan vertexinfo.json && { echo "vertexinfo.json has nan"; exit 1; }
+"$PLM" -TSfile Open.tsi -r vertexinfo -vertices all -vertexformat binary > bin.txt || exit 1
+# magic, order and count (20 bytes), then an int and 15 doubles per vertex
+[ "$(wc -c < vertexinfo.bin)" -eq $((20+130*124)) ] || { echo "vertexinfo.bin has the wrong size"; exit 1; }
@@ -0,0 +1,24 @@
+#!/bin/sh
+# PLM -r vertexinfo -vertexformat json on the vesicle of tutorial 1, under a file name with a quote and a
+# backslash: the name is escaped, the vertices come in the order they are asked for (ids and ranges, or a file
+# of them), the values are the same as in the csv file, and an id that does not exist is an error.
+# usage: plm_vertexinfo_json.sh PLM TUTORIAL_DIR WORK_DIR
+PLM=$1; TUT=$2; WORK=$3
+rm -rf "$WORK"; mkdir -p "$WORK"; cd "$WORK" || exit 1
+NAME='we"ird\name.tsi'
+cp "$TUT/Sphere.tsi" "$NAME"
+"$PLM" -TSfile "$NAME" -r vertexinfo -vertices 7,0,5-6 > csv.txt || exit 1
+"$PLM" -TSfile "$NAME" -r vertexinfo -vertices 7,0,5-6 -vertexformat json > json.txt || exit 1
+grep -qF '"file": "we\"ird\\name.tsi",' vertexinfo.json || { echo "the file name is not escaped"; head -2 vertexinfo.json; exit 1; }
+[ "$(grep -o '"id": [0-9]*' vertexinfo.json | tr -dc '0-9\n' | tr '\n' ' ')" = "7 0 5 6 " ] || { echo "vertexinfo.json does not have the vertices 7 0 5 6"; exit 1; }
+# the json objects without the keys and brackets are the csv lines
+sed -n 's/^    {\(.*\)},\{0,1\}$/\1/p' vertexinfo.json | sed 's/"[a-z0-9]*": //g; s/[][ ]//g' > json.csv
+tail -n +2 vertexinfo.csv | cmp - json.csv || { echo "vertexinfo.json and vertexinfo.csv differ"; exit 1; }
+printf '7\n0 5-6\n' > ids.txt
+mv vertexinfo.json list.json
+"$PLM" -TSfile "$NAME" -r vertexinfo -vertices ids.txt -vertexformat json > file.txt || exit 1
+cmp list.json vertexinfo.json || { echo "a file of ids gives another vertexinfo.json"; exit 1; }
+rm vertexinfo.json
+"$PLM" -TSfile "$NAME" -r vertexinfo -vertices 0,500 -vertexformat json > missing.txt
+grep -q "error: vertex 500 does not exist" missing.txt || { echo "no error for a vertex that does not exist"; exit 1; }
+[ ! -f vertexinfo.json ] || { echo "vertexinfo.json is written for a vertex that does not exist"; exit 1; }
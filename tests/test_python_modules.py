@@ -0,0 +1,124 @@
+"""Smoke test of the in-process python modules _plm, _pcg and _sol (ctest python_modules).
+
+TS2CG_EXTENSION_DIR is the folder with the built modules and TS2CG_TUTORIALS the tutorial folder.
+ctest sets TS2CG_EXTENSION_DIR, and then a module that can not be imported is a failure; run by hand
+without it, the test is skipped when the modules were not built.
+"""
+import importlib
+import os
+import shutil
+import sys
+import threading
+
+import numpy as np
+import pytest
+
+if os.environ.get("TS2CG_EXTENSION_DIR"):
+    sys.path.insert(0, os.environ["TS2CG_EXTENSION_DIR"])
+    _plm, _pcg, _sol = (importlib.import_module(name) for name in ("_plm", "_pcg", "_sol"))
+else:
+    _plm, _pcg, _sol = (pytest.importorskip(name) for name in ("_plm", "_pcg", "_sol"))
+
+TUT1 = os.path.join(os.environ.get("TS2CG_TUTORIALS", os.path.join(os.path.dirname(__file__), "..", "Tutorials")), "tut1")
+PLM_OPTIONS = ["-bilayerThickness", "3.8", "-rescalefactor", "4", "4", "4"]
+
+
+def read_tsi(path):
+    """box, vertices and triangles of a tsi file"""
+    with open(path) as f:
+        lines = [line.split() for line in f if line.strip()]
+    box = np.array(next(l for l in lines if l[0] == "box")[1:4], dtype=float)
+    start = next(i for i, l in enumerate(lines) if l[0] == "vertex")
+    nv = int(lines[start][1])
+    vertices = np.array([l[1:4] for l in lines[start + 1:start + 1 + nv]], dtype=float)
+    start = next(i for i, l in enumerate(lines) if l[0] == "triangle")
+    nt = int(lines[start][1])
+    triangles = np.array([l[1:4] for l in lines[start + 1:start + 1 + nt]], dtype=np.int32)
+    return box, vertices, triangles
+
+
+def read_gro(path):
+    """atom names and coordinates of a gro file"""
+    with open(path) as f:
+        lines = f.readlines()
+    n = int(lines[1])
+    atoms = lines[2:2 + n]
+    return [a[10:15].strip() for a in atoms], np.array([[a[20:28], a[28:36], a[36:44]] for a in atoms], dtype=float)
+
+
+def pcg_options(defout):
+    return ["-str", "input.str", "-Bondlength", "0.2", "-LLIB", os.path.join(TUT1, "files", "Martini3.LIB"), "-defout", defout]
+
+
+@pytest.fixture(scope="module")
+def tut1(tmp_path_factory):
+    """tutorial 1 refined by _plm.run into <work>/point"""
+    work = tmp_path_factory.mktemp("tut1")
+    for name in ("Sphere.tsi", "input.str"):
+        shutil.copy(os.path.join(TUT1, name), str(work))
+    before = os.getcwd()
+    _plm.run(["-TSfile", "Sphere.tsi"] + PLM_OPTIONS, cwd=str(work))
+    assert os.getcwd() == before
+    assert os.path.isfile(os.path.join(str(work), "point", "OuterBM.dat"))
+    return work
+
+
+def test_failed_run_raises_and_restores_cwd(tut1):
+    before = os.getcwd()
+    with pytest.raises(RuntimeError):
+        _pcg.run(["-str", "missing.str"], cwd=str(tut1))
+    assert os.getcwd() == before
+
+
+def test_runs_in_threads_keep_their_directory(tmp_path):
+    """the runs share the process (working directory, seed), so they must not overlap"""
+    works = [tmp_path / name for name in ("a", "b")]
+    for work in works:
+        work.mkdir()
+        shutil.copy(os.path.join(TUT1, "Sphere.tsi"), str(work))
+    threads = [threading.Thread(target=_plm.run, args=(["-TSfile", "Sphere.tsi", "-nt", "1"] + PLM_OPTIONS, str(work)))
+               for work in works]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    outer = [open(str(work / "point" / "OuterBM.dat")).read() for work in works]
+    assert outer[0] == outer[1]
+
+
+def test_refine_matches_point_folder(tut1):
+    box, vertices, triangles = read_tsi(os.path.join(TUT1, "Sphere.tsi"))
+    refined = _plm.refine(vertices, triangles, box, options=PLM_OPTIONS)
+    folder = _plm.read_points(os.path.join(str(tut1), "point"))
+    for layer in ("outer", "inner"):
+        assert refined[layer]["coordinates"].shape == folder[layer]["coordinates"].shape
+        np.testing.assert_array_equal(refined[layer]["domain_ids"], folder[layer]["domain_ids"])
+        np.testing.assert_allclose(refined[layer]["coordinates"], folder[layer]["coordinates"], atol=1e-3)
+
+
+def test_place_matches_command_line(tut1):
+    points = _plm.read_points(os.path.join(str(tut1), "point"))
+    beads = _pcg.place(points, pcg_options("inprocess"), cwd=str(tut1))
+    _pcg.run(pcg_options("cli"), cwd=str(tut1))
+    names, coordinates = read_gro(os.path.join(str(tut1), "cli.gro"))
+    assert beads["names"] == names
+    assert beads["coordinates"].shape == (len(names), 3)
+    np.testing.assert_allclose(beads["coordinates"], coordinates, atol=1e-3)
+
+
+def test_transform_identity_frame():
+    template = np.array([[0.0, 0.0, 1.0], [0.1, 0.0, -1.0]])
+    positions = np.array([[5.0, 5.0, 5.0], [2.0, 3.0, 4.0]])
+    normals = np.tile([0.0, 0.0, 1.0], (2, 1))
+    p1 = np.tile([1.0, 0.0, 0.0], (2, 1))
+    p2 = np.tile([0.0, 1.0, 0.0], (2, 1))
+    out = _pcg.transform(template, positions, normals, p1, p2, np.array([10.0, 10.0, 10.0]))
+    np.testing.assert_allclose(out, np.concatenate([p + template for p in positions]), atol=1e-12)
+
+
+def test_fill_empty_box():
+    template = np.array([[0.25, 0.25, 0.25], [0.75, 0.75, 0.75]])
+    out = _sol.fill(np.zeros((0, 3)), np.array([3.0, 3.0, 3.0]), template, np.array([1.0, 1.0, 1.0]), npos=2, nneg=1)
+    n = len(out["coordinates"])
+    assert n > 0 and out["coordinates"].shape == (n, 3)
+    assert list(np.bincount(out["kind"], minlength=3)) == [n - 3, 2, 1]